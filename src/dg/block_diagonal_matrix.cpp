@@ -0,0 +1,130 @@
+#include <algorithm>
+
+#include "block_diagonal_matrix.h"
+
+namespace PHiLiP {
+
+template <typename real>
+void BlockDiagonalMatrix<real>::reinit(const dealii::IndexSet &locally_owned_rows_input)
+{
+    locally_owned_rows = locally_owned_rows_input;
+    block_sizes.clear();
+    block_value_offsets.clear();
+    block_row_offsets.clear();
+    block_rows.clear();
+    block_values.clear();
+    max_block_size = 0;
+}
+
+template <typename real>
+unsigned int BlockDiagonalMatrix<real>::add_block(
+    const std::vector<dealii::types::global_dof_index> &rows,
+    const dealii::FullMatrix<real> &block)
+{
+    const unsigned int n_rows = rows.size();
+    AssertDimension(block.m(), n_rows);
+    AssertDimension(block.n(), n_rows);
+
+    block_sizes.push_back(n_rows);
+    block_value_offsets.push_back(block_values.size());
+    block_row_offsets.push_back(block_rows.size());
+    max_block_size = std::max(max_block_size, n_rows);
+
+    for (unsigned int i = 0; i < n_rows; ++i) {
+        Assert(locally_owned_rows.is_element(rows[i]), dealii::ExcMessage("Block rows must be locally owned."));
+        block_rows.push_back(locally_owned_rows.index_within_set(rows[i]));
+    }
+    for (unsigned int i = 0; i < n_rows; ++i) {
+        for (unsigned int j = 0; j < n_rows; ++j) {
+            block_values.push_back(block(i,j));
+        }
+    }
+    return block_sizes.size() - 1;
+}
+
+template <typename real>
+dealii::types::global_dof_index BlockDiagonalMatrix<real>::m() const
+{
+    return locally_owned_rows.size();
+}
+
+template <typename real>
+unsigned int BlockDiagonalMatrix<real>::n_blocks() const
+{
+    return block_sizes.size();
+}
+
+template <typename real>
+unsigned int BlockDiagonalMatrix<real>::block_size(const unsigned int iblock) const
+{
+    return block_sizes[iblock];
+}
+
+template <typename real>
+real BlockDiagonalMatrix<real>::block_el(const unsigned int iblock, const unsigned int i, const unsigned int j) const
+{
+    return block_values[block_value_offsets[iblock] + i*block_sizes[iblock] + j];
+}
+
+template <typename real>
+void BlockDiagonalMatrix<real>::vmult(
+    dealii::LinearAlgebra::distributed::Vector<double> &dst,
+    const dealii::LinearAlgebra::distributed::Vector<double> &src) const
+{
+    AssertDimension(block_rows.size(), locally_owned_rows.n_elements());
+
+    // Gathering the block's entries first allows dst and src to be the same vector.
+    std::vector<real> src_block(max_block_size);
+    for (unsigned int iblock = 0; iblock < block_sizes.size(); ++iblock) {
+        const unsigned int n_rows = block_sizes[iblock];
+        const unsigned int *rows = &block_rows[block_row_offsets[iblock]];
+        const real *values = &block_values[block_value_offsets[iblock]];
+
+        for (unsigned int j = 0; j < n_rows; ++j) {
+            src_block[j] = src.local_element(rows[j]);
+        }
+        for (unsigned int i = 0; i < n_rows; ++i) {
+            const real *values_row = values + i*n_rows;
+            real sum = 0.0;
+            for (unsigned int j = 0; j < n_rows; ++j) {
+                sum += values_row[j] * src_block[j];
+            }
+            dst.local_element(rows[i]) = sum;
+        }
+    }
+}
+
+template <typename real>
+void BlockDiagonalMatrix<real>::add_to(dealii::TrilinosWrappers::SparseMatrix &matrix, const real scale) const
+{
+    std::vector<dealii::types::global_dof_index> rows;
+    dealii::FullMatrix<real> block;
+    for (unsigned int iblock = 0; iblock < block_sizes.size(); ++iblock) {
+        const unsigned int n_rows = block_sizes[iblock];
+        rows.resize(n_rows);
+        block.reinit(n_rows, n_rows);
+        for (unsigned int i = 0; i < n_rows; ++i) {
+            rows[i] = locally_owned_rows.nth_index_in_set(block_rows[block_row_offsets[iblock] + i]);
+            for (unsigned int j = 0; j < n_rows; ++j) {
+                block(i,j) = scale * block_el(iblock, i, j);
+            }
+        }
+        matrix.add(rows, block);
+    }
+    matrix.compress(dealii::VectorOperation::add);
+}
+
+template <typename real>
+std::size_t BlockDiagonalMatrix<real>::memory_consumption() const
+{
+    return locally_owned_rows.memory_consumption()
+           + block_sizes.capacity() * sizeof(unsigned int)
+           + block_value_offsets.capacity() * sizeof(std::size_t)
+           + block_row_offsets.capacity() * sizeof(std::size_t)
+           + block_rows.capacity() * sizeof(unsigned int)
+           + block_values.capacity() * sizeof(real);
+}
+
+template class BlockDiagonalMatrix<double>;
+
+} // PHiLiP namespace
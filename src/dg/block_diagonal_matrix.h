@@ -0,0 +1,85 @@
+#ifndef __BLOCK_DIAGONAL_MATRIX_H__
+#define __BLOCK_DIAGONAL_MATRIX_H__
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <vector>
+
+namespace PHiLiP {
+
+/// Block diagonal matrix with one dense block per locally owned cell.
+/** Stores operators that do not couple cells, such as the mass matrix and its inverse.
+ *  The dense blocks are stored contiguously (row-major) in the order they are added, i.e. in cell order.
+ *  On hp meshes, blocks of different sizes are therefore interleaved; they are not grouped by degree
+ *  and each block is applied with its own matrix-vector product.
+ *  Compared to a sparse matrix, no column index is stored per entry;
+ *  only the local row indices of each block are kept.
+ *
+ *  The blocks only involve locally owned rows, so no communication is required to apply it.
+ */
+template <typename real>
+class BlockDiagonalMatrix
+{
+public:
+    /// Removes all blocks and sets the locally owned rows.
+    void reinit(const dealii::IndexSet &locally_owned_rows_input);
+
+    /// Appends the dense block coupling the given (locally owned) rows.
+    /** @return Index of the block, in the order the blocks were added. */
+    unsigned int add_block(
+        const std::vector<dealii::types::global_dof_index> &rows,
+        const dealii::FullMatrix<real> &block);
+
+    /// Number of global rows.
+    dealii::types::global_dof_index m() const;
+
+    /// Number of blocks stored on this process.
+    unsigned int n_blocks() const;
+
+    /// Size of a block.
+    unsigned int block_size(const unsigned int iblock) const;
+
+    /// Entry (i,j) of block iblock, where i and j are the block's local row and column.
+    real block_el(const unsigned int iblock, const unsigned int i, const unsigned int j) const;
+
+    /// Matrix-vector product dst = A*src on the locally owned entries.
+    /** dst and src may be the same vector. Ghost entries of dst are not updated. */
+    void vmult(
+        dealii::LinearAlgebra::distributed::Vector<double> &dst,
+        const dealii::LinearAlgebra::distributed::Vector<double> &src) const;
+
+    /// Adds scale*A to a sparse matrix whose sparsity pattern contains the blocks.
+    void add_to(dealii::TrilinosWrappers::SparseMatrix &matrix, const real scale) const;
+
+    /// Memory used by the matrix in bytes.
+    std::size_t memory_consumption() const;
+
+protected:
+    /// Rows owned by this process.
+    dealii::IndexSet locally_owned_rows;
+
+    /// Number of rows of each block.
+    std::vector<unsigned int> block_sizes;
+
+    /// Position of the first entry of each block in block_values.
+    std::vector<std::size_t> block_value_offsets;
+
+    /// Position of the first row of each block in block_rows.
+    std::vector<std::size_t> block_row_offsets;
+
+    /// Index of each block row within the locally owned rows.
+    std::vector<unsigned int> block_rows;
+
+    /// Row-major entries of all blocks.
+    std::vector<real> block_values;
+
+    /// Largest block size, used to size the work vectors.
+    unsigned int max_block_size = 0;
+};
+
+} // PHiLiP namespace
+
+#endif
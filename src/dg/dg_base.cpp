@@ -1,11 +1,18 @@
 #include<limits>
 #include<fstream>
+#include<algorithm>
+#include<map>
+#include<future>
+#include<memory>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/tensor.h>
 
 #include <deal.II/base/qprojector.h>
+#include <deal.II/base/graph_coloring.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/grid/tria.h>
+#include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
 
@@ -23,6 +30,7 @@
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_tools.h>
 
 //#include <deal.II/fe/mapping_q1.h> // Might need mapping_q
 #include <deal.II/fe/mapping_q.h> // Might need mapping_q
@@ -46,6 +54,7 @@
 #include "dg_base.hpp"
 #include "global_counter.hpp"
 #include "post_processor/physics_post_processor.h"
+#include "linear_solver/p_multigrid_preconditioner.h"
 
 unsigned int n_vmult;
 unsigned int dRdW_form;
@@ -56,6 +65,113 @@ unsigned int d2R_mult;
 
 namespace PHiLiP {
 
+namespace {
+/// Returns true if the locally owned entries of both vectors are identical.
+/** Purely local; callers reduce the result over all processes. */
+bool locally_owned_entries_equal(
+    const dealii::LinearAlgebra::distributed::Vector<double> &vector_a,
+    const dealii::LinearAlgebra::distributed::Vector<double> &vector_b)
+{
+    if (vector_a.size() != vector_b.size()) return false;
+    if ((vector_a.end() - vector_a.begin()) != (vector_b.end() - vector_b.begin())) return false;
+    return std::equal(vector_a.begin(), vector_a.end(), vector_b.begin());
+}
+
+/// Patches built by a DataOut object, which no longer refer to the discretization.
+/** Holds everything needed to write the vtu files of the patches, such that they can be written in the background
+ *  while the solution changes.
+ */
+template <int patch_dim, int spacedim>
+class DetachedPatches : public dealii::DataOutInterface<patch_dim, spacedim>
+{
+public:
+    /// Ranges of the vector-valued data, as returned by get_nonscalar_data_ranges().
+    using NonscalarDataRanges = std::vector<std::tuple<unsigned int, unsigned int, std::string, dealii::DataComponentInterpretation::DataComponentInterpretation>>;
+
+    /// Constructor.
+    DetachedPatches(std::vector<dealii::DataOutBase::Patch<patch_dim, spacedim>> &&patches_input,
+                    std::vector<std::string> &&dataset_names_input,
+                    NonscalarDataRanges &&nonscalar_data_ranges_input)
+        : patches(std::move(patches_input))
+        , dataset_names(std::move(dataset_names_input))
+        , nonscalar_data_ranges(std::move(nonscalar_data_ranges_input))
+    {}
+
+    /// Writes the vtu file of this process, and the pvtu record of all the pieces if pvtu_filename is not empty.
+    void write_vtu_files(const std::string &vtu_filename, const std::string &pvtu_filename, const std::vector<std::string> &piece_filenames) const
+    {
+        std::ofstream output(vtu_filename);
+        this->write_vtu(output);
+        if (!pvtu_filename.empty()) {
+            std::ofstream master_output(pvtu_filename);
+            this->write_pvtu_record(master_output, piece_filenames);
+        }
+    }
+
+protected:
+    /// Patches to write.
+    const std::vector<dealii::DataOutBase::Patch<patch_dim, spacedim>> &get_patches() const override { return patches; }
+    /// Names of the data of the patches.
+    std::vector<std::string> get_dataset_names() const override { return dataset_names; }
+    /// Ranges of the vector-valued data of the patches.
+    NonscalarDataRanges get_nonscalar_data_ranges() const override { return nonscalar_data_ranges; }
+
+private:
+    const std::vector<dealii::DataOutBase::Patch<patch_dim, spacedim>> patches; ///< Patches built by the DataOut object.
+    const std::vector<std::string> dataset_names; ///< Names of the data of the patches.
+    const NonscalarDataRanges nonscalar_data_ranges; ///< Ranges of the vector-valued data.
+};
+
+/// DataOut object whose patches can be detached once built.
+template <typename DataOutType, int patch_dim, int spacedim>
+class DetachableDataOut : public DataOutType
+{
+public:
+    /// Moves the built patches, along with the names of their data, out of this object.
+    std::shared_ptr<DetachedPatches<patch_dim, spacedim>> detach_patches()
+    {
+        return std::make_shared<DetachedPatches<patch_dim, spacedim>>(
+            std::move(this->patches), this->get_dataset_names(), this->get_nonscalar_data_ranges());
+    }
+};
+
+/// Writes the patches to vtu_filename, and the pvtu record to pvtu_filename if it is not empty.
+/** Waits for the files of the previous output of the same kind first, such that at most one output per kind is pending.
+ *  If write_asynchronously, the files are compressed and written by a background thread, without any MPI communication,
+ *  and pending_output holds the write until the next output or DGBase::finish_vtk_output().
+ */
+template <int patch_dim, int spacedim>
+void write_detached_patches(
+    const std::shared_ptr<DetachedPatches<patch_dim, spacedim>> patches,
+    const std::string &vtu_filename,
+    const std::string &pvtu_filename,
+    const std::vector<std::string> &piece_filenames,
+    const bool write_asynchronously,
+    std::future<void> &pending_output)
+{
+    const auto write_files = [patches, vtu_filename, pvtu_filename, piece_filenames]() {
+        patches->write_vtu_files(vtu_filename, pvtu_filename, piece_filenames);
+    };
+    if (pending_output.valid()) pending_output.get();
+    if (write_asynchronously) {
+        pending_output = std::async(std::launch::async, write_files);
+    } else {
+        write_files();
+    }
+}
+
+/// Returns the deal.II zlib compression level of the solution vtk files.
+dealii::DataOutBase::VtkFlags::ZlibCompressionLevel vtk_compression_level(
+    const Parameters::AllParameters::VtkOutputCompressionLevel compression_level)
+{
+    using CompressionLevelEnum = Parameters::AllParameters::VtkOutputCompressionLevel;
+    if (compression_level == CompressionLevelEnum::no_compression) return dealii::DataOutBase::VtkFlags::ZlibCompressionLevel::no_compression;
+    if (compression_level == CompressionLevelEnum::best_speed) return dealii::DataOutBase::VtkFlags::ZlibCompressionLevel::best_speed;
+    if (compression_level == CompressionLevelEnum::default_compression) return dealii::DataOutBase::VtkFlags::ZlibCompressionLevel::default_compression;
+    return dealii::DataOutBase::VtkFlags::ZlibCompressionLevel::best_compression;
+}
+} // namespace
+
 template <int dim, typename real, typename MeshType>
 DGBase<dim,real,MeshType>::DGBase(
     const int nstate_input,
@@ -95,7 +211,7 @@ DGBase<dim,real,MeshType>::DGBase(
     , high_order_grid(std::make_shared<HighOrderGrid<dim,real,MeshType>>(grid_degree_input, triangulation, all_parameters->check_valid_metric_Jacobian, all_parameters->do_renumber_dofs, all_parameters->output_high_order_grid))
     , fe_q_artificial_dissipation(1)
     , dof_handler_artificial_dissipation(*triangulation, false)
-    , mpi_communicator(MPI_COMM_WORLD)
+    , mpi_communicator(MeshTypeHelper<MeshType>::get_mpi_communicator(*triangulation))
     , pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(mpi_communicator)==0)
     , freeze_artificial_dissipation(false)
     , max_artificial_dissipation_coeff(0.0)
@@ -310,7 +426,7 @@ unsigned int DGBase<dim,real,MeshType>::get_max_fe_degree()
         if(cell->is_locally_owned() && cell->active_fe_index() > max_fe_degree)
             max_fe_degree = cell->active_fe_index();
 
-    return dealii::Utilities::MPI::max(max_fe_degree, MPI_COMM_WORLD);
+    return dealii::Utilities::MPI::max(max_fe_degree, mpi_communicator);
 }
 
 template <int dim, typename real, typename MeshType>
@@ -322,7 +438,7 @@ unsigned int DGBase<dim,real,MeshType>::get_min_fe_degree()
         if(cell->is_locally_owned() && cell->active_fe_index() < min_fe_degree)
             min_fe_degree = cell->active_fe_index();
 
-    return dealii::Utilities::MPI::min(min_fe_degree, MPI_COMM_WORLD);
+    return dealii::Utilities::MPI::min(min_fe_degree, mpi_communicator);
 }
 
 template <int dim, typename real, typename MeshType>
@@ -510,15 +626,6 @@ void DGBase<dim,real,MeshType>::assemble_cell_residual (
                                                                store_vol_flux_nodes,
                                                                store_surf_flux_nodes);
 
-    //flag to terminate if strong form and implicit
-    if((this->all_parameters->use_weak_form==false) 
-       && (this->all_parameters->ode_solver_param.ode_solver_type
-                    == Parameters::ODESolverParam::ODESolverEnum::implicit_solver))
-    {
-        pcout<<"ERROR: Implicit does not currently work for strong form. Aborting..."<<std::endl;
-        std::abort();
-    }
-
 
     assemble_volume_term_and_build_operators(
         current_cell,
@@ -1087,6 +1194,382 @@ void DGBase<dim,real,MeshType>::reinit_operators_for_cell_residual_loop(
     mapping_basis.build_1D_shape_functions_at_flux_nodes(high_order_grid->oneD_fe_system, oneD_quadrature_collection[poly_degree_ext], oneD_face_quadrature);
 }
 
+template <int dim, typename real, typename MeshType>
+DGBase<dim,real,MeshType>::AssemblyScratchData::AssemblyScratchData(DGBase<dim,real,MeshType> &dg_input)
+    : dg(dg_input)
+    , mapping_collection(*(dg.high_order_grid->mapping_fe_field))
+    , fe_values_collection_volume (mapping_collection, dg.fe_collection, dg.volume_quadrature_collection, dg.volume_update_flags)
+    , fe_values_collection_face_int (mapping_collection, dg.fe_collection, dg.face_quadrature_collection, dg.face_update_flags)
+    , fe_values_collection_face_ext (mapping_collection, dg.fe_collection, dg.face_quadrature_collection, dg.neighbor_face_update_flags)
+    , fe_values_collection_subface (mapping_collection, dg.fe_collection, dg.face_quadrature_collection, dg.face_update_flags)
+    , fe_values_collection_volume_lagrange (mapping_collection, dg.fe_collection_lagrange, dg.volume_quadrature_collection, dg.volume_update_flags)
+    , soln_basis_int(1, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree())
+    , soln_basis_ext(1, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree())
+    , flux_basis_int(1, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree())
+    , flux_basis_ext(1, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree())
+    , flux_basis_stiffness(1, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree(), true)
+    , soln_basis_projection_oper_int(1, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree())
+    , soln_basis_projection_oper_ext(1, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree())
+    , mapping_basis(1, dg.high_order_grid->fe_system.tensor_degree(), dg.high_order_grid->fe_system.tensor_degree())
+{
+    dg.reinit_operators_for_cell_residual_loop(
+        dg.max_degree, dg.max_degree, dg.high_order_grid->fe_system.tensor_degree(),
+        soln_basis_int, soln_basis_ext,
+        flux_basis_int, flux_basis_ext,
+        flux_basis_stiffness,
+        soln_basis_projection_oper_int, soln_basis_projection_oper_ext,
+        mapping_basis);
+}
+
+template <int dim, typename real, typename MeshType>
+DGBase<dim,real,MeshType>::AssemblyScratchData::AssemblyScratchData(const AssemblyScratchData &scratch_data)
+    : AssemblyScratchData(scratch_data.dg)
+{ }
+
+template <int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::build_cell_partitions()
+{
+    using CellIterator = typename dealii::DoFHandler<dim>::active_cell_iterator;
+    using LocallyOwnedCellIterator = dealii::FilteredIterator<CellIterator>;
+
+    // Face neighbours whose solution is read when assembling the cell.
+    // Finer neighbours are skipped since they do the work on that face.
+    const auto get_face_neighbors = [](const CellIterator &cell) {
+        std::vector<CellIterator> face_neighbors;
+        for (unsigned int iface=0; iface < dealii::GeometryInfo<dim>::faces_per_cell; ++iface) {
+            if (cell->face(iface)->at_boundary() && !cell->has_periodic_neighbor(iface)) continue;
+            const auto neighbor_cell = cell->neighbor_or_periodic_neighbor(iface);
+            if (neighbor_cell->has_children()) continue;
+            face_neighbors.push_back(neighbor_cell);
+        }
+        return face_neighbors;
+    };
+
+    cell_has_ghost_neighbor.assign(triangulation->n_active_cells(), false);
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) continue;
+        for (const auto &neighbor_cell : get_face_neighbors(cell)) {
+            if (neighbor_cell->is_ghost()) cell_has_ghost_neighbor[cell->active_cell_index()] = true;
+        }
+    }
+
+    colored_interior_cells.clear();
+    colored_ghost_adjacent_cells.clear();
+    if (all_parameters->n_threads_residual_assembly <= 1) return;
+
+    // A cell conflicts with another cell if they write to the same cell's residual,
+    // i.e. if they are, or share, a face neighbour.
+    const auto get_conflict_indices = [&get_face_neighbors](const LocallyOwnedCellIterator &cell) {
+        std::vector<dealii::types::global_dof_index> conflict_indices;
+        conflict_indices.push_back(cell->active_cell_index());
+        for (const auto &neighbor_cell : get_face_neighbors(*cell)) {
+            conflict_indices.push_back(neighbor_cell->active_cell_index());
+        }
+        return conflict_indices;
+    };
+
+    const auto color_cells = [&](const bool ghost_adjacent,
+                                 std::vector<std::vector<CellIterator>> &colored_cells) {
+        const auto cell_filter = [this, ghost_adjacent](const CellIterator &cell) {
+            return cell->is_locally_owned() && (cell_has_ghost_neighbor[cell->active_cell_index()] == ghost_adjacent);
+        };
+        const LocallyOwnedCellIterator begin_cell(cell_filter, dof_handler.begin_active());
+        const LocallyOwnedCellIterator end_cell(cell_filter, dof_handler.end());
+        const std::vector<std::vector<LocallyOwnedCellIterator>> filtered_colored_cells
+            = dealii::GraphColoring::make_graph_coloring(begin_cell, end_cell,
+                std::function<std::vector<dealii::types::global_dof_index>(const LocallyOwnedCellIterator &)>(get_conflict_indices));
+
+        colored_cells.resize(filtered_colored_cells.size());
+        for (unsigned int icolor=0; icolor<filtered_colored_cells.size(); ++icolor) {
+            colored_cells[icolor].reserve(filtered_colored_cells[icolor].size());
+            for (const auto &cell : filtered_colored_cells[icolor]) {
+                colored_cells[icolor].push_back(cell);
+            }
+        }
+    };
+    color_cells(false, colored_interior_cells);
+    color_cells(true, colored_ghost_adjacent_cells);
+}
+
+template <int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::assemble_residual_threaded(
+    const std::vector<std::vector<typename dealii::DoFHandler<dim>::active_cell_iterator>> &colored_cells)
+{
+    using CellIterator = typename dealii::DoFHandler<dim>::active_cell_iterator;
+
+    const auto worker = [&](const CellIterator &soln_cell, AssemblyScratchData &scratch, AssemblyCopyData &/*copy_data*/) {
+        const CellIterator metric_cell(triangulation.get(), soln_cell->level(), soln_cell->index(), &(high_order_grid->dof_handler_grid));
+        assemble_cell_residual (
+            soln_cell,
+            metric_cell,
+            false, false, false,
+            scratch.fe_values_collection_volume,
+            scratch.fe_values_collection_face_int,
+            scratch.fe_values_collection_face_ext,
+            scratch.fe_values_collection_subface,
+            scratch.fe_values_collection_volume_lagrange,
+            scratch.soln_basis_int,
+            scratch.soln_basis_ext,
+            scratch.flux_basis_int,
+            scratch.flux_basis_ext,
+            scratch.flux_basis_stiffness,
+            scratch.soln_basis_projection_oper_int,
+            scratch.soln_basis_projection_oper_ext,
+            scratch.mapping_basis,
+            false,
+            right_hand_side,
+            auxiliary_right_hand_side);
+    };
+    // Contributions are added directly to the right_hand_side by the worker.
+    const auto copier = [](const AssemblyCopyData &/*copy_data*/) {};
+
+    dealii::WorkStream::run(colored_cells,
+                            worker,
+                            copier,
+                            AssemblyScratchData(*this),
+                            AssemblyCopyData());
+}
+
+template <int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::update_metric_terms_cache()
+{
+    if (!all_parameters->use_metric_cache) return;
+
+    const unsigned int grid_changed_locally = (metric_terms_cache.size() != triangulation->n_active_cells())
+                                              || !locally_owned_entries_equal(high_order_grid->volume_nodes, volume_nodes_metric_cache);
+    const bool grid_changed = (dealii::Utilities::MPI::max(grid_changed_locally, mpi_communicator) != 0);
+    if (grid_changed) {
+        metric_terms_cache.clear();
+        metric_terms_cache.resize(triangulation->n_active_cells());
+        volume_nodes_metric_cache = high_order_grid->volume_nodes;
+    }
+}
+
+template <int dim, typename real, typename MeshType>
+bool DGBase<dim,real,MeshType>::get_cached_volume_metric_terms(
+    const dealii::types::global_dof_index cell_index,
+    const unsigned int poly_degree,
+    OPERATOR::metric_operators<real,dim,2*dim> &metric_oper) const
+{
+    if (!all_parameters->use_metric_cache || cell_index >= metric_terms_cache.size()) return false;
+    const CellMetricTerms &cached = metric_terms_cache[cell_index];
+    if (!cached.volume_is_cached || cached.poly_degree != poly_degree) return false;
+
+    metric_oper.metric_cofactor_vol = cached.metric_cofactor_vol;
+    metric_oper.det_Jac_vol = cached.det_Jac_vol;
+    metric_oper.flux_nodes_vol = cached.flux_nodes_vol;
+    return true;
+}
+
+template <int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::store_volume_metric_terms(
+    const dealii::types::global_dof_index cell_index,
+    const unsigned int poly_degree,
+    const OPERATOR::metric_operators<real,dim,2*dim> &metric_oper)
+{
+    if (!all_parameters->use_metric_cache || cell_index >= metric_terms_cache.size()) return;
+    CellMetricTerms &cached = metric_terms_cache[cell_index];
+    if (cached.poly_degree != poly_degree) {
+        // The cell changed degree, the facet terms are on the wrong cubature.
+        cached = CellMetricTerms();
+        cached.poly_degree = poly_degree;
+    }
+    cached.metric_cofactor_vol = metric_oper.metric_cofactor_vol;
+    cached.det_Jac_vol = metric_oper.det_Jac_vol;
+    cached.flux_nodes_vol = metric_oper.flux_nodes_vol;
+    cached.volume_is_cached = true;
+}
+
+template <int dim, typename real, typename MeshType>
+bool DGBase<dim,real,MeshType>::get_cached_facet_metric_terms(
+    const dealii::types::global_dof_index cell_index,
+    const unsigned int iface,
+    const unsigned int poly_degree,
+    OPERATOR::metric_operators<real,dim,2*dim> &metric_oper) const
+{
+    if (!all_parameters->use_metric_cache || cell_index >= metric_terms_cache.size()) return false;
+    const CellMetricTerms &cached = metric_terms_cache[cell_index];
+    if (!cached.face_is_cached[iface] || cached.poly_degree != poly_degree) return false;
+
+    metric_oper.metric_cofactor_surf = cached.metric_cofactor_surf[iface];
+    metric_oper.det_Jac_surf = cached.det_Jac_surf[iface];
+    metric_oper.flux_nodes_surf = cached.flux_nodes_surf;
+    return true;
+}
+
+template <int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::store_facet_metric_terms(
+    const dealii::types::global_dof_index cell_index,
+    const unsigned int iface,
+    const unsigned int poly_degree,
+    const OPERATOR::metric_operators<real,dim,2*dim> &metric_oper)
+{
+    if (!all_parameters->use_metric_cache || cell_index >= metric_terms_cache.size()) return;
+    CellMetricTerms &cached = metric_terms_cache[cell_index];
+    if (cached.poly_degree != poly_degree) {
+        cached = CellMetricTerms();
+        cached.poly_degree = poly_degree;
+    }
+    cached.metric_cofactor_surf[iface] = metric_oper.metric_cofactor_surf;
+    cached.det_Jac_surf[iface] = metric_oper.det_Jac_surf;
+    // The facet flux nodes are built for all the faces at once.
+    cached.flux_nodes_surf = metric_oper.flux_nodes_surf;
+    cached.face_is_cached[iface] = true;
+}
+
+template <int dim, typename real, typename MeshType>
+bool DGBase<dim,real,MeshType>::state_matches (
+    const dealii::LinearAlgebra::distributed::Vector<double> &stored_solution,
+    const dealii::LinearAlgebra::distributed::Vector<double> &stored_volume_nodes,
+    const dealii::LinearAlgebra::distributed::Vector<double> *stored_dual) const
+{
+    bool matches_locally = locally_owned_entries_equal(solution, stored_solution)
+                           && locally_owned_entries_equal(high_order_grid->volume_nodes, stored_volume_nodes);
+    if (matches_locally && stored_dual != nullptr) {
+        matches_locally = locally_owned_entries_equal(dual, *stored_dual);
+    }
+    const unsigned int n_mismatch = dealii::Utilities::MPI::sum(static_cast<unsigned int>(!matches_locally), mpi_communicator);
+    return (n_mismatch == 0);
+}
+
+template <int dim, typename real, typename MeshType>
+std::vector<std::vector<dealii::types::global_dof_index>> DGBase<dim,real,MeshType>::locally_owned_cell_dof_indices () const
+{
+    std::vector<std::vector<dealii::types::global_dof_index>> cell_dof_indices;
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) continue;
+        cell_dof_indices.emplace_back(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(cell_dof_indices.back());
+    }
+    return cell_dof_indices;
+}
+
+template <int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::set_sample_mesh (const dealii::LinearAlgebra::distributed::Vector<double> &sampled_dofs)
+{
+    // The stored states no longer correspond to the assembled operators.
+    solution_dRdW.reinit(0);
+    solution_dRdX.reinit(0);
+    solution_d2R.reinit(0);
+
+    cell_is_in_sample_mesh.clear();
+    if (sampled_dofs.size() == 0) return;
+
+    std::vector<dealii::types::global_dof_index> dof_indices;
+    const auto is_sampled = [&](const typename dealii::DoFHandler<dim>::active_cell_iterator &cell) {
+        dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(dof_indices);
+        for (const auto &dof : dof_indices) {
+            if (sampled_dofs[dof] != 0.0) return true;
+        }
+        return false;
+    };
+
+    cell_is_in_sample_mesh.assign(triangulation->n_active_cells(), false);
+    unsigned int n_sample_mesh_cells = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) continue;
+
+        bool in_sample_mesh = is_sampled(cell);
+        for (unsigned int iface=0; iface < dealii::GeometryInfo<dim>::faces_per_cell && !in_sample_mesh; ++iface) {
+            if (cell->face(iface)->at_boundary() && !cell->has_periodic_neighbor(iface)) continue;
+            const auto neighbor_cell = cell->neighbor_or_periodic_neighbor(iface);
+            if (!neighbor_cell->has_children()) {
+                in_sample_mesh = is_sampled(neighbor_cell);
+                continue;
+            }
+            for (unsigned int isubface=0; isubface < cell->face(iface)->n_children() && !in_sample_mesh; ++isubface) {
+                in_sample_mesh = is_sampled(cell->neighbor_child_on_subface(iface, isubface));
+            }
+        }
+        cell_is_in_sample_mesh[cell->active_cell_index()] = in_sample_mesh;
+        if (in_sample_mesh) ++n_sample_mesh_cells;
+    }
+    pcout << "Sample mesh contains " << dealii::Utilities::MPI::sum(n_sample_mesh_cells, mpi_communicator)
+          << " out of " << triangulation->n_global_active_cells() << " cells." << std::endl;
+}
+
+template <int dim, typename real, typename MeshType>
+PMultigridHierarchy DGBase<dim,real,MeshType>::build_p_multigrid_hierarchy (const unsigned int coarse_degree) const
+{
+    unsigned int fine_degree = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (cell->is_locally_owned()) fine_degree = std::max<unsigned int>(fine_degree, cell->active_fe_index());
+    }
+    fine_degree = dealii::Utilities::MPI::max(fine_degree, mpi_communicator);
+    const unsigned int n_levels = (fine_degree > coarse_degree) ? fine_degree - coarse_degree + 1 : 1;
+
+    // The fe_index of a cell is its polynomial degree.
+    std::vector<std::unique_ptr<dealii::DoFHandler<dim>>> coarse_dof_handlers;
+    for (unsigned int level = 0; level + 1 < n_levels; ++level) {
+        const unsigned int level_degree = coarse_degree + level;
+        coarse_dof_handlers.push_back(std::make_unique<dealii::DoFHandler<dim>>(*triangulation));
+        dealii::DoFHandler<dim> &level_dof_handler = *coarse_dof_handlers.back();
+        auto fine_cell = dof_handler.begin_active();
+        for (auto cell = level_dof_handler.begin_active(); cell != level_dof_handler.end(); ++cell, ++fine_cell) {
+            if (cell->is_locally_owned()) cell->set_active_fe_index(std::min<unsigned int>(fine_cell->active_fe_index(), level_degree));
+        }
+        level_dof_handler.distribute_dofs(fe_collection);
+    }
+    const auto level_dof_handler = [&](const unsigned int level) -> const dealii::DoFHandler<dim> & {
+        return (level + 1 < n_levels) ? *coarse_dof_handlers[level] : dof_handler;
+    };
+
+    PMultigridHierarchy hierarchy;
+    hierarchy.level_cell_dof_indices.resize(n_levels);
+    for (unsigned int level = 0; level < n_levels; ++level) {
+        for (const auto &cell : level_dof_handler(level).active_cell_iterators()) {
+            if (!cell->is_locally_owned()) continue;
+            hierarchy.level_cell_dof_indices[level].emplace_back(cell->get_fe().n_dofs_per_cell());
+            cell->get_dof_indices(hierarchy.level_cell_dof_indices[level].back());
+        }
+    }
+
+    // Interpolation of the coarse basis onto the fine basis, for each pair of fe_index.
+    std::map<std::pair<unsigned int, unsigned int>, dealii::FullMatrix<double>> interpolation_matrices;
+    const auto interpolation_matrix = [&](const unsigned int coarse_index, const unsigned int fine_index) -> const dealii::FullMatrix<double> & {
+        const std::pair<unsigned int, unsigned int> key(coarse_index, fine_index);
+        auto matrix = interpolation_matrices.find(key);
+        if (matrix == interpolation_matrices.end()) {
+            dealii::FullMatrix<double> local_matrix(fe_collection[fine_index].n_dofs_per_cell(), fe_collection[coarse_index].n_dofs_per_cell());
+            dealii::FETools::get_interpolation_matrix(fe_collection[coarse_index], fe_collection[fine_index], local_matrix);
+            matrix = interpolation_matrices.emplace(key, local_matrix).first;
+        }
+        return matrix->second;
+    };
+
+    for (unsigned int level = 0; level + 1 < n_levels; ++level) {
+        const dealii::DoFHandler<dim> &coarse_dof_handler = level_dof_handler(level);
+        const dealii::DoFHandler<dim> &fine_dof_handler = level_dof_handler(level+1);
+        const std::vector<std::vector<dealii::types::global_dof_index>> &coarse_cell_dofs = hierarchy.level_cell_dof_indices[level];
+        const std::vector<std::vector<dealii::types::global_dof_index>> &fine_cell_dofs = hierarchy.level_cell_dof_indices[level+1];
+
+        const dealii::IndexSet &fine_locally_owned_dofs = fine_dof_handler.locally_owned_dofs();
+        dealii::DynamicSparsityPattern sparsity_pattern(fine_dof_handler.n_dofs(), coarse_dof_handler.n_dofs(), fine_locally_owned_dofs);
+        for (unsigned int icell = 0; icell < fine_cell_dofs.size(); ++icell) {
+            for (const auto &fine_dof : fine_cell_dofs[icell]) {
+                sparsity_pattern.add_entries(fine_dof, coarse_cell_dofs[icell].begin(), coarse_cell_dofs[icell].end());
+            }
+        }
+
+        auto prolongation = std::make_shared<dealii::TrilinosWrappers::SparseMatrix>();
+        prolongation->reinit(fine_locally_owned_dofs, coarse_dof_handler.locally_owned_dofs(), sparsity_pattern, mpi_communicator);
+
+        unsigned int icell = 0;
+        auto fine_cell = fine_dof_handler.begin_active();
+        for (auto coarse_cell = coarse_dof_handler.begin_active(); coarse_cell != coarse_dof_handler.end(); ++coarse_cell, ++fine_cell) {
+            if (!coarse_cell->is_locally_owned()) continue;
+            prolongation->set(fine_cell_dofs[icell], coarse_cell_dofs[icell],
+                              interpolation_matrix(coarse_cell->active_fe_index(), fine_cell->active_fe_index()));
+            ++icell;
+        }
+        prolongation->compress(dealii::VectorOperation::insert);
+        hierarchy.prolongations.push_back(prolongation);
+    }
+
+    return hierarchy;
+}
+
 template <int dim, typename real, typename MeshType>
 void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R, const double CFL_mass)
 {
@@ -1101,22 +1584,9 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
     if (compute_dRdW) {
         pcout << " with dRdW...";
 
-        auto diff_sol = solution;
-        diff_sol -= solution_dRdW;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = high_order_grid->volume_nodes;
-            diff_node -= volume_nodes_dRdW;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-                if (CFL_mass_dRdW == CFL_mass) {
-                    pcout << " which is already assembled..." << std::endl;
-                    return;
-                }
-            }
+        if (CFL_mass_dRdW == CFL_mass && state_matches(solution_dRdW, volume_nodes_dRdW)) {
+            pcout << " which is already assembled..." << std::endl;
+            return;
         }
         {
             int n_stencil = 1 + std::pow(2,dim);
@@ -1133,20 +1603,9 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
     if (compute_dRdX) {
         pcout << " with dRdX...";
 
-        auto diff_sol = solution;
-        diff_sol -= solution_dRdX;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = high_order_grid->volume_nodes;
-            diff_node -= volume_nodes_dRdX;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-                pcout << " which is already assembled..." << std::endl;
-                return;
-            }
+        if (state_matches(solution_dRdX, volume_nodes_dRdX)) {
+            pcout << " which is already assembled..." << std::endl;
+            return;
         }
         solution_dRdX = solution;
         volume_nodes_dRdX = high_order_grid->volume_nodes;
@@ -1159,26 +1618,9 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
     }
     if (compute_d2R) {
         pcout << " with d2RdWdW, d2RdWdX, d2RdXdX...";
-        auto diff_sol = solution;
-        diff_sol -= solution_d2R;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = high_order_grid->volume_nodes;
-            diff_node -= volume_nodes_d2R;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-
-                auto diff_dual = dual;
-                diff_dual -= dual_d2R;
-                const double l2_norm_dual = diff_dual.l2_norm();
-                if (l2_norm_dual == 0.0) {
-                    pcout << " which is already assembled..." << std::endl;
-                    return;
-                }
-            }
+        if (state_matches(solution_d2R, volume_nodes_d2R, &dual_d2R)) {
+            pcout << " which is already assembled..." << std::endl;
+            return;
         }
         solution_d2R = solution;
         volume_nodes_d2R = high_order_grid->volume_nodes;
@@ -1231,8 +1673,20 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
         soln_basis_projection_oper_int, soln_basis_projection_oper_ext,
         mapping_basis);
 
-    solution.update_ghost_values();
-
+    // Only the face terms of cells neighbouring another process need the ghosted solution.
+    // The ghost exchange can therefore be overlapped with the residual of the interior cells,
+    // unless the ghosted solution is already needed before the cell loop.
+    const bool overlap_ghost_exchange = all_parameters->overlap_ghost_exchange
+                                        && !all_parameters->artificial_dissipation_param.add_artificial_dissipation
+                                        && all_parameters->pde_type != Parameters::AllParameters::PartialDifferentialEquation::physics_model
+                                        && !use_auxiliary_eq;
+    bool ghost_exchange_in_flight = false;
+    if (overlap_ghost_exchange) {
+        solution.update_ghost_values_start();
+        ghost_exchange_in_flight = true;
+    } else {
+        solution.update_ghost_values();
+    }
 
     int assembly_error = 0;
     try {
@@ -1243,6 +1697,9 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
         // updates model variables only if there is a model
         if(all_parameters->pde_type == Parameters::AllParameters::PartialDifferentialEquation::physics_model) update_model_variables();
 
+        // clears the cached metric terms if the grid moved since the last residual.
+        if (!compute_dRdX && !compute_d2R) update_metric_terms_cache();
+
         // assembles and solves for auxiliary variable if necessary.
         assemble_auxiliary_residual();
 
@@ -1251,32 +1708,59 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
             timer.start();
         }
 
-        auto metric_cell = high_order_grid->dof_handler_grid.begin_active();
-        for (auto soln_cell = dof_handler.begin_active(); soln_cell != dof_handler.end(); ++soln_cell, ++metric_cell) {
-            if (!soln_cell->is_locally_owned()) continue;
+        if (cell_has_ghost_neighbor.size() != triangulation->n_active_cells()) build_cell_partitions();
 
-            // Add right-hand side contributions this cell can compute
-            assemble_cell_residual (
-                soln_cell,
-                metric_cell,
-                compute_dRdW, compute_dRdX, compute_d2R,
-                fe_values_collection_volume,
-                fe_values_collection_face_int,
-                fe_values_collection_face_ext,
-                fe_values_collection_subface,
-                fe_values_collection_volume_lagrange,
-                soln_basis_int,
-                soln_basis_ext,
-                flux_basis_int,
-                flux_basis_ext,
-                flux_basis_stiffness,
-                soln_basis_projection_oper_int,
-                soln_basis_projection_oper_ext,
-                mapping_basis,
-                false,
-                right_hand_side,
-                auxiliary_right_hand_side);
-        } // end of cell loop
+        const bool use_threaded_assembly = (all_parameters->n_threads_residual_assembly > 1)
+                                           && !compute_dRdW && !compute_dRdX && !compute_d2R
+                                           && cell_is_in_sample_mesh.empty();
+        // Assembles the interior cells, the cells neighbouring a ghost cell, or both.
+        const auto assemble_cell_loop = [&](const bool assemble_interior_cells, const bool assemble_ghost_adjacent_cells) {
+            if (use_threaded_assembly) {
+                if (assemble_interior_cells) assemble_residual_threaded(colored_interior_cells);
+                if (assemble_ghost_adjacent_cells) assemble_residual_threaded(colored_ghost_adjacent_cells);
+                return;
+            }
+            auto metric_cell = high_order_grid->dof_handler_grid.begin_active();
+            for (auto soln_cell = dof_handler.begin_active(); soln_cell != dof_handler.end(); ++soln_cell, ++metric_cell) {
+                if (!soln_cell->is_locally_owned()) continue;
+                if (!cell_is_in_sample_mesh.empty() && !cell_is_in_sample_mesh[soln_cell->active_cell_index()]) continue;
+
+                const bool is_ghost_adjacent = cell_has_ghost_neighbor[soln_cell->active_cell_index()];
+                if (is_ghost_adjacent && !assemble_ghost_adjacent_cells) continue;
+                if (!is_ghost_adjacent && !assemble_interior_cells) continue;
+
+                // Add right-hand side contributions this cell can compute
+                assemble_cell_residual (
+                    soln_cell,
+                    metric_cell,
+                    compute_dRdW, compute_dRdX, compute_d2R,
+                    fe_values_collection_volume,
+                    fe_values_collection_face_int,
+                    fe_values_collection_face_ext,
+                    fe_values_collection_subface,
+                    fe_values_collection_volume_lagrange,
+                    soln_basis_int,
+                    soln_basis_ext,
+                    flux_basis_int,
+                    flux_basis_ext,
+                    flux_basis_stiffness,
+                    soln_basis_projection_oper_int,
+                    soln_basis_projection_oper_ext,
+                    mapping_basis,
+                    false,
+                    right_hand_side,
+                    auxiliary_right_hand_side);
+            } // end of cell loop
+        };
+
+        if (overlap_ghost_exchange) {
+            assemble_cell_loop(true, false);
+            solution.update_ghost_values_finish();
+            ghost_exchange_in_flight = false;
+            assemble_cell_loop(false, true);
+        } else {
+            assemble_cell_loop(true, true);
+        }
 
         if(all_parameters->store_residual_cpu_time){
             timer.stop();
@@ -1285,6 +1769,8 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
     } catch(...) {
         assembly_error = 1;
     }
+    // Complete the pending exchange such that no MPI request is left behind on failure.
+    if (ghost_exchange_in_flight) solution.update_ghost_values_finish();
     const int mpi_assembly_error = dealii::Utilities::MPI::sum(assembly_error, mpi_communicator);
 
 
@@ -1297,7 +1783,12 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
             std::cout << " Filling up Jacobian with mass matrix. " << std::endl;
             const bool do_inverse_mass_matrix = false;
             evaluate_mass_matrices (do_inverse_mass_matrix);
-            system_matrix.copy_from(global_mass_matrix);
+            if (this->all_parameters->use_block_diagonal_mass_matrices) {
+                system_matrix = 0;
+                add_mass_matrices(1.0);
+            } else {
+                system_matrix.copy_from(global_mass_matrix);
+            }
         }
         //if (compute_dRdX) {
         //    dRdXv.trilinos_matrix().
@@ -1314,7 +1805,10 @@ void DGBase<dim,real,MeshType>::assemble_residual (const bool compute_dRdW, cons
     if ( compute_dRdW ) {
         system_matrix.compress(dealii::VectorOperation::add);
 
-        if (global_mass_matrix.m() != system_matrix.m()) {
+        const dealii::types::global_dof_index n_rows_mass_matrix = this->all_parameters->use_block_diagonal_mass_matrices
+                                                                   ? global_mass_matrix_blocks.m()
+                                                                   : global_mass_matrix.m();
+        if (n_rows_mass_matrix != system_matrix.m()) {
             const bool do_inverse_mass_matrix = false;
             evaluate_mass_matrices (do_inverse_mass_matrix);
         }
@@ -1631,7 +2125,7 @@ template <int dim, typename real, typename MeshType>
 void DGBase<dim,real,MeshType>::output_face_results_vtk (const unsigned int cycle, const double current_time)// const
 {
 
-    DataOutEulerFaces<dim, dealii::DoFHandler<dim>> data_out;
+    DetachableDataOut<DataOutEulerFaces<dim, dealii::DoFHandler<dim>>, dim-1, dim> data_out;
 
     data_out.attach_dof_handler (dof_handler);
 
@@ -1664,7 +2158,7 @@ void DGBase<dim,real,MeshType>::output_face_results_vtk (const unsigned int cycl
 
     // Let the physics post-processor determine what to output.
     const std::unique_ptr< dealii::DataPostprocessor<dim> > post_processor = Postprocess::PostprocessorFactory<dim>::create_Postprocessor(all_parameters);
-    data_out.add_data_vector (solution, *post_processor);
+    if (!post_processor->get_names().empty()) data_out.add_data_vector (solution, *post_processor);
 
     NormalPostprocessor<dim> normals_post_processor;
     data_out.add_data_vector (solution, normals_post_processor);
@@ -1678,18 +2172,24 @@ void DGBase<dim,real,MeshType>::output_face_results_vtk (const unsigned int cycl
     data_out.add_data_vector (active_fe_indices_dealiivector, "PolynomialDegree", dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim-1,dim>::DataVectorType::type_cell_data);
 
     // Output absolute value of the residual so that we can visualize it on a logscale.
+    const std::vector<std::string> &output_variables = all_parameters->vtk_output_variables;
+    const bool output_residual = output_variables.empty() || (std::find(output_variables.begin(), output_variables.end(), "residual") != output_variables.end());
     std::vector<std::string> residual_names;
     for(int s=0;s<nstate;++s) {
         std::string varname = "residual" + dealii::Utilities::int_to_string(s,1);
         residual_names.push_back(varname);
     }
-    auto residual = right_hand_side;
-    for (auto &&rhs_value : residual) {
-        if (std::signbit(rhs_value)) rhs_value = -rhs_value;
-        if (rhs_value == 0.0) rhs_value = std::numeric_limits<double>::min();
+    // Declared outside of the if such that it outlives build_patches, but only copied when it is output.
+    dealii::LinearAlgebra::distributed::Vector<double> residual;
+    if (output_residual) {
+        residual = right_hand_side;
+        for (auto &&rhs_value : residual) {
+            if (std::signbit(rhs_value)) rhs_value = -rhs_value;
+            if (rhs_value == 0.0) rhs_value = std::numeric_limits<double>::min();
+        }
+        residual.update_ghost_values();
+        data_out.add_data_vector (residual, residual_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim-1,dim>::DataVectorType::type_dof_data);
     }
-    residual.update_ghost_values();
-    data_out.add_data_vector (residual, residual_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim-1,dim>::DataVectorType::type_dof_data);
 
     //for(int s=0;s<nstate;++s) {
     //    residual_names[s] = "scaled_" + residual_names[s];
@@ -1711,24 +2211,25 @@ void DGBase<dim,real,MeshType>::output_face_results_vtk (const unsigned int cycl
     const int grid_degree = high_order_grid->max_degree;
     //const int n_subdivisions = max_degree+1;//+30; // if write_higher_order_cells, n_subdivisions represents the order of the cell
     //const int n_subdivisions = 1;//+30; // if write_higher_order_cells, n_subdivisions represents the order of the cell
-    const int n_subdivisions = grid_degree;
+    const unsigned int n_subdivisions_in_vtk_output = all_parameters->number_of_subdivisions_in_vtk_output;
+    const int n_subdivisions = (n_subdivisions_in_vtk_output > 0) ? n_subdivisions_in_vtk_output : grid_degree;
     data_out.build_patches(mapping, n_subdivisions);
     //const bool write_higher_order_cells = (dim>1 && max_degree > 1) ? true : false;
     const bool write_higher_order_cells = false;//(dim>1 && grid_degree > 1) ? true : false;
-    dealii::DataOutBase::VtkFlags vtkflags(current_time,cycle,true,dealii::DataOutBase::VtkFlags::ZlibCompressionLevel::best_compression,write_higher_order_cells);
-    data_out.set_flags(vtkflags);
+    dealii::DataOutBase::VtkFlags vtkflags(current_time,cycle,true,vtk_compression_level(all_parameters->vtk_output_compression_level),write_higher_order_cells);
+    const std::shared_ptr<DetachedPatches<dim-1,dim>> patches = data_out.detach_patches();
+    patches->set_flags(vtkflags);
 
     const int iproc = dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
     std::string filename = this->all_parameters->solution_vtk_files_directory_name + "/" + "surface_solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
     filename += dealii::Utilities::int_to_string(cycle, 4) + ".";
     filename += dealii::Utilities::int_to_string(iproc, 4);
     filename += ".vtu";
-    std::ofstream output(filename);
-    data_out.write_vtu(output);
     //std::cout << "Writing out file: " << filename << std::endl;
 
+    std::vector<std::string> filenames;
+    std::string master_fn;
     if (iproc == 0) {
-        std::vector<std::string> filenames;
         for (unsigned int iproc = 0; iproc < dealii::Utilities::MPI::n_mpi_processes(mpi_communicator); ++iproc) {
             std::string fn = "surface_solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
             fn += dealii::Utilities::int_to_string(cycle, 4) + ".";
@@ -1736,12 +2237,10 @@ void DGBase<dim,real,MeshType>::output_face_results_vtk (const unsigned int cycl
             fn += ".vtu";
             filenames.push_back(fn);
         }
-        std::string master_fn = this->all_parameters->solution_vtk_files_directory_name + "/" + "surface_solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
+        master_fn = this->all_parameters->solution_vtk_files_directory_name + "/" + "surface_solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
         master_fn += dealii::Utilities::int_to_string(cycle, 4) + ".pvtu";
-        std::ofstream master_output(master_fn);
-        data_out.write_pvtu_record(master_output, filenames);
     }
-
+    write_detached_patches(patches, filename, master_fn, filenames, all_parameters->write_vtk_output_asynchronously, pending_face_vtk_output);
 }
 #endif
 
@@ -1753,7 +2252,7 @@ void DGBase<dim,real,MeshType>::output_results_vtk (const unsigned int cycle, co
 #endif
 
     const bool enable_higher_order_vtk_output = this->all_parameters->enable_higher_order_vtk_output;
-    dealii::DataOut<dim, dealii::DoFHandler<dim>> data_out;
+    DetachableDataOut<dealii::DataOut<dim, dealii::DoFHandler<dim>>, dim, dim> data_out;
 
     data_out.attach_dof_handler (dof_handler);
 
@@ -1785,7 +2284,7 @@ void DGBase<dim,real,MeshType>::output_results_vtk (const unsigned int cycle, co
 
     // Let the physics post-processor determine what to output.
     const std::unique_ptr< dealii::DataPostprocessor<dim> > post_processor = Postprocess::PostprocessorFactory<dim>::create_Postprocessor(all_parameters);
-    data_out.add_data_vector (solution, *post_processor);
+    if (!post_processor->get_names().empty()) data_out.add_data_vector (solution, *post_processor);
 
     // Output the polynomial degree in each cell
     std::vector<unsigned int> active_fe_indices;
@@ -1796,18 +2295,24 @@ void DGBase<dim,real,MeshType>::output_results_vtk (const unsigned int cycle, co
     data_out.add_data_vector (active_fe_indices_dealiivector, "PolynomialDegree", dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_cell_data);
 
     // Output absolute value of the residual so that we can visualize it on a logscale.
+    const std::vector<std::string> &output_variables = all_parameters->vtk_output_variables;
+    const bool output_residual = output_variables.empty() || (std::find(output_variables.begin(), output_variables.end(), "residual") != output_variables.end());
     std::vector<std::string> residual_names;
     for(int s=0;s<nstate;++s) {
         std::string varname = "residual" + dealii::Utilities::int_to_string(s,1);
         residual_names.push_back(varname);
     }
-    auto residual = right_hand_side;
-    for (auto &&rhs_value : residual) {
-        if (std::signbit(rhs_value)) rhs_value = -rhs_value;
-        if (rhs_value == 0.0) rhs_value = std::numeric_limits<double>::min();
+    // Declared outside of the if such that it outlives build_patches, but only copied when it is output.
+    dealii::LinearAlgebra::distributed::Vector<double> residual;
+    if (output_residual) {
+        residual = right_hand_side;
+        for (auto &&rhs_value : residual) {
+            if (std::signbit(rhs_value)) rhs_value = -rhs_value;
+            if (rhs_value == 0.0) rhs_value = std::numeric_limits<double>::min();
+        }
+        residual.update_ghost_values();
+        data_out.add_data_vector (residual, residual_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
     }
-    residual.update_ghost_values();
-    data_out.add_data_vector (residual, residual_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
 
     typename dealii::DataOut<dim,dealii::DoFHandler<dim>>::CurvedCellRegion curved = dealii::DataOut<dim,dealii::DoFHandler<dim>>::CurvedCellRegion::curved_inner_cells;
     //typename dealii::DataOut<dim>::CurvedCellRegion curved = dealii::DataOut<dim>::CurvedCellRegion::curved_boundary;
@@ -1816,23 +2321,26 @@ void DGBase<dim,real,MeshType>::output_results_vtk (const unsigned int cycle, co
     const dealii::Mapping<dim> &mapping = (*(high_order_grid->mapping_fe_field));
     const unsigned int grid_degree = high_order_grid->max_degree;
     // If higher-order vtk output is not enabled, passing 0 will be interpreted as DataOutInterface::default_subdivisions
-    const int n_subdivisions = (enable_higher_order_vtk_output) ? std::max(grid_degree,get_max_fe_degree()) : 0;
+    // A given number of subdivisions overrides both, for example to subsample high-order solutions
+    const unsigned int n_subdivisions_in_vtk_output = all_parameters->number_of_subdivisions_in_vtk_output;
+    const int n_subdivisions = (n_subdivisions_in_vtk_output > 0) ? n_subdivisions_in_vtk_output
+                               : (enable_higher_order_vtk_output) ? std::max(grid_degree,get_max_fe_degree()) : 0;
     data_out.build_patches(mapping, n_subdivisions, curved);
     const bool write_higher_order_cells = (n_subdivisions>1 && dim>1) ? true : false;
-    dealii::DataOutBase::VtkFlags vtkflags(current_time,cycle,true,dealii::DataOutBase::VtkFlags::ZlibCompressionLevel::best_compression,write_higher_order_cells);
-    data_out.set_flags(vtkflags);
+    dealii::DataOutBase::VtkFlags vtkflags(current_time,cycle,true,vtk_compression_level(all_parameters->vtk_output_compression_level),write_higher_order_cells);
+    const std::shared_ptr<DetachedPatches<dim,dim>> patches = data_out.detach_patches();
+    patches->set_flags(vtkflags);
 
     const int iproc = dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
     std::string filename = this->all_parameters->solution_vtk_files_directory_name + "/" + "solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
     filename += dealii::Utilities::int_to_string(cycle, 4) + ".";
     filename += dealii::Utilities::int_to_string(iproc, 4);
     filename += ".vtu";
-    std::ofstream output(filename);
-    data_out.write_vtu(output);
     //std::cout << "Writing out file: " << filename << std::endl;
 
+    std::vector<std::string> filenames;
+    std::string master_fn;
     if (iproc == 0) {
-        std::vector<std::string> filenames;
         for (unsigned int iproc = 0; iproc < dealii::Utilities::MPI::n_mpi_processes(mpi_communicator); ++iproc) {
             std::string fn = "solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
             fn += dealii::Utilities::int_to_string(cycle, 4) + ".";
@@ -1840,12 +2348,17 @@ void DGBase<dim,real,MeshType>::output_results_vtk (const unsigned int cycle, co
             fn += ".vtu";
             filenames.push_back(fn);
         }
-        std::string master_fn = this->all_parameters->solution_vtk_files_directory_name + "/" + "solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
+        master_fn = this->all_parameters->solution_vtk_files_directory_name + "/" + "solution-" + dealii::Utilities::int_to_string(dim, 1) +"D_maxpoly"+dealii::Utilities::int_to_string(max_degree, 2)+"-";
         master_fn += dealii::Utilities::int_to_string(cycle, 4) + ".pvtu";
-        std::ofstream master_output(master_fn);
-        data_out.write_pvtu_record(master_output, filenames);
     }
+    write_detached_patches(patches, filename, master_fn, filenames, all_parameters->write_vtk_output_asynchronously, pending_vtk_output);
+}
 
+template <int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::finish_vtk_output ()
+{
+    if (pending_vtk_output.valid()) pending_vtk_output.get();
+    if (pending_face_vtk_output.valid()) pending_face_vtk_output.get();
 }
 
 template <int dim, typename real, typename MeshType>
@@ -1896,6 +2409,12 @@ void DGBase<dim,real,MeshType>::allocate_system (
     max_dt_cell.reinit(triangulation->n_active_cells());
     cell_volume.reinit(triangulation->n_active_cells());
 
+    // Cell partitions used by the residual cell loop depend on the mesh only.
+    build_cell_partitions();
+
+    // The cached metric terms belong to the previous mesh.
+    metric_terms_cache.clear();
+
     // allocates model variables only if there is a model
     if(all_parameters->pde_type == Parameters::AllParameters::PartialDifferentialEquation::physics_model) allocate_model_variables();
 
@@ -2015,7 +2534,7 @@ void DGBase<dim,real,MeshType>::allocate_dRdX ()
     dealii::SparsityPattern dRdXv_sparsity_pattern = get_dRdX_sparsity_pattern ();
     const dealii::IndexSet &row_parallel_partitioning = locally_owned_dofs;
     const dealii::IndexSet &col_parallel_partitioning = high_order_grid->locally_owned_dofs_grid;
-    dRdXv.reinit(row_parallel_partitioning, col_parallel_partitioning, dRdXv_sparsity_pattern, MPI_COMM_WORLD);
+    dRdXv.reinit(row_parallel_partitioning, col_parallel_partitioning, dRdXv_sparsity_pattern, mpi_communicator);
 }
 
 template <int dim, typename real, typename MeshType>
@@ -2068,46 +2587,58 @@ void DGBase<dim,real,MeshType>::evaluate_mass_matrices (bool do_inverse_mass_mat
     // flag for energy tests
     const bool use_energy = this->all_parameters->use_energy;
 
-    // Mass matrix sparsity pattern
-    dealii::DynamicSparsityPattern dsp(dof_handler.n_dofs());
     std::vector<dealii::types::global_dof_index> dofs_indices;
-    for (auto cell = dof_handler.begin_active(); cell!=dof_handler.end(); ++cell) {
+    if (this->all_parameters->use_block_diagonal_mass_matrices) {
+        // The blocks are appended in the cell loop below; no sparsity pattern is needed.
+        if (do_inverse_mass_matrix) {
+            global_inverse_mass_matrix_blocks.reinit(locally_owned_dofs);
+            if (use_auxiliary_eq) global_inverse_mass_matrix_auxiliary_blocks.reinit(locally_owned_dofs);
+        }
+        if (!do_inverse_mass_matrix || use_energy) {
+            global_mass_matrix_blocks.reinit(locally_owned_dofs);
+            if (use_auxiliary_eq) global_mass_matrix_auxiliary_blocks.reinit(locally_owned_dofs);
+        }
+    } else {
+        // Mass matrix sparsity pattern
+        dealii::DynamicSparsityPattern dsp(dof_handler.n_dofs());
+        for (auto cell = dof_handler.begin_active(); cell!=dof_handler.end(); ++cell) {
 
-        if (!cell->is_locally_owned()) continue;
+            if (!cell->is_locally_owned()) continue;
 
-        const unsigned int fe_index_curr_cell = cell->active_fe_index();
+            const unsigned int fe_index_curr_cell = cell->active_fe_index();
 
-        // Current reference element related to this physical cell
-        const dealii::FESystem<dim,dim> &current_fe_ref = fe_collection[fe_index_curr_cell];
-        const unsigned int n_dofs_cell = current_fe_ref.n_dofs_per_cell();
+            // Current reference element related to this physical cell
+            const dealii::FESystem<dim,dim> &current_fe_ref = fe_collection[fe_index_curr_cell];
+            const unsigned int n_dofs_cell = current_fe_ref.n_dofs_per_cell();
 
-        dofs_indices.resize(n_dofs_cell);
-        cell->get_dof_indices (dofs_indices);
-        for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
-            for (unsigned int itrial=0; itrial<n_dofs_cell; ++itrial) {
-                dsp.add(dofs_indices[itest], dofs_indices[itrial]);
+            dofs_indices.resize(n_dofs_cell);
+            cell->get_dof_indices (dofs_indices);
+            for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
+                for (unsigned int itrial=0; itrial<n_dofs_cell; ++itrial) {
+                    dsp.add(dofs_indices[itest], dofs_indices[itrial]);
+                }
             }
         }
-    }
-    // Initialize global matrices to 0.
-    dealii::SparsityTools::distribute_sparsity_pattern(dsp, dof_handler.locally_owned_dofs(), mpi_communicator, locally_owned_dofs);
-    mass_sparsity_pattern.copy_from(dsp);
-    if (do_inverse_mass_matrix) {
-        global_inverse_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
-        if (use_auxiliary_eq){
-            global_inverse_mass_matrix_auxiliary.reinit(locally_owned_dofs, mass_sparsity_pattern);
-        }
-        if (use_energy){//for split form get energy
+        // Initialize global matrices to 0.
+        dealii::SparsityTools::distribute_sparsity_pattern(dsp, dof_handler.locally_owned_dofs(), mpi_communicator, locally_owned_dofs);
+        mass_sparsity_pattern.copy_from(dsp);
+        if (do_inverse_mass_matrix) {
+            global_inverse_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
+            if (use_auxiliary_eq){
+                global_inverse_mass_matrix_auxiliary.reinit(locally_owned_dofs, mass_sparsity_pattern);
+            }
+            if (use_energy){//for split form get energy
+                global_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
+                if (use_auxiliary_eq){
+                    global_mass_matrix_auxiliary.reinit(locally_owned_dofs, mass_sparsity_pattern);
+                }
+            }
+        } else {
             global_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
             if (use_auxiliary_eq){
                 global_mass_matrix_auxiliary.reinit(locally_owned_dofs, mass_sparsity_pattern);
             }
         }
-    } else {
-        global_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
-        if (use_auxiliary_eq){
-            global_mass_matrix_auxiliary.reinit(locally_owned_dofs, mass_sparsity_pattern);
-        }
     }
 
     // setup 1D operators for ONE STATE. We loop over states in assembly for speedup.
@@ -2202,7 +2733,9 @@ void DGBase<dim,real,MeshType>::evaluate_mass_matrices (bool do_inverse_mass_mat
     }//end of cell loop
 
     //Compress global matrices.
-    if (do_inverse_mass_matrix) {
+    if (this->all_parameters->use_block_diagonal_mass_matrices) {
+        // Nothing to communicate since the blocks only involve locally owned rows.
+    } else if (do_inverse_mass_matrix) {
         global_inverse_mass_matrix.compress(dealii::VectorOperation::insert);
         if (use_auxiliary_eq){
             global_inverse_mass_matrix_auxiliary.compress(dealii::VectorOperation::insert);
@@ -2421,7 +2954,20 @@ void DGBase<dim,real,MeshType>::evaluate_local_metric_dependent_mass_matrix_and_
     }
 
     //set in global matrices
-    if (do_inverse_mass_matrix) {
+    if (this->all_parameters->use_block_diagonal_mass_matrices) {
+        if (do_inverse_mass_matrix) {
+            global_inverse_mass_matrix_blocks.add_block(dofs_indices, local_mass_matrix_inv);
+            if(use_auxiliary_eq){
+                global_inverse_mass_matrix_auxiliary_blocks.add_block(dofs_indices, local_mass_matrix_aux_inv);
+            }
+        }
+        if (!do_inverse_mass_matrix || this->all_parameters->use_energy) {
+            global_mass_matrix_blocks.add_block(dofs_indices, local_mass_matrix);
+            if(use_auxiliary_eq){
+                global_mass_matrix_auxiliary_blocks.add_block(dofs_indices, local_mass_matrix_aux);
+            }
+        }
+    } else if (do_inverse_mass_matrix) {
         //set the global inverse mass matrix
         global_inverse_mass_matrix.set(dofs_indices, local_mass_matrix_inv);
         //set the global inverse mass matrix for auxiliary equations
@@ -2444,6 +2990,36 @@ void DGBase<dim,real,MeshType>::evaluate_local_metric_dependent_mass_matrix_and_
     }
 }
 
+template<int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::apply_stored_global_mass_matrix(
+    const dealii::LinearAlgebra::distributed::Vector<double> &input_vector,
+    dealii::LinearAlgebra::distributed::Vector<double> &output_vector,
+    const bool use_auxiliary_eq) const
+{
+    if (this->all_parameters->use_block_diagonal_mass_matrices) {
+        if (use_auxiliary_eq) global_mass_matrix_auxiliary_blocks.vmult(output_vector, input_vector);
+        else                  global_mass_matrix_blocks.vmult(output_vector, input_vector);
+    } else {
+        if (use_auxiliary_eq) global_mass_matrix_auxiliary.vmult(output_vector, input_vector);
+        else                  global_mass_matrix.vmult(output_vector, input_vector);
+    }
+}
+
+template<int dim, typename real, typename MeshType>
+void DGBase<dim,real,MeshType>::apply_stored_inverse_global_mass_matrix(
+    const dealii::LinearAlgebra::distributed::Vector<double> &input_vector,
+    dealii::LinearAlgebra::distributed::Vector<double> &output_vector,
+    const bool use_auxiliary_eq) const
+{
+    if (this->all_parameters->use_block_diagonal_mass_matrices) {
+        if (use_auxiliary_eq) global_inverse_mass_matrix_auxiliary_blocks.vmult(output_vector, input_vector);
+        else                  global_inverse_mass_matrix_blocks.vmult(output_vector, input_vector);
+    } else {
+        if (use_auxiliary_eq) global_inverse_mass_matrix_auxiliary.vmult(output_vector, input_vector);
+        else                  global_inverse_mass_matrix.vmult(output_vector, input_vector);
+    }
+}
+
 template<int dim, typename real, typename MeshType>
 void DGBase<dim,real,MeshType>::apply_inverse_global_mass_matrix(
         const dealii::LinearAlgebra::distributed::Vector<double> &input_vector,
@@ -2454,6 +3030,9 @@ void DGBase<dim,real,MeshType>::apply_inverse_global_mass_matrix(
     using FR_Aux_enum = Parameters::AllParameters::Flux_Reconstruction_Aux;
     const FR_enum FR_Type = this->all_parameters->flux_reconstruction_type;
     const FR_Aux_enum FR_Type_Aux = this->all_parameters->flux_reconstruction_aux_type;
+
+    // The determinants of the metric Jacobian are reused from the residual if cached.
+    update_metric_terms_cache();
      
     const unsigned int init_grid_degree = high_order_grid->fe_system.tensor_degree();
     OPERATOR::mapping_shape_functions<dim,2*dim,real> mapping_basis(1, init_grid_degree, init_grid_degree);
@@ -2548,10 +3127,12 @@ void DGBase<dim,real,MeshType>::apply_inverse_global_mass_matrix(
         const unsigned int n_grid_nodes = n_metric_dofs / dim;
         //get determinant of Jacobian
         OPERATOR::metric_operators<real, dim, 2*dim> metric_oper(1, poly_degree, grid_degree);
-        metric_oper.build_determinant_volume_metric_Jacobian(
-                        n_quad_pts, n_grid_nodes, 
-                        mapping_support_points,
-                        mapping_basis);
+        if(!get_cached_volume_metric_terms(metric_cell->active_cell_index(), poly_degree, metric_oper)){
+            metric_oper.build_determinant_volume_metric_Jacobian(
+                            n_quad_pts, n_grid_nodes, 
+                            mapping_support_points,
+                            mapping_basis);
+        }
         //solve mass inverse times input vector for each state independently
         for(int istate=0; istate<nstate; istate++){
             const unsigned int n_shape_fns = n_dofs_cell / nstate;
@@ -2797,7 +3378,11 @@ void DGBase<dim,real,MeshType>::apply_global_mass_matrix(
 template<int dim, typename real, typename MeshType>
 void DGBase<dim,real,MeshType>::add_mass_matrices(const real scale)
 {
-    system_matrix.add(scale, global_mass_matrix);
+    if (this->all_parameters->use_block_diagonal_mass_matrices) {
+        global_mass_matrix_blocks.add_to(system_matrix, scale);
+    } else {
+        system_matrix.add(scale, global_mass_matrix);
+    }
 }
 template<int dim, typename real, typename MeshType>
 void DGBase<dim,real,MeshType>::add_time_scaled_mass_matrices()
@@ -2809,7 +3394,10 @@ void DGBase<dim,real,MeshType>::time_scaled_mass_matrices(const real dt_scale)
 {
     time_scaled_global_mass_matrix.reinit(system_matrix);
     time_scaled_global_mass_matrix = 0.0;
+    const bool use_block_diagonal_mass_matrices = this->all_parameters->use_block_diagonal_mass_matrices;
     std::vector<dealii::types::global_dof_index> dofs_indices;
+    // The mass matrix blocks are stored in the same order as the locally owned cells are visited.
+    unsigned int iblock = 0;
     for (auto cell = dof_handler.begin_active(); cell!=dof_handler.end(); ++cell) {
 
         if (!cell->is_locally_owned()) continue;
@@ -2833,7 +3421,9 @@ void DGBase<dim,real,MeshType>::time_scaled_mass_matrices(const real dt_scale)
                 if(istate_test==istate_trial) {
                     const unsigned int row = dofs_indices[itest];
                     const unsigned int col = dofs_indices[itrial];
-                    const double value = global_mass_matrix.el(row, col);
+                    const double value = use_block_diagonal_mass_matrices
+                                         ? global_mass_matrix_blocks.block_el(iblock, itest, itrial)
+                                         : global_mass_matrix.el(row, col);
                     const double new_val = value / (dt_scale * max_dt);
                     AssertIsFinite(new_val);
                     time_scaled_global_mass_matrix.set(row, col, new_val);
@@ -2841,6 +3431,7 @@ void DGBase<dim,real,MeshType>::time_scaled_mass_matrices(const real dt_scale)
                 }
             }
         }
+        ++iblock;
     }
     time_scaled_global_mass_matrix.compress(dealii::VectorOperation::insert);
 }
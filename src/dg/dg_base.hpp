@@ -40,8 +40,10 @@
 #include "numerical_flux/viscous_numerical_flux.hpp"
 #include "parameters/all_parameters.h"
 #include "operators/operators.h"
+#include "block_diagonal_matrix.h"
 #include "artificial_dissipation_factory.h"
 
+#include <future>
 #include <time.h>
 #include <deal.II/base/timer.h>
 
@@ -49,6 +51,9 @@
 //extern template class dealii::MappingFEField<PHILIP_DIM,PHILIP_DIM,dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<PHILIP_DIM> >;
 namespace PHiLiP {
 
+/// Polynomial levels of the p-multigrid preconditioner, see linear_solver/p_multigrid_preconditioner.h.
+struct PMultigridHierarchy;
+
 /// Get the coefficients of a function projected onto a set of basis (to be replaced with operators->projection_operator). 
 template<int dim, typename real>
 std::vector< real > project_function(
@@ -284,6 +289,20 @@ public:
         const bool use_auxiliary_eq = false,
         const bool use_unmodified_mass_matrix = false);
 
+    /// Applies the global mass matrix built by evaluate_mass_matrices().
+    /** Uses either the sparse or the block diagonal storage, depending on use_block_diagonal_mass_matrices. */
+    void apply_stored_global_mass_matrix(
+        const dealii::LinearAlgebra::distributed::Vector<double> &input_vector,
+        dealii::LinearAlgebra::distributed::Vector<double> &output_vector,
+        const bool use_auxiliary_eq = false) const;
+
+    /// Applies the global inverse mass matrix built by evaluate_mass_matrices(true).
+    /** Uses either the sparse or the block diagonal storage, depending on use_block_diagonal_mass_matrices. */
+    void apply_stored_inverse_global_mass_matrix(
+        const dealii::LinearAlgebra::distributed::Vector<double> &input_vector,
+        dealii::LinearAlgebra::distributed::Vector<double> &output_vector,
+        const bool use_auxiliary_eq = false) const;
+
     /// Evaluates the maximum stable time step
     /** If exact_time_stepping = true, use the same time step for the entire solution
      *  NOT YET IMPLEMENTED
@@ -338,6 +357,18 @@ public:
     /// Global inverse of the auxiliary mass matrix
     dealii::TrilinosWrappers::SparseMatrix global_inverse_mass_matrix_auxiliary;
 
+    /// Global mass matrix stored as dense cell blocks; used instead of global_mass_matrix if use_block_diagonal_mass_matrices.
+    BlockDiagonalMatrix<real> global_mass_matrix_blocks;
+
+    /// Global inverse mass matrix stored as dense cell blocks; used instead of global_inverse_mass_matrix if use_block_diagonal_mass_matrices.
+    BlockDiagonalMatrix<real> global_inverse_mass_matrix_blocks;
+
+    /// Global auxiliary mass matrix stored as dense cell blocks; used instead of global_mass_matrix_auxiliary if use_block_diagonal_mass_matrices.
+    BlockDiagonalMatrix<real> global_mass_matrix_auxiliary_blocks;
+
+    /// Global inverse auxiliary mass matrix stored as dense cell blocks; used instead of global_inverse_mass_matrix_auxiliary if use_block_diagonal_mass_matrices.
+    BlockDiagonalMatrix<real> global_inverse_mass_matrix_auxiliary_blocks;
+
     /// System matrix corresponding to the derivative of the right_hand_side with
     /// respect to the solution
     dealii::TrilinosWrappers::SparseMatrix system_matrix;
@@ -527,6 +558,7 @@ public:
 
     void output_results_vtk (const unsigned int cycle, const double current_time=0.0); ///< Output solution
     void output_face_results_vtk (const unsigned int cycle, const double current_time=0.0); ///< Output Euler face solution
+    void finish_vtk_output (); ///< Waits until the solution vtk files written in the background are complete
 
     bool update_artificial_diss;
     /// Main loop of the DG class.
@@ -563,6 +595,37 @@ public:
     //void assemble_residual_dRdW ();
     void assemble_residual (const bool compute_dRdW=false, const bool compute_dRdX=false, const bool compute_d2R=false, const double CFL_mass = 0.0);
 
+    /// Checks if the solution, volume nodes and, if provided, dual are identical to the stored copies.
+    /** Used to avoid re-assembling quantities that were evaluated at the same state.
+     *  The locally owned entries are compared in place, without forming difference vectors,
+     *  and a single reduction makes all processes agree on the result.
+     *  Must therefore be called by all processes.
+     */
+    bool state_matches (
+        const dealii::LinearAlgebra::distributed::Vector<double> &stored_solution,
+        const dealii::LinearAlgebra::distributed::Vector<double> &stored_volume_nodes,
+        const dealii::LinearAlgebra::distributed::Vector<double> *stored_dual = nullptr) const;
+
+    /// Degrees of freedom of each locally owned cell, in the order of the active cells.
+    /** The DoFs of a cell are not necessarily consecutive once renumbered.
+     *  Used to build the cell-block preconditioners of the linear solver.
+     */
+    std::vector<std::vector<dealii::types::global_dof_index>> locally_owned_cell_dof_indices () const;
+
+    /// Restricts assemble_residual() to the sample mesh of a hyper-reduced model.
+    /** A locally owned cell is assembled if its DoFs, or the DoFs of one of its face neighbours,
+     *  have a non-zero entry in sampled_dofs. The residual and Jacobian rows of the sampled cells
+     *  are therefore complete, while the other rows are incomplete and should be discarded.
+     *  sampled_dofs must be ghosted like the solution. An empty vector restores the full assembly.
+     */
+    void set_sample_mesh (const dealii::LinearAlgebra::distributed::Vector<double> &sampled_dofs);
+
+    /// Builds the polynomial levels of the p-multigrid preconditioner, from coarse_degree up to the current degrees.
+    /** Each level lowers the degree of the cells above it by one. The prolongations interpolate the
+     *  nested coarse basis functions onto the fine ones, cell by cell, and do not depend on the mapping.
+     */
+    PMultigridHierarchy build_p_multigrid_hierarchy (const unsigned int coarse_degree) const;
+
     /// Used in assemble_residual().
     /** IMPORTANT: This does not fully compute the cell residual since it might not
      *  perform the work on all the faces.
@@ -590,6 +653,131 @@ public:
         dealii::LinearAlgebra::distributed::Vector<double>                 &rhs,
         std::array<dealii::LinearAlgebra::distributed::Vector<double>,dim> &rhs_aux);
 
+    /// Thread-local FEValues and reference operators used by the threaded cell loop.
+    /** dealii::WorkStream copies the sample scratch data once per thread.
+     *  The copy constructor therefore rebuilds every object from the DG discretization
+     *  instead of sharing any state with the sample.
+     */
+    struct AssemblyScratchData
+    {
+        /// Constructor.
+        explicit AssemblyScratchData(DGBase<dim,real,MeshType> &dg_input);
+        /// Copy constructor used by dealii::WorkStream to create the thread-local copies.
+        AssemblyScratchData(const AssemblyScratchData &scratch_data);
+
+        DGBase<dim,real,MeshType> &dg; ///< Discretization providing the collections.
+        const dealii::hp::MappingCollection<dim> mapping_collection; ///< High-order grid mapping. Must outlive the FEValues below.
+
+        dealii::hp::FEValues<dim,dim>        fe_values_collection_volume; ///< FEValues of volume.
+        dealii::hp::FEFaceValues<dim,dim>    fe_values_collection_face_int; ///< FEValues of interior face.
+        dealii::hp::FEFaceValues<dim,dim>    fe_values_collection_face_ext; ///< FEValues of exterior face.
+        dealii::hp::FESubfaceValues<dim,dim> fe_values_collection_subface; ///< FEValues of subface.
+        dealii::hp::FEValues<dim,dim>        fe_values_collection_volume_lagrange; ///< FEValues of volume for the Lagrange basis.
+
+        OPERATOR::basis_functions<dim,2*dim,real>         soln_basis_int; ///< Interior solution basis.
+        OPERATOR::basis_functions<dim,2*dim,real>         soln_basis_ext; ///< Exterior solution basis.
+        OPERATOR::basis_functions<dim,2*dim,real>         flux_basis_int; ///< Interior flux basis.
+        OPERATOR::basis_functions<dim,2*dim,real>         flux_basis_ext; ///< Exterior flux basis.
+        OPERATOR::local_basis_stiffness<dim,2*dim,real>   flux_basis_stiffness; ///< Flux basis stiffness for skew-symmetric form.
+        OPERATOR::vol_projection_operator<dim,2*dim,real> soln_basis_projection_oper_int; ///< Interior projection operator.
+        OPERATOR::vol_projection_operator<dim,2*dim,real> soln_basis_projection_oper_ext; ///< Exterior projection operator.
+        OPERATOR::mapping_shape_functions<dim,2*dim,real> mapping_basis; ///< Mapping shape functions.
+    };
+
+    /// Nothing is copied back since cells of the same color never write to the same rows.
+    struct AssemblyCopyData {};
+
+protected:
+    /// Flags the locally owned cells that have at least one ghost face neighbour.
+    /** Indexed by the active cell index. Only those cells need the ghosted solution,
+     *  which allows the ghost exchange to be overlapped with the other cells' residual.
+     */
+    std::vector<bool> cell_has_ghost_neighbor;
+
+    /// Flags the cells assembled by assemble_residual(), indexed by the active cell index.
+    /** Empty unless set_sample_mesh() restricted the assembly. */
+    std::vector<bool> cell_is_in_sample_mesh;
+
+    /// Locally owned interior cells grouped by color for the threaded residual assembly.
+    /** Two cells share a color only if neither of them, nor any of their face neighbours,
+     *  coincide. Therefore, cells of a same color can add their face contributions to the
+     *  neighbouring cells' right-hand side concurrently.
+     *  Only built when n_threads_residual_assembly > 1.
+     */
+    std::vector<std::vector<typename dealii::DoFHandler<dim>::active_cell_iterator>> colored_interior_cells;
+
+    /// Locally owned cells with a ghost neighbour grouped by color for the threaded residual assembly.
+    std::vector<std::vector<typename dealii::DoFHandler<dim>::active_cell_iterator>> colored_ghost_adjacent_cells;
+
+    /// Builds cell_has_ghost_neighbor and, if needed, the colored cells.
+    /** Called in allocate_system() since it only depends on the mesh. */
+    void build_cell_partitions();
+
+    /// Threaded version of the explicit cell loop in assemble_residual().
+    /** Each color is assembled concurrently through dealii::WorkStream with
+     *  the number of threads set by n_threads_residual_assembly.
+     */
+    void assemble_residual_threaded(
+        const std::vector<std::vector<typename dealii::DoFHandler<dim>::active_cell_iterator>> &colored_cells);
+
+    /// Metric terms of one cell kept across residual evaluations when use_metric_cache is set.
+    struct CellMetricTerms
+    {
+        unsigned int poly_degree = 0; ///< Polynomial degree of the cubature the terms were built on.
+        bool volume_is_cached = false; ///< Flag if the volume terms are stored.
+        std::array<bool,2*dim> face_is_cached {}; ///< Flags if the facet terms of each face are stored.
+
+        dealii::Tensor<2,dim,std::vector<real>> metric_cofactor_vol; ///< Volume metric cofactor.
+        std::vector<real> det_Jac_vol; ///< Determinant of the metric Jacobian at the volume cubature nodes.
+        dealii::Tensor<1,dim,std::vector<real>> flux_nodes_vol; ///< Physical volume flux nodes, if stored.
+
+        std::array<dealii::Tensor<2,dim,std::vector<real>>,2*dim> metric_cofactor_surf; ///< Facet metric cofactor of each face.
+        std::array<std::vector<real>,2*dim> det_Jac_surf; ///< Determinant of the metric Jacobian at each face's cubature nodes.
+        std::array<dealii::Tensor<1,dim,std::vector<real>>,2*dim> flux_nodes_surf; ///< Physical facet flux nodes, if stored.
+    };
+
+    /// Metric terms of the locally owned cells indexed by the active cell index.
+    /** Filled during the residual assembly and cleared whenever the grid changes.
+     *  Only the entries of the cell being assembled are written, such that the
+     *  threaded cell loop may read the neighbours' entries without races.
+     */
+    std::vector<CellMetricTerms> metric_terms_cache;
+
+    /// Grid nodes used to build the metric_terms_cache.
+    dealii::LinearAlgebra::distributed::Vector<double> volume_nodes_metric_cache;
+
+    /// Clears the metric_terms_cache if the mesh or the volume nodes changed since it was filled.
+    /** Must be called by all processes before a cell loop that uses the cache. */
+    void update_metric_terms_cache();
+
+    /// Copies the cached volume metric terms into metric_oper. Returns false if they are not cached.
+    bool get_cached_volume_metric_terms(
+        const dealii::types::global_dof_index cell_index,
+        const unsigned int poly_degree,
+        OPERATOR::metric_operators<real,dim,2*dim> &metric_oper) const;
+
+    /// Stores the volume metric terms of metric_oper in the cache.
+    void store_volume_metric_terms(
+        const dealii::types::global_dof_index cell_index,
+        const unsigned int poly_degree,
+        const OPERATOR::metric_operators<real,dim,2*dim> &metric_oper);
+
+    /// Copies the cached facet metric terms of face iface into metric_oper. Returns false if they are not cached.
+    bool get_cached_facet_metric_terms(
+        const dealii::types::global_dof_index cell_index,
+        const unsigned int iface,
+        const unsigned int poly_degree,
+        OPERATOR::metric_operators<real,dim,2*dim> &metric_oper) const;
+
+    /// Stores the facet metric terms of face iface of metric_oper in the cache.
+    void store_facet_metric_terms(
+        const dealii::types::global_dof_index cell_index,
+        const unsigned int iface,
+        const unsigned int poly_degree,
+        const OPERATOR::metric_operators<real,dim,2*dim> &metric_oper);
+
+public:
+
     /// Finite Element Collection for p-finite-element to represent the solution
     /** This is a collection of FESystems */
     const dealii::hp::FECollection<dim>    fe_collection;
@@ -887,9 +1075,20 @@ public:
     */
     virtual void allocate_dual_vector () = 0;
 
+    /// MPI communicator of the discretization.
+    /** Communicator of the triangulation when it is distributed, MPI_COMM_WORLD otherwise.
+     */
+    MPI_Comm mpi_communicator;
+
 protected:
-    MPI_Comm mpi_communicator; ///< MPI communicator
     dealii::ConditionalOStream pcout; ///< Parallel std::cout that only outputs on mpi_rank==0
+
+    /// Write of the last solution vtk files, when write_vtk_output_asynchronously is set.
+    std::future<void> pending_vtk_output;
+    /// Write of the last face solution vtk files, when write_vtk_output_asynchronously is set.
+    /** Kept apart from pending_vtk_output such that the face output does not wait for the volume output of the same cycle.
+     */
+    std::future<void> pending_face_vtk_output;
 private:
 
     /** Evaluate the average penalty term at the face.
@@ -10,6 +10,7 @@
 #include <deal.II/dofs/dof_accessor.h>
 
 #include <deal.II/lac/vector.h>
+#include <deal.II/lac/full_matrix.h>
 
 #include "ADTypes.hpp"
 
@@ -29,6 +30,60 @@ DGStrong<dim,nstate,real,MeshType>::DGStrong(
     : DGBaseState<dim,nstate,real,MeshType>::DGBaseState(parameters_input, degree, max_degree_input, grid_degree_input, triangulation_input)
 { }
 
+template <int dim, int nstate, typename real, typename MeshType>
+template<typename LocalResidualFunction>
+void DGStrong<dim,nstate,real,MeshType>::assemble_local_jacobian_finite_difference(
+    const std::vector<dealii::types::global_dof_index> &perturbed_dofs_indices,
+    const std::vector<dealii::types::global_dof_index> &dofs_indices_int,
+    const std::vector<dealii::types::global_dof_index> &dofs_indices_ext,
+    const LocalResidualFunction                        &local_residual)
+{
+    // The auxiliary variable is not re-evaluated for the perturbed solution,
+    // such that the viscous fluxes' dependence on the solution would be missing.
+    if (this->use_auxiliary_eq) {
+        pcout << "ERROR: The finite difference Jacobian of the strong form does not include the auxiliary equation. "
+              << "Use the weak form for implicit viscous problems. Aborting..." << std::endl;
+        std::abort();
+    }
+
+    const unsigned int n_perturbed_dofs = perturbed_dofs_indices.size();
+    const unsigned int n_dofs_int = dofs_indices_int.size();
+    const unsigned int n_dofs_ext = dofs_indices_ext.size();
+
+    dealii::Vector<real> unperturbed_rhs_int(n_dofs_int);
+    dealii::Vector<real> unperturbed_rhs_ext(n_dofs_ext);
+    local_residual(unperturbed_rhs_int, unperturbed_rhs_ext);
+
+    dealii::FullMatrix<real> jacobian_int(n_dofs_int, n_perturbed_dofs);
+    dealii::FullMatrix<real> jacobian_ext(n_dofs_ext, n_perturbed_dofs);
+    dealii::Vector<real> perturbed_rhs_int(n_dofs_int);
+    dealii::Vector<real> perturbed_rhs_ext(n_dofs_ext);
+    const real sqrt_machine_epsilon = sqrt(std::numeric_limits<real>::epsilon());
+    for (unsigned int jdof = 0; jdof < n_perturbed_dofs; ++jdof) {
+        // Perturb the solution in place; the perturbed dof may be a ghost of the exterior cell.
+        real &solution_value = DGBase<dim,real,MeshType>::solution(perturbed_dofs_indices[jdof]);
+        const real unperturbed_value = solution_value;
+        const real step_size = sqrt_machine_epsilon * std::max(1.0, std::abs(unperturbed_value));
+
+        solution_value = unperturbed_value + step_size;
+        perturbed_rhs_int = 0.0;
+        perturbed_rhs_ext = 0.0;
+        local_residual(perturbed_rhs_int, perturbed_rhs_ext);
+        solution_value = unperturbed_value;
+
+        for (unsigned int idof = 0; idof < n_dofs_int; ++idof) {
+            jacobian_int(idof, jdof) = (perturbed_rhs_int[idof] - unperturbed_rhs_int[idof]) / step_size;
+        }
+        for (unsigned int idof = 0; idof < n_dofs_ext; ++idof) {
+            jacobian_ext(idof, jdof) = (perturbed_rhs_ext[idof] - unperturbed_rhs_ext[idof]) / step_size;
+        }
+    }
+
+    const bool elide_zero_values = false;
+    this->system_matrix.add(dofs_indices_int, perturbed_dofs_indices, jacobian_int, elide_zero_values);
+    if (n_dofs_ext > 0) this->system_matrix.add(dofs_indices_ext, perturbed_dofs_indices, jacobian_ext, elide_zero_values);
+}
+
 /***********************************************************
 *
 *       Build operators and solve for RHS
@@ -56,7 +111,7 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_volume_term_and_build_operator
     dealii::Vector<real>                                   &local_rhs_int_cell,
     std::vector<dealii::Tensor<1,dim,real>>                &local_auxiliary_RHS,
     const bool                                             compute_auxiliary_right_hand_side,
-    const bool /*compute_dRdW*/, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
+    const bool compute_dRdW, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
 {
     // Check if the current cell's poly degree etc is different then previous cell's.
     // If the current cell's poly degree is different, then we recompute the 1D 
@@ -92,11 +147,15 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_volume_term_and_build_operator
 
     //build the volume metric cofactor matrix and the determinant of the volume metric Jacobian
     //Also, computes the physical volume flux nodes if needed from flag passed to constructor in dg.cpp
-    metric_oper.build_volume_metric_operators(
-        this->volume_quadrature_collection[poly_degree].size(), n_grid_nodes,
-        mapping_support_points,
-        mapping_basis,
-        this->all_parameters->use_invariant_curl_form);
+    //Reuse them from the metric cache if they were stored by a previous residual.
+    if(!this->get_cached_volume_metric_terms(current_cell_index, poly_degree, metric_oper)){
+        metric_oper.build_volume_metric_operators(
+            this->volume_quadrature_collection[poly_degree].size(), n_grid_nodes,
+            mapping_support_points,
+            mapping_basis,
+            this->all_parameters->use_invariant_curl_form);
+        this->store_volume_metric_terms(current_cell_index, poly_degree, metric_oper);
+    }
 
     if(compute_auxiliary_right_hand_side){
         assemble_volume_term_auxiliary_equation (
@@ -108,6 +167,20 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_volume_term_and_build_operator
             local_auxiliary_RHS);
     }
     else{
+        if(compute_dRdW){
+            // Evaluated before the residual itself such that the cell's
+            // maximum time step is computed from the unperturbed solution.
+            const std::vector<dealii::types::global_dof_index> no_ext_dofs_indices;
+            assemble_local_jacobian_finite_difference(
+                cell_dofs_indices, cell_dofs_indices, no_ext_dofs_indices,
+                [&](dealii::Vector<real> &local_rhs_int, dealii::Vector<real> &/*local_rhs_ext*/) {
+                    assemble_volume_term_strong(
+                        cell, current_cell_index, cell_dofs_indices, poly_degree,
+                        soln_basis, flux_basis, flux_basis_stiffness,
+                        soln_basis_projection_oper_int, metric_oper,
+                        local_rhs_int);
+                });
+        }
         assemble_volume_term_strong(
             cell,
             current_cell_index,
@@ -145,20 +218,23 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_boundary_term_and_build_operat
     dealii::Vector<real>                                   &local_rhs_int_cell,
     std::vector<dealii::Tensor<1,dim,real>>                &local_auxiliary_RHS,
     const bool                                             compute_auxiliary_right_hand_side,
-    const bool /*compute_dRdW*/, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
+    const bool compute_dRdW, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
 {
 
     const dealii::FESystem<dim> &fe_metric = this->high_order_grid->fe_system;
     const unsigned int n_metric_dofs = fe_metric.dofs_per_cell;
     const unsigned int n_grid_nodes  = n_metric_dofs / dim;
     //build the surface metric operators for interior
-    metric_oper.build_facet_metric_operators(
-        iface,
-        this->face_quadrature_collection[poly_degree].size(),
-        n_grid_nodes,
-        mapping_support_points,
-        mapping_basis,
-        this->all_parameters->use_invariant_curl_form);
+    if(!this->get_cached_facet_metric_terms(current_cell_index, iface, poly_degree, metric_oper)){
+        metric_oper.build_facet_metric_operators(
+            iface,
+            this->face_quadrature_collection[poly_degree].size(),
+            n_grid_nodes,
+            mapping_support_points,
+            mapping_basis,
+            this->all_parameters->use_invariant_curl_form);
+        this->store_facet_metric_terms(current_cell_index, iface, poly_degree, metric_oper);
+    }
 
     if(compute_auxiliary_right_hand_side){
         assemble_boundary_term_auxiliary_equation (
@@ -168,6 +244,18 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_boundary_term_and_build_operat
             local_auxiliary_RHS);
     }
     else{
+        if(compute_dRdW){
+            const std::vector<dealii::types::global_dof_index> no_ext_dofs_indices;
+            assemble_local_jacobian_finite_difference(
+                cell_dofs_indices, cell_dofs_indices, no_ext_dofs_indices,
+                [&](dealii::Vector<real> &local_rhs_int, dealii::Vector<real> &/*local_rhs_ext*/) {
+                    assemble_boundary_term_strong(
+                        iface, current_cell_index, boundary_id, poly_degree, penalty,
+                        cell_dofs_indices, soln_basis, flux_basis,
+                        soln_basis_projection_oper_int, metric_oper,
+                        local_rhs_int);
+                });
+        }
         assemble_boundary_term_strong (
             iface,
             current_cell_index,
@@ -218,20 +306,23 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_face_term_and_build_operators(
     dealii::LinearAlgebra::distributed::Vector<double>     &rhs,
     std::array<dealii::LinearAlgebra::distributed::Vector<double>,dim> &rhs_aux,
     const bool                                             compute_auxiliary_right_hand_side,
-    const bool /*compute_dRdW*/, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
+    const bool compute_dRdW, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
 {
 
     const dealii::FESystem<dim> &fe_metric = this->high_order_grid->fe_system;
     const unsigned int n_metric_dofs = fe_metric.dofs_per_cell;
     const unsigned int n_grid_nodes  = n_metric_dofs / dim;
     //build the surface metric operators for interior
-    metric_oper_int.build_facet_metric_operators(
-        iface,
-        this->face_quadrature_collection[poly_degree_int].size(),
-        n_grid_nodes,
-        mapping_support_points,
-        mapping_basis,
-        this->all_parameters->use_invariant_curl_form);
+    if(!this->get_cached_facet_metric_terms(current_cell_index, iface, poly_degree_int, metric_oper_int)){
+        metric_oper_int.build_facet_metric_operators(
+            iface,
+            this->face_quadrature_collection[poly_degree_int].size(),
+            n_grid_nodes,
+            mapping_support_points,
+            mapping_basis,
+            this->all_parameters->use_invariant_curl_form);
+        this->store_facet_metric_terms(current_cell_index, iface, poly_degree_int, metric_oper_int);
+    }
 
     if(poly_degree_ext != soln_basis_ext.current_degree){
         soln_basis_ext.current_degree    = poly_degree_ext; 
@@ -245,7 +336,11 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_face_term_and_build_operators(
                                                       mapping_basis);
     }
 
-    if(!compute_auxiliary_right_hand_side){//only for primary equations
+    //get neighbor metric operator from the cache if the neighbour has already been assembled.
+    //Only the current cell's entry is ever written to, since the neighbour may belong to another thread.
+    const bool neighbor_metric_is_cached = !compute_auxiliary_right_hand_side
+                                           && this->get_cached_volume_metric_terms(neighbor_cell_index, poly_degree_ext, metric_oper_ext);
+    if(!compute_auxiliary_right_hand_side && !neighbor_metric_is_cached){//only for primary equations
         //get neighbor metric operator
         //rewrite the high_order_grid->volume_nodes in a way we can use sum-factorization on.
         //that is, splitting up the vector by the dimension.
@@ -288,6 +383,23 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_face_term_and_build_operators(
         }
     }
     else{
+        if(compute_dRdW){
+            // The face couples both cells, so both the current and the neighbour cell's
+            // dofs are perturbed, giving the four blocks of the face Jacobian.
+            const auto local_face_residual = [&](dealii::Vector<real> &local_rhs_int, dealii::Vector<real> &local_rhs_ext) {
+                assemble_face_term_strong(
+                    iface, neighbor_iface, current_cell_index, neighbor_cell_index,
+                    poly_degree_int, poly_degree_ext, penalty,
+                    current_dofs_indices, neighbor_dofs_indices,
+                    soln_basis_int, soln_basis_ext,
+                    flux_basis_int, flux_basis_ext,
+                    soln_basis_projection_oper_int, soln_basis_projection_oper_ext,
+                    metric_oper_int, metric_oper_ext,
+                    local_rhs_int, local_rhs_ext);
+            };
+            assemble_local_jacobian_finite_difference(current_dofs_indices, current_dofs_indices, neighbor_dofs_indices, local_face_residual);
+            assemble_local_jacobian_finite_difference(neighbor_dofs_indices, current_dofs_indices, neighbor_dofs_indices, local_face_residual);
+        }
         assemble_face_term_strong (
             iface, neighbor_iface, 
             current_cell_index,
@@ -477,7 +589,7 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_auxiliary_residual()
             if(this->all_parameters->use_inverse_mass_on_the_fly)
                 this->apply_inverse_global_mass_matrix(this->auxiliary_right_hand_side[idim], this->auxiliary_solution[idim], true);
             else
-                this->global_inverse_mass_matrix_auxiliary.vmult(this->auxiliary_solution[idim], this->auxiliary_right_hand_side[idim]);
+                this->apply_stored_inverse_global_mass_matrix(this->auxiliary_right_hand_side[idim], this->auxiliary_solution[idim], true);
 
             //update ghost values of auxiliary solution
             this->auxiliary_solution[idim].update_ghost_values();
@@ -928,15 +1040,57 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_volume_term_strong(
     std::vector<std::array<real,nstate>> soln_at_q_for_max_CFL(n_quad_pts);//Need soln written in a different for to use pre-existing max CFL function
     // Interpolate each state to the quadrature points using sum-factorization
     // with the basis functions in each reference direction.
-    for(int istate=0; istate<nstate; istate++){
-        soln_at_q[istate].resize(n_quad_pts);
-        soln_basis.matrix_vector_mult_1D(soln_coeff[istate], soln_at_q[istate],
-                                         soln_basis.oneD_vol_operator);
-        for(int idim=0; idim<dim; idim++){
-            aux_soln_at_q[istate][idim].resize(n_quad_pts);
-            soln_basis.matrix_vector_mult_1D(aux_soln_coeff[istate][idim], aux_soln_at_q[istate][idim],
+    if(this->all_parameters->use_vectorized_volume_kernel){
+        // Pack the states and the auxiliary components into the SIMD lanes,
+        // such that one sum-factorized interpolation serves several of them.
+        // The auxiliary components are only packed if they are non-zero.
+        const unsigned int n_lanes = dealii::VectorizedArray<real>::size();
+        const unsigned int n_comps_per_state = (this->use_auxiliary_eq) ? dim+1 : 1;
+        const unsigned int n_fields = nstate * n_comps_per_state;
+        for(int istate=0; istate<nstate; istate++){
+            soln_at_q[istate].resize(n_quad_pts);
+            for(int idim=0; idim<dim; idim++){
+                aux_soln_at_q[istate][idim].resize(n_quad_pts, 0.0);
+            }
+        }
+        std::vector<dealii::VectorizedArray<real>> coeff_batch(n_shape_fns);
+        std::vector<dealii::VectorizedArray<real>> at_q_batch(n_quad_pts);
+        for(unsigned int ifield_start=0; ifield_start<n_fields; ifield_start+=n_lanes){
+            const unsigned int n_lanes_used = std::min(n_lanes, n_fields - ifield_start);
+            for(unsigned int ishape=0; ishape<n_shape_fns; ishape++){
+                coeff_batch[ishape] = 0.0;
+                for(unsigned int ilane=0; ilane<n_lanes_used; ilane++){
+                    const unsigned int istate = (ifield_start + ilane) / n_comps_per_state;
+                    const unsigned int icomp  = (ifield_start + ilane) % n_comps_per_state;
+                    coeff_batch[ishape][ilane] = (icomp == 0) ? soln_coeff[istate][ishape]
+                                                              : aux_soln_coeff[istate][icomp-1][ishape];
+                }
+            }
+            soln_basis.matrix_vector_mult_1D_vectorized(coeff_batch, at_q_batch,
+                                                        soln_basis.oneD_vol_operator);
+            for(unsigned int ilane=0; ilane<n_lanes_used; ilane++){
+                const unsigned int istate = (ifield_start + ilane) / n_comps_per_state;
+                const unsigned int icomp  = (ifield_start + ilane) % n_comps_per_state;
+                std::vector<real> &field_at_q = (icomp == 0) ? soln_at_q[istate] : aux_soln_at_q[istate][icomp-1];
+                for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
+                    field_at_q[iquad] = at_q_batch[iquad][ilane];
+                }
+            }
+        }
+    }
+    else{
+        for(int istate=0; istate<nstate; istate++){
+            soln_at_q[istate].resize(n_quad_pts);
+            soln_basis.matrix_vector_mult_1D(soln_coeff[istate], soln_at_q[istate],
                                              soln_basis.oneD_vol_operator);
+            for(int idim=0; idim<dim; idim++){
+                aux_soln_at_q[istate][idim].resize(n_quad_pts);
+                soln_basis.matrix_vector_mult_1D(aux_soln_coeff[istate][idim], aux_soln_at_q[istate][idim],
+                                                 soln_basis.oneD_vol_operator);
+            }
         }
+    }
+    for(int istate=0; istate<nstate; istate++){
         for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
             soln_at_q_for_max_CFL[iquad][istate] = soln_at_q[istate][iquad];
         }
@@ -1217,71 +1371,118 @@ void DGStrong<dim,nstate,real,MeshType>::assemble_volume_term_strong(
                                                           flux_basis_stiffness_skew_symm_oper_sparse);
     }
 
+    // With the vectorized kernel and a conservative convective flux, the convective and diffusive
+    // reference fluxes are summed at the flux nodes, and the states are packed into the SIMD lanes.
+    // Thus, a single divergence and inner product gives the flux contribution to the rhs of several states.
+    const bool use_vectorized_flux_divergence = this->all_parameters->use_vectorized_volume_kernel
+                                             && !(this->all_parameters->use_split_form || this->all_parameters->use_curvilinear_split_form);
+    std::array<std::vector<real>,nstate> flux_divergence_rhs;
+    if(use_vectorized_flux_divergence){
+        const unsigned int n_lanes = dealii::VectorizedArray<real>::size();
+        dealii::Tensor<1,dim,std::vector<dealii::VectorizedArray<real>>> ref_flux_batch;
+        for(int idim=0; idim<dim; idim++){
+            ref_flux_batch[idim].resize(n_quad_pts);
+        }
+        std::vector<dealii::VectorizedArray<real>> flux_divergence_batch(n_quad_pts);
+        std::vector<dealii::VectorizedArray<real>> rhs_batch(n_shape_fns);
+        for(unsigned int istate_start=0; istate_start<(unsigned int)nstate; istate_start+=n_lanes){
+            const unsigned int n_lanes_used = std::min(n_lanes, nstate - istate_start);
+            for(int idim=0; idim<dim; idim++){
+                for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
+                    ref_flux_batch[idim][iquad] = 0.0;
+                    for(unsigned int ilane=0; ilane<n_lanes_used; ilane++){
+                        const unsigned int istate = istate_start + ilane;
+                        ref_flux_batch[idim][iquad][ilane] = conv_ref_flux_at_q[istate][idim][iquad]
+                                                           + diffusive_ref_flux_at_q[istate][idim][iquad];
+                    }
+                }
+            }
+            flux_basis.divergence_matrix_vector_mult_1D_vectorized(ref_flux_batch, flux_divergence_batch,
+                                                                   flux_basis.oneD_vol_operator,
+                                                                   flux_basis.oneD_grad_operator);
+            // Same sign convention as the scalar path below.
+            soln_basis.inner_product_1D_vectorized(flux_divergence_batch, vol_quad_weights, rhs_batch,
+                                                   soln_basis.oneD_vol_operator_transpose, false, -1.0);
+            for(unsigned int ilane=0; ilane<n_lanes_used; ilane++){
+                const unsigned int istate = istate_start + ilane;
+                flux_divergence_rhs[istate].resize(n_shape_fns);
+                for(unsigned int ishape=0; ishape<n_shape_fns; ishape++){
+                    flux_divergence_rhs[istate][ishape] = rhs_batch[ishape][ilane];
+                }
+            }
+        }
+    }
+
     //For each state we:
     //  1. Compute reference divergence.
     //  2. Then compute and write the rhs for the given state.
     for(int istate=0; istate<nstate; istate++){
 
-        //Compute reference divergence of the reference fluxes.
-        std::vector<real> conv_flux_divergence(n_quad_pts); 
-        std::vector<real> diffusive_flux_divergence(n_quad_pts); 
+        std::vector<real> rhs(n_shape_fns);
+        if(use_vectorized_flux_divergence){
+            rhs = flux_divergence_rhs[istate];
+        }
+        else{
+            //Compute reference divergence of the reference fluxes.
+            std::vector<real> conv_flux_divergence(n_quad_pts); 
+            std::vector<real> diffusive_flux_divergence(n_quad_pts); 
+
+            if (this->all_parameters->use_split_form || this->all_parameters->use_curvilinear_split_form){
+                //2pt flux Hadamard Product, and then multiply by vector of ones scaled by 1.
+                // Same as the volume term in Eq. (15) in Chan, Jesse. "Skew-symmetric entropy stable modal discontinuous Galerkin formulations." Journal of Scientific Computing 81.1 (2019): 459-485. but, 
+                // where we use the reference skew-symmetric stiffness operator of the flux basis for the Q operator and the reference two-point flux as to make use of Alex's Hadamard product
+                // sum-factorization type algorithm that exploits the structure of the flux basis in the reference space to have O(n^{d+1}).
 
-        if (this->all_parameters->use_split_form || this->all_parameters->use_curvilinear_split_form){
-            //2pt flux Hadamard Product, and then multiply by vector of ones scaled by 1.
-            // Same as the volume term in Eq. (15) in Chan, Jesse. "Skew-symmetric entropy stable modal discontinuous Galerkin formulations." Journal of Scientific Computing 81.1 (2019): 459-485. but, 
-            // where we use the reference skew-symmetric stiffness operator of the flux basis for the Q operator and the reference two-point flux as to make use of Alex's Hadamard product
-            // sum-factorization type algorithm that exploits the structure of the flux basis in the reference space to have O(n^{d+1}).
-
-            for(int ref_dim=0; ref_dim<dim; ref_dim++){
-                dealii::FullMatrix<real> divergence_ref_flux_Hadamard_product(n_quad_pts, n_quad_pts_1D);
-                flux_basis.Hadamard_product(flux_basis_stiffness_skew_symm_oper_sparse[ref_dim], conv_ref_2pt_flux_at_q[istate][ref_dim], divergence_ref_flux_Hadamard_product); 
-                //Hadamard product times the vector of ones.
-                for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
-                    if(ref_dim == 0){
-                        conv_flux_divergence[iquad] = 0.0;
-                    }
-                    for(unsigned int iquad_1D=0; iquad_1D<n_quad_pts_1D; iquad_1D++){
-                        conv_flux_divergence[iquad] += divergence_ref_flux_Hadamard_product[iquad][iquad_1D];
+                for(int ref_dim=0; ref_dim<dim; ref_dim++){
+                    dealii::FullMatrix<real> divergence_ref_flux_Hadamard_product(n_quad_pts, n_quad_pts_1D);
+                    flux_basis.Hadamard_product(flux_basis_stiffness_skew_symm_oper_sparse[ref_dim], conv_ref_2pt_flux_at_q[istate][ref_dim], divergence_ref_flux_Hadamard_product); 
+                    //Hadamard product times the vector of ones.
+                    for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
+                        if(ref_dim == 0){
+                            conv_flux_divergence[iquad] = 0.0;
+                        }
+                        for(unsigned int iquad_1D=0; iquad_1D<n_quad_pts_1D; iquad_1D++){
+                            conv_flux_divergence[iquad] += divergence_ref_flux_Hadamard_product[iquad][iquad_1D];
+                        }
                     }
                 }
-            }
             
-        }
-        else{
-            //Reference divergence of the reference convective flux.
-            flux_basis.divergence_matrix_vector_mult_1D(conv_ref_flux_at_q[istate], conv_flux_divergence,
+            }
+            else{
+                //Reference divergence of the reference convective flux.
+                flux_basis.divergence_matrix_vector_mult_1D(conv_ref_flux_at_q[istate], conv_flux_divergence,
+                                                            flux_basis.oneD_vol_operator,
+                                                            flux_basis.oneD_grad_operator);
+            }
+            //Reference divergence of the reference diffusive flux.
+            flux_basis.divergence_matrix_vector_mult_1D(diffusive_ref_flux_at_q[istate], diffusive_flux_divergence,
                                                         flux_basis.oneD_vol_operator,
                                                         flux_basis.oneD_grad_operator);
-        }
-        //Reference divergence of the reference diffusive flux.
-        flux_basis.divergence_matrix_vector_mult_1D(diffusive_ref_flux_at_q[istate], diffusive_flux_divergence,
-                                                    flux_basis.oneD_vol_operator,
-                                                    flux_basis.oneD_grad_operator);
 
 
-        // Strong form
-        // The right-hand side sends all the term to the side of the source term
-        // Therefore, 
-        // \divergence ( Fconv + Fdiss ) = source 
-        // has the right-hand side
-        // rhs = - \divergence( Fconv + Fdiss ) + source 
-        // Since we have done an integration by parts, the volume term resulting from the divergence of Fconv and Fdiss
-        // is negative. Therefore, negative of negative means we add that volume term to the right-hand-side
-        std::vector<real> rhs(n_shape_fns);
+            // Strong form
+            // The right-hand side sends all the term to the side of the source term
+            // Therefore, 
+            // \divergence ( Fconv + Fdiss ) = source 
+            // has the right-hand side
+            // rhs = - \divergence( Fconv + Fdiss ) + source 
+            // Since we have done an integration by parts, the volume term resulting from the divergence of Fconv and Fdiss
+            // is negative. Therefore, negative of negative means we add that volume term to the right-hand-side
 
-        // Convective
-        if (this->all_parameters->use_split_form || this->all_parameters->use_curvilinear_split_form){
-            std::vector<real> ones(n_quad_pts, 1.0);
-            soln_basis.inner_product_1D(conv_flux_divergence, ones, rhs, soln_basis.oneD_vol_operator, false, -1.0);
-        }
-        else {
-            soln_basis.inner_product_1D(conv_flux_divergence, vol_quad_weights, rhs, soln_basis.oneD_vol_operator, false, -1.0);
-        }
+            // Convective
+            if (this->all_parameters->use_split_form || this->all_parameters->use_curvilinear_split_form){
+                std::vector<real> ones(n_quad_pts, 1.0);
+                soln_basis.inner_product_1D(conv_flux_divergence, ones, rhs, soln_basis.oneD_vol_operator, false, -1.0);
+            }
+            else {
+                soln_basis.inner_product_1D(conv_flux_divergence, vol_quad_weights, rhs, soln_basis.oneD_vol_operator, false, -1.0);
+            }
 
-        // Diffusive
-        // Note that for diffusion, the negative is defined in the physics. Since we used the auxiliary
-        // variable, put a negative here.
-        soln_basis.inner_product_1D(diffusive_flux_divergence, vol_quad_weights, rhs, soln_basis.oneD_vol_operator, true, -1.0);
+            // Diffusive
+            // Note that for diffusion, the negative is defined in the physics. Since we used the auxiliary
+            // variable, put a negative here.
+            soln_basis.inner_product_1D(diffusive_flux_divergence, vol_quad_weights, rhs, soln_basis.oneD_vol_operator, true, -1.0);
+        }
 
         // Manufactured source
         if(this->all_parameters->manufactured_convergence_study_param.manufactured_solution_param.use_manufactured_source_term) {
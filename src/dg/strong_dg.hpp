@@ -299,6 +299,28 @@ protected:
         dealii::Vector<real>                               &local_rhs_int_cell,
         dealii::Vector<real>                               &local_rhs_ext_cell);
 
+    /// Adds the Jacobian of a local residual contribution to the system matrix.
+    /** The strong form operators are not templated on an AD type. Instead, each column of the
+     *  local Jacobian block is obtained by a forward finite difference of the local residual
+     *  contribution, perturbing one solution coefficient at a time.
+     *  The rows are given by the interior and exterior cells' dofs, the columns by the perturbed dofs.
+     *  Since only the contribution of a single volume/face/boundary term is re-evaluated,
+     *  this costs n_dofs_cell evaluations of that term per cell.
+     *  The auxiliary variable is not perturbed, so this aborts for PDEs using the auxiliary
+     *  equation (viscous terms) rather than assembling an inconsistent Jacobian.
+     *
+     *  @param[in] perturbed_dofs_indices Columns of the Jacobian block.
+     *  @param[in] dofs_indices_int Rows of the local residual's interior contribution.
+     *  @param[in] dofs_indices_ext Rows of the local residual's exterior contribution; empty for volume and boundary terms.
+     *  @param[in] local_residual Function evaluating the interior and exterior contributions of the local residual.
+     */
+    template<typename LocalResidualFunction>
+    void assemble_local_jacobian_finite_difference(
+        const std::vector<dealii::types::global_dof_index> &perturbed_dofs_indices,
+        const std::vector<dealii::types::global_dof_index> &dofs_indices_int,
+        const std::vector<dealii::types::global_dof_index> &dofs_indices_ext,
+        const LocalResidualFunction                        &local_residual);
+
 protected:
     /// Evaluate the integral over the cell volume and the specified derivatives.
     /** Compute both the right-hand side and the corresponding block of dRdW, dRdX, and/or d2R. */
@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <vector>
 #include <sstream>
+#include <future>
 #include "reduced_order/pod_basis_offline.h"
 #include "physics/initial_conditions/set_initial_condition.h"
 #include "mesh/mesh_adaptation/mesh_adaptation.h"
@@ -25,9 +26,9 @@ FlowSolver<dim, nstate>::FlowSolver(
 : FlowSolverBase()
 , flow_solver_case(flow_solver_case_input)
 , parameter_handler(parameter_handler_input)
-, mpi_communicator(MPI_COMM_WORLD)
-, mpi_rank(dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD))
-, n_mpi(dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD))
+, mpi_communicator(flow_solver_case->mpi_communicator)
+, mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
+, n_mpi(dealii::Utilities::MPI::n_mpi_processes(mpi_communicator))
 , pcout(std::cout, mpi_rank==0)
 , all_param(*parameters_input)
 , flow_solver_param(all_param.flow_solver_param)
@@ -60,12 +61,11 @@ FlowSolver<dim, nstate>::FlowSolver(
 
     flow_solver_case->display_flow_solver_setup(dg);
 
-    if(flow_solver_param.restart_computation_from_file == true) {
-        if(dim == 1) {
-            pcout << "Error: restart_computation_from_file is not possible for 1D. Set to false." << std::endl;
-            std::abort();
-        }
+    if(flow_solver_param.output_restart_files == true || flow_solver_param.restart_computation_from_file == true) {
+        restart_file_header = ProperOrthogonalDecomposition::snapshot_file_header(*dg);
+    }
 
+    if(flow_solver_param.restart_computation_from_file == true) {
         if (flow_solver_param.steady_state == true) {
             pcout << "Error: Restart capability has not been fully implemented / tested for steady state computations." << std::endl;
             std::abort();
@@ -74,17 +74,33 @@ FlowSolver<dim, nstate>::FlowSolver(
         // Initialize solution from restart file
         pcout << "Initializing solution from restart file..." << std::flush;
         const std::string restart_filename_without_extension = get_restart_filename_without_extension(flow_solver_param.restart_file_index);
-#if PHILIP_DIM>1
-        dg->triangulation->load(flow_solver_param.restart_files_directory_name + std::string("/") + restart_filename_without_extension);
-        
-        // Note: Future development with hp-capabilities, see section "Note on usage with DoFHandler with hp-capabilities"
-        // ----- Ref: https://www.dealii.org/current/doxygen/deal.II/classparallel_1_1distributed_1_1SolutionTransfer.html
+        const std::string restart_solution_filename = flow_solver_param.restart_files_directory_name + std::string("/") + restart_filename_without_extension + std::string(".solution");
         dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
         solution_no_ghost.reinit(dg->locally_owned_dofs, this->mpi_communicator);
-        dealii::parallel::distributed::SolutionTransfer<dim, dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<dim>> solution_transfer(dg->dof_handler);
-        solution_transfer.deserialize(solution_no_ghost);
-        dg->solution = solution_no_ghost; //< assignment
+        if(ProperOrthogonalDecomposition::SnapshotFile::is_snapshot_file(restart_solution_filename)) {
+            // Stored cell by cell in the order of the cell ids, which depends neither on the number of processes nor on the DoF numbering
+            const ProperOrthogonalDecomposition::SnapshotFile restart_solution_file(restart_solution_filename, this->mpi_communicator);
+            if(!restart_solution_file.is_compatible(restart_solution_file.read_header(), restart_file_header)) {
+                pcout << "Error: The restart file " << restart_solution_filename << " does not match the discretization of the computation." << std::endl;
+                std::abort();
+            }
+            restart_solution_file.read(0, ProperOrthogonalDecomposition::SnapshotFileOrdering(*dg), solution_no_ghost);
+        } else {
+#if PHILIP_DIM>1
+            // Restart files written by previous versions, through the serialization of the triangulation
+            dg->triangulation->load(flow_solver_param.restart_files_directory_name + std::string("/") + restart_filename_without_extension);
+
+            // Note: Future development with hp-capabilities, see section "Note on usage with DoFHandler with hp-capabilities"
+            // ----- Ref: https://www.dealii.org/current/doxygen/deal.II/classparallel_1_1distributed_1_1SolutionTransfer.html
+            solution_no_ghost.reinit(dg->locally_owned_dofs, this->mpi_communicator);
+            dealii::parallel::distributed::SolutionTransfer<dim, dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<dim>> solution_transfer(dg->dof_handler);
+            solution_transfer.deserialize(solution_no_ghost);
+#else
+            pcout << "Error: No restart file named " << restart_solution_filename << " exists." << std::endl;
+            std::abort();
 #endif
+        }
+        dg->solution = solution_no_ghost; //< assignment
         pcout << "done." << std::endl;
     } else {
         // Initialize solution
@@ -216,15 +232,12 @@ std::string FlowSolver<dim,nstate>::double_to_string(const double value_input) c
 template <int dim, int nstate>
 void FlowSolver<dim,nstate>::write_restart_parameter_file(
     const unsigned int restart_index_input,
-    const double time_step_input) const {
+    const double time_step_input,
+    std::ostream &restart_file) const {
     // write the restart parameter file
     if(mpi_rank==0) {
         // read a copy of the current parameters file
         std::ifstream CURRENT_FILE(input_parameters_file_reference_copy_filename);
-        
-        // create write file with appropriate postfix given the restart index input
-        const std::string restart_filename = get_restart_filename_without_extension(restart_index_input)+std::string(".prm");
-        std::ofstream RESTART_FILE(flow_solver_param.restart_files_directory_name + std::string("/") + restart_filename);
 
         // Lines to identify the subsections in the .prm file
         /* WARNING: (2) These must be in the order they appear in the .prm file
@@ -281,7 +294,7 @@ void FlowSolver<dim,nstate>::write_restart_parameter_file(
         while (std::getline(CURRENT_FILE, line)) {
             // check if the desired subsection has been reached
             if (line == subsection_line[i_subsection]) {
-                RESTART_FILE << line << "\n"; // write line
+                restart_file << line << "\n"; // write line
 
                 int i_parameter = 0;
                 std::string name;
@@ -309,7 +322,7 @@ void FlowSolver<dim,nstate>::write_restart_parameter_file(
                         updated_line.replace(position_to_replace,part_of_line_to_replace.length(),value_string);
 
                         // write updated line to restart file
-                        RESTART_FILE << updated_line << "\n";
+                        restart_file << updated_line << "\n";
                         
                         // update the parameter index, name, and value
                         if ((i_parameter+1) < number_of_subsection_parameters[i_subsection]) ++i_parameter; // to avoid going out of bounds
@@ -322,20 +335,19 @@ void FlowSolver<dim,nstate>::write_restart_parameter_file(
                         }
                     } else {
                         // write line (that does correspond to the desired parameter) to the restart file
-                        RESTART_FILE << line << "\n";
+                        restart_file << line << "\n";
                     }
                 }
                 // update the subsection index
                 if ((i_subsection+1) < number_of_subsections) ++i_subsection; // to avoid going out of bounds
             } else {
                 // write line (that is not in a desired subsection) to the restart file
-                RESTART_FILE << line << "\n";
+                restart_file << line << "\n";
             }
         }
     }
 }
 
-#if PHILIP_DIM>1
 template <int dim, int nstate>
 void FlowSolver<dim,nstate>::output_restart_files(
     const unsigned int current_restart_index,
@@ -343,26 +355,52 @@ void FlowSolver<dim,nstate>::output_restart_files(
     const std::shared_ptr <dealii::TableHandler> unsteady_data_table) const
 {
     pcout << "  ... Writing restart files ... " << std::endl;
+    // the previous restart files must be complete before new ones are started
+    finish_restart_files();
+
     const std::string restart_filename_without_extension = get_restart_filename_without_extension(current_restart_index);
+    const std::string restart_files_prefix = flow_solver_param.restart_files_directory_name + std::string("/") + restart_filename_without_extension;
+
+    // solution file; the locally owned values are copied before the time stepping modifies them
+    pending_restart_solution = std::make_unique<ProperOrthogonalDecomposition::PendingSnapshotWrite>(
+        restart_files_prefix + std::string(".solution"), mpi_communicator, dg->solution, ProperOrthogonalDecomposition::SnapshotFileOrdering(*dg), restart_file_header);
 
-    // solution files
-    dealii::parallel::distributed::SolutionTransfer<dim, dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<dim>> solution_transfer(dg->dof_handler);
-    // Note: Future development with hp-capabilities, see section "Note on usage with DoFHandler with hp-capabilities"
-    // ----- Ref: https://www.dealii.org/current/doxygen/deal.II/classparallel_1_1distributed_1_1SolutionTransfer.html
-    solution_transfer.prepare_for_serialization(dg->solution);
-    dg->triangulation->save(flow_solver_param.restart_files_directory_name + std::string("/") + restart_filename_without_extension);
-    
-    // unsteady data table
     if(mpi_rank==0) {
-        std::string restart_unsteady_data_table_filename = flow_solver_param.unsteady_data_table_filename+std::string("-")+restart_filename_without_extension+std::string(".txt");
-        std::ofstream unsteady_data_table_file(flow_solver_param.restart_files_directory_name + std::string("/") + restart_unsteady_data_table_filename);
-        unsteady_data_table->write_text(unsteady_data_table_file);
+        // unsteady data table
+        std::ostringstream unsteady_data_table_text;
+        unsteady_data_table->write_text(unsteady_data_table_text);
+        const std::string restart_unsteady_data_table_filename = flow_solver_param.restart_files_directory_name + std::string("/")
+            + flow_solver_param.unsteady_data_table_filename+std::string("-")+restart_filename_without_extension+std::string(".txt");
+        pending_restart_data_table = std::async(std::launch::async,
+            [restart_unsteady_data_table_filename, text = unsteady_data_table_text.str()]() {
+                std::ofstream unsteady_data_table_file(restart_unsteady_data_table_filename);
+                unsteady_data_table_file << text;
+            });
+
+        // parameter file, from the current state of the ODE solver
+        std::ostringstream restart_parameter_file_text;
+        write_restart_parameter_file(current_restart_index, time_step_input, restart_parameter_file_text);
+        pending_restart_parameter_file = std::make_pair(restart_files_prefix + std::string(".prm"), restart_parameter_file_text.str());
     }
+}
 
+template <int dim, int nstate>
+void FlowSolver<dim,nstate>::finish_restart_files() const
+{
+    if(pending_restart_solution) {
+        pending_restart_solution->wait();
+        pending_restart_solution.reset();
+    }
+    if(pending_restart_data_table.valid()) {
+        pending_restart_data_table.get();
+    }
     // parameter file; written last to ensure necessary data/solution files have been written before
-    write_restart_parameter_file(current_restart_index, time_step_input);
+    if(mpi_rank==0 && !pending_restart_parameter_file.first.empty()) {
+        std::ofstream restart_parameter_file(pending_restart_parameter_file.first);
+        restart_parameter_file << pending_restart_parameter_file.second;
+        pending_restart_parameter_file = std::make_pair(std::string(), std::string());
+    }
 }
-#endif
 
 template <int dim, int nstate>
 void FlowSolver<dim,nstate>::perform_steady_state_mesh_adaptation() const
@@ -433,9 +471,7 @@ int FlowSolver<dim,nstate>::run() const
         //----------------------------------------------------
         // Initializing restart related variables
         //----------------------------------------------------
-#if PHILIP_DIM>1
         double current_desired_time_for_output_restart_files_every_dt_time_intervals = ode_solver->current_time; // when used, same as the initial time
-#endif
         //----------------------------------------------------
         // Initialize time step
         //----------------------------------------------------
@@ -505,16 +541,29 @@ int FlowSolver<dim,nstate>::run() const
             // advance solution
             ode_solver->step_in_time(time_step,false); // pseudotime==false
 
+            // the restart files started at the previous time step were written during the step; complete them
+            finish_restart_files();
+            if(ode_param.use_error_controlled_time_step == true) {
+                // rejected steps reduce the time step; keep the flow case in sync with the accepted one
+                time_step = ode_solver->get_original_time_step();
+                flow_solver_case->set_time_step(time_step);
+            }
+
             // Compute the unsteady quantities, write to the dealii table, and output to file
             flow_solver_case->compute_unsteady_data_and_write_to_table(ode_solver, dg, unsteady_data_table);
             // update next time step
-            if(flow_solver_param.adaptive_time_step == true) {
+            if(ode_param.use_error_controlled_time_step == true) {
+                // time step from the embedded RK error estimate, limited by the CFL condition if adaptive_time_step is also used
+                next_time_step = ode_solver->get_error_controlled_time_step();
+                if(flow_solver_param.adaptive_time_step == true) {
+                    next_time_step = std::min(next_time_step, flow_solver_case->get_adaptive_time_step(dg));
+                }
+            } else if(flow_solver_param.adaptive_time_step == true) {
                 next_time_step = flow_solver_case->get_adaptive_time_step(dg);
             } else {
                 next_time_step = flow_solver_case->get_constant_time_step(dg);
             }
 
-#if PHILIP_DIM>1
             if(flow_solver_param.output_restart_files == true) {
                 // Output restart files
                 if(flow_solver_param.output_restart_files_every_dt_time_intervals > 0.0) {
@@ -533,7 +582,6 @@ int FlowSolver<dim,nstate>::run() const
                     }
                 }
             }
-#endif
 
             // Output vtk solution files for post-processing in Paraview
             if (ode_param.output_solution_every_x_steps > 0) {
@@ -575,6 +623,9 @@ int FlowSolver<dim,nstate>::run() const
                 }
             }
         } // close while
+        // complete the last restart and solution files
+        finish_restart_files();
+        dg->finish_vtk_output();
         timer.stop();
         pcout << "Timer stopped. " << std::endl;
         const double max_wall_time = dealii::Utilities::MPI::max(timer.wall_time(), this->mpi_communicator);
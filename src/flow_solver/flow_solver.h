@@ -28,6 +28,10 @@
 #include <string>
 #include <vector>
 #include <deal.II/base/parameter_handler.h>
+#include <future>
+#include <memory>
+#include <utility>
+#include "reduced_order/snapshot_file.h"
 
 namespace PHiLiP {
 namespace FlowSolver {
@@ -119,18 +123,38 @@ private:
 
     /// Writes a parameter file (.prm) for restarting the computation with
     void write_restart_parameter_file(const unsigned int restart_index_input,
-                                      const double constant_time_step_input) const;
+                                      const double constant_time_step_input,
+                                      std::ostream &restart_file) const;
 
     /// Converts a double to a string with scientific format and with full precision
     std::string double_to_string(const double value_input) const;
 
-#if PHILIP_DIM>1
-    /// Outputs all the necessary restart files
+    /// Starts writing all the necessary restart files, which are completed after the next time step
+    /** The solution is written cell by cell in the order of the cell ids with nonblocking collective MPI-IO,
+     *  such that the computation can be restarted on a different number of processes. The data table is written by the
+     *  first process on a background thread, and the parameter file once the other files are complete.
+     */
     void output_restart_files(
         const unsigned int current_restart_index,
         const double constant_time_step,
         const std::shared_ptr <dealii::TableHandler> unsteady_data_table) const;
-#endif
+
+    /// Waits until the restart files being written are complete, and writes their parameter file
+    /** Called after every time step, such that the parameter file of a restart index is written one step after its solution.
+     */
+    void finish_restart_files() const;
+
+    /// Header of the restart solution files, identifying the mesh and its polynomial degree
+    ProperOrthogonalDecomposition::SnapshotFileHeader restart_file_header;
+
+    /// Restart solution file being written
+    mutable std::unique_ptr<ProperOrthogonalDecomposition::PendingSnapshotWrite> pending_restart_solution;
+
+    /// Restart data table being written by the first process
+    mutable std::future<void> pending_restart_data_table;
+
+    /// Name and contents of the restart parameter file, written once the other restart files are complete
+    mutable std::pair<std::string, std::string> pending_restart_parameter_file;
 
     /// Performs mesh adaptation.
     /** Currently implemented for steady state flows.
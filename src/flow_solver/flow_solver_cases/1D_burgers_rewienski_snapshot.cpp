@@ -21,8 +21,9 @@ namespace PHiLiP {
 namespace FlowSolver {
 
 template <int dim, int nstate>
-BurgersRewienskiSnapshot<dim, nstate>::BurgersRewienskiSnapshot(const PHiLiP::Parameters::AllParameters *const parameters_input)
-        : FlowSolverCaseBase<dim, nstate>(parameters_input)
+BurgersRewienskiSnapshot<dim, nstate>::BurgersRewienskiSnapshot(const PHiLiP::Parameters::AllParameters *const parameters_input,
+                                                                const MPI_Comm mpi_communicator_input)
+        : FlowSolverCaseBase<dim, nstate>(parameters_input, mpi_communicator_input)
         , number_of_refinements(this->all_param.grid_refinement_study_param.num_refinements)
         , domain_left(this->all_param.flow_solver_param.grid_left_bound)
         , domain_right(this->all_param.flow_solver_param.grid_right_bound)
@@ -26,7 +26,8 @@ class BurgersRewienskiSnapshot: public FlowSolverCaseBase<dim, nstate>
 {
 public:
     /// Constructor.
-    explicit BurgersRewienskiSnapshot(const Parameters::AllParameters *const parameters_input);
+    explicit BurgersRewienskiSnapshot(const Parameters::AllParameters *const parameters_input,
+                                      const MPI_Comm mpi_communicator_input = MPI_COMM_WORLD);
 
     /// Function to generate the grid
     std::shared_ptr<Triangulation> generate_grid() const override;
@@ -4,12 +4,13 @@ namespace PHiLiP {
 namespace FlowSolver {
 
 template<int dim, int nstate>
-FlowSolverCaseBase<dim, nstate>::FlowSolverCaseBase(const PHiLiP::Parameters::AllParameters *const parameters_input)
+FlowSolverCaseBase<dim, nstate>::FlowSolverCaseBase(const PHiLiP::Parameters::AllParameters *const parameters_input,
+                                                    const MPI_Comm mpi_communicator_input)
         : initial_condition_function(InitialConditionFactory<dim, nstate, double>::create_InitialConditionFunction(parameters_input))
+        , mpi_communicator(mpi_communicator_input)
         , all_param(*parameters_input)
-        , mpi_communicator(MPI_COMM_WORLD)
-        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD))
-        , n_mpi(dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD))
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
+        , n_mpi(dealii::Utilities::MPI::n_mpi_processes(mpi_communicator))
         , pcout(std::cout, mpi_rank==0)
         {}
 
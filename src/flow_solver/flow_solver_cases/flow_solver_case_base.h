@@ -25,10 +25,15 @@ class FlowSolverCaseBase
 {
 public:
     ///Constructor
-    explicit FlowSolverCaseBase(const Parameters::AllParameters *const parameters_input);
+    /** The grid of the flow case is distributed over mpi_communicator_input.
+     */
+    explicit FlowSolverCaseBase(const Parameters::AllParameters *const parameters_input,
+                                const MPI_Comm mpi_communicator_input = MPI_COMM_WORLD);
 
     std::shared_ptr<InitialConditionFunction<dim,nstate,double>> initial_condition_function; ///< Initial condition function
 
+    const MPI_Comm mpi_communicator; ///< MPI communicator the flow case is solved on.
+
     /// Destructor
     virtual ~FlowSolverCaseBase() = default;
 
@@ -72,7 +77,6 @@ public:
 
 protected:
     const Parameters::AllParameters all_param; ///< All parameters
-    const MPI_Comm mpi_communicator; ///< MPI communicator.
     const int mpi_rank; ///< MPI rank.
     const int n_mpi; ///< Number of MPI processes.
 
@@ -13,8 +13,9 @@ namespace PHiLiP{
 namespace FlowSolver{
 
 template <int dim, int nstate>
-GaussianBump<dim, nstate>::GaussianBump(const PHiLiP::Parameters::AllParameters *const parameters_input)
-    : FlowSolverCaseBase<dim, nstate>(parameters_input)
+GaussianBump<dim, nstate>::GaussianBump(const PHiLiP::Parameters::AllParameters *const parameters_input,
+                                        const MPI_Comm mpi_communicator_input)
+    : FlowSolverCaseBase<dim, nstate>(parameters_input, mpi_communicator_input)
 {}
 
 template <int dim, int nstate>
@@ -41,7 +42,9 @@ std::shared_ptr<Triangulation> GaussianBump<dim,nstate>::generate_grid() const
     } 
     else if constexpr(dim==3) {
         const std::string mesh_filename = this->all_param.flow_solver_param.input_mesh_filename+std::string(".msh");
-        std::shared_ptr<HighOrderGrid<dim,double>> gaussian_bump_mesh = read_gmsh<dim, dim> (mesh_filename, this->all_param.do_renumber_dofs);
+        const int requested_grid_order = 0;
+        const bool use_mesh_smoothing = true;
+        std::shared_ptr<HighOrderGrid<dim,double>> gaussian_bump_mesh = read_gmsh<dim, dim> (mesh_filename, this->all_param.do_renumber_dofs, requested_grid_order, use_mesh_smoothing, this->mpi_communicator);
         return gaussian_bump_mesh->triangulation;
     }
     
@@ -53,7 +56,9 @@ void GaussianBump<dim,nstate>::set_higher_order_grid(std::shared_ptr<DGBase<dim,
 {
     if constexpr(dim==3) {
         const std::string mesh_filename = this->all_param.flow_solver_param.input_mesh_filename+std::string(".msh");
-        std::shared_ptr<HighOrderGrid<dim,double>> gaussian_bump_mesh = read_gmsh<dim, dim> (mesh_filename, this->all_param.do_renumber_dofs);
+        const int requested_grid_order = 0;
+        const bool use_mesh_smoothing = true;
+        std::shared_ptr<HighOrderGrid<dim,double>> gaussian_bump_mesh = read_gmsh<dim, dim> (mesh_filename, this->all_param.do_renumber_dofs, requested_grid_order, use_mesh_smoothing, this->mpi_communicator);
         dg->set_high_order_grid(gaussian_bump_mesh);
         for (int i=0; i<this->all_param.flow_solver_param.number_of_mesh_refinements; ++i) {
             dg->high_order_grid->refine_global();
@@ -25,7 +25,8 @@ class NACA0012 : public FlowSolverCaseBase<dim,nstate>
 #endif
 public:
     /// Constructor.
-    explicit NACA0012(const Parameters::AllParameters *const parameters_input);
+    explicit NACA0012(const Parameters::AllParameters *const parameters_input,
+                      const MPI_Comm mpi_communicator_input = MPI_COMM_WORLD);
 
     /// Function to generate the grid
     std::shared_ptr<Triangulation> generate_grid() const override;
@@ -28,7 +28,7 @@ double Periodic1DUnsteady<dim, nstate>::compute_energy(
     if(this->all_param.use_inverse_mass_on_the_fly){
         dg->apply_global_mass_matrix(dg->solution, temp);
     } else{
-        dg->global_mass_matrix.vmult(temp,dg->solution);
+        dg->apply_stored_global_mass_matrix(dg->solution, temp);
     } //replace stage_j with M*stage_j
     return temp * dg->solution;
 }
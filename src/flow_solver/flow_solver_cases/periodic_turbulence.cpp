@@ -8,6 +8,7 @@
 #include <deal.II/numerics/vector_tools.h>
 #include <deal.II/fe/fe_values.h>
 #include "physics/physics_factory.h"
+#include "physics/initial_conditions/flow_field_file.h"
 #include <deal.II/base/table_handler.h>
 #include <deal.II/base/tensor.h>
 #include "math.h"
@@ -29,6 +30,7 @@ PeriodicTurbulence<dim, nstate>::PeriodicTurbulence(const PHiLiP::Parameters::Al
         , output_velocity_field_at_fixed_times(this->all_param.flow_solver_param.output_velocity_field_at_fixed_times)
         , output_vorticity_magnitude_field_in_addition_to_velocity(this->all_param.flow_solver_param.output_vorticity_magnitude_field_in_addition_to_velocity)
         , output_flow_field_files_directory_name(this->all_param.flow_solver_param.output_flow_field_files_directory_name)
+        , output_flow_field_files_in_binary(this->all_param.flow_solver_param.output_flow_field_files_in_binary)
         , output_solution_at_exact_fixed_times(this->all_param.ode_solver_param.output_solution_at_exact_fixed_times)
 {
     // Get the flow case type
@@ -162,16 +164,24 @@ void PeriodicTurbulence<dim, nstate>::output_velocity_field(
 
     // (2) Write file
     //-------------------------------------------------------------
-    std::ofstream FILE (filename);
-    
-    // check that the file is open and write DOFs
-    if (!FILE.is_open()) {
-        this->pcout << "ERROR: Cannot open file " << filename << std::endl;
-        std::abort();
-    } else if(this->mpi_rank==0) {
-        const unsigned int number_of_degrees_of_freedom_per_state = dg->dof_handler.n_dofs()/nstate;
-        FILE << number_of_degrees_of_freedom_per_state << std::string("\n");
+    std::ofstream FILE;
+    if(!output_flow_field_files_in_binary) {
+        FILE.open(filename);
+
+        // check that the file is open and write DOFs
+        if (!FILE.is_open()) {
+            this->pcout << "ERROR: Cannot open file " << filename << std::endl;
+            std::abort();
+        } else if(this->mpi_rank==0) {
+            const unsigned int number_of_degrees_of_freedom_per_state = dg->dof_handler.n_dofs()/nstate;
+            FILE << number_of_degrees_of_freedom_per_state << std::string("\n");
+        }
     }
+    // -- values of each locally owned cell for the binary file, in the same order as the text file
+    const unsigned int n_values_per_point = 2*dim + (output_vorticity_magnitude_field_in_addition_to_velocity ? 1 : 0);
+    const unsigned int n_points_per_cell = dg->fe_collection[dg->max_degree].dofs_per_cell / nstate;
+    std::vector<dealii::CellId> cell_ids;
+    std::vector<double> binary_values;
 
     // build a basis oneD on equidistant nodes in 1D
     dealii::Quadrature<1> vol_quad_equidistant_1D = dealii::QIterated<1>(dealii::QTrapez<1>(),dg->max_degree);
@@ -198,6 +208,10 @@ void PeriodicTurbulence<dim, nstate>::output_velocity_field(
         const unsigned int n_dofs_cell = dg->fe_collection[poly_degree].dofs_per_cell;
         const unsigned int n_shape_fns = n_dofs_cell / nstate;
         const unsigned int n_quad_pts = n_shape_fns;
+        if(output_flow_field_files_in_binary && n_shape_fns != n_points_per_cell) {
+            std::cout << "ERROR: Flow field files require the same polynomial degree on every cell." << std::endl;
+            std::abort();
+        }
 
         // We first need to extract the mapping support points (grid nodes) from high_order_grid.
         const dealii::FESystem<dim> &fe_metric = dg->high_order_grid->fe_system;
@@ -298,6 +312,21 @@ void PeriodicTurbulence<dim, nstate>::output_velocity_field(
             }
         }
         // write out all values at equidistant nodes
+        if(output_flow_field_files_in_binary) {
+            cell_ids.push_back(current_cell->id());
+            for(unsigned int ishape=0; ishape<n_shape_fns; ishape++){
+                for(int idim=0; idim<dim; idim++) {
+                    binary_values.push_back(metric_oper_equid.flux_nodes_vol[idim][ishape]);
+                }
+                for (int d=0; d<dim; ++d) {
+                    binary_values.push_back(velocity_at_q[d][ishape]);
+                }
+                if(output_vorticity_magnitude_field_in_addition_to_velocity) {
+                    binary_values.push_back(vorticity_magnitude_at_q[ishape]);
+                }
+            }
+            continue;
+        }
         for(unsigned int ishape=0; ishape<n_shape_fns; ishape++){
             dealii::Point<dim,double> vol_equid_node;
             // write coordinates
@@ -316,7 +345,14 @@ void PeriodicTurbulence<dim, nstate>::output_velocity_field(
             FILE << std::string("\n"); // next line
         }
     }
-    FILE.close();
+    if(output_flow_field_files_in_binary) {
+        // -- single file for all processes, which can be read on any number of processes
+        const std::string binary_filename = output_flow_field_files_directory_name + std::string("/") + filename_prefix + std::string(".field");
+        const FlowFieldFile flow_field_file(binary_filename, this->mpi_communicator);
+        flow_field_file.write(dim, cell_ids, n_points_per_cell, n_values_per_point, binary_values);
+    } else {
+        FILE.close();
+    }
     this->pcout << "done." << std::endl;
 }
 
@@ -104,6 +104,9 @@ protected:
     /// Directory for writting flow field files
     const std::string output_flow_field_files_directory_name;
 
+    /// Flag for writing each flow field as a single binary file instead of one text file per process
+    const bool output_flow_field_files_in_binary;
+
     const bool output_solution_at_exact_fixed_times;///< Flag for outputting the solution at exact fixed times by decreasing the time step on the fly
 
     /// Pointer to Navier-Stokes physics object for computing things on the fly
@@ -15,9 +15,13 @@ class FlowSolverFactory
 {
 public:
     /// Factory to return the correct flow solver given input file.
+    /** The flow cases used for reduced-order sampling (burgers_rewienski_snapshot, naca0012 and gaussian_bump)
+     *  are solved on mpi_communicator_input, the other cases always use MPI_COMM_WORLD.
+     */
     static std::unique_ptr< FlowSolver<dim,nstate> >
         select_flow_case(const Parameters::AllParameters *const parameters_input,
-                         const dealii::ParameterHandler &parameter_handler_input);
+                         const dealii::ParameterHandler &parameter_handler_input,
+                         const MPI_Comm mpi_communicator_input = MPI_COMM_WORLD);
 
     /// Recursive factory that will create FlowSolverBase (i.e. FlowSolver<dim,nstate>)
     static std::unique_ptr< FlowSolverBase > 
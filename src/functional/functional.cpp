@@ -393,7 +393,7 @@ void Functional<dim,nstate,real,MeshType>::allocate_dIdX(dealii::LinearAlgebra::
     dealii::DoFTools::extract_locally_relevant_dofs(dg->high_order_grid->dof_handler_grid, locally_relevant_dofs);
     ghost_dofs = locally_relevant_dofs;
     ghost_dofs.subtract_set(locally_owned_dofs);
-    dIdX.reinit(locally_owned_dofs, ghost_dofs, MPI_COMM_WORLD);
+    dIdX.reinit(locally_owned_dofs, ghost_dofs, dg->mpi_communicator);
 }
 
 template <int dim, int nstate, typename real, typename MeshType>
@@ -402,7 +402,7 @@ void Functional<dim,nstate,real,MeshType>::allocate_derivatives(const bool compu
     if (compute_dIdW) {
         // allocating the vector
         dealii::IndexSet locally_owned_dofs = dg->dof_handler.locally_owned_dofs();
-        dIdw.reinit(locally_owned_dofs, MPI_COMM_WORLD);
+        dIdw.reinit(locally_owned_dofs, dg->mpi_communicator);
     }
     if (compute_dIdX) {
         allocate_dIdX(dIdX);
@@ -412,21 +412,21 @@ void Functional<dim,nstate,real,MeshType>::allocate_derivatives(const bool compu
             dealii::SparsityPattern sparsity_pattern_d2IdWdX = dg->get_d2RdWdX_sparsity_pattern ();
             const dealii::IndexSet &row_parallel_partitioning_d2IdWdX = dg->locally_owned_dofs;
             const dealii::IndexSet &col_parallel_partitioning_d2IdWdX = dg->high_order_grid->locally_owned_dofs_grid;
-            d2IdWdX->reinit(row_parallel_partitioning_d2IdWdX, col_parallel_partitioning_d2IdWdX, sparsity_pattern_d2IdWdX, MPI_COMM_WORLD);
+            d2IdWdX->reinit(row_parallel_partitioning_d2IdWdX, col_parallel_partitioning_d2IdWdX, sparsity_pattern_d2IdWdX, dg->mpi_communicator);
         }
 
         {
             dealii::SparsityPattern sparsity_pattern_d2IdWdW = dg->get_d2RdWdW_sparsity_pattern ();
             const dealii::IndexSet &row_parallel_partitioning_d2IdWdW = dg->locally_owned_dofs;
             const dealii::IndexSet &col_parallel_partitioning_d2IdWdW = dg->locally_owned_dofs;
-            d2IdWdW->reinit(row_parallel_partitioning_d2IdWdW, col_parallel_partitioning_d2IdWdW, sparsity_pattern_d2IdWdW, MPI_COMM_WORLD);
+            d2IdWdW->reinit(row_parallel_partitioning_d2IdWdW, col_parallel_partitioning_d2IdWdW, sparsity_pattern_d2IdWdW, dg->mpi_communicator);
         }
 
         {
             dealii::SparsityPattern sparsity_pattern_d2IdXdX = dg->get_d2RdXdX_sparsity_pattern ();
             const dealii::IndexSet &row_parallel_partitioning_d2IdXdX = dg->high_order_grid->locally_owned_dofs_grid;
             const dealii::IndexSet &col_parallel_partitioning_d2IdXdX = dg->high_order_grid->locally_owned_dofs_grid;
-            d2IdXdX->reinit(row_parallel_partitioning_d2IdXdX, col_parallel_partitioning_d2IdXdX, sparsity_pattern_d2IdXdX, MPI_COMM_WORLD);
+            d2IdXdX->reinit(row_parallel_partitioning_d2IdXdX, col_parallel_partitioning_d2IdXdX, sparsity_pattern_d2IdXdX, dg->mpi_communicator);
         }
     }
 }
@@ -692,102 +692,46 @@ void Functional<dim,nstate,real,MeshType>::need_compute(bool &compute_value, boo
     if (compute_value) {
         pcout << " with value...";
 
-        if (dg->solution.size() == solution_value.size() 
-            && dg->high_order_grid->volume_nodes.size() == volume_nodes_value.size()) {
-
-            auto diff_sol = dg->solution;
-            diff_sol -= solution_value;
-            const double l2_norm_sol = diff_sol.l2_norm();
-
-            if (l2_norm_sol == 0.0) {
-
-                auto diff_node = dg->high_order_grid->volume_nodes;
-                diff_node -= volume_nodes_value;
-                const double l2_norm_node = diff_node.l2_norm();
-
-                if (l2_norm_node == 0.0) {
-                    pcout << " which is already assembled...";
-                    compute_value = false;
-                }
-            }
+        if (dg->state_matches(solution_value, volume_nodes_value)) {
+            pcout << " which is already assembled...";
+            compute_value = false;
+        } else {
+            solution_value = dg->solution;
+            volume_nodes_value = dg->high_order_grid->volume_nodes;
         }
-        solution_value = dg->solution;
-        volume_nodes_value = dg->high_order_grid->volume_nodes;
     }
     if (compute_dIdW) {
         pcout << " with dIdW...";
 
-        if (dg->solution.size() == solution_dIdW.size() 
-            && dg->high_order_grid->volume_nodes.size() == volume_nodes_dIdW.size()) {
-
-            auto diff_sol = dg->solution;
-            diff_sol -= solution_dIdW;
-            const double l2_norm_sol = diff_sol.l2_norm();
-
-            if (l2_norm_sol == 0.0) {
-
-                auto diff_node = dg->high_order_grid->volume_nodes;
-                diff_node -= volume_nodes_dIdW;
-                const double l2_norm_node = diff_node.l2_norm();
-
-                if (l2_norm_node == 0.0) {
-                    pcout << " which is already assembled...";
-                    compute_dIdW = false;
-                }
-            }
+        if (dg->state_matches(solution_dIdW, volume_nodes_dIdW)) {
+            pcout << " which is already assembled...";
+            compute_dIdW = false;
+        } else {
+            solution_dIdW = dg->solution;
+            volume_nodes_dIdW = dg->high_order_grid->volume_nodes;
         }
-        solution_dIdW = dg->solution;
-        volume_nodes_dIdW = dg->high_order_grid->volume_nodes;
     }
     if (compute_dIdX) {
         pcout << " with dIdX...";
 
-        if (dg->solution.size() == solution_dIdX.size() 
-            && dg->high_order_grid->volume_nodes.size() == volume_nodes_dIdX.size()) {
-            auto diff_sol = dg->solution;
-            diff_sol -= solution_dIdX;
-            const double l2_norm_sol = diff_sol.l2_norm();
-
-            if (l2_norm_sol == 0.0) {
-
-                auto diff_node = dg->high_order_grid->volume_nodes;
-                diff_node -= volume_nodes_dIdX;
-                const double l2_norm_node = diff_node.l2_norm();
-
-                if (l2_norm_node == 0.0) {
-                    pcout << " which is already assembled...";
-                    compute_dIdX = false;
-                }
-            }
+        if (dg->state_matches(solution_dIdX, volume_nodes_dIdX)) {
+            pcout << " which is already assembled...";
+            compute_dIdX = false;
+        } else {
+            solution_dIdX = dg->solution;
+            volume_nodes_dIdX = dg->high_order_grid->volume_nodes;
         }
-        solution_dIdX = dg->solution;
-        volume_nodes_dIdX = dg->high_order_grid->volume_nodes;
     }
     if (compute_d2I) {
         pcout << " with d2IdWdW, d2IdWdX, d2IdXdX...";
 
-        if (dg->solution.size() == solution_d2I.size() 
-            && dg->high_order_grid->volume_nodes.size() == volume_nodes_d2I.size()) {
-
-            auto diff_sol = dg->solution;
-            diff_sol -= solution_d2I;
-            const double l2_norm_sol = diff_sol.l2_norm();
-
-            if (l2_norm_sol == 0.0) {
-
-                auto diff_node = dg->high_order_grid->volume_nodes;
-                diff_node -= volume_nodes_d2I;
-                const double l2_norm_node = diff_node.l2_norm();
-
-                if (l2_norm_node == 0.0) {
-
-                    pcout << " which is already assembled...";
-                    compute_d2I = false;
-                }
-            }
+        if (dg->state_matches(solution_d2I, volume_nodes_d2I)) {
+            pcout << " which is already assembled...";
+            compute_d2I = false;
+        } else {
+            solution_d2I = dg->solution;
+            volume_nodes_d2I = dg->high_order_grid->volume_nodes;
         }
-        solution_d2I = dg->solution;
-        volume_nodes_d2I = dg->high_order_grid->volume_nodes;
     }
 }
 
@@ -967,7 +911,7 @@ real Functional<dim, nstate, real, MeshType>::evaluate_functional(
         AssertDimension(i_derivative, n_total_indep);
     }
 
-    current_functional_value = dealii::Utilities::MPI::sum(local_functional, MPI_COMM_WORLD);
+    current_functional_value = dealii::Utilities::MPI::sum(local_functional, dg->mpi_communicator);
     // compress before the return
     if (actually_compute_dIdW) dIdw.compress(dealii::VectorOperation::add);
     if (actually_compute_dIdX) dIdX.compress(dealii::VectorOperation::add);
@@ -995,7 +939,7 @@ dealii::LinearAlgebra::distributed::Vector<real> Functional<dim,nstate,real,Mesh
 
     // allocating the vector
     dealii::IndexSet locally_owned_dofs = dg.dof_handler.locally_owned_dofs();
-    dIdw.reinit(locally_owned_dofs, MPI_COMM_WORLD);
+    dIdw.reinit(locally_owned_dofs, dg.mpi_communicator);
 
     // setup it mostly the same as evaluating the value (with exception that local solution is also AD)
     const unsigned int max_dofs_per_cell = dg.dof_handler.get_fe_collection().max_dofs_per_cell();
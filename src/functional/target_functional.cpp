@@ -445,7 +445,7 @@ real TargetFunctional<dim, nstate, real>::evaluate_functional(
         this->set_derivatives(actually_compute_dIdW, actually_compute_dIdX, actually_compute_d2I, volume_local_sum, cell_soln_dofs_indices, cell_metric_dofs_indices);
     }
     //std::cout << local_functional << std::endl;
-    current_functional_value = dealii::Utilities::MPI::sum(local_functional, MPI_COMM_WORLD);
+    current_functional_value = dealii::Utilities::MPI::sum(local_functional, dg->mpi_communicator);
     //std::cout << current_functional_value << std::endl;
     // compress before the return
     if (actually_compute_dIdW) dIdw.compress(dealii::VectorOperation::add);
@@ -474,7 +474,7 @@ dealii::LinearAlgebra::distributed::Vector<real> TargetFunctional<dim,nstate,rea
 
     // allocating the vector
     dealii::IndexSet locally_owned_dofs = dg.dof_handler.locally_owned_dofs();
-    dIdw.reinit(locally_owned_dofs, MPI_COMM_WORLD);
+    dIdw.reinit(locally_owned_dofs, dg.mpi_communicator);
 
     // setup it mostly the same as evaluating the value (with exception that local solution is also AD)
     const unsigned int max_dofs_per_cell = dg.dof_handler.get_fe_collection().max_dofs_per_cell();
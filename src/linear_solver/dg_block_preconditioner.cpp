@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <map>
+
+#include "dg_block_preconditioner.h"
+
+namespace PHiLiP {
+
+void DGBlockPreconditioner::initialize (
+    const dealii::TrilinosWrappers::SparseMatrix &matrix,
+    const std::vector<std::vector<dealii::types::global_dof_index>> &cell_dof_indices,
+    const Parameters::LinearSolverParam::PreconditionerEnum preconditioner_type_input,
+    const unsigned int n_gauss_seidel_sweeps_input)
+{
+    using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+    preconditioner_type = preconditioner_type_input;
+    n_gauss_seidel_sweeps = n_gauss_seidel_sweeps_input;
+    n_vmult = 0;
+
+    locally_owned_rows = matrix.locally_owned_range_indices();
+    const unsigned int n_local_rows = locally_owned_rows.n_elements();
+
+    // Local rows of each block.
+    block_rows.clear();
+    if (cell_dof_indices.empty()) {
+        block_rows.resize(n_local_rows);
+        for (unsigned int row = 0; row < n_local_rows; ++row) {
+            block_rows[row].push_back(row);
+        }
+    } else {
+        block_rows.resize(cell_dof_indices.size());
+        for (unsigned int iblock = 0; iblock < cell_dof_indices.size(); ++iblock) {
+            for (const auto &global_row : cell_dof_indices[iblock]) {
+                Assert(locally_owned_rows.is_element(global_row), dealii::ExcMessage("Cell blocks must only contain locally owned rows."));
+                block_rows[iblock].push_back(locally_owned_rows.index_within_set(global_row));
+            }
+        }
+    }
+    const unsigned int n_cell_blocks = block_rows.size();
+
+    // Block and position within the block of each local row.
+    const unsigned int invalid_block = dealii::numbers::invalid_unsigned_int;
+    std::vector<unsigned int> row_block(n_local_rows, invalid_block);
+    std::vector<unsigned int> row_index_in_block(n_local_rows);
+    for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+        for (unsigned int i = 0; i < block_rows[iblock].size(); ++i) {
+            row_block[block_rows[iblock][i]] = iblock;
+            row_index_in_block[block_rows[iblock][i]] = i;
+        }
+    }
+    Assert(std::find(row_block.begin(), row_block.end(), invalid_block) == row_block.end(),
+           dealii::ExcMessage("The cell blocks must cover all the locally owned rows."));
+
+    // Extract the dense blocks from the sparse matrix.
+    const bool store_off_diagonal = (preconditioner_type != PreconditionerEnum::block_jacobi);
+    std::vector<dealii::FullMatrix<double>> diagonal_blocks_full(n_cell_blocks);
+    neighbor_blocks.assign(n_cell_blocks, std::vector<unsigned int>());
+    off_diagonal_blocks.assign(n_cell_blocks, std::vector<dealii::FullMatrix<double>>());
+    for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+        const unsigned int n_rows = block_rows[iblock].size();
+        diagonal_blocks_full[iblock].reinit(n_rows, n_rows);
+
+        std::map<unsigned int, dealii::FullMatrix<double>> neighbors;
+        for (unsigned int i = 0; i < n_rows; ++i) {
+            const dealii::types::global_dof_index global_row = locally_owned_rows.nth_index_in_set(block_rows[iblock][i]);
+            for (auto entry = matrix.begin(global_row); entry != matrix.end(global_row); ++entry) {
+                const dealii::types::global_dof_index global_column = entry->column();
+                // Couplings to other processes are dropped.
+                if (!locally_owned_rows.is_element(global_column)) continue;
+
+                const unsigned int local_column = locally_owned_rows.index_within_set(global_column);
+                const unsigned int jblock = row_block[local_column];
+                const unsigned int j = row_index_in_block[local_column];
+                if (jblock == iblock) {
+                    diagonal_blocks_full[iblock](i,j) = entry->value();
+                } else if (store_off_diagonal) {
+                    auto neighbor = neighbors.find(jblock);
+                    if (neighbor == neighbors.end()) {
+                        neighbor = neighbors.emplace(jblock, dealii::FullMatrix<double>(n_rows, block_rows[jblock].size())).first;
+                    }
+                    neighbor->second(i,j) = entry->value();
+                }
+            }
+        }
+        for (auto &neighbor : neighbors) {
+            neighbor_blocks[iblock].push_back(neighbor.first);
+            off_diagonal_blocks[iblock].push_back(std::move(neighbor.second));
+        }
+    }
+
+    // LAPACKFullMatrix::operator= does not resize, so each block is sized before the copy.
+    diagonal_blocks.resize(n_cell_blocks);
+    if (preconditioner_type == PreconditionerEnum::block_ilu0) {
+        // Block ILU(0) in IKJ order, where the updates are restricted to the existing cell couplings.
+        dealii::FullMatrix<double> update;
+        for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+            const std::vector<unsigned int> &i_neighbors = neighbor_blocks[iblock];
+            for (unsigned int ik = 0; ik < i_neighbors.size() && i_neighbors[ik] < iblock; ++ik) {
+                const unsigned int kblock = i_neighbors[ik];
+                const dealii::FullMatrix<double> &lower_ik = off_diagonal_blocks[iblock][ik];
+
+                const std::vector<unsigned int> &k_neighbors = neighbor_blocks[kblock];
+                const auto k_upper_begin = std::upper_bound(k_neighbors.begin(), k_neighbors.end(), kblock);
+                for (auto kj = k_upper_begin; kj != k_neighbors.end(); ++kj) {
+                    const unsigned int jblock = *kj;
+                    dealii::FullMatrix<double> *target = nullptr;
+                    if (jblock == iblock) {
+                        target = &diagonal_blocks_full[iblock];
+                    } else {
+                        const auto ij = std::lower_bound(i_neighbors.begin(), i_neighbors.end(), jblock);
+                        // Fill outside of the cell graph is dropped.
+                        if (ij == i_neighbors.end() || *ij != jblock) continue;
+                        target = &off_diagonal_blocks[iblock][ij - i_neighbors.begin()];
+                    }
+                    const dealii::FullMatrix<double> &upper_kj = off_diagonal_blocks[kblock][kj - k_neighbors.begin()];
+                    update.reinit(lower_ik.m(), upper_kj.n());
+                    lower_ik.mmult(update, upper_kj);
+                    target->add(-1.0, update);
+                }
+            }
+
+            diagonal_blocks[iblock].reinit(block_rows[iblock].size());
+            diagonal_blocks[iblock] = diagonal_blocks_full[iblock];
+            diagonal_blocks[iblock].compute_lu_factorization();
+
+            // Premultiply the upper blocks by the inverse diagonal block.
+            const auto i_upper_begin = std::upper_bound(i_neighbors.begin(), i_neighbors.end(), iblock);
+            for (auto ij = i_upper_begin; ij != i_neighbors.end(); ++ij) {
+                dealii::FullMatrix<double> &upper_ij = off_diagonal_blocks[iblock][ij - i_neighbors.begin()];
+                dealii::Vector<double> column(upper_ij.m());
+                for (unsigned int j = 0; j < upper_ij.n(); ++j) {
+                    for (unsigned int i = 0; i < upper_ij.m(); ++i) column(i) = upper_ij(i,j);
+                    diagonal_blocks[iblock].solve(column);
+                    for (unsigned int i = 0; i < upper_ij.m(); ++i) upper_ij(i,j) = column(i);
+                }
+            }
+        }
+    } else {
+        for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+            diagonal_blocks[iblock].reinit(block_rows[iblock].size());
+            diagonal_blocks[iblock] = diagonal_blocks_full[iblock];
+            diagonal_blocks[iblock].compute_lu_factorization();
+        }
+    }
+
+    block_rhs.resize(n_cell_blocks);
+    block_solution.resize(n_cell_blocks);
+    for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+        block_rhs[iblock].reinit(block_rows[iblock].size());
+        block_solution[iblock].reinit(block_rows[iblock].size());
+    }
+}
+
+void DGBlockPreconditioner::vmult (VectorType &dst, const VectorType &src) const
+{
+    using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+    ++n_vmult;
+
+    // Gathering all the blocks first allows dst and src to be the same vector.
+    for (unsigned int iblock = 0; iblock < block_rows.size(); ++iblock) {
+        for (unsigned int i = 0; i < block_rows[iblock].size(); ++i) {
+            block_rhs[iblock](i) = src.local_element(block_rows[iblock][i]);
+        }
+    }
+
+    if (preconditioner_type == PreconditionerEnum::block_ilu0) {
+        vmult_block_ilu0();
+    } else if (preconditioner_type == PreconditionerEnum::block_gauss_seidel) {
+        vmult_block_gauss_seidel();
+    } else {
+        for (unsigned int iblock = 0; iblock < block_rows.size(); ++iblock) {
+            block_solution[iblock] = block_rhs[iblock];
+            solve_diagonal_block(iblock, block_solution[iblock]);
+        }
+    }
+
+    for (unsigned int iblock = 0; iblock < block_rows.size(); ++iblock) {
+        for (unsigned int i = 0; i < block_rows[iblock].size(); ++i) {
+            dst.local_element(block_rows[iblock][i]) = block_solution[iblock](i);
+        }
+    }
+}
+
+void DGBlockPreconditioner::vmult_block_ilu0 () const
+{
+    const unsigned int n_cell_blocks = block_rows.size();
+    dealii::Vector<double> product;
+
+    // Forward substitution with the lower factor and the diagonal blocks.
+    for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+        dealii::Vector<double> &solution_i = block_solution[iblock];
+        solution_i = block_rhs[iblock];
+        const std::vector<unsigned int> &i_neighbors = neighbor_blocks[iblock];
+        for (unsigned int ik = 0; ik < i_neighbors.size() && i_neighbors[ik] < iblock; ++ik) {
+            product.reinit(solution_i.size(), true);
+            off_diagonal_blocks[iblock][ik].vmult(product, block_solution[i_neighbors[ik]]);
+            solution_i -= product;
+        }
+        solve_diagonal_block(iblock, solution_i);
+    }
+
+    // Backward substitution with the scaled upper factor.
+    for (unsigned int iblock = n_cell_blocks; iblock-- > 0;) {
+        dealii::Vector<double> &solution_i = block_solution[iblock];
+        const std::vector<unsigned int> &i_neighbors = neighbor_blocks[iblock];
+        const auto i_upper_begin = std::upper_bound(i_neighbors.begin(), i_neighbors.end(), iblock);
+        for (auto ij = i_upper_begin; ij != i_neighbors.end(); ++ij) {
+            product.reinit(solution_i.size(), true);
+            off_diagonal_blocks[iblock][ij - i_neighbors.begin()].vmult(product, block_solution[*ij]);
+            solution_i -= product;
+        }
+    }
+}
+
+void DGBlockPreconditioner::vmult_block_gauss_seidel () const
+{
+    const unsigned int n_cell_blocks = block_rows.size();
+    dealii::Vector<double> product;
+
+    for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+        block_solution[iblock] = 0.0;
+    }
+
+    const auto relax_block = [&](const unsigned int iblock) {
+        dealii::Vector<double> &solution_i = block_solution[iblock];
+        solution_i = block_rhs[iblock];
+        const std::vector<unsigned int> &i_neighbors = neighbor_blocks[iblock];
+        for (unsigned int ij = 0; ij < i_neighbors.size(); ++ij) {
+            product.reinit(solution_i.size(), true);
+            off_diagonal_blocks[iblock][ij].vmult(product, block_solution[i_neighbors[ij]]);
+            solution_i -= product;
+        }
+        solve_diagonal_block(iblock, solution_i);
+    };
+
+    for (unsigned int isweep = 0; isweep < n_gauss_seidel_sweeps; ++isweep) {
+        for (unsigned int iblock = 0; iblock < n_cell_blocks; ++iblock) {
+            relax_block(iblock);
+        }
+        for (unsigned int iblock = n_cell_blocks; iblock-- > 0;) {
+            relax_block(iblock);
+        }
+    }
+}
+
+void DGBlockPreconditioner::solve_diagonal_block (const unsigned int iblock, dealii::Vector<double> &block_vector) const
+{
+    diagonal_blocks[iblock].solve(block_vector);
+}
+
+unsigned int DGBlockPreconditioner::n_blocks() const
+{
+    return block_rows.size();
+}
+
+unsigned int DGBlockPreconditioner::n_applications() const
+{
+    return n_vmult;
+}
+
+} // PHiLiP namespace
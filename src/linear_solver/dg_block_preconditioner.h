@@ -0,0 +1,102 @@
+#ifndef __DG_BLOCK_PRECONDITIONER_H__
+#define __DG_BLOCK_PRECONDITIONER_H__
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <vector>
+
+#include "parameters/parameters_linear_solver.h"
+
+namespace PHiLiP {
+
+/// Preconditioners exploiting the dense cell blocks of DG Jacobians.
+/** The Jacobian is viewed as a sparse matrix of dense blocks, where block (I,J)
+ *  couples the degrees of freedom of cells I and J. Each diagonal block is factored
+ *  with a dense LU decomposition and is applied exactly.
+ *
+ *  Available types:
+ *  - block_jacobi: inverse of the diagonal blocks.
+ *  - block_ilu0: block ILU(0) on the cell graph, i.e. without fill outside of the
+ *    neighbouring cells.
+ *  - block_gauss_seidel: symmetric block Gauss-Seidel sweeps starting from a zero guess.
+ *
+ *  Only the couplings between locally owned cells are used, such that the preconditioner
+ *  is block Jacobi across processes and no communication is required to apply it.
+ *  If no cells are provided, every row is treated as its own block.
+ */
+class DGBlockPreconditioner
+{
+public:
+    /// Vector type the preconditioner is applied to.
+    using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
+    /// Extracts the cell blocks from the matrix and factors them.
+    /** @param cell_dof_indices Degrees of freedom of each locally owned cell. The cell order is the
+     *  order of the block ILU(0) factorization and of the Gauss-Seidel sweeps.
+     */
+    void initialize (
+        const dealii::TrilinosWrappers::SparseMatrix &matrix,
+        const std::vector<std::vector<dealii::types::global_dof_index>> &cell_dof_indices,
+        const Parameters::LinearSolverParam::PreconditionerEnum preconditioner_type,
+        const unsigned int n_gauss_seidel_sweeps = 1);
+
+    /// Applies the preconditioner dst = P^{-1} src.
+    void vmult (VectorType &dst, const VectorType &src) const;
+
+    /// Number of cell blocks stored on this process.
+    unsigned int n_blocks() const;
+
+    /// Number of times the preconditioner has been applied since initialize().
+    unsigned int n_applications() const;
+
+protected:
+    /// Solves the factored diagonal block of a cell in place.
+    void solve_diagonal_block (const unsigned int iblock, dealii::Vector<double> &block_vector) const;
+
+    /// Applies the block ILU(0) factors.
+    void vmult_block_ilu0 () const;
+
+    /// Applies the symmetric block Gauss-Seidel sweeps.
+    void vmult_block_gauss_seidel () const;
+
+    /// Type of preconditioner.
+    Parameters::LinearSolverParam::PreconditionerEnum preconditioner_type;
+
+    /// Number of symmetric Gauss-Seidel sweeps.
+    unsigned int n_gauss_seidel_sweeps;
+
+    /// Rows owned by this process.
+    dealii::IndexSet locally_owned_rows;
+
+    /// Index of each block's rows within the locally owned rows.
+    std::vector<std::vector<unsigned int>> block_rows;
+
+    /// LU factorization of the diagonal blocks.
+    std::vector<dealii::LAPACKFullMatrix<double>> diagonal_blocks;
+
+    /// Neighbouring blocks of each block, in increasing order.
+    std::vector<std::vector<unsigned int>> neighbor_blocks;
+
+    /// Off-diagonal blocks, ordered as neighbor_blocks.
+    /** For the block ILU(0), blocks below the diagonal hold the L factor
+     *  and blocks above the diagonal hold the U factor premultiplied by the inverse diagonal block.
+     */
+    std::vector<std::vector<dealii::FullMatrix<double>>> off_diagonal_blocks;
+
+    /// Right-hand side of each block.
+    mutable std::vector<dealii::Vector<double>> block_rhs;
+    /// Solution of each block.
+    mutable std::vector<dealii::Vector<double>> block_solution;
+
+    /// Number of applications since initialize().
+    mutable unsigned int n_vmult = 0;
+};
+
+} // PHiLiP namespace
+
+#endif
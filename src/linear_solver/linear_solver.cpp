@@ -9,7 +9,13 @@
 
 #include <deal.II/lac/solver_gmres.h>
 
+#include <deal.II/base/timer.h>
+
+#include <string>
+
 #include "linear_solver.h"
+#include "dg_block_preconditioner.h"
+#include "p_multigrid_preconditioner.h"
 
 #include "global_counter.hpp"
 
@@ -163,6 +169,106 @@ solve_linear3 (
 
 }
 
+template <typename PreconditionerType>
+std::pair<unsigned int, double>
+solve_linear_deal_ii_gmres (
+    const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param,
+    const PreconditionerType &preconditioner,
+    const std::string &preconditioner_description,
+    const double preconditioner_setup_time)
+{
+    dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+
+    const double rhs_norm = right_hand_side.l2_norm();
+    const double linear_residual_tolerance = param.linear_residual * rhs_norm;
+    const int max_iterations = param.max_iterations;
+    pcout << " Solving linear system with max_iterations = " << max_iterations
+          << " and linear residual tolerance: " << linear_residual_tolerance << std::endl;
+
+    const bool log_history = (param.linear_solver_output == Parameters::OutputEnum::verbose);
+    const bool log_result = false;
+    dealii::SolverControl solver_control(max_iterations, linear_residual_tolerance, log_history, log_result);
+
+    const bool right_preconditioning = true;
+    using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+    typedef typename dealii::SolverGMRES<VectorType>::AdditionalData AddiData_GMRES;
+    AddiData_GMRES add_data_gmres(param.restart_number, right_preconditioning);
+    dealii::SolverGMRES<VectorType> solver_gmres(solver_control, add_data_gmres);
+
+    dealii::Timer solve_timer;
+    solution *= 0.0;
+    try {
+        solver_gmres.solve(system_matrix, solution, right_hand_side, preconditioner);
+    } catch (const dealii::SolverControl::NoConvergence &) {
+        // Same as the AztecOO solver, the unconverged solution is returned.
+        pcout << " Linear solver did not converge within " << max_iterations << " iterations." << std::endl;
+    }
+    solve_timer.stop();
+
+    pcout << " " << preconditioner_description << " took " << preconditioner_setup_time << "s to set up." << std::endl
+          << " Linear solver took " << solver_control.last_step()
+          << " iterations and " << preconditioner.n_applications() << " preconditioner applications in "
+          << solve_timer.wall_time() << "s resulting in a linear residual of " << solver_control.last_value() << std::endl
+          << " Current RHS norm: " << rhs_norm
+          << " Linear solution norm: " << solution.l2_norm() << std::endl;
+
+    n_vmult += solver_control.last_step();
+    dRdW_mult += solver_control.last_step();
+
+    return {solver_control.last_step(), solver_control.last_value()};
+}
+
+std::pair<unsigned int, double>
+solve_linear_block_preconditioned (
+    const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<dealii::types::global_dof_index>> &cell_dof_indices)
+{
+    using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+    // Without polynomial levels, p-multigrid reduces to its fine-level smoother.
+    const bool is_p_multigrid_without_levels = (param.preconditioner_type == PreconditionerEnum::p_multigrid);
+    if (is_p_multigrid_without_levels) {
+        dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+        pcout << " Warning: the p-multigrid preconditioner requires the polynomial levels of the discretization, "
+              << "which this linear solve does not provide. Using the block Jacobi preconditioner instead." << std::endl;
+    }
+    const PreconditionerEnum preconditioner_type = is_p_multigrid_without_levels
+                                                   ? PreconditionerEnum::block_jacobi
+                                                   : param.preconditioner_type;
+
+    dealii::Timer setup_timer;
+    DGBlockPreconditioner preconditioner;
+    preconditioner.initialize(system_matrix, cell_dof_indices, preconditioner_type, param.block_gauss_seidel_sweeps);
+    setup_timer.stop();
+
+    const std::string description = "Block preconditioner with "
+                                    + std::to_string(dealii::Utilities::MPI::sum(preconditioner.n_blocks(), system_matrix.get_mpi_communicator()))
+                                    + " cell blocks";
+    return solve_linear_deal_ii_gmres(system_matrix, right_hand_side, solution, param, preconditioner, description, setup_timer.wall_time());
+}
+
+std::pair<unsigned int, double>
+solve_linear_p_multigrid (
+    const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param,
+    const PMultigridHierarchy &hierarchy)
+{
+    dealii::Timer setup_timer;
+    PMultigridPreconditioner preconditioner;
+    preconditioner.initialize(system_matrix, hierarchy, param);
+    setup_timer.stop();
+
+    const std::string description = "p-multigrid preconditioner with " + std::to_string(preconditioner.n_levels()) + " levels";
+    return solve_linear_deal_ii_gmres(system_matrix, right_hand_side, solution, param, preconditioner, description, setup_timer.wall_time());
+}
+
 std::pair<unsigned int, double>
 solve_linear (
     const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
@@ -170,6 +276,33 @@ solve_linear (
     dealii::LinearAlgebra::distributed::Vector<double> &solution,
     const Parameters::LinearSolverParam &param)
 {
+    const std::vector<std::vector<dealii::types::global_dof_index>> no_cell_blocks;
+    return solve_linear(system_matrix, right_hand_side, solution, param, no_cell_blocks);
+}
+
+std::pair<unsigned int, double>
+solve_linear (
+    const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param,
+    const PMultigridHierarchy &hierarchy)
+{
+    if (param.linear_solver_type == Parameters::LinearSolverParam::LinearSolverEnum::gmres
+        && param.preconditioner_type == Parameters::LinearSolverParam::PreconditionerEnum::p_multigrid) {
+        return solve_linear_p_multigrid(system_matrix, right_hand_side, solution, param, hierarchy);
+    }
+    return solve_linear(system_matrix, right_hand_side, solution, param, hierarchy.level_cell_dof_indices.back());
+}
+
+std::pair<unsigned int, double>
+solve_linear (
+    const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<dealii::types::global_dof_index>> &cell_dof_indices)
+{
 
     // if (pcout.is_active()) system_matrix.print(pcout.get_stream(), true);
     // if (pcout.is_active()) solution.print(pcout.get_stream());
@@ -195,6 +328,9 @@ solve_linear (
 
         direct.solve(system_matrix, solution, right_hand_side);
         return {solver_control.last_step(), solver_control.last_value()};
+    } else if (param.linear_solver_type == gmres_type
+               && param.preconditioner_type != Parameters::LinearSolverParam::PreconditionerEnum::ilut) {
+        return solve_linear_block_preconditioned(system_matrix, right_hand_side, solution, param, cell_dof_indices);
     } else if (param.linear_solver_type == gmres_type) {
         //solution = right_hand_side;
         //solution *= 1e-3;
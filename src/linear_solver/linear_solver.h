@@ -4,6 +4,9 @@
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 #include <deal.II/lac/la_parallel_vector.h>
 #include "parameters/all_parameters.h"
+#include "p_multigrid_preconditioner.h"
+
+#include <vector>
 
 namespace PHiLiP {
 
@@ -18,6 +21,26 @@ namespace PHiLiP {
                        dealii::LinearAlgebra::distributed::Vector<double> &solution,
                        const Parameters::LinearSolverParam &param);
 
+    /// Same as above, where the degrees of freedom of the locally owned cells
+    /// define the dense blocks of the DG block preconditioners.
+    /** Without cell blocks, the block preconditioners treat every row as a block.
+     */
+    std::pair<unsigned int, double>
+        solve_linear ( const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+                       dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+                       dealii::LinearAlgebra::distributed::Vector<double> &solution,
+                       const Parameters::LinearSolverParam &param,
+                       const std::vector<std::vector<dealii::types::global_dof_index>> &cell_dof_indices);
+
+    /// Same as above, where the polynomial levels of the DG discretization
+    /// are available to the p-multigrid preconditioner.
+    std::pair<unsigned int, double>
+        solve_linear ( const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+                       dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+                       dealii::LinearAlgebra::distributed::Vector<double> &solution,
+                       const Parameters::LinearSolverParam &param,
+                       const PMultigridHierarchy &hierarchy);
+
     std::pair<unsigned int, double>
     solve_linear_2 ( const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
                    const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
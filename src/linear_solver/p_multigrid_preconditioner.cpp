@@ -0,0 +1,168 @@
+#include <array>
+
+#include "p_multigrid_preconditioner.h"
+
+namespace PHiLiP {
+
+void PMultigridPreconditioner::initialize (
+    const dealii::TrilinosWrappers::SparseMatrix &fine_matrix_input,
+    const PMultigridHierarchy &hierarchy,
+    const Parameters::LinearSolverParam &param)
+{
+    using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+    using CycleEnum = Parameters::LinearSolverParam::PMultigridCycleEnum;
+    using CoarseSolverEnum = Parameters::LinearSolverParam::PMultigridCoarseSolverEnum;
+
+    Assert(hierarchy.n_levels() >= 1, dealii::ExcMessage("The p-multigrid hierarchy needs at least one level."));
+    AssertDimension(hierarchy.prolongations.size() + 1, hierarchy.n_levels());
+
+    fine_matrix = &fine_matrix_input;
+    prolongations = hierarchy.prolongations;
+    smoother_type = param.p_multigrid_smoother_type;
+    n_cycles_per_level = (param.p_multigrid_cycle_type == CycleEnum::w_cycle) ? 2 : 1;
+    n_smoothing_steps = param.p_multigrid_smoothing_steps;
+    smoother_relaxation = param.p_multigrid_smoother_relaxation;
+    n_coarse_iterations = param.p_multigrid_coarse_iterations;
+    n_vmult = 0;
+
+    const unsigned int n_levels = hierarchy.n_levels();
+
+    // Galerkin coarse operators, from the finest to the coarsest level.
+    coarse_matrices.assign(n_levels - 1, nullptr);
+    for (unsigned int level = n_levels - 1; level-- > 0;) {
+        const dealii::TrilinosWrappers::SparseMatrix &prolongation = *prolongations[level];
+        dealii::TrilinosWrappers::SparseMatrix matrix_times_prolongation;
+        level_matrix(level+1).mmult(matrix_times_prolongation, prolongation);
+        coarse_matrices[level] = std::make_shared<dealii::TrilinosWrappers::SparseMatrix>();
+        prolongation.Tmmult(*coarse_matrices[level], matrix_times_prolongation);
+    }
+
+    block_jacobi.resize(n_levels);
+    for (unsigned int level = 1; level < n_levels; ++level) {
+        block_jacobi[level].initialize(level_matrix(level), hierarchy.level_cell_dof_indices[level], PreconditionerEnum::block_jacobi);
+    }
+
+    const dealii::TrilinosWrappers::SparseMatrix &coarse_matrix = level_matrix(0);
+    if (param.p_multigrid_coarse_solver_type == CoarseSolverEnum::amg) {
+        dealii::TrilinosWrappers::PreconditionAMG::AdditionalData amg_data;
+        amg_data.elliptic = false;
+        std::shared_ptr<dealii::TrilinosWrappers::PreconditionAMG> amg = std::make_shared<dealii::TrilinosWrappers::PreconditionAMG>();
+        amg->initialize(coarse_matrix, amg_data);
+        coarse_preconditioner = amg;
+    } else {
+        using AdditionalData = dealii::TrilinosWrappers::PreconditionILU::AdditionalData;
+        const unsigned int ilu_fill = 0;
+        const unsigned int overlap = 1;
+        std::shared_ptr<dealii::TrilinosWrappers::PreconditionILU> ilu = std::make_shared<dealii::TrilinosWrappers::PreconditionILU>();
+        ilu->initialize(coarse_matrix, AdditionalData(ilu_fill, param.ilut_atol, param.ilut_rtol, overlap));
+        coarse_preconditioner = ilu;
+    }
+
+    level_rhs.resize(n_levels);
+    level_solution.resize(n_levels);
+    level_residual.resize(n_levels);
+    level_correction.resize(n_levels);
+    for (unsigned int level = 0; level < n_levels; ++level) {
+        const dealii::IndexSet &locally_owned_dofs = level_matrix(level).locally_owned_range_indices();
+        const MPI_Comm mpi_communicator = level_matrix(level).get_mpi_communicator();
+        level_rhs[level].reinit(locally_owned_dofs, mpi_communicator);
+        level_solution[level].reinit(locally_owned_dofs, mpi_communicator);
+        level_residual[level].reinit(locally_owned_dofs, mpi_communicator);
+        level_correction[level].reinit(locally_owned_dofs, mpi_communicator);
+    }
+}
+
+const dealii::TrilinosWrappers::SparseMatrix &PMultigridPreconditioner::level_matrix (const unsigned int level) const
+{
+    if (level == coarse_matrices.size()) return *fine_matrix;
+    return *coarse_matrices[level];
+}
+
+void PMultigridPreconditioner::vmult (VectorType &dst, const VectorType &src) const
+{
+    ++n_vmult;
+    const unsigned int fine_level = level_rhs.size() - 1;
+    level_rhs[fine_level] = src;
+    level_solution[fine_level] = 0.0;
+    cycle(fine_level);
+    dst = level_solution[fine_level];
+}
+
+void PMultigridPreconditioner::cycle (const unsigned int level) const
+{
+    if (level == 0) {
+        coarse_solve();
+        return;
+    }
+
+    smooth(level, n_smoothing_steps);
+
+    // Restrict the residual and solve for the coarse correction.
+    compute_residual(level);
+    const dealii::TrilinosWrappers::SparseMatrix &prolongation = *prolongations[level-1];
+    prolongation.Tvmult(level_rhs[level-1], level_residual[level]);
+    level_solution[level-1] = 0.0;
+    for (unsigned int icycle = 0; icycle < n_cycles_per_level; ++icycle) {
+        cycle(level-1);
+    }
+
+    // Prolongate the coarse correction.
+    prolongation.vmult(level_correction[level], level_solution[level-1]);
+    level_solution[level] += level_correction[level];
+
+    smooth(level, n_smoothing_steps);
+}
+
+void PMultigridPreconditioner::smooth (const unsigned int level, const unsigned int n_steps) const
+{
+    using SmootherEnum = Parameters::LinearSolverParam::PMultigridSmootherEnum;
+
+    VectorType &solution = level_solution[level];
+    VectorType &correction = level_correction[level];
+    if (smoother_type == SmootherEnum::runge_kutta) {
+        // Four-stage scheme, where each stage is a block-Jacobi preconditioned pseudo-time step from the initial state.
+        const std::array<double,4> stage_coefficients {{ 0.25, 1.0/3.0, 0.5, 1.0 }};
+        for (unsigned int istep = 0; istep < n_steps; ++istep) {
+            const VectorType solution_at_step_start = solution;
+            for (const double stage_coefficient : stage_coefficients) {
+                compute_residual(level);
+                block_jacobi[level].vmult(correction, level_residual[level]);
+                solution = solution_at_step_start;
+                solution.add(stage_coefficient * smoother_relaxation, correction);
+            }
+        }
+    } else {
+        for (unsigned int istep = 0; istep < n_steps; ++istep) {
+            compute_residual(level);
+            block_jacobi[level].vmult(correction, level_residual[level]);
+            solution.add(smoother_relaxation, correction);
+        }
+    }
+}
+
+void PMultigridPreconditioner::coarse_solve () const
+{
+    for (unsigned int iteration = 0; iteration < n_coarse_iterations; ++iteration) {
+        compute_residual(0);
+        coarse_preconditioner->vmult(level_correction[0], level_residual[0]);
+        level_solution[0] += level_correction[0];
+    }
+}
+
+void PMultigridPreconditioner::compute_residual (const unsigned int level) const
+{
+    level_matrix(level).vmult(level_residual[level], level_solution[level]);
+    level_residual[level].sadd(-1.0, 1.0, level_rhs[level]);
+}
+
+unsigned int PMultigridPreconditioner::n_levels() const
+{
+    return level_rhs.size();
+}
+
+unsigned int PMultigridPreconditioner::n_applications() const
+{
+    return n_vmult;
+}
+
+} // PHiLiP namespace
@@ -0,0 +1,115 @@
+#ifndef __P_MULTIGRID_PRECONDITIONER_H__
+#define __P_MULTIGRID_PRECONDITIONER_H__
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/trilinos_precondition.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <memory>
+#include <vector>
+
+#include "parameters/parameters_linear_solver.h"
+#include "dg_block_preconditioner.h"
+
+namespace PHiLiP {
+
+/// Polynomial levels of a DG discretization used by the p-multigrid preconditioner.
+/** Level 0 is the coarsest polynomial degree and the last level is the discretization itself.
+ *  See DGBase::build_p_multigrid_hierarchy().
+ */
+struct PMultigridHierarchy
+{
+    /// Prolongation from level l to level l+1, stored at index l.
+    /** Rows are the DoFs of level l+1 and columns are the DoFs of level l.
+     *  The restriction is its transpose.
+     */
+    std::vector<std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix>> prolongations;
+
+    /// Degrees of freedom of each locally owned cell on each level, from coarsest to finest.
+    std::vector<std::vector<std::vector<dealii::types::global_dof_index>>> level_cell_dof_indices;
+
+    /// Number of levels.
+    unsigned int n_levels() const { return level_cell_dof_indices.size(); }
+};
+
+/// p-multigrid V- or W-cycle preconditioner for the DG Jacobian.
+/** The coarse operators are formed algebraically through the Galerkin product
+ *  \f$ A_{l} = P_l^T A_{l+1} P_l \f$, such that the residual is only ever assembled at the finest degree.
+ *  The fine levels are smoothed by damped cell-block Jacobi iterations or by block-Jacobi preconditioned
+ *  multistage Runge-Kutta iterations. The coarsest level is approximately solved with a few
+ *  Richardson iterations preconditioned with ILU or AMG.
+ *
+ *  All the operations are linear and fixed, such that the preconditioner can be used with standard GMRES.
+ */
+class PMultigridPreconditioner
+{
+public:
+    /// Vector type the preconditioner is applied to.
+    using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
+    /// Builds the coarse operators, the smoothers and the coarse solver.
+    /** The fine matrix must remain valid while the preconditioner is in use.
+     */
+    void initialize (
+        const dealii::TrilinosWrappers::SparseMatrix &fine_matrix,
+        const PMultigridHierarchy &hierarchy,
+        const Parameters::LinearSolverParam &param);
+
+    /// Applies one multigrid cycle to src with a zero initial guess.
+    void vmult (VectorType &dst, const VectorType &src) const;
+
+    /// Number of levels.
+    unsigned int n_levels() const;
+
+    /// Number of times the preconditioner has been applied since initialize().
+    unsigned int n_applications() const;
+
+protected:
+    /// Recursive multigrid cycle on a level, improving level_solution from level_rhs.
+    void cycle (const unsigned int level) const;
+
+    /// Applies the smoother on a level.
+    void smooth (const unsigned int level, const unsigned int n_steps) const;
+
+    /// Approximately solves the coarsest level.
+    void coarse_solve () const;
+
+    /// Computes level_residual = level_rhs - A*level_solution.
+    void compute_residual (const unsigned int level) const;
+
+    /// Matrix of a level.
+    const dealii::TrilinosWrappers::SparseMatrix &level_matrix (const unsigned int level) const;
+
+    /// Finest level matrix.
+    const dealii::TrilinosWrappers::SparseMatrix *fine_matrix = nullptr;
+
+    /// Galerkin coarse matrices of all levels but the finest.
+    std::vector<std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix>> coarse_matrices;
+
+    /// Prolongations between the levels.
+    std::vector<std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix>> prolongations;
+
+    /// Cell-block Jacobi of each level above the coarsest, used by the smoothers.
+    std::vector<DGBlockPreconditioner> block_jacobi;
+
+    /// ILU or AMG preconditioner of the coarsest level.
+    std::shared_ptr<dealii::TrilinosWrappers::PreconditionBase> coarse_preconditioner;
+
+    Parameters::LinearSolverParam::PMultigridSmootherEnum smoother_type; ///< Smoother of the fine levels.
+    unsigned int n_cycles_per_level; ///< 1 for a V-cycle, 2 for a W-cycle.
+    unsigned int n_smoothing_steps; ///< Number of pre- and post-smoothing steps.
+    double smoother_relaxation; ///< Damping of the smoother updates.
+    unsigned int n_coarse_iterations; ///< Number of preconditioned Richardson iterations on the coarsest level.
+
+    mutable std::vector<VectorType> level_rhs; ///< Right-hand side of each level.
+    mutable std::vector<VectorType> level_solution; ///< Solution of each level.
+    mutable std::vector<VectorType> level_residual; ///< Residual of each level.
+    mutable std::vector<VectorType> level_correction; ///< Smoother and coarse-level corrections of each level.
+
+    /// Number of applications since initialize().
+    mutable unsigned int n_vmult = 0;
+};
+
+} // PHiLiP namespace
+
+#endif
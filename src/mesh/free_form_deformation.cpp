@@ -22,11 +22,13 @@ template<int dim>
 FreeFormDeformation<dim>::FreeFormDeformation (
         const dealii::Point<dim> &_origin,
         const std::array<dealii::Tensor<1,dim,double>,dim> _parallepiped_vectors,
-        const std::array<unsigned int,dim> &_ndim_control_pts)
+        const std::array<unsigned int,dim> &_ndim_control_pts,
+        const MeshMovementPreconditionerEnum _mesh_movement_preconditioner_type)
         : origin(_origin)
         , parallepiped_vectors(_parallepiped_vectors)
         , ndim_control_pts(_ndim_control_pts)
         , n_control_pts(compute_total_ctl_pts())
+        , mesh_movement_preconditioner_type(_mesh_movement_preconditioner_type)
         , pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
 { 
     control_pts.resize(n_control_pts);
@@ -49,8 +51,9 @@ template<int dim>
 FreeFormDeformation<dim>::FreeFormDeformation (
         const dealii::Point<dim> &_origin,
         const std::array<double,dim> &rectangle_lengths,
-        const std::array<unsigned int,dim> &_ndim_control_pts)
-    : FreeFormDeformation (_origin, get_rectangular_parallepiped_vectors(rectangle_lengths), _ndim_control_pts)
+        const std::array<unsigned int,dim> &_ndim_control_pts,
+        const MeshMovementPreconditionerEnum _mesh_movement_preconditioner_type)
+    : FreeFormDeformation (_origin, get_rectangular_parallepiped_vectors(rectangle_lengths), _ndim_control_pts, _mesh_movement_preconditioner_type)
 { }
 
 template<int dim>
@@ -347,7 +350,8 @@ void FreeFormDeformation<dim>
           high_order_grid.initial_mapping_fe_field,
           high_order_grid.dof_handler_grid,
           high_order_grid.surface_to_volume_indices,
-          surface_node_displacements);
+          surface_node_displacements,
+          mesh_movement_preconditioner_type);
     dealii::LinearAlgebra::distributed::Vector<double> volume_displacements = meshmover.get_volume_displacements();
     high_order_grid.volume_nodes = high_order_grid.initial_volume_nodes;
     high_order_grid.volume_nodes += volume_displacements;
@@ -568,7 +572,8 @@ FreeFormDeformation<dim>
           high_order_grid.initial_mapping_fe_field,
           high_order_grid.dof_handler_grid,
           high_order_grid.surface_to_volume_indices,
-          surface_node_displacements);
+          surface_node_displacements,
+          mesh_movement_preconditioner_type);
     //meshmover.evaluate_dXvdXs();
     meshmover.apply_dXvdXvs(dXvsdXp_vector, dXvdXp);
 }
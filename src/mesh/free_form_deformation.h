@@ -1,6 +1,7 @@
 #ifndef __FREE_FORM_DEFORMATION__
 #define __FREE_FORM_DEFORMATION__
 
+#include "parameters/parameters_linear_solver.h"
 #include "high_order_grid.h"
 
 namespace PHiLiP {
@@ -10,17 +11,22 @@ template<int dim>
 class FreeFormDeformation
 {
 public:
+    /// Preconditioner of the linear elasticity mesh movement solves.
+    using MeshMovementPreconditionerEnum = Parameters::LinearSolverParam::MeshMovementPreconditionerEnum;
+
     /// Constructor for an oblique parallepiped.
     FreeFormDeformation (
         const dealii::Point<dim> &_origin,
         const std::array<dealii::Tensor<1,dim,double>,dim> _parallepiped_vectors,
-        const std::array<unsigned int,dim> &_ndim_control);
+        const std::array<unsigned int,dim> &_ndim_control,
+        const MeshMovementPreconditionerEnum _mesh_movement_preconditioner_type = MeshMovementPreconditionerEnum::ilut);
 
     /// Constructor for a rectangular FFD box.
     FreeFormDeformation (
         const dealii::Point<dim> &_origin,
         const std::array<double,dim> &rectangle_lengths,
-        const std::array<unsigned int,dim> &_ndim_control);
+        const std::array<unsigned int,dim> &_ndim_control,
+        const MeshMovementPreconditionerEnum _mesh_movement_preconditioner_type = MeshMovementPreconditionerEnum::ilut);
 
     /// Given an initial point in the undeformed initial parallepiped, return the 
     /// position of the new point location.
@@ -164,6 +170,9 @@ protected:
 public:
     /// Total number of control points.
     const unsigned int n_control_pts;
+
+    /// Preconditioner of the linear elasticity solves in deform_mesh() and get_dXvdXp().
+    const MeshMovementPreconditionerEnum mesh_movement_preconditioner_type;
 private:
 
     /// Returns rectangular vector box given the box lengths.
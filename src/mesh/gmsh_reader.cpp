@@ -1,5 +1,8 @@
 #include <fstream>
 #include <map>
+#include <numeric>
+#include <string>
+#include <unordered_map>
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/utilities.h>
@@ -288,7 +291,8 @@ assign_1d_boundary_ids(const std::map<unsigned int, dealii::types::boundary_id>
 
 void open_file_toRead(const std::string filepath, std::ifstream& file_in)
 {
-    file_in.open(filepath);
+    // Binary mode leaves ASCII files unchanged, and is needed to read the sections of binary files.
+    file_in.open(filepath, std::ios::binary);
     if(!file_in) {
         std::cout << "Could not open file "<< filepath << std::endl;
         std::abort();
@@ -296,162 +300,145 @@ void open_file_toRead(const std::string filepath, std::ifstream& file_in)
 }
 
 
-void read_gmsh_entities(std::ifstream &infile, std::array<std::map<int, int>, 4> &tag_maps)
+/**
+ * Reads the numbers of a Gmsh 4.1 file, stored either as ASCII text or in binary.
+ * In binary files, tags and element types are stored as int, numbers of entities,
+ * node tags and element tags as size_t, and coordinates as double.
+ **/
+class GmshFileReader
 {
-    std::string  line;
-    // if the next block is of kind $Entities, parse it
-    unsigned long n_points, n_curves, n_surfaces, n_volumes;
-
-    infile >> n_points >> n_curves >> n_surfaces >> n_volumes;
-    int entity_tag;
-    unsigned int n_physicals;
-    double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y, box_max_z;
-    (void) box_min_x; (void) box_min_y; (void) box_min_z;
-    (void) box_max_x; (void) box_max_y; (void) box_max_z;
-    for (unsigned int i = 0; i < n_points; ++i) {
-        // parse point ids
-
-        // we only care for 'tag' as key for tag_maps[0]
-        infile >> entity_tag >> box_min_x >> box_min_y >> box_min_z >> n_physicals;
-
-        // if there is a physical tag, we will use it as boundary id below
-        AssertThrow(n_physicals < 2, dealii::ExcMessage("More than one tag is not supported!"));
-        // if there is no physical tag, use 0 as default
-        int physical_tag = 0;
-        for (unsigned int j = 0; j < n_physicals; ++j) {
-            infile >> physical_tag;
-        }
+public:
+    /// Constructor.
+    GmshFileReader(std::ifstream &infile_input, const bool binary_input)
+        : infile(infile_input)
+        , binary(binary_input)
+    {}
 
-        tag_maps[0][entity_tag] = physical_tag;
-    }
-    for (unsigned int i = 0; i < n_curves; ++i) {
-        // parse curve ids
-
-        // we only care for 'tag' as key for tag_maps[1]
-        infile >> entity_tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >> box_max_y >> box_max_z >> n_physicals;
-        // if there is a physical tag, we will use it as boundary id below
-        AssertThrow(n_physicals < 2, dealii::ExcMessage("More than one tag is not supported!"));
-        // if there is no physical tag, use 0 as default
-        int physical_tag = 0;
-        for (unsigned int j = 0; j < n_physicals; ++j) {
-            infile >> physical_tag;
-        }
-        tag_maps[1][entity_tag] = physical_tag;
+    /// Reads an entity tag, a physical tag, a dimension or an element type.
+    int read_int() { return read_value<int>(); }
+
+    /// Reads a number of entities, a node tag or an element tag.
+    std::size_t read_size() { return read_value<std::size_t>(); }
 
-        // we don't care about the points associated to a curve, but have
-        // to parse them anyway because their format is unstructured
-        infile >> n_points;
-        for (unsigned int j = 0; j < n_points; ++j) {
-            infile >> entity_tag;
+    /// Reads a coordinate.
+    double read_double() { return read_value<double>(); }
+
+    /// Reads n_values consecutive values, in a single read for binary files.
+    template <typename T>
+    void read_values(T *values, const std::size_t n_values)
+    {
+        if (binary) {
+            infile.read(reinterpret_cast<char *>(values), n_values * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < n_values; ++i) infile >> values[i];
         }
     }
-    for (unsigned int i = 0; i < n_surfaces; ++i) {
-        // parse surface ids
-
-        // we only care for 'tag' as key for tag_maps[2]
-        infile >> entity_tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >> box_max_y >> box_max_z >> n_physicals;
-        // if there is a physical tag, we will use it as boundary id below
-        AssertThrow(n_physicals < 2, dealii::ExcMessage("More than one tag is not supported!"));
-        // if there is no physical tag, use 0 as default
-        int physical_tag = 0;
-        for (unsigned int j = 0; j < n_physicals; ++j) {
-          infile >> physical_tag;
-        }
 
-        tag_maps[2][entity_tag] = physical_tag;
-        // we don't care about the curves associated to a surface, but
-        // have to parse them anyway because their format is unstructured
-        infile >> n_curves;
-        for (unsigned int j = 0; j < n_curves; ++j) {
-          infile >> entity_tag;
-        }
+    /// Skips the end of the line of a section marker, after which the binary data of the section starts.
+    void begin_section() { if (binary) infile.get(); }
+
+    std::ifstream &infile; ///< Gmsh file.
+    const bool binary; ///< Whether the sections are stored in binary.
+
+private:
+    /// Reads a single value.
+    template <typename T>
+    T read_value()
+    {
+        T value;
+        read_values(&value, 1);
+        return value;
     }
-    for (unsigned int i = 0; i < n_volumes; ++i) {
-        // parse volume ids
-
-        // we only care for 'tag' as key for tag_maps[3]
-        infile >> entity_tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >> box_max_y >> box_max_z >> n_physicals;
-        // if there is a physical tag, we will use it as boundary id below
-        AssertThrow(n_physicals < 2,
-                    dealii::ExcMessage("More than one tag is not supported!"));
-        // if there is no physical tag, use 0 as default
-        int physical_tag = 0;
-        for (unsigned int j = 0; j < n_physicals; ++j) {
-            infile >> physical_tag;
-        }
+};
 
-        tag_maps[3][entity_tag] = physical_tag;
-        // we don't care about the surfaces associated to a volume, but
-        // have to parse them anyway because their format is unstructured
-        infile >> n_surfaces;
-        for (unsigned int j = 0; j < n_surfaces; ++j) {
-            infile >> entity_tag;
+void read_gmsh_entities(GmshFileReader &gmsh_file, std::array<std::map<int, int>, 4> &tag_maps)
+{
+    std::string  line;
+    gmsh_file.begin_section();
+    // if the next block is of kind $Entities, parse it
+    const std::size_t n_entities[4] = {gmsh_file.read_size(), gmsh_file.read_size(), gmsh_file.read_size(), gmsh_file.read_size()};
+
+    // points only store their coordinates, while curves, surfaces and volumes store their bounding box
+    for (int entity_dim = 0; entity_dim < 4; ++entity_dim) {
+        for (std::size_t i = 0; i < n_entities[entity_dim]; ++i) {
+            // we only care for 'tag' as key for tag_maps[entity_dim]
+            const int entity_tag = gmsh_file.read_int();
+            double box[6];
+            gmsh_file.read_values(box, (entity_dim == 0) ? 3 : 6);
+            const std::size_t n_physicals = gmsh_file.read_size();
+
+            // if there is a physical tag, we will use it as boundary id below
+            AssertThrow(n_physicals < 2, dealii::ExcMessage("More than one tag is not supported!"));
+            // if there is no physical tag, use 0 as default
+            int physical_tag = 0;
+            for (std::size_t j = 0; j < n_physicals; ++j) {
+                physical_tag = gmsh_file.read_int();
+            }
+            tag_maps[entity_dim][entity_tag] = physical_tag;
+
+            // we don't care about the entities bounding a curve, surface or volume, but have
+            // to parse them anyway because their format is unstructured
+            if (entity_dim > 0) {
+                const std::size_t n_bounding_entities = gmsh_file.read_size();
+                for (std::size_t j = 0; j < n_bounding_entities; ++j) {
+                    gmsh_file.read_int();
+                }
+            }
         }
     }
-    infile >> line;
+    gmsh_file.infile >> line;
     //AssertThrow(line == "$EndEntities", PHiLiP::ExcInvalidGMSHInput(line));
 }
 
+/**
+ * Reads the nodes and their coordinates.
+ * vertex_indices is indexed by the Gmsh node tags, which are bounded by max_node_tag, and gives
+ * the index of each node in vertices, or invalid_unsigned_int for tags without a node.
+ **/
 template<int spacedim>
-void read_gmsh_nodes( std::ifstream &infile, std::vector<dealii::Point<spacedim>> &vertices, std::map<int, int> &vertex_indices, const bool mesh_reader_verbose_output )
+void read_gmsh_nodes( GmshFileReader &gmsh_file, std::vector<dealii::Point<spacedim>> &vertices, std::vector<unsigned int> &vertex_indices, const bool mesh_reader_verbose_output )
 {
 
     const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
     dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
 
-    std::string  line;
+    gmsh_file.begin_section();
     // now read the nodes list
-    unsigned int n_entity_blocks, n_vertices;
-    int min_node_tag;
-    int max_node_tag;
-    infile >> n_entity_blocks >> n_vertices >> min_node_tag >> max_node_tag;
+    const std::size_t n_entity_blocks = gmsh_file.read_size();
+    const std::size_t n_vertices = gmsh_file.read_size();
+    const std::size_t min_node_tag = gmsh_file.read_size();
+    const std::size_t max_node_tag = gmsh_file.read_size();
+    (void) min_node_tag;
     if(mesh_reader_verbose_output) pcout << "Reading nodes..." << std::endl;
 
     vertices.resize(n_vertices);
+    vertex_indices.assign(max_node_tag + 1, dealii::numbers::invalid_unsigned_int);
   
     unsigned int global_vertex = 0;
-    for (unsigned int entity_block = 0; entity_block < n_entity_blocks; ++entity_block) {
-        int           parametric;
-        unsigned long numNodes;
-
-        // for gmsh_file_format 4.1 the order of tag and dim is reversed,
-        // but we are ignoring both anyway.
-        int tagEntity, dimEntity;
-        infile >> tagEntity >> dimEntity >> parametric >> numNodes;
-
-        std::vector<int> vertex_numbers;
-
-        for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes; ++vertex_per_entity) {
-            int vertex_number;
-            infile >> vertex_number;
-            vertex_numbers.push_back(vertex_number);
-        }
-
-        for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes; ++vertex_per_entity, ++global_vertex) {
-            // read vertex
-            double x[3];
-            infile >> x[0] >> x[1] >> x[2];
-
+    std::vector<std::size_t> vertex_numbers;
+    std::vector<double> coordinates;
+    for (std::size_t entity_block = 0; entity_block < n_entity_blocks; ++entity_block) {
+        const int dimEntity = gmsh_file.read_int();
+        const int tagEntity = gmsh_file.read_int();
+        const int parametric = gmsh_file.read_int();
+        const std::size_t numNodes = gmsh_file.read_size();
+        (void) tagEntity;
+
+        vertex_numbers.resize(numNodes);
+        gmsh_file.read_values(vertex_numbers.data(), numNodes);
+
+        // each node stores its coordinates, followed by its parametric coordinates which are ignored
+        const unsigned int n_parametric = (parametric == 0) ? 0 : std::max(dimEntity, 1);
+        const unsigned int n_values_per_node = 3 + n_parametric;
+        coordinates.resize(numNodes * n_values_per_node);
+        gmsh_file.read_values(coordinates.data(), coordinates.size());
+
+        for (std::size_t vertex_per_entity = 0; vertex_per_entity < numNodes; ++vertex_per_entity, ++global_vertex) {
             for (unsigned int d = 0; d < spacedim; ++d) {
-                vertices[global_vertex](d) = x[d];
+                vertices[global_vertex](d) = coordinates[vertex_per_entity * n_values_per_node + d];
             }
-
-            int vertex_number;
-            vertex_number = vertex_numbers[vertex_per_entity];
             // store mapping
-            vertex_indices[vertex_number] = global_vertex;
-
-
-            // ignore parametric coordinates
-            if (parametric != 0) {
-                int n_parametric = dimEntity;
-                if (dimEntity == 0) n_parametric = 1;
-                double uvw[3];
-                for (int d=0; d<n_parametric; ++d) {
-                    infile >> uvw[d];
-                }
-                (void)uvw;
-            }
+            vertex_indices[vertex_numbers[vertex_per_entity]] = global_vertex;
         }
     }
     AssertDimension(global_vertex, n_vertices);
@@ -499,61 +486,194 @@ unsigned int gmsh_cell_type_to_order(unsigned int cell_type)
  * 
  **/ 
 template<int dim>
-unsigned int find_grid_order(std::ifstream &infile,const bool mesh_reader_verbose_output)
+unsigned int find_grid_order(GmshFileReader &gmsh_file,const bool mesh_reader_verbose_output)
 {
 
     const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
     dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
 
-    auto entity_file_position = infile.tellg();
+    auto entity_file_position = gmsh_file.infile.tellg();
 
     unsigned int grid_order = 0;
 
-    unsigned int n_entity_blocks, n_cells;
-    int min_ele_tag, max_ele_tag;
-    infile >> n_entity_blocks >> n_cells >> min_ele_tag >> max_ele_tag;
+    const std::size_t n_entity_blocks = gmsh_file.read_size();
+    const std::size_t n_cells = gmsh_file.read_size();
+    const std::size_t min_ele_tag = gmsh_file.read_size();
+    const std::size_t max_ele_tag = gmsh_file.read_size();
+    (void) min_ele_tag; (void) max_ele_tag;
 
     if(mesh_reader_verbose_output) pcout << "Finding grid order..." << std::endl;
     if(mesh_reader_verbose_output) pcout << n_entity_blocks << " entity blocks with a total of " << n_cells << " cells. " << std::endl;
 
-    std::vector<unsigned int> vertices_id;
-
-    unsigned int global_cell = 0;
-    for (unsigned int entity_block = 0; entity_block < n_entity_blocks; ++entity_block) {
-        unsigned long numElements;
-        int           cell_type;
+    std::vector<std::size_t> vertices_id;
 
-        int tagEntity, dimEntity;
-        infile >> dimEntity >> tagEntity >> cell_type >> numElements;
+    std::size_t global_cell = 0;
+    for (std::size_t entity_block = 0; entity_block < n_entity_blocks; ++entity_block) {
+        const int dimEntity = gmsh_file.read_int();
+        const int tagEntity = gmsh_file.read_int();
+        const int cell_type = gmsh_file.read_int();
+        const std::size_t numElements = gmsh_file.read_size();
+        (void) tagEntity;
 
         const unsigned int cell_order = gmsh_cell_type_to_order(cell_type);
         const unsigned int nodes_per_element = std::pow(cell_order + 1, dimEntity);
 
         grid_order = std::max(cell_order, grid_order);
 
-        vertices_id.resize(nodes_per_element);
-
-        for (unsigned int cell_per_entity = 0; cell_per_entity < numElements; ++cell_per_entity, ++global_cell) {
-            // note that since infile the input file we found the number of p1_cells at the top, there
-            // should still be input here, so check this:
-            AssertThrow(infile, dealii::ExcIO());
-
-            int tag;
-            infile >> tag;
-
-            for (unsigned int i = 0; i < nodes_per_element; ++i) {
-                infile >> vertices_id[i];
-            }
-        } // End of cell per entity
+        // each element stores its tag followed by its nodes
+        vertices_id.resize(numElements * (1 + nodes_per_element));
+        gmsh_file.read_values(vertices_id.data(), vertices_id.size());
+        // note that since infile the input file we found the number of p1_cells at the top, there
+        // should still be input here, so check this:
+        AssertThrow(gmsh_file.infile, dealii::ExcIO());
+        global_cell += numElements;
     } // End of entity block
 
-    infile.seekg(entity_file_position);
+    gmsh_file.infile.seekg(entity_file_position);
 
     AssertDimension(global_cell, n_cells);
     if(mesh_reader_verbose_output) pcout << "Found grid order = " << grid_order << std::endl;
     return grid_order;
 }
 
+/**
+ * Broadcasts the coarse mesh read by the first process. Every process needs the
+ * vertices and p1 cells of the coarse mesh to create the distributed triangulation,
+ * but not the high-order nodes.
+ **/
+template <int dim, int spacedim>
+void broadcast_coarse_mesh(std::vector<dealii::Point<spacedim>> &vertices,
+                           std::vector<dealii::CellData<dim>> &cells,
+                           dealii::SubCellData &subcelldata,
+                           std::map<unsigned int, dealii::types::boundary_id> &boundary_ids_1d,
+                           const MPI_Comm mpi_communicator)
+{
+    const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+    const unsigned int vertices_per_cell = dealii::GeometryInfo<dim>::vertices_per_cell;
+
+    unsigned int sizes[5] = {static_cast<unsigned int>(vertices.size()),
+                             static_cast<unsigned int>(cells.size()),
+                             static_cast<unsigned int>(subcelldata.boundary_lines.size()),
+                             static_cast<unsigned int>(subcelldata.boundary_quads.size()),
+                             static_cast<unsigned int>(boundary_ids_1d.size())};
+    MPI_Bcast(sizes, 5, MPI_UNSIGNED, 0, mpi_communicator);
+
+    // Pack the coordinates and the vertex, material and boundary ids in two arrays.
+    std::vector<double> coordinates;
+    std::vector<unsigned int> ids;
+    if (mpi_rank == 0) {
+        for (const auto &vertex : vertices) {
+            for (int d = 0; d < spacedim; ++d) coordinates.push_back(vertex[d]);
+        }
+        for (const auto &cell : cells) {
+            for (unsigned int i = 0; i < vertices_per_cell; ++i) ids.push_back(cell.vertices[i]);
+            ids.push_back(cell.material_id);
+        }
+        for (const auto &line : subcelldata.boundary_lines) {
+            for (unsigned int i = 0; i < 2; ++i) ids.push_back(line.vertices[i]);
+            ids.push_back(line.boundary_id);
+        }
+        for (const auto &quad : subcelldata.boundary_quads) {
+            for (unsigned int i = 0; i < 4; ++i) ids.push_back(quad.vertices[i]);
+            ids.push_back(quad.boundary_id);
+        }
+        for (const auto &vertex_boundary_id : boundary_ids_1d) {
+            ids.push_back(vertex_boundary_id.first);
+            ids.push_back(vertex_boundary_id.second);
+        }
+    }
+    coordinates.resize(sizes[0] * spacedim);
+    ids.resize(sizes[1] * (vertices_per_cell + 1) + sizes[2] * 3 + sizes[3] * 5 + sizes[4] * 2);
+    MPI_Bcast(coordinates.data(), coordinates.size(), MPI_DOUBLE, 0, mpi_communicator);
+    MPI_Bcast(ids.data(), ids.size(), MPI_UNSIGNED, 0, mpi_communicator);
+    if (mpi_rank == 0) return;
+
+    vertices.resize(sizes[0]);
+    for (unsigned int ivertex = 0; ivertex < sizes[0]; ++ivertex) {
+        for (int d = 0; d < spacedim; ++d) vertices[ivertex][d] = coordinates[ivertex * spacedim + d];
+    }
+    auto id = ids.begin();
+    cells.resize(sizes[1]);
+    for (auto &cell : cells) {
+        cell.vertices.resize(vertices_per_cell);
+        for (unsigned int i = 0; i < vertices_per_cell; ++i) cell.vertices[i] = *id++;
+        cell.material_id = *id++;
+    }
+    subcelldata.boundary_lines.resize(sizes[2]);
+    for (auto &line : subcelldata.boundary_lines) {
+        line.vertices.resize(2);
+        for (unsigned int i = 0; i < 2; ++i) line.vertices[i] = *id++;
+        line.boundary_id = *id++;
+    }
+    subcelldata.boundary_quads.resize(sizes[3]);
+    for (auto &quad : subcelldata.boundary_quads) {
+        quad.vertices.resize(4);
+        for (unsigned int i = 0; i < 4; ++i) quad.vertices[i] = *id++;
+        quad.boundary_id = *id++;
+    }
+    for (unsigned int i = 0; i < sizes[4]; ++i) {
+        const unsigned int vertex = *id++;
+        boundary_ids_1d[vertex] = *id++;
+    }
+}
+
+/**
+ * Sends to each process the high-order nodes of the coarse cells it owns, read by the first process.
+ * The coarse cells are numbered in the order in which they were read, such that the nodes of the
+ * i-th locally owned cell are returned at positions [i*n_nodes_per_cell, (i+1)*n_nodes_per_cell).
+ **/
+template <int dim, int spacedim>
+std::vector<dealii::Point<spacedim>> scatter_high_order_nodes(const dealii::DoFHandler<dim> &dof_handler_grid,
+                                                              const std::vector<dealii::Point<spacedim>> &all_vertices,
+                                                              const std::vector<dealii::CellData<dim>> &high_order_cells,
+                                                              const unsigned int n_nodes_per_cell,
+                                                              const MPI_Comm mpi_communicator)
+{
+    const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+    const int n_mpi = dealii::Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    std::vector<unsigned int> owned_cells;
+    unsigned int icell = 0;
+    for (const auto &cell : dof_handler_grid.active_cell_iterators()) {
+        if (cell->is_locally_owned()) owned_cells.push_back(icell);
+        icell++;
+    }
+    const int n_owned_cells = owned_cells.size();
+
+    std::vector<int> n_cells_per_process(n_mpi), cell_offsets(n_mpi);
+    MPI_Gather(&n_owned_cells, 1, MPI_INT, n_cells_per_process.data(), 1, MPI_INT, 0, mpi_communicator);
+    for (int i = 1; i < n_mpi; ++i) {
+        cell_offsets[i] = cell_offsets[i-1] + n_cells_per_process[i-1];
+    }
+    std::vector<unsigned int> requested_cells((mpi_rank == 0) ? cell_offsets.back() + n_cells_per_process.back() : 0);
+    MPI_Gatherv(owned_cells.data(), n_owned_cells, MPI_UNSIGNED, requested_cells.data(), n_cells_per_process.data(), cell_offsets.data(), MPI_UNSIGNED, 0, mpi_communicator);
+
+    const int n_values_per_cell = n_nodes_per_cell * spacedim;
+    std::vector<double> sent_values;
+    std::vector<int> n_values_per_process(n_mpi), value_offsets(n_mpi);
+    if (mpi_rank == 0) {
+        sent_values.reserve(requested_cells.size() * n_values_per_cell);
+        for (const unsigned int requested_cell : requested_cells) {
+            for (const unsigned int node : high_order_cells[requested_cell].vertices) {
+                for (int d = 0; d < spacedim; ++d) sent_values.push_back(all_vertices[node][d]);
+            }
+        }
+        for (int i = 0; i < n_mpi; ++i) {
+            n_values_per_process[i] = n_cells_per_process[i] * n_values_per_cell;
+            value_offsets[i] = cell_offsets[i] * n_values_per_cell;
+        }
+    }
+    std::vector<double> received_values(n_owned_cells * n_values_per_cell);
+    MPI_Scatterv(sent_values.data(), n_values_per_process.data(), value_offsets.data(), MPI_DOUBLE,
+                 received_values.data(), received_values.size(), MPI_DOUBLE, 0, mpi_communicator);
+
+    std::vector<dealii::Point<spacedim>> owned_cell_nodes(n_owned_cells * n_nodes_per_cell);
+    for (unsigned int inode = 0; inode < owned_cell_nodes.size(); ++inode) {
+        for (int d = 0; d < spacedim; ++d) owned_cell_nodes[inode][d] = received_values[inode * spacedim + d];
+    }
+    return owned_cell_nodes;
+}
+
 unsigned int ijk_to_num(const unsigned int i,
                         const unsigned int j,
                         const unsigned int k,
@@ -1057,185 +1177,117 @@ void fe_q_node_number(const unsigned int index,
 }
 
 /**
- * Function to get rotated indices in 2D
- **/ 
-template <int dim, int spacedim>
-bool get_new_rotated_indices(const dealii::CellAccessor<dim, spacedim>& cell,
-                             const std::vector<dealii::Point<spacedim>>& all_vertices,
-                             const std::vector<unsigned int>& deal_h2l,
-                             const std::vector<unsigned int>& rotate_z90degree,
-                             std::vector<unsigned int>& high_order_vertices_id)
+ * Orientations of the lexicographic nodes of a Gmsh cell with respect to the deal.II cell,
+ * generated by the 90 degree rotations and the flip of the reference cell.
+ *
+ * An orientation is fully determined by where it sends the vertices of the cell, so the
+ * orientations are hashed by the positions of the vertices. The orientation of a cell is then
+ * found by locating its vertices once, instead of trying every rotation in turn.
+ **/
+template <int dim>
+class GmshCellOrientations
 {
-
-    const unsigned int n_vertices = cell.n_vertices();
-    for (int zr = 0; zr < 4; ++zr) {
-
-        std::vector<char> matching(n_vertices);
-
-        for (unsigned int i_vertex=0; i_vertex < n_vertices; ++i_vertex) {
-
-            const unsigned int base_index = i_vertex;
-            const unsigned int lexicographic_index = deal_h2l[base_index];
-
-            const unsigned int vertex_id = high_order_vertices_id[lexicographic_index];
-            const dealii::Point<dim,double> high_order_vertex = all_vertices[vertex_id];
-
-            bool found = false;
-            for (unsigned int i=0; i < n_vertices; ++i) {
-                if (cell.vertex(i) == high_order_vertex) {
-                    found = true;
-                }
-            }
-            if (!found) {
-                std::cout << "Wrong cell... High-order nodes do not match the cell's vertices." << std::endl;
-                std::abort();
-            }
-
-            matching[i_vertex] = (high_order_vertex == cell.vertex(i_vertex)) ? 'T' : 'F';
-        }
-
-        bool all_matching = true;
-        for (unsigned int i=0; i < n_vertices; ++i) {
-            if (matching[i] == 'F') all_matching = false;
+public:
+    /// Constructor. Generates all the orientations of a cell of order grid_order.
+    GmshCellOrientations(const unsigned int grid_order, const std::vector<unsigned int> &deal_h2l, const bool mesh_reader_verbose_output)
+    {
+        const unsigned int n_nodes = dealii::Utilities::pow(grid_order + 1, dim);
+        const unsigned int n_vertices = dealii::GeometryInfo<dim>::vertices_per_cell;
+
+        vertex_lexicographic_index.resize(n_vertices);
+        vertex_of_lexicographic_index.assign(n_nodes, dealii::numbers::invalid_unsigned_int);
+        for (unsigned int i_vertex = 0; i_vertex < n_vertices; ++i_vertex) {
+            vertex_lexicographic_index[i_vertex] = deal_h2l[i_vertex];
+            vertex_of_lexicographic_index[deal_h2l[i_vertex]] = i_vertex;
         }
-        if (all_matching) return true;
 
-        const auto high_order_vertices_id_temp = high_order_vertices_id;
-        for (unsigned int i=0; i<high_order_vertices_id.size(); ++i) {
-            high_order_vertices_id[i] = high_order_vertices_id_temp[rotate_z90degree[i]];
+        // Generators of the orientations, applied as new_ids[i] = ids[generator[i]].
+        const std::vector<char> directions = (dim == 3) ? std::vector<char>{'Z', 'Y', 'X', 'F'}
+                                           : (dim == 2) ? std::vector<char>{'Z', '3'}
+                                                        : std::vector<char>{'Z'};
+        std::vector<std::vector<unsigned int>> generators(directions.size());
+        for (unsigned int i = 0; i < directions.size(); ++i) {
+            rotate_indices<dim>(generators[i], grid_order + 1, directions[i], mesh_reader_verbose_output);
         }
-    }
-    return false;
-}
-
-/**
- * Function to get rotated indices in 3D
- **/ 
-template <int dim, int spacedim>
-bool get_new_rotated_indices_3D(const dealii::CellAccessor<dim, spacedim>& cell,
-                                const std::vector<dealii::Point<spacedim>>& all_vertices,
-                                const std::vector<unsigned int>& deal_h2l,
-                                const std::vector<unsigned int>& rotate_x90degree_3D,
-                                const std::vector<unsigned int>& rotate_y90degree_3D,
-                                const std::vector<unsigned int>& rotate_z90degree_3D,
-                                std::vector<unsigned int>& high_order_vertices_id_rotated,
-                                const bool /*mesh_reader_verbose_output*/)
-{
-
-    const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
-    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
-
-    //These variables are for 3D case
-    auto high_order_flip_id_rotated = high_order_vertices_id_rotated;
-    auto high_order_x_id_rotated = high_order_vertices_id_rotated;
-    auto high_order_y_id_rotated = high_order_vertices_id_rotated;
-    auto high_order_vertices_id = high_order_vertices_id_rotated;
-
-    const unsigned int n_vertices = cell.n_vertices();
-
-    bool good_rotation;
-
-    for (int xr = 0; xr < 4; ++xr) {                    //Rotate in X-Axis                                                                       
-        for (int zr = 0; zr < 4; ++zr) {                //Rotate in Y-Axis   
-            for (int zr3d = 0; zr3d < 4; ++zr3d) {      //Rotate in Z-Axis
 
-                std::vector<char> matching(n_vertices);
-
-                //Parse through vertex points
-                for (unsigned int i_vertex = 0; i_vertex < n_vertices; ++i_vertex) {                            
-
-                    const unsigned int base_index = i_vertex;
-
-                   //THESE ARE POSITIONS INDEX, SO GET THE LEXICOGRAHICAL_INDEX OF DEALII AND MAP IT BACK
-                    const unsigned int lexicographic_index = deal_h2l[base_index];                                      
-
-                    const unsigned int vertex_id = high_order_vertices_id_rotated[lexicographic_index];
-
-                    //ALL_VERTICES IS IN HIERARCHICAL ORDER WITH POINTS (SO VERTEX_ID HITS BANG ON)
-                    const dealii::Point<dim, double> high_order_vertex = all_vertices[vertex_id];                       
-
-                    //.I.E. 0 4 20 24 5 -> POSITION 1 IS 4, SO FIRST NODE IN DEALII ORDERING WOULD BE AT POSITION 4 IN THE LEXICOGRPAHICAL ORDERING GENERATED BY GMSH
-
-                    //THIS IS JUST TO SEE IF THE HIGHER ORDER NODES ARE FOUND (TECHNICALLY, WE SHOULD BE ONLY TARGETING 2D NODES, NOT THE 1D) 
-                    //-> THIS SHOULD BE FILTERED OUT FROM HIGH_ORDER_VERTEX
-                    bool found = false;
-                    for (unsigned int i = 0; i < n_vertices; ++i) {
-                        if (cell.vertex(i) == high_order_vertex) {
-                            found = true;
-                        }
-                    }
-
-                    if (!found) {
-                        std::cout
-                                << "Wrong cell... High order nodes do not match the cell's vertices | "
-                                << "mpi_rank = " << mpi_rank << std::endl;
-                        std::abort();
-                    }
-
-                    //CHECK FOR WHETHER THE VERTEX IS AT THE GOOD LOCATION OR NOT
-                    matching[i_vertex] = (high_order_vertex == cell.vertex(i_vertex)) ? 0 : 1;
-                }
-
-                /**
-                 * TECHNICALLY, THE MATCHING VECTOR SHOULD BE ALL 0 IF THEY ALL MATCH
-                 */
-
-                // if(mesh_reader_verbose_output) pcout << "********** CELL VERTEX **********" << std::endl;
-
-                bool all_matching = true;
-                for (unsigned int i = 0; i < n_vertices; ++i) {
-                    if (matching[i] == 1) all_matching = false;
-                }
-
-                //Boolean for good rotation from the previous matching for loop
-                good_rotation = all_matching;
-
-                //If rotation is good, i.e., matching vertices, then we break.
-                if (good_rotation) {
-                    break;
-                }
-
-                //If we did not find a good rotation, we rotate in the Z-axis,
-                //Swap the high_order_vertices_id_rotated by Z-axis rotation
-                high_order_vertices_id = high_order_vertices_id_rotated;
-                for (unsigned int i = 0; i < high_order_vertices_id.size(); ++i) {
-                    high_order_vertices_id_rotated[i] = high_order_vertices_id[rotate_z90degree_3D[i]];
+        // Breadth-first closure of the generators, starting from the identity.
+        std::vector<unsigned int> identity(n_nodes);
+        std::iota(identity.begin(), identity.end(), 0);
+        std::vector<std::vector<unsigned int>> candidates(1, identity);
+        for (unsigned int i_candidate = 0; i_candidate < candidates.size(); ++i_candidate) {
+            const std::vector<unsigned int> permutation = candidates[i_candidate];
+            const unsigned int key = permutation_key(permutation);
+            if (orientation_of_key.find(key) != orientation_of_key.end()) continue;
+            orientation_of_key[key] = permutations.size();
+            permutations.push_back(permutation);
+
+            for (const auto &generator : generators) {
+                std::vector<unsigned int> rotated(n_nodes);
+                for (unsigned int i = 0; i < n_nodes; ++i) {
+                    rotated[i] = permutation[generator[i]];
                 }
+                candidates.push_back(rotated);
             }
+        }
+    }
 
-            //If rotation is good, i.e., matching vertices, then we break.
-            if (good_rotation) {
-                break;
+    /// Reorders the lexicographic node ids of cell such that its vertices are at the positions of the deal.II vertices.
+    /** Aborts if the high-order nodes do not match the vertices of the cell.
+     */
+    template <int spacedim>
+    void orient(const dealii::CellAccessor<dim, spacedim> &cell,
+                const std::vector<dealii::Point<spacedim>> &all_vertices,
+                const std::vector<unsigned int> &high_order_vertices_id,
+                std::vector<unsigned int> &high_order_vertices_id_rotated) const
+    {
+        // Position, among the Gmsh vertices, of each deal.II vertex.
+        unsigned int key = 0;
+        const unsigned int n_vertices = vertex_lexicographic_index.size();
+        for (unsigned int i_vertex = 0; i_vertex < n_vertices; ++i_vertex) {
+            unsigned int j_vertex = 0;
+            while (j_vertex < n_vertices && all_vertices[high_order_vertices_id[vertex_lexicographic_index[j_vertex]]] != cell.vertex(i_vertex)) {
+                ++j_vertex;
             }
-
-            //If we did not find a good rotation, we rotate in the Y-axis,
-            //Swap the high_order_vertices_id_rotated by Y-axis rotation
-            high_order_y_id_rotated = high_order_vertices_id_rotated;
-            for (unsigned int i = 0; i < high_order_vertices_id.size(); ++i) {
-                high_order_vertices_id_rotated[i] = high_order_y_id_rotated[rotate_y90degree_3D[i]];
+            if (j_vertex == n_vertices) {
+                std::cout << "Wrong cell... High-order nodes do not match the cell's vertices." << std::endl;
+                std::abort();
             }
+            key |= j_vertex << (bits_per_vertex * i_vertex);
         }
 
-        //If rotation is good, i.e., matching vertices, then we break.
-        if (good_rotation) {
-            break;
+        const auto orientation = orientation_of_key.find(key);
+        if (orientation == orientation_of_key.end()) {
+            std::cout << "Couldn't find a rotation or flip of the high-order nodes matching the cell's vertices... Aborting..." << std::endl;
+            std::abort();
         }
 
-        //If we did not find a good rotation, we rotate in the X-axis
-        //Swap the high_order_vertices_id_rotated by X-axis rotation
-        high_order_x_id_rotated = high_order_vertices_id_rotated;
-        for (unsigned int i = 0; i < high_order_vertices_id.size(); ++i) {
-            high_order_vertices_id_rotated[i] = high_order_x_id_rotated[rotate_x90degree_3D[i]];
+        const std::vector<unsigned int> &permutation = permutations[orientation->second];
+        high_order_vertices_id_rotated.resize(permutation.size());
+        for (unsigned int i = 0; i < permutation.size(); ++i) {
+            high_order_vertices_id_rotated[i] = high_order_vertices_id[permutation[i]];
         }
-
     }
 
-    if (good_rotation) {
-        return true;
+private:
+    /// Number of bits used to store the position of one vertex in a key.
+    static constexpr unsigned int bits_per_vertex = 3;
+
+    /// Returns the key of the positions to which permutation sends the vertices.
+    unsigned int permutation_key(const std::vector<unsigned int> &permutation) const
+    {
+        unsigned int key = 0;
+        for (unsigned int i_vertex = 0; i_vertex < vertex_lexicographic_index.size(); ++i_vertex) {
+            const unsigned int j_vertex = vertex_of_lexicographic_index[permutation[vertex_lexicographic_index[i_vertex]]];
+            key |= j_vertex << (bits_per_vertex * i_vertex);
+        }
+        return key;
     }
 
-    return false;
-}
+    std::vector<unsigned int> vertex_lexicographic_index; ///< Lexicographic index of each vertex.
+    std::vector<unsigned int> vertex_of_lexicographic_index; ///< Vertex at each lexicographic index, if any.
+    std::vector<std::vector<unsigned int>> permutations; ///< Permutation of the lexicographic nodes of each orientation.
+    std::unordered_map<unsigned int, unsigned int> orientation_of_key; ///< Orientation sending the vertices to the positions of a key.
+};
 
 
 // template <int dim, int spacedim>
@@ -1252,314 +1304,364 @@ read_gmsh(std::string filename,
           const bool mesh_reader_verbose_output,
           const bool do_renumber_dofs,
           int requested_grid_order,
-          const bool use_mesh_smoothing)
+          const bool use_mesh_smoothing,
+          const MPI_Comm mpi_communicator)
 {
 
-    const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
     dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
 
+    // Only the first process reads the file. The other processes receive the coarse mesh needed to create the
+    // distributed triangulation, and the high-order nodes of their own cells once the triangulation is partitioned.
+    std::vector<dealii::Point<spacedim>> vertices;
+    std::vector<dealii::Point<spacedim>> all_vertices;
+    std::vector<dealii::CellData<dim>> p1_cells;
+    std::vector<dealii::CellData<dim>> high_order_cells;
+    dealii::SubCellData                                subcelldata;
+    std::map<unsigned int, dealii::types::boundary_id> boundary_ids_1d;
+    unsigned int grid_order = 0;
+
+    if (mpi_rank == 0) {
 //    Assert(dim==2, dealii::ExcInternalError());
-    std::ifstream infile;
+        std::ifstream infile;
 
-    open_file_toRead(filename, infile);
+        open_file_toRead(filename, infile);
   
-    std::string  line;
+        std::string  line;
 
-    // This array stores maps from the 'entities' to the 'physical tags' for
-    // points, curves, surfaces and volumes. We use this information later to
-    // assign boundary ids.
-    std::array<std::map<int, int>, 4> tag_maps;
-  
-  
-    infile >> line;
+        // This array stores maps from the 'entities' to the 'physical tags' for
+        // points, curves, surfaces and volumes. We use this information later to
+        // assign boundary ids.
+        std::array<std::map<int, int>, 4> tag_maps;
   
-    //Assert(tria != nullptr, dealii::ExcNoTriangulationSelected());
   
-    // first determine file format
-    unsigned int gmsh_file_format = 0;
-    if (line == "$MeshFormat") {
-      gmsh_file_format = 20;
-    } else {
-      //AssertThrow(false, dealii::ExcInvalidGMSHInput(line));
-    }
-  
-    // if file format is 2.0 or greater then we also have to read the rest of the
-    // header
-    if (gmsh_file_format == 20) {
-        double       version;
-        unsigned int file_type, data_size;
+        infile >> line;
   
-        infile >> version >> file_type >> data_size;
+        //Assert(tria != nullptr, dealii::ExcNoTriangulationSelected());
   
-        Assert((version == 4.1), dealii::ExcNotImplemented());
-        gmsh_file_format = static_cast<unsigned int>(version * 10);
+        // first determine file format
+        unsigned int gmsh_file_format = 0;
+        if (line == "$MeshFormat") {
+          gmsh_file_format = 20;
+        } else {
+          //AssertThrow(false, dealii::ExcInvalidGMSHInput(line));
+        }
   
+        // if file format is 2.0 or greater then we also have to read the rest of the
+        // header
+        bool binary = false;
+        if (gmsh_file_format == 20) {
+            double       version;
+            unsigned int file_type, data_size;
   
-        Assert(file_type == 0, dealii::ExcNotImplemented());
-        Assert(data_size == sizeof(double), dealii::ExcNotImplemented());
+            infile >> version >> file_type >> data_size;
   
+            Assert((version == 4.1), dealii::ExcNotImplemented());
+            gmsh_file_format = static_cast<unsigned int>(version * 10);
   
-        // Read the end of the header and the first line of the nodes description
-        // to synch ourselves with the format 1 handling above
-        infile >> line;
-        //AssertThrow(line == "$EndMeshFormat", PHiLiP::ExcInvalidGMSHInput(line));
+            if (file_type != 0 && (file_type != 1 || data_size != sizeof(std::size_t))) {
+                std::cout << "Gmsh file type " << file_type << " with data size " << data_size << " is not supported." << std::endl;
+                std::abort();
+            }
+
+            // Binary files store the integer 1 after the header, to check that they were written with the same byte order.
+            binary = (file_type == 1);
+            if (binary) {
+                infile.get();
+                int one = 0;
+                infile.read(reinterpret_cast<char *>(&one), sizeof(int));
+                if (one != 1) {
+                    std::cout << "Binary Gmsh file " << filename << " was written with a different byte order." << std::endl;
+                    std::abort();
+                }
+            }
   
-        infile >> line;
-        // if the next block is of kind $PhysicalNames, ignore it
-        if (line == "$PhysicalNames") {
-            do {
-                infile >> line;
-            } while (line != "$EndPhysicalNames");
+            // Read the end of the header and the first line of the nodes description
+            // to synch ourselves with the format 1 handling above
             infile >> line;
-        }
-  
-  
-        // if the next block is of kind $Entities, parse it
-        if (line == "$Entities") read_gmsh_entities(infile, tag_maps);
-        infile >> line;
+            //AssertThrow(line == "$EndMeshFormat", PHiLiP::ExcInvalidGMSHInput(line));
   
-        // if the next block is of kind $PartitionedEntities, ignore it
-        if (line == "$PartitionedEntities") {
-            do {
-                infile >> line;
-            } while (line != "$EndPartitionedEntities");
             infile >> line;
+            // if the next block is of kind $PhysicalNames, ignore it
+            if (line == "$PhysicalNames") {
+                do {
+                    infile >> line;
+                } while (line != "$EndPhysicalNames");
+                infile >> line;
+            }
         }
+        GmshFileReader gmsh_file(infile, binary);
+
+        if (gmsh_file_format != 0) {
+            // if the next block is of kind $Entities, parse it
+            if (line == "$Entities") read_gmsh_entities(gmsh_file, tag_maps);
+            infile >> line;
   
-        // But the next thing should,
-        // infile any case, be the list of
-        // nodes:
-        //AssertThrow(line == "$Nodes", PHiLiP::ExcInvalidGMSHInput(line));
-    }
+            // if the next block is of kind $PartitionedEntities, ignore it
+            if (line == "$PartitionedEntities") {
+                do {
+                    infile >> line;
+                } while (line != "$EndPartitionedEntities");
+                infile >> line;
+            }
   
-    std::vector<dealii::Point<spacedim>> vertices;
+            // But the next thing should,
+            // infile any case, be the list of
+            // nodes:
+            //AssertThrow(line == "$Nodes", PHiLiP::ExcInvalidGMSHInput(line));
+        }
 
-    // Set up mapping between numbering
-    // infile msh-file (node) and infile the
-    // vertices vector
+        // Set up mapping between numbering
+        // infile msh-file (node) and infile the
+        // vertices vector
 
-    std::map<int, int> vertex_indices;
-    read_gmsh_nodes( infile, vertices, vertex_indices, mesh_reader_verbose_output );
+        std::vector<unsigned int> vertex_indices;
+        read_gmsh_nodes( gmsh_file, vertices, vertex_indices, mesh_reader_verbose_output );
   
-    // Assert we reached the end of the block
-    infile >> line;
-    static const std::string end_nodes_marker = "$EndNodes";
-    //AssertThrow(line == end_nodes_marker, PHiLiP::ExcInvalidGMSHInput(line));
-  
-    // Now read infile next bit
-    infile >> line;
-    static const std::string begin_elements_marker = "$Elements";
-    //AssertThrow(line == begin_elements_marker, PHiLiP::ExcInvalidGMSHInput(line));
-
-    const unsigned int grid_order = find_grid_order<dim>(infile,mesh_reader_verbose_output);
+        // Assert we reached the end of the block
+        infile >> line;
+        static const std::string end_nodes_marker = "$EndNodes";
+        //AssertThrow(line == end_nodes_marker, PHiLiP::ExcInvalidGMSHInput(line));
   
-    using Triangulation = dealii::parallel::distributed::Triangulation<dim>;
-    std::shared_ptr<Triangulation> triangulation;
+        // Now read infile next bit
+        infile >> line;
+        static const std::string begin_elements_marker = "$Elements";
+        //AssertThrow(line == begin_elements_marker, PHiLiP::ExcInvalidGMSHInput(line));
+        gmsh_file.begin_section();
 
-    if(use_mesh_smoothing) {
-        triangulation = std::make_shared<Triangulation>(
-            MPI_COMM_WORLD,
-            typename dealii::Triangulation<dim>::MeshSmoothing(
-                dealii::Triangulation<dim>::smoothing_on_refinement |
-                dealii::Triangulation<dim>::smoothing_on_coarsening));
-    }
-    else
-    {
-        triangulation = std::make_shared<Triangulation>(MPI_COMM_WORLD); // Dealii's default mesh smoothing flag is none. 
-    }
+        grid_order = find_grid_order<dim>(gmsh_file,mesh_reader_verbose_output);
 
-    auto high_order_grid = std::make_shared<HighOrderGrid<dim, double>>(grid_order, triangulation);
-  
-    unsigned int n_entity_blocks, n_cells;
-    int min_ele_tag, max_ele_tag;
-    infile >> n_entity_blocks >> n_cells >> min_ele_tag >> max_ele_tag;
+        const std::size_t n_entity_blocks = gmsh_file.read_size();
+        const std::size_t n_cells = gmsh_file.read_size();
+        const std::size_t min_ele_tag = gmsh_file.read_size();
+        const std::size_t max_ele_tag = gmsh_file.read_size();
+        (void) min_ele_tag; (void) max_ele_tag;
 
-    // Set up array of p1_cells and subcells (faces). In 1d, there is currently no
-    // standard way infile deal.II to pass boundary indicators attached to individual
-    // vertices, so do this by hand via the boundary_ids_1d array
+        // Set up array of p1_cells and subcells (faces). In 1d, there is currently no
+        // standard way infile deal.II to pass boundary indicators attached to individual
+        // vertices, so do this by hand via the boundary_ids_1d array
 
-    std::vector<dealii::CellData<dim>> p1_cells;
-    std::vector<dealii::CellData<dim>> high_order_cells;
-    dealii::CellData<dim> temp_high_order_cells;
+        dealii::CellData<dim> temp_high_order_cells;
 
-    dealii::SubCellData                                subcelldata;
-    std::map<unsigned int, dealii::types::boundary_id> boundary_ids_1d;
+        std::size_t global_cell = 0;
+        for (std::size_t entity_block = 0; entity_block < n_entity_blocks; ++entity_block) {
+            unsigned int  material_id;
 
-    unsigned int global_cell = 0;
-    for (unsigned int entity_block = 0; entity_block < n_entity_blocks; ++entity_block) {
-        unsigned int  material_id;
-        unsigned long numElements;
-        int           cell_type;
+            // For gmsh_file_format 4.1 the order of tag and dim is reversed,
+            const int dimEntity = gmsh_file.read_int();
+            const int tagEntity = gmsh_file.read_int();
+            const int cell_type = gmsh_file.read_int();
+            const std::size_t numElements = gmsh_file.read_size();
+            material_id = tag_maps[dimEntity][tagEntity];
 
-        // For gmsh_file_format 4.1 the order of tag and dim is reversed,
-        int tagEntity, dimEntity;
-        infile >> dimEntity >> tagEntity >> cell_type >> numElements;
-        material_id = tag_maps[dimEntity][tagEntity];
+            const unsigned int cell_order = gmsh_cell_type_to_order(cell_type);
 
-        const unsigned int cell_order = gmsh_cell_type_to_order(cell_type);
+            unsigned int vertices_per_element = std::pow(2, dimEntity);
+            unsigned int nodes_per_element = std::pow(cell_order + 1, dimEntity);
 
-        unsigned int vertices_per_element = std::pow(2, dimEntity);
-        unsigned int nodes_per_element = std::pow(cell_order + 1, dimEntity);
+            // Each element is stored as its tag followed by its node tags. The whole block is read at once,
+            // in a single read for binary files.
+            const std::size_t n_values_per_element = 1 + nodes_per_element;
+            std::vector<std::size_t> element_block(numElements * n_values_per_element);
+            gmsh_file.read_values(element_block.data(), element_block.size());
 
+            for (std::size_t cell_per_entity = 0; cell_per_entity < numElements; ++cell_per_entity, ++global_cell) {
 
-        for (unsigned int cell_per_entity = 0; cell_per_entity < numElements; ++cell_per_entity, ++global_cell) {
+                // Node tags of the element, after its tag which is ignored
+                const std::size_t *element_nodes = element_block.data() + cell_per_entity * n_values_per_element + 1;
 
-            // Ignore tag
-            int tag;
-            infile >> tag;
+                if (dimEntity == dim) {
 
-            if (dimEntity == dim) {
+                    /**
+                     * When dimEntity == dim, this means we found a Face (2D) or Cell (3D)
+                     **/
 
-                /**
-                 * When dimEntity == dim, this means we found a Face (2D) or Cell (3D)
-                 **/
+                    // Allocate and read indices
+                    p1_cells.emplace_back(vertices_per_element);
+                    high_order_cells.emplace_back(vertices_per_element);
 
-                // Allocate and read indices
-                p1_cells.emplace_back(vertices_per_element);
-                high_order_cells.emplace_back(vertices_per_element);
+                    auto &p1_vertices_id = p1_cells.back().vertices;
+                    auto &high_order_vertices_id = high_order_cells.back().vertices;
 
-                auto &p1_vertices_id = p1_cells.back().vertices;
-                auto &high_order_vertices_id = high_order_cells.back().vertices;
+                    p1_vertices_id.resize(vertices_per_element);
+                    high_order_vertices_id.resize(nodes_per_element);
 
-                p1_vertices_id.resize(vertices_per_element);
-                high_order_vertices_id.resize(nodes_per_element);
+                    for (unsigned int i = 0; i < nodes_per_element; ++i) {
+                        high_order_vertices_id[i] = element_nodes[i];
+                    }
+                    for (unsigned int i = 0; i < vertices_per_element; ++i) {
+                        p1_vertices_id[i] = high_order_vertices_id[i];
+                    }
 
-                for (unsigned int i = 0; i < nodes_per_element; ++i) {
-                    infile >> high_order_vertices_id[i];
-                }
-                for (unsigned int i = 0; i < vertices_per_element; ++i) {
-                    p1_vertices_id[i] = high_order_vertices_id[i];
-                }
+                    // To make sure that the cast won't fail
+                    Assert(material_id <= std::numeric_limits<dealii::types::material_id>::max(),
+                           dealii::ExcIndexRange( material_id, 0, std::numeric_limits<dealii::types::material_id>::max()));
+                    // We use only material_ids infile the range from 0 to dealii::numbers::invalid_material_id-1
+                    AssertIndexRange(material_id, dealii::numbers::invalid_material_id);
+
+                    p1_cells.back().material_id = material_id;
+
+                    // Transform from ucd to consecutive numbering
+                    // Unlike the boundary lines, the cells cannot skip an unknown node, so the file is rejected.
+                    for (unsigned int i = 0; i < vertices_per_element; ++i) {
+                        AssertThrow(p1_vertices_id[i] < vertex_indices.size()
+                                    && vertex_indices[p1_vertices_id[i]] != dealii::numbers::invalid_unsigned_int,
+                                    dealii::ExcMessage("Cell " + std::to_string(cell_per_entity) + " refers to the undefined node "
+                                                       + std::to_string(p1_vertices_id[i]) + "."));
+                        p1_vertices_id[i] = vertex_indices[p1_vertices_id[i]];
+                    }
+                    for (unsigned int i = 0; i < nodes_per_element; ++i) {
+                        AssertThrow(high_order_vertices_id[i] < vertex_indices.size()
+                                    && vertex_indices[high_order_vertices_id[i]] != dealii::numbers::invalid_unsigned_int,
+                                    dealii::ExcMessage("Cell " + std::to_string(cell_per_entity) + " refers to the undefined node "
+                                                       + std::to_string(high_order_vertices_id[i]) + "."));
+                        high_order_vertices_id[i] = vertex_indices[high_order_vertices_id[i]];
+                    }
+                } else if (dimEntity == 1 && dimEntity < dim) {
 
-                // To make sure that the cast won't fail
-                Assert(material_id <= std::numeric_limits<dealii::types::material_id>::max(),
-                       dealii::ExcIndexRange( material_id, 0, std::numeric_limits<dealii::types::material_id>::max()));
-                // We use only material_ids infile the range from 0 to dealii::numbers::invalid_material_id-1
-                AssertIndexRange(material_id, dealii::numbers::invalid_material_id);
+                    // Boundary info
+                    subcelldata.boundary_lines.emplace_back(vertices_per_element);
+                    auto &p1_vertices_id = subcelldata.boundary_lines.back().vertices;
+                    p1_vertices_id.resize(vertices_per_element);
 
-                p1_cells.back().material_id = material_id;
+                    temp_high_order_cells.vertices.resize(nodes_per_element);
 
-                // Transform from ucd to consecutive numbering
-                for (unsigned int i = 0; i < vertices_per_element; ++i) {
-                    //AssertThrow( vertex_indices.find(p1_cells.back().vertices[i]) != vertex_indices.end(),
-                    //  dealii::ExcInvalidVertexIndexGmsh(global_cell, elm_number, p1_cells.back().vertices[i]));
+                    for (unsigned int i = 0; i < nodes_per_element; ++i) {
+                        temp_high_order_cells.vertices[i] = element_nodes[i];
+                    }
+                    for (unsigned int i = 0; i < vertices_per_element; ++i) {
+                        p1_vertices_id[i] = temp_high_order_cells.vertices[i];
+                    }
 
-                    // Vertex with this index exists
-                    p1_vertices_id[i] = vertex_indices[p1_cells.back().vertices[i]];
-                }
-                for (unsigned int i = 0; i < nodes_per_element; ++i) {
-                    high_order_vertices_id[i] = vertex_indices[high_order_cells.back().vertices[i]];
-                }
-            } else if (dimEntity == 1 && dimEntity < dim) {
+                    // To make sure that the cast won't fail
+                    Assert(material_id <= std::numeric_limits<dealii::types::boundary_id>::max(),
+                           dealii::ExcIndexRange( material_id, 0, std::numeric_limits<dealii::types::boundary_id>::max()));
+                    // We use only boundary_ids infile the range from 0 to dealii::numbers::internal_face_boundary_id-1
+                    AssertIndexRange(material_id, dealii::numbers::internal_face_boundary_id);
+
+                    subcelldata.boundary_lines.back().boundary_id = static_cast<dealii::types::boundary_id>(material_id);
+
+                    // Transform from ucd to consecutive numbering
+                    for (unsigned int &vertex : subcelldata.boundary_lines.back().vertices) {
+                        if (vertex < vertex_indices.size() && vertex_indices[vertex] != dealii::numbers::invalid_unsigned_int) {
+                          vertex = vertex_indices[vertex];
+                        } else {
+                            // No such vertex index
+                            //AssertThrow(false, dealii::ExcInvalidVertexIndex(cell_per_entity, vertex));
+                            vertex = dealii::numbers::invalid_unsigned_int;
+                            std::abort();
+                        }
+                    }
+                } else if (dimEntity == 2 && dimEntity < dim) {
 
-                // Boundary info
-                subcelldata.boundary_lines.emplace_back(vertices_per_element);
-                auto &p1_vertices_id = subcelldata.boundary_lines.back().vertices;
-                p1_vertices_id.resize(vertices_per_element);
+                    // Boundary info
+                    subcelldata.boundary_quads.emplace_back(vertices_per_element);
+                    auto &p1_vertices_id = subcelldata.boundary_quads.back().vertices;
+                    p1_vertices_id.resize(vertices_per_element);
 
-                temp_high_order_cells.vertices.resize(nodes_per_element);
+                    temp_high_order_cells.vertices.resize(nodes_per_element);
 
-                for (unsigned int i = 0; i < nodes_per_element; ++i) {
-                    infile >> temp_high_order_cells.vertices[i];
-                }
-                for (unsigned int i = 0; i < vertices_per_element; ++i) {
-                    p1_vertices_id[i] = temp_high_order_cells.vertices[i];
-                }
+                    for (unsigned int i = 0; i < nodes_per_element; ++i) {
+                        temp_high_order_cells.vertices[i] = element_nodes[i];
+                    }
+                    for (unsigned int i = 0; i < vertices_per_element; ++i) {
+                        p1_vertices_id[i] = temp_high_order_cells.vertices[i];
+                    }
 
-                // To make sure that the cast won't fail
-                Assert(material_id <= std::numeric_limits<dealii::types::boundary_id>::max(),
-                       dealii::ExcIndexRange( material_id, 0, std::numeric_limits<dealii::types::boundary_id>::max()));
-                // We use only boundary_ids infile the range from 0 to dealii::numbers::internal_face_boundary_id-1
-                AssertIndexRange(material_id, dealii::numbers::internal_face_boundary_id);
-
-                subcelldata.boundary_lines.back().boundary_id = static_cast<dealii::types::boundary_id>(material_id);
-
-                // Transform from ucd to consecutive numbering
-                for (unsigned int &vertex : subcelldata.boundary_lines.back().vertices) {
-                    if (vertex_indices.find(vertex) != vertex_indices.end()) {
-                      vertex = vertex_indices[vertex];
-                    } else {
-                        // No such vertex index
-                        //AssertThrow(false, dealii::ExcInvalidVertexIndex(cell_per_entity, vertex));
-                        vertex = dealii::numbers::invalid_unsigned_int;
-                        std::abort();
+                    // To make sure that the cast won't fail
+                    Assert(material_id <= std::numeric_limits<dealii::types::boundary_id>::max(),
+                           dealii::ExcIndexRange( material_id, 0, std::numeric_limits<dealii::types::boundary_id>::max()));
+                    // We use only boundary_ids infile the range from 0 to dealii::numbers::internal_face_boundary_id-1
+                    AssertIndexRange(material_id, dealii::numbers::internal_face_boundary_id);
+
+                    subcelldata.boundary_quads.back().boundary_id = static_cast<dealii::types::boundary_id>(material_id);
+
+                    // Transform from gmsh to consecutive numbering
+                    for (unsigned int &vertex : subcelldata.boundary_quads.back().vertices) {
+                        if (vertex < vertex_indices.size() && vertex_indices[vertex] != dealii::numbers::invalid_unsigned_int) {
+                          vertex = vertex_indices[vertex];
+                        } else {
+                            // No such vertex index
+                            //Assert(false, dealii::ExcInvalidVertexIndex(cell_per_entity, vertex));
+                            vertex = dealii::numbers::invalid_unsigned_int;
+                        }
                     }
+                } else if (cell_type == MSH_PNT) {
+                  // Read the indices of nodes given
+                  const unsigned int node_index = element_nodes[0];
+
+                  // We only care about boundary indicators assigned to individual
+                  // vertices infile 1d (because otherwise the vertices are not faces)
+                  if (dim == 1) {
+                      AssertThrow(node_index < vertex_indices.size()
+                                  && vertex_indices[node_index] != dealii::numbers::invalid_unsigned_int,
+                                  dealii::ExcMessage("Point " + std::to_string(cell_per_entity) + " refers to the undefined node "
+                                                     + std::to_string(node_index) + "."));
+                      boundary_ids_1d[vertex_indices[node_index]] = material_id;
+                  }
+                } else {
+                  //AssertThrow(false, dealii::ExcGmshUnsupportedGeometry(cell_type));
                 }
-            } else if (dimEntity == 2 && dimEntity < dim) {
+            } // End of cell per entity
+        } // End of entity block
 
-                // Boundary info
-                subcelldata.boundary_quads.emplace_back(vertices_per_element);
-                auto &p1_vertices_id = subcelldata.boundary_quads.back().vertices;
-                p1_vertices_id.resize(vertices_per_element);
+        AssertDimension(global_cell, n_cells);
 
-                temp_high_order_cells.vertices.resize(nodes_per_element);
+        // Assert we reached the end of the block
+        infile >> line;
+        static const std::string end_elements_marker[] = {"$ENDELM", "$EndElements"};
+        //AssertThrow(line == end_elements_marker[gmsh_file_format == 10 ? 0 : 1],
+        //            PHiLiP::ExcInvalidGMSHInput(line));
+  
+        // Check that no forbidden arrays are used
+        Assert(subcelldata.check_consistency(dim), dealii::ExcInternalError());
 
-                for (unsigned int i = 0; i < nodes_per_element; ++i) {
-                    infile >> temp_high_order_cells.vertices[i];
-                }
-                for (unsigned int i = 0; i < vertices_per_element; ++i) {
-                    p1_vertices_id[i] = temp_high_order_cells.vertices[i];
-                }
+        AssertThrow(infile, dealii::ExcIO());
 
-                // To make sure that the cast won't fail
-                Assert(material_id <= std::numeric_limits<dealii::types::boundary_id>::max(),
-                       dealii::ExcIndexRange( material_id, 0, std::numeric_limits<dealii::types::boundary_id>::max()));
-                // We use only boundary_ids infile the range from 0 to dealii::numbers::internal_face_boundary_id-1
-                AssertIndexRange(material_id, dealii::numbers::internal_face_boundary_id);
-
-                subcelldata.boundary_quads.back().boundary_id = static_cast<dealii::types::boundary_id>(material_id);
-
-                // Transform from gmsh to consecutive numbering
-                for (unsigned int &vertex : subcelldata.boundary_quads.back().vertices) {
-                    if (vertex_indices.find(vertex) != vertex_indices.end()) {
-                      vertex = vertex_indices[vertex];
-                    } else {
-                        // No such vertex index
-                        //Assert(false, dealii::ExcInvalidVertexIndex(cell_per_entity, vertex));
-                        vertex = dealii::numbers::invalid_unsigned_int;
-                    }
-                }
-            } else if (cell_type == MSH_PNT) {
-              // Read the indices of nodes given
-              unsigned int node_index = 0;
-              infile >> node_index;
-
-              // We only care about boundary indicators assigned to individual
-              // vertices infile 1d (because otherwise the vertices are not faces)
-              if (dim == 1) {
-                  boundary_ids_1d[vertex_indices[node_index]] = material_id;
-              }
-            } else {
-              //AssertThrow(false, dealii::ExcGmshUnsupportedGeometry(cell_type));
+        // Check that we actually read some p1_cells.
+        // AssertThrow(p1_cells.size() > 0, dealii::ExcGmshNoCellInformation());
+  
+        // Do some clean-up on vertices...
+        all_vertices = vertices;
+        dealii::GridTools::delete_unused_vertices(vertices, p1_cells, subcelldata);
+
+        // ... and p1_cells
+        if (dim == spacedim) {
+          dealii::GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices, p1_cells);
+        }
+        dealii::GridReordering<dim, spacedim>::reorder_cells(p1_cells);
+
+        // The high-order nodes are sent cell by cell, which requires cells of a single order.
+        const unsigned int n_nodes_per_cell = dealii::Utilities::pow(grid_order + 1, dim);
+        for (const auto &high_order_cell : high_order_cells) {
+            if (high_order_cell.vertices.size() != n_nodes_per_cell) {
+                std::cout << "Gmsh cells of different orders are not supported. Found a cell with " << high_order_cell.vertices.size()
+                          << " nodes while cells of order " << grid_order << " have " << n_nodes_per_cell << " nodes." << std::endl;
+                std::abort();
             }
-        } // End of cell per entity
-    } // End of entity block
+        }
+    } // End of reading on the first process
 
-    AssertDimension(global_cell, n_cells);
+    MPI_Bcast(&grid_order, 1, MPI_UNSIGNED, 0, mpi_communicator);
+    broadcast_coarse_mesh<dim,spacedim>(vertices, p1_cells, subcelldata, boundary_ids_1d, mpi_communicator);
 
-    // Assert we reached the end of the block
-    infile >> line;
-    static const std::string end_elements_marker[] = {"$ENDELM", "$EndElements"};
-    //AssertThrow(line == end_elements_marker[gmsh_file_format == 10 ? 0 : 1],
-    //            PHiLiP::ExcInvalidGMSHInput(line));
-  
-    // Check that no forbidden arrays are used
-    Assert(subcelldata.check_consistency(dim), dealii::ExcInternalError());
+    using Triangulation = dealii::parallel::distributed::Triangulation<dim>;
+    std::shared_ptr<Triangulation> triangulation;
 
-    AssertThrow(infile, dealii::ExcIO());
+    if(use_mesh_smoothing) {
+        triangulation = std::make_shared<Triangulation>(
+            mpi_communicator,
+            typename dealii::Triangulation<dim>::MeshSmoothing(
+                dealii::Triangulation<dim>::smoothing_on_refinement |
+                dealii::Triangulation<dim>::smoothing_on_coarsening));
+    }
+    else
+    {
+        triangulation = std::make_shared<Triangulation>(mpi_communicator); // Dealii's default mesh smoothing flag is none. 
+    }
 
-    // Check that we actually read some p1_cells.
-    // AssertThrow(p1_cells.size() > 0, dealii::ExcGmshNoCellInformation());
-  
-    // Do some clean-up on vertices...
-    const std::vector<dealii::Point<spacedim>> all_vertices = vertices;
-    dealii::GridTools::delete_unused_vertices(vertices, p1_cells, subcelldata);
+    auto high_order_grid = std::make_shared<HighOrderGrid<dim, double>>(grid_order, triangulation);
 
-    // ... and p1_cells
-    if (dim == spacedim) {
-      dealii::GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices, p1_cells);
-    }
-    dealii::GridReordering<dim, spacedim>::reorder_cells(p1_cells);
     triangulation->create_triangulation_compatibility(vertices, p1_cells, subcelldata);
 
     triangulation->repartition();
@@ -1581,34 +1683,20 @@ read_gmsh(std::string filename,
     std::vector<unsigned int> gmsh_h2l = gmsh_hierarchic_to_lexicographic<dim>(grid_order,mesh_reader_verbose_output);
     std::vector<unsigned int> gmsh_l2h = dealii::Utilities::invert_permutation(gmsh_h2l);
 
-    int icell = 0;
-    std::vector<dealii::types::global_dof_index> dof_indices(high_order_grid->fe_system.dofs_per_cell);
+    const unsigned int n_nodes_per_cell = dealii::Utilities::pow(grid_order + 1, dim);
+    const std::vector<dealii::Point<spacedim>> owned_cell_nodes = scatter_high_order_nodes<dim,spacedim>(
+        high_order_grid->dof_handler_grid, all_vertices, high_order_cells, n_nodes_per_cell, mpi_communicator);
+    // Only the first process needs the nodes of all the cells, to send them.
+    all_vertices.clear();
+    all_vertices.shrink_to_fit();
+    high_order_cells.clear();
+    high_order_cells.shrink_to_fit();
 
-    std::vector<unsigned int> rotate_z90degree;
+    int i_owned_cell = 0;
+    std::vector<dealii::types::global_dof_index> dof_indices(high_order_grid->fe_system.dofs_per_cell);
 
-    /**
-     * For 3D ROTATIONS (INITIATING ONCE HERE, SO WE DON'T RECOMPUTE FOR EACH ROTATION/CELL)
-     */
-    std::vector<unsigned int> rotate_z90degree_3D;
-    std::vector<unsigned int> rotate_y90degree_3D;
-    std::vector<unsigned int> rotate_x90degree_3D;
-    std::vector<unsigned int> rotate_flip_z90degree_3D;
-
-    //2D Rotation matrix (Pre allocate once)
-    if constexpr(dim == 2) {
-        if(mesh_reader_verbose_output) pcout << "Allocating 2D Rotate Z matrix..." << std::endl;
-        rotate_indices<dim>(rotate_z90degree, grid_order+1, 'Z', mesh_reader_verbose_output);
-    } else {
-        //3D Rotation matrix (Pre allocate once)
-        if(mesh_reader_verbose_output) pcout << "Allocating 3D Rotate Z matrix..." << std::endl;
-        rotate_indices<dim>(rotate_z90degree_3D, grid_order + 1, 'Z', mesh_reader_verbose_output);
-        if(mesh_reader_verbose_output) pcout << "Allocating 3D Rotate Y matrix..." << std::endl;
-        rotate_indices<dim>(rotate_y90degree_3D, grid_order + 1, 'Y', mesh_reader_verbose_output);
-        if(mesh_reader_verbose_output) pcout << "Allocating 3D Rotate X matrix..." << std::endl;
-        rotate_indices<dim>(rotate_x90degree_3D, grid_order + 1, 'X', mesh_reader_verbose_output);
-        if(mesh_reader_verbose_output) pcout << "Allocating 3D Rotate FLIP matrix..." << std::endl;
-        rotate_indices<dim>(rotate_flip_z90degree_3D, grid_order + 1, 'F', mesh_reader_verbose_output);
-    }
+    if(mesh_reader_verbose_output) pcout << "Generating the cell orientations..." << std::endl;
+    const GmshCellOrientations<dim> cell_orientations(grid_order, deal_h2l, mesh_reader_verbose_output);
 
     if(mesh_reader_verbose_output) pcout << " " << std::endl;
     if(mesh_reader_verbose_output) pcout << "*********************************************************************\n";
@@ -1621,7 +1709,10 @@ read_gmsh(std::string filename,
      */
     for (const auto &cell : high_order_grid->dof_handler_grid.active_cell_iterators()) {
         if (cell->is_locally_owned()) {
-            auto &high_order_vertices_id = high_order_cells[icell].vertices;
+            // Identify the nodes of the cell by their position in owned_cell_nodes.
+            std::vector<unsigned int> high_order_vertices_id(n_nodes_per_cell);
+            std::iota(high_order_vertices_id.begin(), high_order_vertices_id.end(), i_owned_cell * n_nodes_per_cell);
+            i_owned_cell++;
 
             auto high_order_vertices_id_lexico = high_order_vertices_id;
             for (unsigned int ihierachic=0; ihierachic<high_order_vertices_id.size(); ++ihierachic) {
@@ -1629,51 +1720,8 @@ read_gmsh(std::string filename,
                 high_order_vertices_id_lexico[lexico_id] = high_order_vertices_id[ihierachic];
             }
 
-            //auto high_order_vertices_id_rotated = high_order_cells[icell].vertices;
-            auto high_order_vertices_id_rotated = high_order_vertices_id_lexico;
-
-            if constexpr(dim == 2) {    //2D case
-
-                bool good_rotation = get_new_rotated_indices(*cell, all_vertices, deal_h2l, rotate_z90degree, high_order_vertices_id_rotated);
-                if (!good_rotation) {
-                    //std::cout << "Couldn't find rotation... Flipping Z axis and doing it again" << std::endl;
-
-                    // Flip Z-axis and do above again
-                    std::vector<unsigned int> flipZ;
-                    rotate_indices<dim>(flipZ, grid_order+1, '3', mesh_reader_verbose_output);
-                    auto high_order_vertices_id_copy = high_order_vertices_id_rotated;
-                    for (unsigned int i=0; i<high_order_vertices_id_rotated.size(); ++i) {
-                        high_order_vertices_id_rotated[i] = high_order_vertices_id_copy[flipZ[i]];
-                    }
-                    good_rotation = get_new_rotated_indices(*cell, all_vertices, deal_h2l, rotate_z90degree, high_order_vertices_id_rotated);
-                }
-
-                if (!good_rotation) {
-                    std::cout << "Couldn't find rotation after flipping either... Aborting..." << std::endl;
-                    std::abort();
-                }
-
-            } else {    //3D case
-
-                bool good_rotation = get_new_rotated_indices_3D(*cell, all_vertices, deal_h2l, rotate_x90degree_3D, rotate_y90degree_3D, rotate_z90degree_3D, high_order_vertices_id_rotated, mesh_reader_verbose_output);
-                if (!good_rotation) {
-                    if(mesh_reader_verbose_output) pcout << "3D -- Couldn't find rotation... Flipping Z axis and doing it again" << std::endl;
-
-                    // Flip Z-axis and perform rotation again. 
-                    auto high_order_vertices_id_copy = high_order_vertices_id_rotated;
-                    for (unsigned int i=0; i<high_order_vertices_id_rotated.size(); ++i) {
-                        high_order_vertices_id_rotated[i] = high_order_vertices_id_copy[rotate_flip_z90degree_3D[i]];
-                    }
-
-                    //Flip boolean should be included inside this boolean if statement
-                    good_rotation = get_new_rotated_indices_3D(*cell, all_vertices, deal_h2l, rotate_x90degree_3D, rotate_y90degree_3D, rotate_z90degree_3D, high_order_vertices_id_rotated, mesh_reader_verbose_output);
-                }
-
-                if (!good_rotation) {
-                    if(mesh_reader_verbose_output) pcout << "3D -- Couldn't find rotation after flipping 3D either... Aborting..." << std::endl;
-                    std::abort();
-                }
-            }
+            std::vector<unsigned int> high_order_vertices_id_rotated;
+            cell_orientations.orient(*cell, owned_cell_nodes, high_order_vertices_id_lexico, high_order_vertices_id_rotated);
 
             cell->get_dof_indices(dof_indices);
             for (unsigned int i_vertex = 0; i_vertex < high_order_vertices_id.size(); ++i_vertex) {
@@ -1682,7 +1730,7 @@ read_gmsh(std::string filename,
                 const unsigned int lexicographic_index = deal_h2l[base_index];
 
                 const unsigned int vertex_id = high_order_vertices_id_rotated[lexicographic_index];
-                const dealii::Point<dim,double> vertex = all_vertices[vertex_id];
+                const dealii::Point<dim,double> vertex = owned_cell_nodes[vertex_id];
 
 
                 for (int d = 0; d < dim; ++d) {
@@ -1693,7 +1741,6 @@ read_gmsh(std::string filename,
                 }
             }
         }
-        icell++;
     }
 
     if(mesh_reader_verbose_output) pcout << " " << std::endl;
@@ -1814,7 +1861,7 @@ read_gmsh(std::string filename,
 
 template <int dim, int spacedim>
 std::shared_ptr< HighOrderGrid<dim, double> >
-read_gmsh(std::string filename, const bool do_renumber_dofs, int requested_grid_order, const bool use_mesh_smoothing)
+read_gmsh(std::string filename, const bool do_renumber_dofs, int requested_grid_order, const bool use_mesh_smoothing, const MPI_Comm mpi_communicator)
 {
   // default parameters
   const bool periodic_x = false;
@@ -1836,12 +1883,13 @@ read_gmsh(std::string filename, const bool do_renumber_dofs, int requested_grid_
     mesh_reader_verbose_output,
     do_renumber_dofs,
     requested_grid_order,
-    use_mesh_smoothing);
+    use_mesh_smoothing,
+    mpi_communicator);
 }
 
 #if PHILIP_DIM!=1 
-template std::shared_ptr< HighOrderGrid<PHILIP_DIM, double> > read_gmsh<PHILIP_DIM,PHILIP_DIM>(std::string filename, const bool periodic_x, const bool periodic_y, const bool periodic_z, const int x_periodic_1, const int x_periodic_2, const int y_periodic_1, const int y_periodic_2, const int z_periodic_1, const int z_periodic_2, const bool mesh_reader_verbose_output, const bool do_renumber_dofs, int requested_grid_order, const bool use_mesh_smoothing);
-template std::shared_ptr< HighOrderGrid<PHILIP_DIM, double> > read_gmsh<PHILIP_DIM,PHILIP_DIM>(std::string filename, const bool do_renumber_dofs, int requested_grid_order, const bool use_mesh_smoothing);
+template std::shared_ptr< HighOrderGrid<PHILIP_DIM, double> > read_gmsh<PHILIP_DIM,PHILIP_DIM>(std::string filename, const bool periodic_x, const bool periodic_y, const bool periodic_z, const int x_periodic_1, const int x_periodic_2, const int y_periodic_1, const int y_periodic_2, const int z_periodic_1, const int z_periodic_2, const bool mesh_reader_verbose_output, const bool do_renumber_dofs, int requested_grid_order, const bool use_mesh_smoothing, const MPI_Comm mpi_communicator);
+template std::shared_ptr< HighOrderGrid<PHILIP_DIM, double> > read_gmsh<PHILIP_DIM,PHILIP_DIM>(std::string filename, const bool do_renumber_dofs, int requested_grid_order, const bool use_mesh_smoothing, const MPI_Comm mpi_communicator);
 #endif
 
 } // namespace PHiLiP
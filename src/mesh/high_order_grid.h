@@ -56,6 +56,12 @@ public:
     {
         vector.reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
     }
+
+    // communicator the mesh is solved on; serial meshes are replicated over MPI_COMM_WORLD
+    static MPI_Comm get_mpi_communicator(dealii::Triangulation<PHILIP_DIM> const &/* mesh */)
+    {
+        return MPI_COMM_WORLD;
+    }
 };
 
 template <>
@@ -78,6 +84,12 @@ public:
     {
         vector.reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
     }
+
+    // communicator the mesh is distributed over
+    static MPI_Comm get_mpi_communicator(dealii::parallel::distributed::Triangulation<PHILIP_DIM> const &mesh)
+    {
+        return mesh.get_communicator();
+    }
 };
 
 #if PHILIP_DIM1!=1 // dealii::parallel::distributed::Triangulation<dim> does not work for 1D
@@ -101,6 +113,12 @@ public:
     {
         vector.reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
     }
+
+    // communicator the mesh is distributed over
+    static MPI_Comm get_mpi_communicator(dealii::parallel::shared::Triangulation<PHILIP_DIM> const &mesh)
+    {
+        return mesh.get_communicator();
+    }
 };
 #endif
 
@@ -16,6 +16,15 @@
 
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 
+#include <deal.II/base/timer.h>
+
+#include <deal.II/fe/fe_values.h>
+
+#include <Epetra_Map.h>
+#include <ml_MultiLevelPreconditioner.h>
+
+#include <algorithm>
+
 #include "meshmover_linear_elasticity.hpp"
 
 namespace PHiLiP {
@@ -42,13 +51,15 @@ namespace MeshMover {
     template <int dim, typename real>
     LinearElasticity<dim,real>::LinearElasticity(
         const HighOrderGrid<dim,real> &high_order_grid,
-        const dealii::LinearAlgebra::distributed::Vector<double> &boundary_displacements_vector)
+        const dealii::LinearAlgebra::distributed::Vector<double> &boundary_displacements_vector,
+        const PreconditionerEnum _preconditioner_type)
       : LinearElasticity<dim,real> (
           *(high_order_grid.triangulation),
           high_order_grid.mapping_fe_field,
           high_order_grid.dof_handler_grid,
           high_order_grid.surface_to_volume_indices,
-          boundary_displacements_vector)
+          boundary_displacements_vector,
+          _preconditioner_type)
     { }
 
     template <int dim, typename real>
@@ -57,8 +68,10 @@ namespace MeshMover {
         const std::shared_ptr<dealii::MappingFEField<dim,dim,VectorType,DoFHandlerType>> mapping_fe_field,
         const DoFHandlerType &_dof_handler,
         const dealii::LinearAlgebra::distributed::Vector<int> &_boundary_ids_vector,
-        const dealii::LinearAlgebra::distributed::Vector<double> &_boundary_displacements_vector)
-      : triangulation(_triangulation)
+        const dealii::LinearAlgebra::distributed::Vector<double> &_boundary_displacements_vector,
+        const PreconditionerEnum _preconditioner_type)
+      : preconditioner_type(_preconditioner_type)
+      , triangulation(_triangulation)
       , mapping_fe_field(mapping_fe_field)
       , dof_handler(_dof_handler)
       , quadrature_formula(dof_handler.get_fe().degree + 1)
@@ -346,6 +359,125 @@ namespace MeshMover {
         system_matrix_unconstrained.compress(dealii::VectorOperation::insert);
         system_rhs_unconstrained.compress(dealii::VectorOperation::insert);
     }
+
+    template <int dim, typename real>
+    std::uint64_t LinearElasticity<dim,real>::hash_system_matrix() const
+    {
+        // FNV-1a over the column indices and the bit patterns of the values of every locally owned row.
+        std::uint64_t hash = 14695981039346656037ULL;
+        const auto hash_bytes = [&hash](const void *data, const std::size_t n_bytes) {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (std::size_t i = 0; i < n_bytes; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+        const Epetra_CrsMatrix &matrix = system_matrix.trilinos_matrix();
+        for (int row = 0; row < matrix.NumMyRows(); ++row) {
+            int n_entries;
+            double *values;
+            int *indices;
+            matrix.ExtractMyRowView(row, n_entries, values, indices);
+            hash_bytes(&n_entries, sizeof(n_entries));
+            for (int i = 0; i < n_entries; ++i) {
+                const int global_column = matrix.GCID(indices[i]);
+                hash_bytes(&global_column, sizeof(global_column));
+            }
+            hash_bytes(values, n_entries * sizeof(double));
+        }
+        return hash;
+    }
+
+    template <int dim, typename real>
+    void LinearElasticity<dim,real>::update_preconditioner(const dealii::TrilinosWrappers::PreconditionILUT::AdditionalData &ilut_settings)
+    {
+        // Compare the current matrix with the one the preconditioner was built from through their hashes,
+        // such that no copy of the matrix is kept.
+        const std::uint64_t matrix_hash = hash_system_matrix();
+        bool is_unchanged_locally = (preconditioner != nullptr) && (matrix_hash == preconditioner_matrix_hash);
+        if (preconditioner_type == PreconditionerEnum::ilut) {
+            is_unchanged_locally = is_unchanged_locally
+                                   && ilut_settings.ilut_drop == preconditioner_ilut_settings.ilut_drop
+                                   && ilut_settings.ilut_fill == preconditioner_ilut_settings.ilut_fill
+                                   && ilut_settings.ilut_atol == preconditioner_ilut_settings.ilut_atol
+                                   && ilut_settings.ilut_rtol == preconditioner_ilut_settings.ilut_rtol
+                                   && ilut_settings.overlap == preconditioner_ilut_settings.overlap;
+        }
+        const unsigned int n_changed = dealii::Utilities::MPI::sum(static_cast<unsigned int>(!is_unchanged_locally), mpi_communicator);
+        if (n_changed == 0) {
+            pcout << "Reusing the mesh movement preconditioner." << std::endl;
+            return;
+        }
+
+        dealii::Timer timer;
+        if (preconditioner_type == PreconditionerEnum::amg) {
+            compute_rigid_body_modes();
+
+            Teuchos::ParameterList ml_parameters;
+            ML_Epetra::SetDefaults("SA", ml_parameters);
+            ml_parameters.set("ML output", 0);
+            ml_parameters.set("aggregation: type", "Uncoupled");
+            ml_parameters.set("smoother: type", "Chebyshev");
+            ml_parameters.set("smoother: sweeps", 2);
+            ml_parameters.set("coarse: type", "Amesos-KLU");
+            ml_parameters.set("coarse: max size", 2000);
+            ml_parameters.set("null space: type", "pre-computed");
+            ml_parameters.set("null space: dimension", n_rigid_body_modes);
+            ml_parameters.set("null space: vectors", rigid_body_modes.data());
+
+            std::shared_ptr<dealii::TrilinosWrappers::PreconditionAMG> amg = std::make_shared<dealii::TrilinosWrappers::PreconditionAMG>();
+            amg->initialize(system_matrix, ml_parameters);
+            preconditioner = amg;
+        } else {
+            std::shared_ptr<dealii::TrilinosWrappers::PreconditionILUT> ilut = std::make_shared<dealii::TrilinosWrappers::PreconditionILUT>();
+            ilut->initialize(system_matrix, ilut_settings);
+            preconditioner = ilut;
+            preconditioner_ilut_settings = ilut_settings;
+        }
+        preconditioner_matrix_hash = matrix_hash;
+        pcout << "Built the mesh movement " << (preconditioner_type == PreconditionerEnum::amg ? "AMG" : "ILUT")
+              << " preconditioner in " << timer.wall_time() << "s." << std::endl;
+    }
+
+    template <int dim, typename real>
+    void LinearElasticity<dim,real>::compute_rigid_body_modes()
+    {
+        // dim translations, and 1 (2D) or 3 (3D) rotations.
+        n_rigid_body_modes = (dim == 1) ? 1 : ((dim == 2) ? 3 : 6);
+        const unsigned int n_locally_owned_dofs = locally_owned_dofs.n_elements();
+        rigid_body_modes.assign(n_rigid_body_modes * n_locally_owned_dofs, 0.0);
+
+        const dealii::FiniteElement<dim> &fe = dof_handler.get_fe();
+        const dealii::Quadrature<dim> support_points(fe.get_unit_support_points());
+        dealii::FEValues<dim> fe_values(*mapping_fe_field, fe, support_points, dealii::update_quadrature_points);
+        std::vector<dealii::types::global_dof_index> dof_indices(fe.dofs_per_cell);
+        for (const auto &cell : dof_handler.active_cell_iterators()) {
+            if (!cell->is_locally_owned()) continue;
+            fe_values.reinit(cell);
+            cell->get_dof_indices(dof_indices);
+            for (unsigned int idof = 0; idof < fe.dofs_per_cell; ++idof) {
+                if (!locally_owned_dofs.is_element(dof_indices[idof])) continue;
+                const unsigned int local_row = locally_owned_dofs.index_within_set(dof_indices[idof]);
+                const unsigned int component = fe.system_to_component_index(idof).first;
+                const dealii::Point<dim> &point = fe_values.quadrature_point(idof);
+                const auto mode = [&](const unsigned int imode) -> double & {
+                    return rigid_body_modes[imode * n_locally_owned_dofs + local_row];
+                };
+
+                mode(component) = 1.0;
+                if constexpr (dim == 2) {
+                    // Rotation about z: (-y, x).
+                    mode(2) = (component == 0) ? -point[1] : point[0];
+                } else if constexpr (dim == 3) {
+                    // Rotations about x: (0, -z, y), y: (z, 0, -x) and z: (-y, x, 0).
+                    if (component == 0) { mode(4) =  point[2]; mode(5) = -point[1]; }
+                    if (component == 1) { mode(3) = -point[2]; mode(5) =  point[0]; }
+                    if (component == 2) { mode(3) =  point[1]; mode(4) = -point[0]; }
+                }
+            }
+        }
+    }
+
     template <int dim, typename real>
     void LinearElasticity<dim,real>::solve_timestep()
     {
@@ -385,31 +517,13 @@ namespace MeshMover {
         dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>>::AdditionalData gmres_settings(max_n_tmp_vectors, right_preconditioning, use_default_residual, force_re_orthogonalization);
         dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control, gmres_settings);
 
-        //dealii::TrilinosWrappers::PreconditionJacobi      precondition;
-        //precondition.initialize(system_matrix);
-
-        //dealii::TrilinosWrappers::PreconditionILU  precondition;
-        //const int ilu_fill = 2;
-        //dealii::TrilinosWrappers::PreconditionILU::AdditionalData precond_settings(ilu_fill, 0., 1.0, 1);
-        //precondition.initialize(system_matrix, precond_settings);
-
-        dealii::TrilinosWrappers::PreconditionILUT  precondition;
         const unsigned int ilut_fill=50;
         const double ilut_drop=1e-15;
         const double ilut_atol=1e-6;
         const double ilut_rtol=1.00001;
         const unsigned int overlap=1;
-        dealii::TrilinosWrappers::PreconditionILUT::AdditionalData precond_settings(ilut_drop, ilut_fill, ilut_atol, ilut_rtol, overlap);
-        precondition.initialize(system_matrix, precond_settings);
-
-
-        //const double 	omega = 1;
-        //const double 	min_diagonal = 1e-8;
-        //const unsigned int 	overlap = 1;
-        //const unsigned int 	n_sweeps = 1;
-        //dealii::TrilinosWrappers::PreconditionSSOR::AdditionalData precond_settings(omega, min_diagonal, overlap, n_sweeps);
-        //dealii::TrilinosWrappers::PreconditionSSOR  precondition;
-        //precondition.initialize(system_matrix, precond_settings);
+        const dealii::TrilinosWrappers::PreconditionILUT::AdditionalData precond_settings(ilut_drop, ilut_fill, ilut_atol, ilut_rtol, overlap);
+        update_preconditioner(precond_settings);
 
         using trilinos_vector_type = dealii::LinearAlgebra::distributed::Vector<double>;
         using payload_type = dealii::TrilinosWrappers::internal::LinearOperatorImplementation::TrilinosPayload;
@@ -421,22 +535,26 @@ namespace MeshMover {
 
         // Solve modified system.
         dealii::deallog.depth_console(2);
-        solver.solve(op_a, output_vector, rhs_vector, precondition);
+        try {
+            solver.solve(op_a, output_vector, rhs_vector, *preconditioner);
+        } catch (const dealii::SolverControl::NoConvergence &) {
+            // The second solve restarts from the unconverged solution.
+        }
 
         pcout << "dXvdXvs Solver took " << solver_control.last_step() << " steps. "
               << "Residual: " << solver_control.last_value() << ". "
               << std::endl;
 
-        solver.solve(op_a, output_vector, rhs_vector, precondition);
+        try {
+            solver.solve(op_a, output_vector, rhs_vector, *preconditioner);
+        } catch (const dealii::SolverControl::NoConvergence &) {
+            pcout << "Failed to converge." << std::endl;
+            std::abort();
+        }
 
         pcout << "dXvdXvs Solver took " << solver_control.last_step() << " steps. "
               << "Residual: " << solver_control.last_value() << ". "
               << std::endl;
-
-        if (solver_control.last_check() != dealii::SolverControl::State::success) {
-            pcout << "Failed to converge." << std::endl;
-            std::abort();
-        }
     }
 
     template <int dim, typename real>
@@ -446,8 +564,6 @@ namespace MeshMover {
         std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &list_of_vectors,
         dealii::TrilinosWrappers::SparseMatrix &output_matrix)
     {
-        assemble_system();
-
         const unsigned int n_rows = dof_handler.n_dofs();
         const unsigned int n_cols = list_of_vectors.size();
         //const unsigned int max_per_row = n_cols;
@@ -470,87 +586,168 @@ namespace MeshMover {
 
         output_matrix.reinit(row_part, col_part, full_sp, mpi_communicator);
 
-        //dealii::TrilinosWrappers::PreconditionJacobi      precondition;
-        //precondition.initialize(system_matrix);
+        pcout << "Applying for [dXvdXs] onto " << list_of_vectors.size() << " vectors..." << std::endl;
+        dXvdXs.resize(n_cols);
+        if (n_cols > 0) {
+            const Epetra_Map map = locally_owned_dofs.make_trilinos_map(mpi_communicator);
+            Epetra_MultiVector input_vectors(map, n_cols);
+            Epetra_MultiVector output_vectors(map, n_cols);
+            for (unsigned int col = 0; col < n_cols; ++col) {
+                for (unsigned int i = 0; i < locally_owned_dofs.n_elements(); ++i) {
+                    input_vectors[col][i] = list_of_vectors[col].local_element(i);
+                }
+            }
 
-        //dealii::TrilinosWrappers::PreconditionILU  precondition;
-        //const int ilu_fill = 2;
-        //dealii::TrilinosWrappers::PreconditionILU::AdditionalData precond_settings(ilu_fill, 0., 1.0, 1);
-        //precondition.initialize(system_matrix, precond_settings);
+            apply_dXvdXvs(input_vectors, output_vectors);
 
-        dealii::TrilinosWrappers::PreconditionILUT  precondition;
-        const unsigned int ilut_fill=50;
-        const double ilut_drop=0.0;//1e-15;
-        const double ilut_atol=0.0;//1e-6;
-        const double ilut_rtol=1.0;//1.00001;
-        const unsigned int overlap=1;
-        dealii::TrilinosWrappers::PreconditionILUT::AdditionalData precond_settings(ilut_drop, ilut_fill, ilut_atol, ilut_rtol, overlap);
-        precondition.initialize(system_matrix, precond_settings);
+            for (unsigned int col = 0; col < n_cols; ++col) {
+                dXvdXs[col].reinit(system_rhs);
+                for (unsigned int i = 0; i < locally_owned_dofs.n_elements(); ++i) {
+                    dXvdXs[col].local_element(i) = output_vectors[col][i];
+                }
+                dXvdXs[col].update_ghost_values();
+            }
+        }
 
+        for (unsigned int col = 0; col < n_cols; ++col) {
+            for (const auto &row: dof_handler.locally_owned_dofs()) {
+                output_matrix.set(row, col, dXvdXs[col][row]);
+            }
+        }
+        output_matrix.compress(dealii::VectorOperation::insert);
+
+    }
+
+    template <int dim, typename real>
+    void
+    LinearElasticity<dim,real>
+    ::apply_dXvdXvs(
+        const Epetra_MultiVector &input_vectors,
+        Epetra_MultiVector &output_vectors)
+    {
+        AssertDimension(input_vectors.NumVectors(), output_vectors.NumVectors());
+        AssertDimension(static_cast<unsigned int>(input_vectors.MyLength()), locally_owned_dofs.n_elements());
+        AssertDimension(static_cast<unsigned int>(output_vectors.MyLength()), locally_owned_dofs.n_elements());
 
-        //const double 	omega = 1;
-        //const double 	min_diagonal = 1e-8;
-        //const unsigned int 	overlap = 1;
-        //const unsigned int 	n_sweeps = 1;
-        //dealii::TrilinosWrappers::PreconditionSSOR::AdditionalData precond_settings(omega, min_diagonal, overlap, n_sweeps);
-        //dealii::TrilinosWrappers::PreconditionSSOR  precondition;
-        //precondition.initialize(system_matrix, precond_settings);
+        pcout << "Applying [dXvdXs] onto a multi-vector of " << input_vectors.NumVectors() << " vectors..." << std::endl;
+        solve_multiple_rhs(input_vectors, output_vectors);
+    }
+
+    template <int dim, typename real>
+    void
+    LinearElasticity<dim,real>
+    ::solve_multiple_rhs(
+        const Epetra_MultiVector &list_of_rhs,
+        Epetra_MultiVector &list_of_solutions)
+    {
+        assemble_system();
+        const unsigned int ilut_fill=50;
+        const double ilut_drop=0.0;
+        const double ilut_atol=0.0;
+        const double ilut_rtol=1.0;
+        const unsigned int overlap=1;
+        const dealii::TrilinosWrappers::PreconditionILUT::AdditionalData precond_settings(ilut_drop, ilut_fill, ilut_atol, ilut_rtol, overlap);
+        update_preconditioner(precond_settings);
 
         using trilinos_vector_type = dealii::LinearAlgebra::distributed::Vector<double>;
         using payload_type = dealii::TrilinosWrappers::internal::LinearOperatorImplementation::TrilinosPayload;
         const auto op_a = dealii::linear_operator<trilinos_vector_type,trilinos_vector_type,payload_type>(system_matrix);
 
-        dXvdXs.clear();
-        pcout << "Applying for [dXvdXs] onto " << list_of_vectors.size() << " vectors..." << std::endl;
-
-        unsigned int col = 0;
-        dealii::LinearAlgebra::distributed::Vector<double> output_vector;
-        output_vector.reinit(list_of_vectors[0]);
-        for (auto &input_vector: list_of_vectors) {
+        const int max_n_tmp_vectors=200;
+        const bool right_preconditioning=true;
+        const bool use_default_residual=true;
+        const bool force_re_orthogonalization=false;
+        const dealii::SolverGMRES<trilinos_vector_type>::AdditionalData gmres_settings(max_n_tmp_vectors, right_preconditioning, use_default_residual, force_re_orthogonalization);
+
+        // Orthonormal basis Q = A*Z of the previous solutions, used to project the initial guesses.
+        // It is limited to the size of the GMRES basis, such that its memory and projection cost per
+        // right-hand side stay bounded; the oldest solutions are dropped first.
+        const unsigned int max_n_recycled_vectors = max_n_tmp_vectors;
+        std::vector<trilinos_vector_type> recycled_a_times_solutions;
+        std::vector<trilinos_vector_type> recycled_solutions;
+
+        dealii::Timer timer;
+        unsigned int n_total_iterations = 0;
+        const unsigned int n_rhs = list_of_rhs.NumVectors();
+        const unsigned int n_locally_owned_dofs = locally_owned_dofs.n_elements();
+        trilinos_vector_type rhs, solution, residual;
+        for (unsigned int irhs = 0; irhs < n_rhs; ++irhs) {
+            // Work on one column at a time, such that the solves only store the recycled space.
+            rhs.reinit(system_rhs);
+            solution.reinit(system_rhs);
+            for (unsigned int i = 0; i < n_locally_owned_dofs; ++i) {
+                rhs.local_element(i) = list_of_rhs[irhs][i];
+            }
+            rhs.update_ghost_values();
 
-            pcout << " Vector " << col << " out of " << list_of_vectors.size() << std::endl;
+            const double rhs_norm = rhs.l2_norm();
+            if (rhs_norm == 0.0) {
+                pcout << " Vector " << irhs << " out of " << n_rhs << ": zero input vector. Zero output vector." << std::endl;
+                for (unsigned int i = 0; i < n_locally_owned_dofs; ++i) {
+                    list_of_solutions[irhs][i] = 0.0;
+                }
+                continue;
+            }
 
-            dealii::deallog.depth_console(0);
+            // Initial guess x = b + Z Q^T (b - A b), whose residual is orthogonal to the previous A*Z.
+            solution = rhs;
+            residual.reinit(rhs, true);
+            system_matrix.vmult(residual, solution);
+            residual.sadd(-1.0, 1.0, rhs);
+            for (unsigned int k = 0; k < recycled_solutions.size(); ++k) {
+                const double coefficient = recycled_a_times_solutions[k] * residual;
+                solution.add(coefficient, recycled_solutions[k]);
+            }
 
-            double input_vector_norm = input_vector.l2_norm();
-            if (input_vector_norm == 0.0) {
-                pcout << "Zero input vector. Zero output vector." << std::endl;
-                output_vector = 0.0;
-            } else {
-                const bool log_history = (this_mpi_process == 0);
-                dealii::SolverControl solver_control(20000, 1e-14 * input_vector_norm, log_history);
-                //dealii::SolverControl solver_control(20000, 1e-14, log_history);
-                solver_control.log_frequency(100);
-                const int max_n_tmp_vectors=200;
-                const bool right_preconditioning=true;
-                const bool use_default_residual=true;
-                const bool force_re_orthogonalization=false;
-                dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>>::AdditionalData gmres_settings(max_n_tmp_vectors, right_preconditioning, use_default_residual, force_re_orthogonalization);
-                dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control, gmres_settings);
-
-                //dealii::SolverBicgstab<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control);
-
-                dealii::deallog.depth_console(2);
-                solver.solve(op_a, output_vector, input_vector, precondition);
-                pcout << "dXvdXvs Solver took " << solver_control.last_step() << " steps. "
-                      << "Residual: " << solver_control.last_value() << ". "
-                      << std::endl;
+            const bool log_history = (this_mpi_process == 0);
+            dealii::SolverControl solver_control(20000, 1e-14 * rhs_norm, log_history);
+            solver_control.log_frequency(100);
+            dealii::SolverGMRES<trilinos_vector_type> solver(solver_control, gmres_settings);
 
-                solver.solve(op_a, output_vector, input_vector, precondition);
-                pcout << "dXvdXvs Solver took " << solver_control.last_step() << " steps. "
+            dealii::deallog.depth_console(0);
+            try {
+                solver.solve(op_a, solution, rhs, *preconditioner);
+            } catch (const dealii::SolverControl::NoConvergence &) {
+                pcout << " Vector " << irhs << " out of " << n_rhs
+                      << ": dXvdXvs Solver failed to converge in " << solver_control.last_step() << " steps. "
                       << "Residual: " << solver_control.last_value() << ". "
                       << std::endl;
+                std::abort();
+            }
+            n_total_iterations += solver_control.last_step();
+            pcout << " Vector " << irhs << " out of " << n_rhs
+                  << ": dXvdXvs Solver took " << solver_control.last_step() << " steps. "
+                  << "Residual: " << solver_control.last_value() << ". "
+                  << std::endl;
+            for (unsigned int i = 0; i < n_locally_owned_dofs; ++i) {
+                list_of_solutions[irhs][i] = solution.local_element(i);
             }
 
-            dXvdXs.push_back(output_vector);
-
-            for (const auto &row: dof_handler.locally_owned_dofs()) {
-                output_matrix.set(row, col, dXvdXs[col][row]);
+            // Add the solution to the recycled space through a Gram-Schmidt step on A*x.
+            trilinos_vector_type recycled_solution(solution);
+            trilinos_vector_type recycled_a_times_solution(rhs, true);
+            system_matrix.vmult(recycled_a_times_solution, recycled_solution);
+            const double a_times_solution_norm = recycled_a_times_solution.l2_norm();
+            for (unsigned int k = 0; k < recycled_solutions.size(); ++k) {
+                const double coefficient = recycled_a_times_solutions[k] * recycled_a_times_solution;
+                recycled_a_times_solution.add(-coefficient, recycled_a_times_solutions[k]);
+                recycled_solution.add(-coefficient, recycled_solutions[k]);
             }
-            col++;
+            const double orthogonal_norm = recycled_a_times_solution.l2_norm();
+            // Skip solutions already spanned by the recycled space.
+            if (orthogonal_norm <= 1e-10 * a_times_solution_norm) continue;
+            recycled_a_times_solution /= orthogonal_norm;
+            recycled_solution /= orthogonal_norm;
+            // Any subset of the orthonormal basis stays orthonormal.
+            if (recycled_solutions.size() == max_n_recycled_vectors) {
+                recycled_a_times_solutions.erase(recycled_a_times_solutions.begin());
+                recycled_solutions.erase(recycled_solutions.begin());
+            }
+            recycled_a_times_solutions.push_back(std::move(recycled_a_times_solution));
+            recycled_solutions.push_back(std::move(recycled_solution));
         }
-        output_matrix.compress(dealii::VectorOperation::insert);
-
+        pcout << "Solved " << n_rhs << " mesh sensitivity systems in " << n_total_iterations
+              << " total GMRES iterations and " << timer.wall_time() << "s." << std::endl;
     }
 
     template <int dim, typename real>
@@ -582,30 +779,13 @@ namespace MeshMover {
         dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>>::AdditionalData gmres_settings(max_n_tmp_vectors, right_preconditioning, use_default_residual, force_re_orthogonalization);
         dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control, gmres_settings);
 
-        //dealii::TrilinosWrappers::PreconditionJacobi      precondition;
-        //precondition.initialize(system_matrix);
-
-        // dealii::TrilinosWrappers::PreconditionILU  precondition;
-        // const int ilu_fill = 2;
-        // dealii::TrilinosWrappers::PreconditionILU::AdditionalData precond_settings(ilu_fill, 0., 1.0, 1);
-        // precondition.initialize(system_matrix, precond_settings);
-
-        dealii::TrilinosWrappers::PreconditionILUT  precondition;
         const unsigned int ilut_fill=50;
         const double ilut_drop=1e-15;
         const double ilut_atol=1e-6;
         const double ilut_rtol=1.00001;
         const unsigned int overlap=1;
-        dealii::TrilinosWrappers::PreconditionILUT::AdditionalData precond_settings(ilut_drop, ilut_fill, ilut_atol, ilut_rtol, overlap);
-        precondition.initialize(system_matrix, precond_settings);
-
-        //const double 	omega = 1;
-        //const double 	min_diagonal = 1e-8;
-        //const unsigned int 	overlap = 1;
-        //const unsigned int 	n_sweeps = 1;
-        //dealii::TrilinosWrappers::PreconditionSSOR::AdditionalData precond_settings(omega, min_diagonal, overlap, n_sweeps);
-        //dealii::TrilinosWrappers::PreconditionSSOR  precondition;
-        //precondition.initialize(system_matrix, precond_settings);
+        const dealii::TrilinosWrappers::PreconditionILUT::AdditionalData precond_settings(ilut_drop, ilut_fill, ilut_atol, ilut_rtol, overlap);
+        update_preconditioner(precond_settings);
 
         using trilinos_vector_type = VectorType;
         using payload_type = dealii::TrilinosWrappers::internal::LinearOperatorImplementation::TrilinosPayload;
@@ -615,18 +795,23 @@ namespace MeshMover {
         // Solve system.
         dealii::deallog.depth_console(2);
         output_vector = input_vector;
-        solver.solve(op_at, output_vector, input_vector, precondition);
-        pcout << "dXvdXvs_Transpose Solver took " << solver_control.last_step() << " steps. "
-              << "Residual: " << solver_control.last_value() << ". "
-              << std::endl;
-        solver.solve(op_at, output_vector, input_vector, precondition);
+        try {
+            solver.solve(op_at, output_vector, input_vector, *preconditioner);
+        } catch (const dealii::SolverControl::NoConvergence &) {
+            // The second solve restarts from the unconverged solution.
+        }
         pcout << "dXvdXvs_Transpose Solver took " << solver_control.last_step() << " steps. "
               << "Residual: " << solver_control.last_value() << ". "
               << std::endl;
-        if (solver_control.last_check() != dealii::SolverControl::State::success) {
+        try {
+            solver.solve(op_at, output_vector, input_vector, *preconditioner);
+        } catch (const dealii::SolverControl::NoConvergence &) {
             pcout << "Failed to converge." << std::endl;
             std::abort();
         }
+        pcout << "dXvdXvs_Transpose Solver took " << solver_control.last_step() << " steps. "
+              << "Residual: " << solver_control.last_value() << ". "
+              << std::endl;
 
 
     }
@@ -2,6 +2,11 @@
 #define __MESHMOVER_LINEAR_ELASTICITY_H__
 
 #include <deal.II/lac/trilinos_sparse_matrix.h>
+#include <deal.II/lac/trilinos_precondition.h>
+
+#include <Epetra_MultiVector.h>
+
+#include <cstdint>
 
 #include "parameters/all_parameters.h"
 
@@ -34,18 +39,23 @@ namespace MeshMover
     using Triangulation = dealii::parallel::distributed::Triangulation<dim>;
 #endif
       public:
+        /// Preconditioners of the mesh movement solves.
+        using PreconditionerEnum = Parameters::LinearSolverParam::MeshMovementPreconditionerEnum;
+
         /// Constructor.
         LinearElasticity(
             const Triangulation &_triangulation,
             const std::shared_ptr<dealii::MappingFEField<dim,dim,VectorType,DoFHandlerType>> mapping_fe_field,
             const DoFHandlerType &_dof_handler,
             const dealii::LinearAlgebra::distributed::Vector<int> &_boundary_ids_vector,
-            const dealii::LinearAlgebra::distributed::Vector<double> &_boundary_displacements_vector);
+            const dealii::LinearAlgebra::distributed::Vector<double> &_boundary_displacements_vector,
+            const PreconditionerEnum _preconditioner_type = PreconditionerEnum::ilut);
 
         /// Constructor that uses information from HighOrderGrid and uses current volume_nodes from HighOrderGrid.
         LinearElasticity(
             const HighOrderGrid<dim,real> &high_order_grid,
-   const dealii::LinearAlgebra::distributed::Vector<double> &boundary_displacements_vector);
+   const dealii::LinearAlgebra::distributed::Vector<double> &boundary_displacements_vector,
+            const PreconditionerEnum _preconditioner_type = PreconditionerEnum::ilut);
 
         /** Evaluate and return volume displacements given boundary displacements.
          */
@@ -62,6 +72,8 @@ namespace MeshMover
          *  If the right-hand-side are the surface node displacements indexed in a
          *  volume node vector, the result is a displacement vector of the volume
          *  volume_nodes (which include the prescribed surface nodes).
+         *  The right-hand sides are solved together through the multi-vector apply_dXvdXvs(),
+         *  and the results are also stored in dXvdXs.
          */
         void
         apply_dXvdXvs(std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &list_of_vectors, dealii::TrilinosWrappers::SparseMatrix &output_matrix);
@@ -76,6 +88,14 @@ namespace MeshMover
         void
         apply_dXvdXvs(const dealii::LinearAlgebra::distributed::Vector<double> &input_vector, dealii::LinearAlgebra::distributed::Vector<double> &output_vector);
 
+        /** Apply the analytical derivatives of volume displacements with respect
+         *  to surface displacements onto every column of a multi-vector.
+         *  The system is assembled and preconditioned once for all the columns.
+         *  Both multi-vectors must be distributed as the locally owned volume nodes.
+         */
+        void
+        apply_dXvdXvs(const Epetra_MultiVector &input_vectors, Epetra_MultiVector &output_vectors);
+
         /** Apply the transposed analytical derivatives of volume displacements with respect
          *  to surface displacements onto a right-hand sides.
          *  Note that the right-hand side and solution is of size n_volume_nodes.
@@ -126,6 +146,43 @@ namespace MeshMover
          */
         unsigned int solve_linear_problem();
 
+        /** Solves the mesh movement system for multiple right-hand sides.
+         *  The assembled matrix and its preconditioner are shared by all the solves, and the
+         *  initial guess of each solve is projected onto the span of the most recent solutions,
+         *  at most as many as the GMRES basis vectors.
+         */
+        void solve_multiple_rhs(
+            const Epetra_MultiVector &list_of_rhs,
+            Epetra_MultiVector &list_of_solutions);
+
+        /** Builds the preconditioner of system_matrix, unless it was already built from identical values
+         *  and, for ILUT, identical settings.
+         *  Must be called by all processes after assemble_system().
+         */
+        void update_preconditioner(const dealii::TrilinosWrappers::PreconditionILUT::AdditionalData &ilut_settings);
+
+        /// Hash of the locally owned rows of system_matrix, used to detect changes without storing a copy.
+        std::uint64_t hash_system_matrix() const;
+
+        /// Evaluates the translations and rotations of the locally owned DoFs, stored mode by mode.
+        void compute_rigid_body_modes();
+
+        /** Preconditioner of the mesh movement solves.
+         *  It is built on the first solve and reused by all following solves, e.g. for all the
+         *  right-hand sides of apply_dXvdXvs(), as long as the assembled matrix does not change.
+         */
+        const PreconditionerEnum preconditioner_type;
+        /// Preconditioner of system_matrix.
+        std::shared_ptr<dealii::TrilinosWrappers::PreconditionBase> preconditioner;
+        /// Hash of the locally owned rows of the system_matrix the preconditioner was built from.
+        std::uint64_t preconditioner_matrix_hash = 0;
+        /// ILUT settings the preconditioner was built with.
+        dealii::TrilinosWrappers::PreconditionILUT::AdditionalData preconditioner_ilut_settings;
+        /// Rigid-body modes used as the near-nullspace of the AMG preconditioner.
+        std::vector<double> rigid_body_modes;
+        /// Number of rigid-body modes.
+        int n_rigid_body_modes = 0;
+
         const Triangulation &triangulation; ///< Triangulation on which this acts.
         /// MappingFEField corresponding to curved mesh.
         const std::shared_ptr<dealii::MappingFEField<dim,dim,VectorType,DoFHandlerType>> mapping_fe_field;
@@ -16,6 +16,24 @@ void JacobianVectorProduct<dim,real,MeshType>:: reinit_for_next_timestep(const d
     dt = dt_input;
     fd_perturbation = fd_perturbation_input;
     previous_step_solution = previous_step_solution_input;
+    is_pseudotime_step = false;
+}
+
+template <int dim, typename real, typename MeshType>
+void JacobianVectorProduct<dim,real,MeshType>::reinit_for_pseudotime_step(const double fd_perturbation_input,
+                const dealii::LinearAlgebra::distributed::Vector<double> &current_solution_input,
+                const bool use_time_scaled_mass_matrix_input,
+                const double mass_scale_input)
+{
+    fd_perturbation = fd_perturbation_input;
+    is_pseudotime_step = true;
+    use_time_scaled_mass_matrix = use_time_scaled_mass_matrix_input;
+    pseudotime_mass_scale = mass_scale_input;
+
+    current_solution_estimate = std::make_unique<dealii::LinearAlgebra::distributed::Vector<double>>(current_solution_input);
+    dg->solution = current_solution_input;
+    dg->assemble_residual();
+    current_solution_estimate_residual = dg->right_hand_side;
 }
 
 template <int dim, typename real, typename MeshType>
@@ -34,7 +52,7 @@ void JacobianVectorProduct<dim,real,MeshType>::compute_dg_residual(dealii::Linea
     if(dg->all_parameters->use_inverse_mass_on_the_fly){
         dg->apply_inverse_global_mass_matrix(dg->right_hand_side, dg->solution);//dg->solution = IMM * RHS
     } else{
-        dg->global_inverse_mass_matrix.vmult(dg->solution, dg->right_hand_side);//dg->solution = IMM * RHS
+        dg->apply_stored_inverse_global_mass_matrix(dg->right_hand_side, dg->solution);//dg->solution = IMM * RHS
     }
     dst = dg->solution;
 }
@@ -65,6 +83,25 @@ template <int dim, typename real, typename MeshType>
 void JacobianVectorProduct<dim,real,MeshType>::vmult (dealii::LinearAlgebra::distributed::Vector<double> &destination,
                 const dealii::LinearAlgebra::distributed::Vector<double> &w) const
 {
+    if (is_pseudotime_step) {
+        // destination = mass_scale * M * w - 1/fd_perturbation * (R(current_soln_estimate + fd_perturbation*w) - R(current_soln_estimate))
+        dg->solution = (*current_solution_estimate);
+        dg->solution.add(fd_perturbation, w);
+        dg->assemble_residual();
+        dg->solution = (*current_solution_estimate);
+
+        destination = dg->right_hand_side;
+        destination -= current_solution_estimate_residual;
+        destination *= -1.0/fd_perturbation;
+
+        dealii::LinearAlgebra::distributed::Vector<double> mass_w;
+        mass_w.reinit(destination);
+        if (use_time_scaled_mass_matrix) dg->time_scaled_global_mass_matrix.vmult(mass_w, w);
+        else                             dg->apply_stored_global_mass_matrix(w, mass_w);
+        destination.add(pseudotime_mass_scale, mass_w);
+        return;
+    }
+
     destination = w;
     destination *= fd_perturbation; 
     destination += (*current_solution_estimate);
@@ -21,6 +21,16 @@ public:
     /// Reinitializes the stored data for the next Newton iteration.
     void reinit_for_next_Newton_iter(const dealii::LinearAlgebra::distributed::Vector<double> &current_solution_estimate_input);
 
+    /// Reinitializes the stored data for a pseudo-time step of the steady-state solver.
+    /** vmult then returns (mass_scale * M - dR/dW) w, with R = dg->right_hand_side
+     *  evaluated at current_solution_input. M is either dg's time-scaled mass matrix
+     *  of local time stepping or its global mass matrix.
+     */
+    void reinit_for_pseudotime_step(const double fd_perturbation_input,
+                const dealii::LinearAlgebra::distributed::Vector<double> &current_solution_input,
+                const bool use_time_scaled_mass_matrix_input,
+                const double mass_scale_input);
+
     /// Returns the product of the Jacobian with vector w, computed with a matrix-free finite difference approximation
     /** Write the results into destination. */
     void vmult (dealii::LinearAlgebra::distributed::Vector<double> &destination,
@@ -48,6 +58,15 @@ protected:
     
     /// residual of current estimate for the solution
     dealii::LinearAlgebra::distributed::Vector<double> current_solution_estimate_residual;
+
+    /// Flag for the steady-state pseudo-time step operator; false for the implicit Euler steps of the JFNK solver
+    bool is_pseudotime_step = false;
+
+    /// Flag to use the time-scaled mass matrix in the pseudo-time step operator, otherwise the global mass matrix
+    bool use_time_scaled_mass_matrix;
+
+    /// Factor multiplying the mass matrix of the pseudo-time step operator
+    double pseudotime_mass_scale;
     
     /// Compute residual from dg,  R(w) = IMM * RHS where RHS is evaluated using solution=w, and store in destination
     void compute_dg_residual(dealii::LinearAlgebra::distributed::Vector<double> &destination,
@@ -1,5 +1,8 @@
 #include "implicit_ode_solver.h"
 
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+
 
 namespace PHiLiP {
 namespace ODE {
@@ -7,42 +10,184 @@ namespace ODE {
 template <int dim, typename real, typename MeshType>
 ImplicitODESolver<dim,real,MeshType>::ImplicitODESolver(std::shared_ptr< DGBase<dim, real, MeshType> > dg_input)
         : ODESolverBase<dim,real,MeshType>(dg_input)
+        , jacobian_vector_product(dg_input)
+        , n_steps_since_preconditioner_update(0)
         {}
 
 template <int dim, typename real, typename MeshType>
 void ImplicitODESolver<dim,real,MeshType>::step_in_time (real dt, const bool pseudotime)
 {
-    const bool compute_dRdW = true;
-    this->dg->assemble_residual(compute_dRdW);
-    this->current_time += dt;
-    // Solve (M/dt - dRdW) dw = R
-    // w = w + dw
+    const Parameters::LinearSolverParam &linear_param = this->ODESolverBase<dim,real,MeshType>::all_parameters->linear_solver_param;
+    if (linear_param.use_jfnk_for_steady_state) {
+        this->current_time += dt;
+        solve_linear_matrix_free(dt, pseudotime);
+    } else {
+        const bool compute_dRdW = true;
+        this->dg->assemble_residual(compute_dRdW);
+        this->current_time += dt;
+        // Solve (M/dt - dRdW) dw = R
+        // w = w + dw
 
-    this->dg->system_matrix *= -1.0;
+        this->dg->system_matrix *= -1.0;
+
+        if (pseudotime) {
+            const double CFL = dt;
+            this->dg->time_scaled_mass_matrices(CFL);
+            this->dg->add_time_scaled_mass_matrices();
+        } else {
+            this->dg->add_mass_matrices(1.0/dt);
+        }
+
+        if ((this->ode_param.ode_output) == Parameters::OutputEnum::verbose &&
+            (this->current_iteration%this->ode_param.print_iteration_modulo) == 0 ) {
+            this->pcout << " Evaluating system update... " << std::endl;
+        }
+
+        using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+        const bool use_block_preconditioner = (linear_param.linear_solver_type == Parameters::LinearSolverParam::LinearSolverEnum::gmres)
+                                              && (linear_param.preconditioner_type != PreconditionerEnum::ilut);
+        if (use_block_preconditioner && linear_param.preconditioner_type == PreconditionerEnum::p_multigrid) {
+            update_p_multigrid_hierarchy();
+            solve_linear (
+                    this->dg->system_matrix,
+                    this->dg->right_hand_side,
+                    this->solution_update,
+                    linear_param,
+                    *p_multigrid_hierarchy);
+        } else if (use_block_preconditioner) {
+            solve_linear (
+                    this->dg->system_matrix,
+                    this->dg->right_hand_side,
+                    this->solution_update,
+                    linear_param,
+                    this->dg->locally_owned_cell_dof_indices());
+        } else {
+            solve_linear (
+                    this->dg->system_matrix,
+                    this->dg->right_hand_side,
+                    this->solution_update,
+                    linear_param);
+        }
+    }
+
+    linesearch();
 
+    this->update_norm = this->solution_update.l2_norm();
+    ++(this->current_iteration);
+}
+
+template <int dim, typename real, typename MeshType>
+void ImplicitODESolver<dim,real,MeshType>::solve_linear_matrix_free (real dt, const bool pseudotime)
+{
+    const Parameters::LinearSolverParam &linear_param = this->ODESolverBase<dim,real,MeshType>::all_parameters->linear_solver_param;
+    if (linear_param.linear_solver_type != Parameters::LinearSolverParam::LinearSolverEnum::gmres) {
+        this->pcout << "ERROR: use_jfnk_for_steady_state requires linear_solver_type = gmres. Aborting..." << std::endl;
+        std::abort();
+    }
+
+    if ((!matrix_free_preconditioner && !matrix_free_block_preconditioner) || n_steps_since_preconditioner_update >= linear_param.jacobian_update_frequency) {
+        update_matrix_free_preconditioner(dt, pseudotime);
+    }
+    ++n_steps_since_preconditioner_update;
+
+    // Evaluates R at the current solution, which also provides the cell-wise time steps of the mass matrix.
+    const dealii::LinearAlgebra::distributed::Vector<double> current_solution = this->dg->solution;
+    const bool use_time_scaled_mass_matrix = pseudotime;
     if (pseudotime) {
+        jacobian_vector_product.reinit_for_pseudotime_step(linear_param.perturbation_magnitude, current_solution, use_time_scaled_mass_matrix, 1.0);
         const double CFL = dt;
         this->dg->time_scaled_mass_matrices(CFL);
-        this->dg->add_time_scaled_mass_matrices();
     } else {
-        this->dg->add_mass_matrices(1.0/dt);
+        jacobian_vector_product.reinit_for_pseudotime_step(linear_param.perturbation_magnitude, current_solution, use_time_scaled_mass_matrix, 1.0/dt);
     }
+    // The Jacobian-vector products overwrite the right_hand_side.
+    const dealii::LinearAlgebra::distributed::Vector<double> right_hand_side = this->dg->right_hand_side;
 
     if ((this->ode_param.ode_output) == Parameters::OutputEnum::verbose &&
         (this->current_iteration%this->ode_param.print_iteration_modulo) == 0 ) {
-        this->pcout << " Evaluating system update... " << std::endl;
+        this->pcout << " Evaluating matrix-free system update... " << std::endl;
     }
 
-    solve_linear (
-            this->dg->system_matrix,
-            this->dg->right_hand_side,
-            this->solution_update,
-            this->ODESolverBase<dim,real,MeshType>::all_parameters->linear_solver_param);
+    using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+    const double linear_residual_tolerance = linear_param.linear_residual * right_hand_side.l2_norm();
+    dealii::SolverControl solver_control(linear_param.max_iterations, linear_residual_tolerance);
+    // Right preconditioning such that the tolerance applies to the unpreconditioned residual.
+    const bool right_preconditioning = true;
+    typename dealii::SolverGMRES<VectorType>::AdditionalData gmres_data(linear_param.restart_number, right_preconditioning);
+    dealii::SolverGMRES<VectorType> solver_gmres(solver_control, gmres_data);
 
-    linesearch();
+    this->solution_update = 0.0;
+    try {
+        if (matrix_free_block_preconditioner) {
+            solver_gmres.solve(jacobian_vector_product, this->solution_update, right_hand_side, *matrix_free_block_preconditioner);
+        } else {
+            solver_gmres.solve(jacobian_vector_product, this->solution_update, right_hand_side, *matrix_free_preconditioner);
+        }
+    } catch (const dealii::SolverControl::NoConvergence &) {
+        // Keep the partially converged update, but refresh the lagged preconditioner at the next step.
+        n_steps_since_preconditioner_update = linear_param.jacobian_update_frequency;
+    }
+    this->pcout << " Matrix-free GMRES took " << solver_control.last_step()
+                << " iterations resulting in a linear residual of " << solver_control.last_value()
+                << " (tolerance " << linear_residual_tolerance << ")." << std::endl;
 
-    this->update_norm = this->solution_update.l2_norm();
-    ++(this->current_iteration);
+    this->dg->solution = current_solution;
+    this->dg->right_hand_side = right_hand_side;
+}
+
+template <int dim, typename real, typename MeshType>
+void ImplicitODESolver<dim,real,MeshType>::update_matrix_free_preconditioner (real dt, const bool pseudotime)
+{
+    const Parameters::LinearSolverParam &linear_param = this->ODESolverBase<dim,real,MeshType>::all_parameters->linear_solver_param;
+    this->pcout << " Assembling the Jacobian of the matrix-free preconditioner... " << std::endl;
+
+    const bool compute_dRdW = true;
+    this->dg->assemble_residual(compute_dRdW);
+    this->dg->system_matrix *= -1.0;
+    if (pseudotime) {
+        const double CFL = dt;
+        this->dg->time_scaled_mass_matrices(CFL);
+        this->dg->add_time_scaled_mass_matrices();
+    } else {
+        this->dg->add_mass_matrices(1.0/dt);
+    }
+
+    if (linear_param.jfnk_preconditioner_type == Parameters::LinearSolverParam::JFNKPreconditionerEnum::block_jacobi) {
+        // The cell blocks are gathered from the DoF indices of each cell, such that they hold for any
+        // DoF renumbering, varying polynomial degrees and processes without cells.
+        matrix_free_preconditioner.reset();
+        matrix_free_block_preconditioner = std::make_shared<DGBlockPreconditioner>();
+        matrix_free_block_preconditioner->initialize(this->dg->system_matrix, this->dg->locally_owned_cell_dof_indices(),
+                                                     Parameters::LinearSolverParam::PreconditionerEnum::block_jacobi);
+    } else if (linear_param.ilut_fill < 1) {
+        using AdditionalData = dealii::TrilinosWrappers::PreconditionILU::AdditionalData;
+        const unsigned int overlap = 1;
+        std::shared_ptr<dealii::TrilinosWrappers::PreconditionILU> ilu = std::make_shared<dealii::TrilinosWrappers::PreconditionILU>();
+        ilu->initialize(this->dg->system_matrix, AdditionalData(std::abs(linear_param.ilut_fill), linear_param.ilut_atol, linear_param.ilut_rtol, overlap));
+        matrix_free_preconditioner = ilu;
+        matrix_free_block_preconditioner.reset();
+    } else {
+        using AdditionalData = dealii::TrilinosWrappers::PreconditionILUT::AdditionalData;
+        const unsigned int overlap = 1;
+        std::shared_ptr<dealii::TrilinosWrappers::PreconditionILUT> ilut = std::make_shared<dealii::TrilinosWrappers::PreconditionILUT>();
+        ilut->initialize(this->dg->system_matrix, AdditionalData(linear_param.ilut_drop, linear_param.ilut_fill, linear_param.ilut_atol, linear_param.ilut_rtol, overlap));
+        matrix_free_preconditioner = ilut;
+        matrix_free_block_preconditioner.reset();
+    }
+    n_steps_since_preconditioner_update = 0;
+}
+
+template <int dim, typename real, typename MeshType>
+void ImplicitODESolver<dim,real,MeshType>::update_p_multigrid_hierarchy ()
+{
+    const std::vector<std::vector<dealii::types::global_dof_index>> cell_dof_indices = this->dg->locally_owned_cell_dof_indices();
+    const bool is_outdated = !p_multigrid_hierarchy || (p_multigrid_hierarchy->level_cell_dof_indices.back() != cell_dof_indices);
+    const bool rebuild = (dealii::Utilities::MPI::max(static_cast<unsigned int>(is_outdated), this->mpi_communicator) == 1);
+    if (!rebuild) return;
+
+    const Parameters::LinearSolverParam &linear_param = this->ODESolverBase<dim,real,MeshType>::all_parameters->linear_solver_param;
+    p_multigrid_hierarchy = std::make_shared<PMultigridHierarchy>(this->dg->build_p_multigrid_hierarchy(linear_param.p_multigrid_coarse_degree));
+    this->pcout << " Built " << p_multigrid_hierarchy->n_levels() << " p-multigrid levels." << std::endl;
 }
 
 template <int dim, typename real, typename MeshType>
@@ -1,9 +1,12 @@
 #ifndef __IMPLICIT_ODESOLVER__
 #define __IMPLICIT_ODESOLVER__
 
+#include <deal.II/lac/trilinos_precondition.h>
+
 #include "dg/dg_base.hpp"
 #include "linear_solver/linear_solver.h"
 #include "ode_solver_base.h"
+#include "JFNK_solver/jacobian_vector_product.h"
 
 namespace PHiLiP {
 namespace ODE {
@@ -25,6 +28,13 @@ namespace ODE {
  *      \frac{\mathbf{u}^{n+1} - \mathbf{u}^{n}}{\Delta t} = \mathbf{R}(\mathbf{u}^{n}) +
  *      \left. \frac{\partial \mathbf{R}}{\partial \mathbf{u}} \right|_{\mathbf{u}^{n}} (\mathbf{u}^{n+1} - \mathbf{u}^{n})
  *  \f]
+ *
+ *  If use_jfnk_for_steady_state is set, the linear system of each step is instead solved
+ *  by GMRES with finite difference Jacobian-vector products, and the Jacobian is only
+ *  assembled every jacobian_update_frequency steps to build a lagged preconditioner.
+ *
+ *  If the p_multigrid preconditioner is selected, the polynomial levels are built from the
+ *  DG degrees and are only rebuilt when the discretization changes, e.g. during polynomial ramping.
  */
 #if PHILIP_DIM==1
 template <int dim, typename real, typename MeshType = dealii::Triangulation<dim>>
@@ -46,6 +56,31 @@ public:
     /// Line search algorithm
     double linesearch ();
 
+protected:
+    /// Solves (M/dt - dRdW) dw = R with matrix-free GMRES, preconditioned by a lagged Jacobian.
+    void solve_linear_matrix_free (real dt, const bool pseudotime);
+
+    /// Assembles (M/dt - dRdW) in the system_matrix and builds the preconditioner from it.
+    void update_matrix_free_preconditioner (real dt, const bool pseudotime);
+
+    /// Matrix-free (M/dt - dRdW) operator
+    JacobianVectorProduct<dim,real,MeshType> jacobian_vector_product;
+
+    /// ILU preconditioner built from the lagged Jacobian
+    std::shared_ptr<dealii::TrilinosWrappers::PreconditionBase> matrix_free_preconditioner;
+
+    /// Cell block Jacobi preconditioner built from the lagged Jacobian
+    std::shared_ptr<DGBlockPreconditioner> matrix_free_block_preconditioner;
+
+    /// Number of steps taken since the preconditioner was last built
+    int n_steps_since_preconditioner_update;
+
+    /// Rebuilds the p-multigrid levels if the discretization changed since they were built.
+    void update_p_multigrid_hierarchy ();
+
+    /// Polynomial levels of the p-multigrid preconditioner
+    std::shared_ptr<PMultigridHierarchy> p_multigrid_hierarchy;
+
 };
 
 } // ODE namespace
@@ -0,0 +1,145 @@
+#include "low_storage_runge_kutta_ode_solver.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+template <int dim, typename real, typename MeshType> 
+LowStorageRungeKuttaODESolver<dim,real,MeshType>::LowStorageRungeKuttaODESolver(std::shared_ptr< DGBase<dim, real, MeshType> > dg_input,
+        std::shared_ptr<LowStorageRKTableauBase<dim,real,MeshType>> rk_tableau_input,
+        std::shared_ptr<EmptyRRKBase<dim,real,MeshType>> RRK_object_input)
+        : ODESolverBase<dim,real,MeshType>(dg_input)
+        , butcher_tableau(rk_tableau_input)
+        , relaxation_runge_kutta(RRK_object_input)
+        , n_rk_stages(rk_tableau_input->n_rk_stages)
+        , store_stage_derivatives(RRK_object_input->requires_stage_derivatives())
+{}
+
+template <int dim, typename real, typename MeshType> 
+void LowStorageRungeKuttaODESolver<dim,real,MeshType>::step_in_time (real dt, const bool pseudotime)
+{
+    this->original_time_step = dt;
+    // u_n is only needed to compute the relaxation parameter
+    if (store_stage_derivatives) this->solution_update = this->dg->solution;
+
+    this->low_storage_register = 0.0;
+
+    // dg->solution holds the register Q, i.e. the solution at the current stage
+    for (int i = 0; i < n_rk_stages; ++i){
+
+        // If using the entropy formulation of RRK, solutions must be stored.
+        relaxation_runge_kutta->store_stage_solutions(i, this->dg->solution);
+
+        // Apply limiter at every RK stage
+        if (this->limiter) {
+            this->limiter->limit(this->dg->solution,
+                this->dg->dof_handler,
+                this->dg->fe_collection,
+                this->dg->volume_quadrature_collection,
+                this->dg->high_order_grid->fe_system.tensor_degree(),
+                this->dg->max_degree,
+                this->dg->oneD_fe_collection_1state,
+                this->dg->oneD_quadrature_collection);
+        }
+
+        //set the DG current time for unsteady source terms
+        this->dg->set_current_time(this->current_time + this->butcher_tableau->get_c(i)*dt);
+
+        //solve the system's right hand side
+        this->dg->assemble_residual();
+
+        if(this->all_parameters->use_inverse_mass_on_the_fly){
+            this->dg->apply_inverse_global_mass_matrix(this->dg->right_hand_side, this->stage_derivative); //stage_derivative = IMM*RHS = F(Q)
+        } else{
+            this->dg->apply_stored_inverse_global_mass_matrix(this->dg->right_hand_side, this->stage_derivative); //stage_derivative = IMM*RHS = F(Q)
+        }
+
+        if (store_stage_derivatives) this->rk_stage[i] = this->stage_derivative;
+
+        if(pseudotime) {
+            const double CFL = dt;
+            this->dg->time_scale_solution_update(this->stage_derivative, CFL);
+        } else {
+            this->stage_derivative *= dt;
+        }
+
+        // dQ = A_i * dQ + dt * F(Q)
+        this->low_storage_register.sadd(this->butcher_tableau->get_low_storage_a(i), 1.0, this->stage_derivative);
+        // Q = Q + B_i * dQ
+        this->dg->solution.add(this->butcher_tableau->get_low_storage_b(i), this->low_storage_register);
+    }
+
+    // Calculates relaxation parameter and modify the time step size as dt*=relaxation_parameter.
+    // if not using RRK, the relaxation parameter will be set to 1, such that dt is not modified.
+    this->relaxation_parameter_RRK_solver = 1.0;
+    if (store_stage_derivatives) {
+        // Reuse dQ to store u_np1 - u_n = dt * sum(b_i * k_i), since update_relaxation_parameter overwrites dg->solution
+        this->low_storage_register = this->dg->solution;
+        this->low_storage_register -= this->solution_update;
+
+        this->relaxation_parameter_RRK_solver = relaxation_runge_kutta->update_relaxation_parameter(dt, this->dg, this->rk_stage, this->solution_update);
+
+        this->dg->solution = this->solution_update;
+        this->dg->solution.add(this->relaxation_parameter_RRK_solver, this->low_storage_register); // u_np1 = u_n + gamma * dt * sum(b_i * k_i)
+    }
+    dt *= this->relaxation_parameter_RRK_solver;
+    this->modified_time_step = dt;
+
+    // Calculate numerical entropy with FR correction. Does nothing if use has not selected param.
+    this->FR_entropy_contribution_RRK_solver = relaxation_runge_kutta->compute_FR_entropy_contribution(dt, this->dg, this->rk_stage, true);
+
+    // Apply limiter at the end of the step
+    if (this->limiter) {
+        this->limiter->limit(this->dg->solution,
+            this->dg->dof_handler,
+            this->dg->fe_collection,
+            this->dg->volume_quadrature_collection,
+            this->dg->high_order_grid->fe_system.tensor_degree(),
+            this->dg->max_degree,
+            this->dg->oneD_fe_collection_1state,
+            this->dg->oneD_quadrature_collection);
+    }
+
+    ++(this->current_iteration);
+    this->current_time += dt;
+}
+
+template <int dim, typename real, typename MeshType> 
+void LowStorageRungeKuttaODESolver<dim,real,MeshType>::allocate_ode_system ()
+{
+    this->pcout << "Allocating ODE system..." << std::flush;
+    if(this->all_parameters->use_inverse_mass_on_the_fly == false) {
+        this->pcout << " evaluating inverse mass matrix..." << std::flush;
+        this->dg->evaluate_mass_matrices(true); // creates and stores global inverse mass matrix
+        //RRK needs both mass matrix and inverse mass matrix
+        using ODEEnum = Parameters::ODESolverParam::ODESolverEnum;
+        ODEEnum ode_type = this->ode_param.ode_solver_type;
+        if (ode_type == ODEEnum::rrk_explicit_solver){
+            this->dg->evaluate_mass_matrices(false); // creates and stores global mass matrix
+        }
+    }
+    this->pcout << std::endl;
+
+    this->low_storage_register.reinit(this->dg->solution);
+    this->stage_derivative.reinit(this->dg->solution);
+
+    // Stage derivatives and u_n are only kept if the RRK object requires them
+    this->rk_stage.clear();
+    if (store_stage_derivatives) {
+        this->solution_update.reinit(this->dg->right_hand_side);
+        this->rk_stage.resize(n_rk_stages);
+        for (int i=0; i<n_rk_stages; ++i) {
+            this->rk_stage[i].reinit(this->dg->solution);
+        }
+    }
+
+    this->butcher_tableau->set_tableau();
+}
+
+template class LowStorageRungeKuttaODESolver<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM> >;
+template class LowStorageRungeKuttaODESolver<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM> >;
+#if PHILIP_DIM != 1
+    template class LowStorageRungeKuttaODESolver<PHILIP_DIM, double, dealii::parallel::distributed::Triangulation<PHILIP_DIM> >;
+#endif
+
+} // ODESolver namespace
+} // PHiLiP namespace
@@ -0,0 +1,67 @@
+#ifndef __LOW_STORAGE_RUNGE_KUTTA_ODESOLVER__
+#define __LOW_STORAGE_RUNGE_KUTTA_ODESOLVER__
+
+#include "dg/dg_base.hpp"
+#include "ode_solver_base.h"
+#include "runge_kutta_methods/low_storage_rk_tableau_base.h"
+#include "relaxation_runge_kutta/empty_RRK_base.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+/// Low-storage (2N) explicit Runge-Kutta ODE solver derived from ODESolver.
+/** Unlike RungeKuttaODESolver, which stores the derivative at every stage,
+ *  this solver only holds the register dQ and the stage derivative in addition to dg->solution,
+ *  independently of the number of stages. See LowStorageRKTableauBase for the update formula.
+ *
+ *  The limiter is applied to the solution at every stage and after the step.
+ *  If the RRK object needs the stage derivatives (RRK or numerical entropy), they are
+ *  also stored, such that the relaxation can be computed from the equivalent Butcher tableau.
+ */
+#if PHILIP_DIM==1
+template <int dim, typename real, typename MeshType = dealii::Triangulation<dim>>
+#else
+template <int dim, typename real, typename MeshType = dealii::parallel::distributed::Triangulation<dim>>
+#endif
+class LowStorageRungeKuttaODESolver: public ODESolverBase <dim, real, MeshType>
+{
+public:
+    LowStorageRungeKuttaODESolver(std::shared_ptr< DGBase<dim, real, MeshType> > dg_input,
+            std::shared_ptr<LowStorageRKTableauBase<dim,real,MeshType>> rk_tableau_input,
+            std::shared_ptr<EmptyRRKBase<dim,real,MeshType>> RRK_object_input); ///< Constructor.
+
+    /// Function to evaluate solution update
+    void step_in_time(real dt, const bool pseudotime);
+
+    /// Function to allocate the ODE system
+    void allocate_ode_system ();
+
+protected:
+    /// Stores the low-storage coefficients and the equivalent Butcher tableau
+    std::shared_ptr<LowStorageRKTableauBase<dim,real,MeshType>> butcher_tableau;
+
+    /// Stores functions related to relaxation Runge-Kutta (RRK).
+    /// Functions are empty by default.
+    std::shared_ptr<EmptyRRKBase<dim,real,MeshType>> relaxation_runge_kutta;
+
+    /// Number of stages of the low-storage method
+    const int n_rk_stages;
+
+    /// Flag to store the derivative at every stage; only true if required by relaxation_runge_kutta
+    bool store_stage_derivatives;
+
+    /// Second register of the 2N scheme, dQ
+    dealii::LinearAlgebra::distributed::Vector<double> low_storage_register;
+
+    /// Derivative at the current stage, i.e. inverse mass matrix times the residual
+    dealii::LinearAlgebra::distributed::Vector<double> stage_derivative;
+
+    /// Storage for the derivative at each Runge-Kutta stage
+    /** Only allocated if store_stage_derivatives is true */
+    std::vector<dealii::LinearAlgebra::distributed::Vector<double>> rk_stage;
+};
+
+} // ODE namespace
+} // PHiLiP namespace
+
+#endif
@@ -1,5 +1,6 @@
 #include "ode_solver_base.h"
 #include "limiter/bound_preserving_limiter_factory.hpp"
+#include "reduced_order/snapshot_file.h"
 
 namespace PHiLiP {
 namespace ODE{
@@ -15,8 +16,9 @@ ODESolverBase<dim,real,MeshType>::ODESolverBase(std::shared_ptr< DGBase<dim, rea
         , current_desired_time_for_output_solution_every_dt_time_intervals(ode_param.initial_desired_time_for_output_solution_every_dt_time_intervals)
         , original_time_step(0.0)
         , modified_time_step(0.0)
-        , mpi_communicator(MPI_COMM_WORLD)
-        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD))
+        , error_controlled_time_step(0.0)
+        , mpi_communicator(dg->mpi_communicator)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
         , pcout(std::cout, mpi_rank==0)
 {}
 
@@ -32,6 +34,12 @@ double ODESolverBase<dim,real,MeshType>::get_modified_time_step() const
     return this->modified_time_step;
 }
 
+template <int dim, typename real, typename MeshType>
+double ODESolverBase<dim,real,MeshType>::get_error_controlled_time_step() const
+{
+    return this->error_controlled_time_step;
+}
+
 template <int dim, typename real, typename MeshType>
 void ODESolverBase<dim,real,MeshType>::initialize_steady_polynomial_ramping (const unsigned int global_final_poly_degree)
 {
@@ -213,15 +221,10 @@ int ODESolverBase<dim,real,MeshType>::steady_state ()
     }
 
     if (ode_param.output_final_steady_state_solution_to_file) {
-        dealii::LinearAlgebra::ReadWriteVector<double> write_dg_solution(this->dg->solution.size());
-        write_dg_solution.import(this->dg->solution, dealii::VectorOperation::values::insert);
-        if(mpi_rank == 0){
-            std::ofstream out_file(ode_param.steady_state_final_solution_filename + ".txt");
-            for(unsigned int i = 0 ; i < write_dg_solution.size() ; i++){
-                out_file << " " << std::setprecision(17) << write_dg_solution(i) << " \n";
-            }
-            out_file.close();
-        }
+        // Every process writes its own values of the solution into the binary snapshot file, read by the offline POD.
+        const ProperOrthogonalDecomposition::SnapshotFile snapshot_file(ode_param.steady_state_final_solution_filename + ".snapshots", mpi_communicator);
+        snapshot_file.write(this->dg->solution, ProperOrthogonalDecomposition::SnapshotFileOrdering(*(this->dg)),
+                            ProperOrthogonalDecomposition::snapshot_file_header(*(this->dg)));
     }
 
     pcout << " ********************************************************** "
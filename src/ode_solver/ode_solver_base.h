@@ -117,9 +117,17 @@ public:
     /// Getter for modified_time_step
     double get_modified_time_step() const;
 
+    /// Getter for error_controlled_time_step
+    double get_error_controlled_time_step() const;
+
 protected:
-    double original_time_step;///< Original time step before calling step_in_time
+    /// Original time step before calling step_in_time
+    /** Solvers with error control reduce it to the accepted time step when steps are rejected. */
+    double original_time_step;
     double modified_time_step;///< Modified time step after calling step_in_time
+    /// Time step proposed for the next step by the embedded error estimate
+    /** Only assigned by RK solvers using an embedded pair with error control; zero otherwise. */
+    double error_controlled_time_step;
 public:
     
     /// Entropy FR correction at the current timestep
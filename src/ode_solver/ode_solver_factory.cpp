@@ -2,6 +2,7 @@
 #include "parameters/all_parameters.h"
 #include "ode_solver_base.h"
 #include "runge_kutta_ode_solver.h"
+#include "low_storage_runge_kutta_ode_solver.h"
 #include "implicit_ode_solver.h"
 #include "relaxation_runge_kutta/algebraic_rrk_ode_solver.h"
 #include "relaxation_runge_kutta/root_finding_rrk_ode_solver.h"
@@ -10,6 +11,7 @@
 #include <deal.II/distributed/solution_transfer.h>
 #include "runge_kutta_methods/runge_kutta_methods.h"
 #include "runge_kutta_methods/rk_tableau_base.h"
+#include "runge_kutta_methods/low_storage_runge_kutta_methods.h"
 #include "relaxation_runge_kutta/empty_RRK_base.h"
 
 namespace PHiLiP {
@@ -22,6 +24,7 @@ std::shared_ptr<ODESolverBase<dim,real,MeshType>> ODESolverFactory<dim,real,Mesh
     pcout << "Creating ODE Solver..." << std::endl;
     using ODEEnum = Parameters::ODESolverParam::ODESolverEnum;
     const ODEEnum ode_solver_type = dg_input->all_parameters->ode_solver_param.ode_solver_type;
+    check_error_controlled_time_step(ode_solver_type, dg_input);
     if((ode_solver_type == ODEEnum::runge_kutta_solver)||(ode_solver_type == ODEEnum::rrk_explicit_solver))     
         return create_RungeKuttaODESolver(dg_input);
     if(ode_solver_type == ODEEnum::implicit_solver)         
@@ -39,6 +42,7 @@ std::shared_ptr<ODESolverBase<dim,real,MeshType>> ODESolverFactory<dim,real,Mesh
     pcout << "Creating ODE Solver..." << std::endl;
     using ODEEnum = Parameters::ODESolverParam::ODESolverEnum;
     const ODEEnum ode_solver_type = dg_input->all_parameters->ode_solver_param.ode_solver_type;
+    check_error_controlled_time_step(ode_solver_type, dg_input);
     if(ode_solver_type == ODEEnum::pod_galerkin_solver)
         return std::make_shared<PODGalerkinODESolver<dim,real,MeshType>>(dg_input, pod);
     if(ode_solver_type == ODEEnum::pod_petrov_galerkin_solver) 
@@ -55,6 +59,7 @@ std::shared_ptr<ODESolverBase<dim,real,MeshType>> ODESolverFactory<dim,real,Mesh
     dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
     pcout << "Creating ODE Solver..." << std::endl;
     using ODEEnum = Parameters::ODESolverParam::ODESolverEnum;
+    check_error_controlled_time_step(ode_solver_type, dg_input);
     if((ode_solver_type == ODEEnum::runge_kutta_solver)||(ode_solver_type == ODEEnum::rrk_explicit_solver))     
         return create_RungeKuttaODESolver(dg_input);
     if(ode_solver_type == ODEEnum::implicit_solver)         
@@ -71,6 +76,7 @@ std::shared_ptr<ODESolverBase<dim,real,MeshType>> ODESolverFactory<dim,real,Mesh
     dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
     pcout << "Creating ODE Solver..." << std::endl;
     using ODEEnum = Parameters::ODESolverParam::ODESolverEnum;
+    check_error_controlled_time_step(ode_solver_type, dg_input);
     if(ode_solver_type == ODEEnum::pod_galerkin_solver) 
         return std::make_shared<PODGalerkinODESolver<dim,real,MeshType>>(dg_input, pod);
     if(ode_solver_type == ODEEnum::pod_petrov_galerkin_solver) 
@@ -82,6 +88,19 @@ std::shared_ptr<ODESolverBase<dim,real,MeshType>> ODESolverFactory<dim,real,Mesh
 }
 
 
+template <int dim, typename real, typename MeshType>
+void ODESolverFactory<dim,real,MeshType>::check_error_controlled_time_step(Parameters::ODESolverParam::ODESolverEnum ode_solver_type, std::shared_ptr< DGBase<dim,real,MeshType> > dg_input)
+{
+    using ODEEnum = Parameters::ODESolverParam::ODESolverEnum;
+    if (dg_input->all_parameters->ode_solver_param.use_error_controlled_time_step
+        && ode_solver_type != ODEEnum::runge_kutta_solver && ode_solver_type != ODEEnum::rrk_explicit_solver) {
+        dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+        pcout << "Error: error-controlled time step is only available for explicit RK solvers "
+              << "(runge_kutta or rrk_explicit with an embedded pair). Aborting..." << std::endl;
+        std::abort();
+    }
+}
+
 template <int dim, typename real, typename MeshType>
 void ODESolverFactory<dim,real,MeshType>::display_error_ode_solver_factory(Parameters::ODESolverParam::ODESolverEnum ode_solver_type, bool reduced_order) 
 {
@@ -126,7 +145,22 @@ std::shared_ptr<ODESolverBase<dim,real,MeshType>> ODESolverFactory<dim,real,Mesh
     const int n_rk_stages = dg_input->all_parameters->ode_solver_param.n_rk_stages;
     using ODEEnum = Parameters::ODESolverParam::ODESolverEnum;
     const ODEEnum ode_solver_type = dg_input->all_parameters->ode_solver_param.ode_solver_type;
-    if (ode_solver_type == ODEEnum::runge_kutta_solver || ode_solver_type == ODEEnum::rrk_explicit_solver) {
+    if (dg_input->all_parameters->ode_solver_param.use_error_controlled_time_step
+        && dg_input->all_parameters->ode_solver_param.rk_embedded_order == 0) {
+        pcout << "Error: error-controlled time step requires an RK method with an embedded pair (bs3_ex). Aborting..." << std::endl;
+        std::abort();
+        return nullptr;
+    }
+    if ((ode_solver_type == ODEEnum::runge_kutta_solver || ode_solver_type == ODEEnum::rrk_explicit_solver)
+        && dg_input->all_parameters->ode_solver_param.rk_low_storage) {
+        // Low-storage solver is not templated on the number of stages
+        pcout << "Creating Low-Storage Runge Kutta ODE Solver with " 
+              << n_rk_stages << " stage(s)..." << std::endl;
+        std::shared_ptr<LowStorageRKTableauBase<dim,real,MeshType>> low_storage_rk_tableau 
+            = std::dynamic_pointer_cast<LowStorageRKTableauBase<dim,real,MeshType>>(rk_tableau);
+        return std::make_shared<LowStorageRungeKuttaODESolver<dim,real,MeshType>>(dg_input,low_storage_rk_tableau,RRK_object);
+    }
+    else if (ode_solver_type == ODEEnum::runge_kutta_solver || ode_solver_type == ODEEnum::rrk_explicit_solver) {
         // Hard-coded templating of n_rk_stages because it is not known at compile time
         pcout << "Creating Runge Kutta ODE Solver with " 
               << n_rk_stages << " stage(s)..." << std::endl;
@@ -179,6 +213,9 @@ std::shared_ptr<RKTableauBase<dim,real,MeshType>> ODESolverFactory<dim,real,Mesh
     if (rk_method == RKMethodEnum::euler_im)    return std::make_shared<EulerImplicit<dim, real, MeshType>>  (n_rk_stages, "Implicit Euler (implicit)");
     if (rk_method == RKMethodEnum::dirk_2_im)   return std::make_shared<DIRK2Implicit<dim, real, MeshType>>  (n_rk_stages, "2nd order diagonally-implicit (implicit)");
     if (rk_method == RKMethodEnum::dirk_3_im)   return std::make_shared<DIRK3Implicit<dim, real, MeshType>>  (n_rk_stages, "3nd order diagonally-implicit (implicit)");
+    if (rk_method == RKMethodEnum::bs3_ex)      return std::make_shared<BogackiShampine32Explicit<dim, real, MeshType>>  (n_rk_stages, "3rd order Bogacki-Shampine with embedded 2nd order pair (explicit)");
+    if (rk_method == RKMethodEnum::lsrk3_2N_ex) return std::make_shared<LowStorageRK3Williamson<dim, real, MeshType>>  (n_rk_stages, "3rd order Williamson low-storage 2N (explicit)");
+    if (rk_method == RKMethodEnum::lsrk4_2N_ex) return std::make_shared<LowStorageRK4CarpenterKennedy<dim, real, MeshType>>  (n_rk_stages, "4th order Carpenter-Kennedy low-storage 2N (explicit)");
     else {
         pcout << "Error: invalid RK method. Aborting..." << std::endl;
         std::abort();
@@ -1,5 +1,5 @@
 #include "pod_galerkin_ode_solver.h"
-#include <EpetraExt_MatrixMatrix.h>
+#include "reduced_order/reduced_basis_operations.h"
 
 namespace PHiLiP {
 namespace ODE {
@@ -10,20 +10,18 @@ PODGalerkinODESolver<dim,real,MeshType>::PODGalerkinODESolver(std::shared_ptr< D
 {}
 
 template <int dim, typename real, typename MeshType>
-std::shared_ptr<Epetra_CrsMatrix> PODGalerkinODESolver<dim,real,MeshType>::generate_test_basis(const Epetra_CrsMatrix &/*system_matrix*/, const Epetra_CrsMatrix &pod_basis)
+std::shared_ptr<Epetra_MultiVector> PODGalerkinODESolver<dim,real,MeshType>::generate_test_basis(const Epetra_CrsMatrix &/*system_matrix*/, const Epetra_MultiVector &pod_basis)
 {
-    return std::make_shared<Epetra_CrsMatrix>(pod_basis);
+    return std::make_shared<Epetra_MultiVector>(pod_basis);
 }
 
 template <int dim, typename real, typename MeshType>
-std::shared_ptr<Epetra_CrsMatrix> PODGalerkinODESolver<dim,real,MeshType>::generate_reduced_lhs(const Epetra_CrsMatrix &system_matrix, Epetra_CrsMatrix &test_basis)
+std::shared_ptr<Epetra_SerialDenseMatrix> PODGalerkinODESolver<dim,real,MeshType>::generate_reduced_lhs(const Epetra_CrsMatrix &system_matrix, const Epetra_MultiVector &test_basis)
 {
-    Epetra_CrsMatrix epetra_reduced_lhs(Epetra_DataAccess::View, test_basis.DomainMap(), test_basis.NumGlobalCols());
-    Epetra_CrsMatrix epetra_reduced_lhs_tmp(Epetra_DataAccess::View, test_basis.RowMap(), test_basis.NumGlobalCols());
-    EpetraExt::MatrixMatrix::Multiply(system_matrix, false, test_basis, false, epetra_reduced_lhs_tmp, true);
-    EpetraExt::MatrixMatrix::Multiply(test_basis, true, epetra_reduced_lhs_tmp, false, epetra_reduced_lhs);
+    Epetra_MultiVector epetra_reduced_lhs_tmp(system_matrix.RangeMap(), test_basis.NumVectors());
+    system_matrix.Multiply(false, test_basis, epetra_reduced_lhs_tmp);
 
-    return std::make_shared<Epetra_CrsMatrix>(epetra_reduced_lhs);
+    return std::make_shared<Epetra_SerialDenseMatrix>(ProperOrthogonalDecomposition::transpose_product(test_basis, epetra_reduced_lhs_tmp));
 }
 
 
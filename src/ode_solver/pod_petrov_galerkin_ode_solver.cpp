@@ -1,5 +1,7 @@
 #include "pod_petrov_galerkin_ode_solver.h"
-#include <EpetraExt_MatrixMatrix.h>
+#include "reduced_order/reduced_basis_operations.h"
+
+#include <cmath>
 
 namespace PHiLiP {
 namespace ODE {
@@ -10,22 +12,24 @@ PODPetrovGalerkinODESolver<dim,real,MeshType>::PODPetrovGalerkinODESolver(std::s
 {}
 
 template <int dim, typename real, typename MeshType>
-std::shared_ptr<Epetra_CrsMatrix> PODPetrovGalerkinODESolver<dim,real,MeshType>::generate_test_basis(const Epetra_CrsMatrix &system_matrix, const Epetra_CrsMatrix &pod_basis)
+std::shared_ptr<Epetra_MultiVector> PODPetrovGalerkinODESolver<dim,real,MeshType>::generate_test_basis(const Epetra_CrsMatrix &system_matrix, const Epetra_MultiVector &pod_basis)
 {
-    Epetra_Map system_matrix_rowmap = system_matrix.RowMap();
-    Epetra_CrsMatrix petrov_galerkin_basis(Epetra_DataAccess::Copy, system_matrix_rowmap, pod_basis.NumGlobalCols());
-    EpetraExt::MatrixMatrix::Multiply(system_matrix, false, pod_basis, false, petrov_galerkin_basis, true);
+    std::shared_ptr<Epetra_MultiVector> petrov_galerkin_basis = std::make_shared<Epetra_MultiVector>(system_matrix.RangeMap(), pod_basis.NumVectors());
+    system_matrix.Multiply(false, pod_basis, *petrov_galerkin_basis);
 
-    return std::make_shared<Epetra_CrsMatrix>(petrov_galerkin_basis);
+    return petrov_galerkin_basis;
 }
 
 template <int dim, typename real, typename MeshType>
-std::shared_ptr<Epetra_CrsMatrix> PODPetrovGalerkinODESolver<dim,real,MeshType>::generate_reduced_lhs(const Epetra_CrsMatrix &/*system_matrix*/, Epetra_CrsMatrix &test_basis)
+std::shared_ptr<Epetra_SerialDenseMatrix> PODPetrovGalerkinODESolver<dim,real,MeshType>::generate_reduced_lhs(const Epetra_CrsMatrix &/*system_matrix*/, const Epetra_MultiVector &test_basis)
 {
-    Epetra_CrsMatrix epetra_reduced_lhs(Epetra_DataAccess::Copy, test_basis.DomainMap(), test_basis.NumGlobalCols());
-    EpetraExt::MatrixMatrix::Multiply(test_basis, true, test_basis, false, epetra_reduced_lhs);
+    return std::make_shared<Epetra_SerialDenseMatrix>(ProperOrthogonalDecomposition::transpose_product(test_basis, test_basis));
+}
 
-    return std::make_shared<Epetra_CrsMatrix>(epetra_reduced_lhs);
+template <int dim, typename real, typename MeshType>
+double PODPetrovGalerkinODESolver<dim,real,MeshType>::hyper_reduction_row_scaling(const double cell_weight) const
+{
+    return std::sqrt(cell_weight);
 }
 
 
@@ -30,10 +30,14 @@ public:
     PODPetrovGalerkinODESolver(std::shared_ptr< DGBase<dim, real, MeshType> > dg_input, std::shared_ptr<ProperOrthogonalDecomposition::PODBase<dim>> pod); ///< Constructor.
 
     ///Generate test basis
-    std::shared_ptr<Epetra_CrsMatrix> generate_test_basis(const Epetra_CrsMatrix &epetra_system_matrix, const Epetra_CrsMatrix &pod_basis) override;
+    std::shared_ptr<Epetra_MultiVector> generate_test_basis(const Epetra_CrsMatrix &epetra_system_matrix, const Epetra_MultiVector &pod_basis) override;
 
     ///Generate reduced LHS
-    std::shared_ptr<Epetra_CrsMatrix> generate_reduced_lhs(const Epetra_CrsMatrix &epetra_system_matrix, Epetra_CrsMatrix &test_basis) override;
+    std::shared_ptr<Epetra_SerialDenseMatrix> generate_reduced_lhs(const Epetra_CrsMatrix &epetra_system_matrix, const Epetra_MultiVector &test_basis) override;
+
+protected:
+    /// The test basis W = sqrt(D)*J*V already carries one factor of the weights, such that W^T*W = V^T*J^T*D*J*V.
+    double hyper_reduction_row_scaling(const double cell_weight) const override;
 };
 
 } // ODE namespace
@@ -1,16 +1,19 @@
 #include "reduced_order_ode_solver.h"
 
-#include <Amesos_Lapack.h>
-#include <Epetra_LinearProblem.h>
+#include <Epetra_LocalMap.h>
 #include <Epetra_Vector.h>
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/trilinos_sparsity_pattern.h>
+#include <deal.II/base/timer.h>
+
+#include <utility>
 
-#include "Amesos_BaseSolver.h"
 #include "dg/dg_base.hpp"
 #include "linear_solver/linear_solver.h"
 #include "ode_solver_base.h"
 #include "reduced_order/pod_basis_base.h"
+#include "reduced_order/nnls_solver.h"
+#include "reduced_order/reduced_basis_operations.h"
 
 namespace PHiLiP {
 namespace ODE {
@@ -21,6 +24,15 @@ ReducedOrderODESolver<dim,real,MeshType>::ReducedOrderODESolver(std::shared_ptr<
         , pod(pod)
 {}
 
+template <int dim, typename real, typename MeshType>
+ReducedOrderODESolver<dim,real,MeshType>::~ReducedOrderODESolver()
+{
+    // Restore the full assembly of the discretization, which outlives the hyper-reduced solver.
+    if (this->all_parameters->reduced_order_param.hyper_reduction == Parameters::ReducedOrderModelParam::HyperReductionEnum::ecsw) {
+        this->dg->set_sample_mesh(dealii::LinearAlgebra::distributed::Vector<double>());
+    }
+}
+
 template <int dim, typename real, typename MeshType>
 int ReducedOrderODESolver<dim,real,MeshType>::steady_state ()
 {
@@ -40,12 +52,11 @@ int ReducedOrderODESolver<dim,real,MeshType>::steady_state ()
     const bool compute_dRdW = true;
     this->dg->assemble_residual(compute_dRdW);
 
-    const Epetra_CrsMatrix epetra_system_matrix = this->dg->system_matrix.trilinos_matrix();
-    const Epetra_CrsMatrix epetra_pod_basis = pod->getPODBasis()->trilinos_matrix();
-    std::shared_ptr<Epetra_CrsMatrix> epetra_test_basis = generate_test_basis(epetra_system_matrix, epetra_pod_basis);
-    Epetra_Vector epetra_right_hand_side(Epetra_DataAccess::Copy, epetra_system_matrix.RowMap(), this->dg->right_hand_side.begin());
-    Epetra_Vector epetra_reduced_rhs(epetra_test_basis->DomainMap());
-    epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+    std::shared_ptr<Epetra_CrsMatrix> epetra_system_matrix = get_weighted_system_matrix();
+    const Epetra_MultiVector &epetra_pod_basis = *pod->getPODBasisDense();
+    std::shared_ptr<Epetra_MultiVector> epetra_test_basis = generate_test_basis(*epetra_system_matrix, epetra_pod_basis);
+    Epetra_Vector epetra_reduced_rhs(ProperOrthogonalDecomposition::reduced_space_map(*epetra_test_basis));
+    project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
     epetra_reduced_rhs.Norm2(&this->initial_residual_norm);
     this->initial_residual_norm /= this->dg->right_hand_side.size();
 
@@ -117,23 +128,21 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
         this->pcout << " Evaluating system update... " << std::endl;
     }
 
-    const Epetra_CrsMatrix epetra_system_matrix = this->dg->system_matrix.trilinos_matrix();
-    const Epetra_CrsMatrix epetra_pod_basis = pod->getPODBasis()->trilinos_matrix();
-    std::shared_ptr<Epetra_CrsMatrix> epetra_test_basis = generate_test_basis(epetra_system_matrix, epetra_pod_basis);
+    std::shared_ptr<Epetra_CrsMatrix> epetra_system_matrix = get_weighted_system_matrix();
+    const Epetra_MultiVector &epetra_pod_basis = *pod->getPODBasisDense();
+    std::shared_ptr<Epetra_MultiVector> epetra_test_basis = generate_test_basis(*epetra_system_matrix, epetra_pod_basis);
 
-    Epetra_Vector epetra_right_hand_side(Epetra_DataAccess::View, epetra_system_matrix.RowMap(), this->dg->right_hand_side.begin());
-    Epetra_Vector epetra_reduced_rhs(epetra_test_basis->DomainMap());
-    epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
-    std::shared_ptr<Epetra_CrsMatrix> epetra_reduced_lhs = generate_reduced_lhs(epetra_system_matrix, *epetra_test_basis);
-    Epetra_Vector epetra_reduced_solution_update(epetra_reduced_lhs->DomainMap());
-    Epetra_LinearProblem linearProblem(epetra_reduced_lhs.get(), &epetra_reduced_solution_update, &epetra_reduced_rhs);
+    const Epetra_LocalMap reduced_map = ProperOrthogonalDecomposition::reduced_space_map(epetra_pod_basis);
+    Epetra_Vector epetra_reduced_rhs(reduced_map);
+    project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
+    std::shared_ptr<Epetra_SerialDenseMatrix> epetra_reduced_lhs = generate_reduced_lhs(*epetra_system_matrix, *epetra_test_basis);
 
-    Amesos_Lapack Solver(linearProblem);
-    Teuchos::ParameterList List;
-    Solver.SetParameters(List);
-    Solver.SymbolicFactorization();
-    Solver.NumericFactorization();
-    Solver.Solve();
+    // The reduced system is small and dense, such that every process solves it.
+    Epetra_Vector epetra_reduced_solution_update(reduced_map);
+    if (ProperOrthogonalDecomposition::solve_reduced_system(*epetra_reduced_lhs, epetra_reduced_rhs, epetra_reduced_solution_update) != 0) {
+        this->pcout << "Error: the reduced linear system is singular." << std::endl;
+        std::abort();
+    }
 
     const dealii::LinearAlgebra::distributed::Vector<double> old_solution(this->dg->solution);
     double step_length = 1.0;
@@ -145,12 +154,12 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
     double initial_residual;
     epetra_reduced_rhs.Norm2(&initial_residual);
     initial_residual /= this->dg->right_hand_side.size();
-    Epetra_Vector epetra_solution(Epetra_DataAccess::View, epetra_pod_basis.RangeMap(), this->dg->solution.begin());
-    Epetra_Vector epetra_solution_update(epetra_pod_basis.RangeMap());
-    epetra_pod_basis.Multiply(false, epetra_reduced_solution_update, epetra_solution_update);
+    Epetra_Vector epetra_solution(Epetra_DataAccess::View, epetra_pod_basis.Map(), this->dg->solution.begin());
+    Epetra_Vector epetra_solution_update(epetra_pod_basis.Map());
+    epetra_solution_update.Multiply('N', 'N', 1.0, epetra_pod_basis, epetra_reduced_solution_update, 0.0);
     epetra_solution.Update(1, epetra_solution_update, 1);
     this->dg->assemble_residual();
-    epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+    project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
     double new_residual;
     epetra_reduced_rhs.Norm2(&new_residual);
     new_residual /= this->dg->right_hand_side.size();
@@ -165,10 +174,10 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
         this->dg->solution = old_solution;
         Epetra_Vector epetra_linesearch_reduced_solution_update(epetra_reduced_solution_update);
         epetra_linesearch_reduced_solution_update.Scale(step_length);
-        epetra_pod_basis.Multiply(false, epetra_linesearch_reduced_solution_update, epetra_solution_update);
+        epetra_solution_update.Multiply('N', 'N', 1.0, epetra_pod_basis, epetra_linesearch_reduced_solution_update, 0.0);
         epetra_solution.Update(1, epetra_solution_update, 1);
         this->dg->assemble_residual();
-        epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+        project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
         epetra_reduced_rhs.Norm2(&new_residual);
         new_residual /= this->dg->right_hand_side.size();
         this->pcout << " Step length " << step_length << " . Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
@@ -181,7 +190,7 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
         this->pcout << " Line search failed. Will accept any valid residual less than " << reduction_tolerance_2 << " times the current " << initial_residual << "residual. " << std::endl;
         epetra_solution.Update(1, epetra_solution_update, 1);
         this->dg->assemble_residual();
-        epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+        project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
         epetra_reduced_rhs.Norm2(&new_residual);
         new_residual /= this->dg->right_hand_side.size();
         this->pcout << " Step length " << step_length << " . Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
@@ -190,10 +199,10 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
             this->dg->solution = old_solution;
             Epetra_Vector epetra_linesearch_reduced_solution_update(epetra_reduced_solution_update);
             epetra_linesearch_reduced_solution_update.Scale(step_length);
-            epetra_pod_basis.Multiply(false, epetra_linesearch_reduced_solution_update, epetra_solution_update);
+            epetra_solution_update.Multiply('N', 'N', 1.0, epetra_pod_basis, epetra_linesearch_reduced_solution_update, 0.0);
             epetra_solution.Update(1, epetra_solution_update, 1);
             this->dg->assemble_residual();
-            epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+            project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
             epetra_reduced_rhs.Norm2(&new_residual);
             new_residual /= this->dg->right_hand_side.size();
             this->pcout << " Step length " << step_length << " . Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
@@ -205,7 +214,7 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
         step_length = -1.0;
         epetra_solution.Update(-1, epetra_solution_update, 1);
         this->dg->assemble_residual();
-        epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+        project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
         epetra_reduced_rhs.Norm2(&new_residual);
         new_residual /= this->dg->right_hand_side.size();
         this->pcout << " Step length " << step_length << " . Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
@@ -214,10 +223,10 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
             this->dg->solution = old_solution;
             Epetra_Vector epetra_linesearch_reduced_solution_update(epetra_reduced_solution_update);
             epetra_linesearch_reduced_solution_update.Scale(step_length);
-            epetra_pod_basis.Multiply(false, epetra_linesearch_reduced_solution_update, epetra_solution_update);
+            epetra_solution_update.Multiply('N', 'N', 1.0, epetra_pod_basis, epetra_linesearch_reduced_solution_update, 0.0);
             epetra_solution.Update(1, epetra_solution_update, 1);
             this->dg->assemble_residual();
-            epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+            project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
             epetra_reduced_rhs.Norm2(&new_residual);
             new_residual /= this->dg->right_hand_side.size();
             this->pcout << " Step length " << step_length << " . Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
@@ -229,7 +238,7 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
         step_length = -1.0;
         epetra_solution.Update(-1, epetra_solution_update, 1);
         this->dg->assemble_residual();
-        epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+        project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
         epetra_reduced_rhs.Norm2(&new_residual);
         new_residual /= this->dg->right_hand_side.size();
         this->pcout << " Step length " << step_length << " . Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
@@ -238,10 +247,10 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
             this->dg->solution = old_solution;
             Epetra_Vector epetra_linesearch_reduced_solution_update(epetra_reduced_solution_update);
             epetra_linesearch_reduced_solution_update.Scale(step_length);
-            epetra_pod_basis.Multiply(false, epetra_linesearch_reduced_solution_update, epetra_solution_update);
+            epetra_solution_update.Multiply('N', 'N', 1.0, epetra_pod_basis, epetra_linesearch_reduced_solution_update, 0.0);
             epetra_solution.Update(1, epetra_solution_update, 1);
             this->dg->assemble_residual();
-            epetra_test_basis->Multiply(true, epetra_right_hand_side, epetra_reduced_rhs);
+            project_right_hand_side(*epetra_test_basis, epetra_reduced_rhs);
             epetra_reduced_rhs.Norm2(&new_residual);
             new_residual /= this->dg->right_hand_side.size();
             this->pcout << " Step length " << step_length << " . Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
@@ -253,7 +262,10 @@ void ReducedOrderODESolver<dim,real,MeshType>::step_in_time (real /*dt*/, const
         this->dg->solution = old_solution;
     }
 
-    this->pcout << "Full-order residual norm: " << this->dg->get_residual_l2norm() << std::endl;
+    // The residual is only assembled on the sample mesh when hyper-reduced.
+    if (hyper_reduction_row_weights.empty()) {
+        this->pcout << "Full-order residual norm: " << this->dg->get_residual_l2norm() << std::endl;
+    }
 
     this->residual_norm = new_residual;
 
@@ -269,27 +281,186 @@ void ReducedOrderODESolver<dim,real,MeshType>::allocate_ode_system ()
     In 54th AIAA Aerospace Sciences Meeting (p. 1814).
     */
     this->pcout << "Allocating ODE system..." << std::endl;
+    if (this->all_parameters->reduced_order_param.hyper_reduction == Parameters::ReducedOrderModelParam::HyperReductionEnum::ecsw) {
+        compute_hyper_reduction();
+    }
+
     dealii::LinearAlgebra::distributed::Vector<double> reference_solution(this->dg->solution);
     reference_solution.import(pod->getReferenceState(), dealii::VectorOperation::values::insert);
 
     dealii::LinearAlgebra::distributed::Vector<double> initial_condition(this->dg->solution);
     initial_condition -= reference_solution;
 
-    const Epetra_CrsMatrix epetra_pod_basis = pod->getPODBasis()->trilinos_matrix();
-    Epetra_Vector epetra_reduced_solution(epetra_pod_basis.DomainMap());
-    Epetra_Vector epetra_initial_condition(Epetra_DataAccess::Copy, epetra_pod_basis.RangeMap(), initial_condition.begin());
+    const Epetra_MultiVector &epetra_pod_basis = *pod->getPODBasisDense();
+    Epetra_Vector epetra_reduced_solution(ProperOrthogonalDecomposition::reduced_space_map(epetra_pod_basis));
+    Epetra_Vector epetra_initial_condition(Epetra_DataAccess::Copy, epetra_pod_basis.Map(), initial_condition.begin());
 
-    epetra_pod_basis.Multiply(true, epetra_initial_condition, epetra_reduced_solution);
+    epetra_reduced_solution.Multiply('T', 'N', 1.0, epetra_pod_basis, epetra_initial_condition, 0.0);
 
-    Epetra_Vector epetra_projection_tmp(epetra_pod_basis.RangeMap());
-    epetra_pod_basis.Multiply(false, epetra_reduced_solution, epetra_projection_tmp);
+    Epetra_Vector epetra_projection_tmp(epetra_pod_basis.Map());
+    epetra_projection_tmp.Multiply('N', 'N', 1.0, epetra_pod_basis, epetra_reduced_solution, 0.0);
 
-    Epetra_Vector epetra_solution(Epetra_DataAccess::View, epetra_pod_basis.RangeMap(), this->dg->solution.begin());
+    Epetra_Vector epetra_solution(Epetra_DataAccess::View, epetra_pod_basis.Map(), this->dg->solution.begin());
 
     epetra_solution = epetra_projection_tmp;
     this->dg->solution += reference_solution;
 }
 
+template <int dim, typename real, typename MeshType>
+double ReducedOrderODESolver<dim,real,MeshType>::hyper_reduction_row_scaling (const double cell_weight) const
+{
+    return cell_weight;
+}
+
+template <int dim, typename real, typename MeshType>
+void ReducedOrderODESolver<dim,real,MeshType>::compute_hyper_reduction ()
+{
+    /*Energy-conserving sampling and weighting (ECSW) of the cells, refer to:
+    Farhat, C., Chapman, T., & Avery, P. (2015).
+    Structure-preserving, stability, and accuracy properties of the energy-conserving sampling and weighting method for the hyper reduction of nonlinear finite element dynamic models.
+    International Journal for Numerical Methods in Engineering, 102(5), 1077-1110.
+    The reduced residual W^T*R is the sum over the cells of W_e^T*R_e. The weights xi >= 0 are chosen such that
+    the sum of xi_e*W_e^T*R_e over few cells reproduces it for a set of training states.
+    */
+    this->pcout << "Computing ECSW hyper-reduction..." << std::endl;
+    dealii::Timer timer;
+
+    hyper_reduction_row_weights.clear();
+    this->dg->set_sample_mesh(dealii::LinearAlgebra::distributed::Vector<double>());
+
+    // The converged snapshots have a vanishing residual. The training states are therefore the
+    // reference state and the midpoints between the reference state and each snapshot, which lie in the affine reduced space.
+    const Epetra_MultiVector &snapshots = *pod->getSnapshots();
+    dealii::LinearAlgebra::distributed::Vector<double> reference_state(this->dg->solution);
+    reference_state.import(pod->getReferenceState(), dealii::VectorOperation::values::insert);
+    const unsigned int n_training_states = snapshots.NumVectors() + 1;
+
+    const Epetra_MultiVector &epetra_pod_basis = *pod->getPODBasisDense();
+    const unsigned int n_modes = epetra_pod_basis.NumVectors();
+
+    const dealii::IndexSet &locally_owned_dofs = this->dg->locally_owned_dofs;
+    const std::vector<std::vector<dealii::types::global_dof_index>> cell_dof_indices = this->dg->locally_owned_cell_dof_indices();
+    const unsigned int n_local_cells = cell_dof_indices.size();
+
+    // Reduced residual contribution of each locally owned cell, for each training state and mode.
+    Eigen::MatrixXd local_contributions = Eigen::MatrixXd::Zero(n_training_states * n_modes, n_local_cells);
+    const dealii::LinearAlgebra::distributed::Vector<double> old_solution(this->dg->solution);
+    for (unsigned int istate = 0; istate < n_training_states; ++istate) {
+        for (const auto &dof : locally_owned_dofs) {
+            const int local_row = snapshots.Map().LID(static_cast<int>(dof));
+            this->dg->solution[dof] = (istate == 0) ? reference_state[dof] : 0.5 * (reference_state[dof] + snapshots[istate-1][local_row]);
+        }
+        this->dg->solution.update_ghost_values();
+
+        const bool compute_dRdW = true;
+        this->dg->assemble_residual(compute_dRdW);
+        std::shared_ptr<Epetra_CrsMatrix> epetra_system_matrix = get_weighted_system_matrix();
+        std::shared_ptr<Epetra_MultiVector> epetra_test_basis = generate_test_basis(*epetra_system_matrix, epetra_pod_basis);
+
+        for (unsigned int icell = 0; icell < n_local_cells; ++icell) {
+            for (const auto &dof : cell_dof_indices[icell]) {
+                const double residual = this->dg->right_hand_side[dof];
+                const int local_row = epetra_test_basis->Map().LID(static_cast<int>(dof));
+                for (unsigned int mode = 0; mode < n_modes; ++mode) {
+                    local_contributions(istate * n_modes + mode, icell) += (*epetra_test_basis)[mode][local_row] * residual;
+                }
+            }
+        }
+    }
+    this->dg->solution = old_solution;
+
+    // Gather the contributions of all the cells on the first process, ordered by process.
+    const unsigned int n_mpi = dealii::Utilities::MPI::n_mpi_processes(this->mpi_communicator);
+    const unsigned int mpi_rank = dealii::Utilities::MPI::this_mpi_process(this->mpi_communicator);
+    const std::vector<unsigned int> n_cells_per_process = dealii::Utilities::MPI::all_gather(this->mpi_communicator, n_local_cells);
+    std::vector<int> n_values_per_process(n_mpi), value_offsets(n_mpi);
+    unsigned int n_global_cells = 0, cell_offset = 0;
+    for (unsigned int iproc = 0; iproc < n_mpi; ++iproc) {
+        n_values_per_process[iproc] = n_cells_per_process[iproc] * local_contributions.rows();
+        value_offsets[iproc] = n_global_cells * local_contributions.rows();
+        if (iproc == mpi_rank) cell_offset = n_global_cells;
+        n_global_cells += n_cells_per_process[iproc];
+    }
+    Eigen::MatrixXd contributions;
+    if (mpi_rank == 0) contributions.resize(local_contributions.rows(), n_global_cells);
+    MPI_Gatherv(local_contributions.data(), n_values_per_process[mpi_rank], MPI_DOUBLE,
+                contributions.data(), n_values_per_process.data(), value_offsets.data(), MPI_DOUBLE,
+                0, this->mpi_communicator);
+
+    // The first process solves the non-negative least-squares problem and broadcasts the weights.
+    Eigen::VectorXd cell_weights(n_global_cells);
+    double relative_residual = 0.0;
+    if (mpi_rank == 0) {
+        const Eigen::VectorXd full_mesh_residuals = contributions * Eigen::VectorXd::Ones(n_global_cells);
+        ProperOrthogonalDecomposition::NNLSSolver nnls(std::move(contributions), full_mesh_residuals, this->all_parameters->reduced_order_param.ecsw_tolerance, n_global_cells);
+        if (!nnls.solve()) {
+            this->pcout << "Warning: ECSW did not reach its tolerance. Relative residual: " << nnls.getRelativeResidual() << std::endl;
+        }
+        cell_weights = nnls.getSolution();
+        relative_residual = nnls.getRelativeResidual();
+    }
+    MPI_Bcast(cell_weights.data(), n_global_cells, MPI_DOUBLE, 0, this->mpi_communicator);
+    MPI_Bcast(&relative_residual, 1, MPI_DOUBLE, 0, this->mpi_communicator);
+
+    dealii::LinearAlgebra::distributed::Vector<double> sampled_dofs(this->dg->solution);
+    sampled_dofs = 0.0;
+    hyper_reduction_row_weights.assign(locally_owned_dofs.n_elements(), 0.0);
+    for (unsigned int icell = 0; icell < n_local_cells; ++icell) {
+        const double cell_weight = cell_weights(cell_offset + icell);
+        if (cell_weight == 0.0) continue;
+        for (const auto &dof : cell_dof_indices[icell]) {
+            sampled_dofs[dof] = cell_weight;
+            hyper_reduction_row_weights[locally_owned_dofs.index_within_set(dof)] = hyper_reduction_row_scaling(cell_weight);
+        }
+    }
+    sampled_dofs.update_ghost_values();
+    this->dg->set_sample_mesh(sampled_dofs);
+
+    this->pcout << "ECSW sampled " << (cell_weights.array() > 0.0).count() << " out of " << n_global_cells
+                << " cells with a relative residual of " << relative_residual
+                << " in " << timer.wall_time() << "s." << std::endl;
+}
+
+template <int dim, typename real, typename MeshType>
+std::shared_ptr<Epetra_CrsMatrix> ReducedOrderODESolver<dim,real,MeshType>::get_weighted_system_matrix () const
+{
+    const Epetra_CrsMatrix &epetra_system_matrix = this->dg->system_matrix.trilinos_matrix();
+    if (hyper_reduction_row_weights.empty()) return std::make_shared<Epetra_CrsMatrix>(epetra_system_matrix);
+
+    // Only copying the sampled rows keeps the cost of the test basis products proportional to the sample mesh.
+    std::shared_ptr<Epetra_CrsMatrix> weighted_system_matrix = std::make_shared<Epetra_CrsMatrix>(Epetra_DataAccess::Copy, epetra_system_matrix.RowMap(), 0);
+    std::vector<int> global_columns;
+    std::vector<double> weighted_values;
+    for (int row = 0; row < epetra_system_matrix.NumMyRows(); ++row) {
+        const double row_weight = hyper_reduction_row_weights[row];
+        if (row_weight == 0.0) continue;
+
+        int n_entries;
+        double *values;
+        int *indices;
+        epetra_system_matrix.ExtractMyRowView(row, n_entries, values, indices);
+        global_columns.resize(n_entries);
+        weighted_values.resize(n_entries);
+        for (int k = 0; k < n_entries; ++k) {
+            global_columns[k] = epetra_system_matrix.ColMap().GID(indices[k]);
+            weighted_values[k] = row_weight * values[k];
+        }
+        weighted_system_matrix->InsertGlobalValues(epetra_system_matrix.RowMap().GID(row), n_entries, weighted_values.data(), global_columns.data());
+    }
+    weighted_system_matrix->FillComplete(epetra_system_matrix.DomainMap(), epetra_system_matrix.RangeMap());
+    return weighted_system_matrix;
+}
+
+template <int dim, typename real, typename MeshType>
+void ReducedOrderODESolver<dim,real,MeshType>::project_right_hand_side (const Epetra_MultiVector &test_basis, Epetra_Vector &reduced_rhs) const
+{
+    Epetra_Vector epetra_right_hand_side(Epetra_DataAccess::Copy, test_basis.Map(), this->dg->right_hand_side.begin());
+    for (unsigned int row = 0; row < hyper_reduction_row_weights.size(); ++row) {
+        epetra_right_hand_side[row] *= hyper_reduction_row_weights[row];
+    }
+    reduced_rhs.Multiply('T', 'N', 1.0, test_basis, epetra_right_hand_side, 0.0);
+}
+
 template class ReducedOrderODESolver<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM>>;
 template class ReducedOrderODESolver<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM>>;
 #if PHILIP_DIM != 1
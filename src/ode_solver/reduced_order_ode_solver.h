@@ -5,6 +5,10 @@
 #include "ode_solver_base.h"
 #include "reduced_order/pod_basis_base.h"
 
+#include <Epetra_MultiVector.h>
+#include <Epetra_SerialDenseMatrix.h>
+#include <Epetra_Vector.h>
+
 namespace PHiLiP {
 namespace ODE {
 
@@ -24,8 +28,8 @@ public:
     ///POD
     std::shared_ptr<ProperOrthogonalDecomposition::PODBase<dim>> pod;
 
-    /// Destructor
-    virtual ~ReducedOrderODESolver() = default;
+    /// Destructor. Restores the full mesh assembly of the DG discretization when hyper-reduced.
+    virtual ~ReducedOrderODESolver();
 
     /// Evaluate steady state solution.
     int steady_state () override;
@@ -37,10 +41,34 @@ public:
     void allocate_ode_system () override;
 
     /// Generate test basis depending on which projection is used
-    virtual std::shared_ptr<Epetra_CrsMatrix> generate_test_basis(const Epetra_CrsMatrix &epetra_system_matrix, const Epetra_CrsMatrix &pod_basis) = 0;
+    /** The bases are dense and distributed by rows as the system matrix.
+     */
+    virtual std::shared_ptr<Epetra_MultiVector> generate_test_basis(const Epetra_CrsMatrix &epetra_system_matrix, const Epetra_MultiVector &pod_basis) = 0;
 
     /// Generate the reduced left-hand side depending on which projection is used
-    virtual std::shared_ptr<Epetra_CrsMatrix> generate_reduced_lhs(const Epetra_CrsMatrix &epetra_system_matrix, Epetra_CrsMatrix &test_basis) = 0;
+    /** The reduced left-hand side is dense and replicated on every process.
+     */
+    virtual std::shared_ptr<Epetra_SerialDenseMatrix> generate_reduced_lhs(const Epetra_CrsMatrix &epetra_system_matrix, const Epetra_MultiVector &test_basis) = 0;
+
+protected:
+    /// Scaling of the residual and Jacobian rows of a cell given its ECSW weight.
+    /** The Galerkin reduced operators V^T*D*J*V and V^T*D*R are weighted by the cell weights themselves.
+     */
+    virtual double hyper_reduction_row_scaling(const double cell_weight) const;
+
+    /// Computes the ECSW cell weights from the POD snapshots and restricts the DG assembly to the resulting sample mesh.
+    void compute_hyper_reduction();
+
+    /// Copy of the assembled Jacobian. When hyper-reduced, only the weighted rows of the sampled cells are kept.
+    std::shared_ptr<Epetra_CrsMatrix> get_weighted_system_matrix() const;
+
+    /// Projects the assembled right-hand side onto the test basis, weighting its rows when hyper-reduced.
+    /** The reduced right-hand side must be on the reduced space map of the test basis.
+     */
+    void project_right_hand_side(const Epetra_MultiVector &test_basis, Epetra_Vector &reduced_rhs) const;
+
+    /// Weight of each locally owned row of the hyper-reduced residual. Empty without hyper-reduction.
+    std::vector<double> hyper_reduction_row_weights;
 
 };
 
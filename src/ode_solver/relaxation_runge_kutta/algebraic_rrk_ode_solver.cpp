@@ -49,7 +49,7 @@ real AlgebraicRRKODESolver<dim,real,MeshType>::compute_inner_product (
     if(dg->all_parameters->use_inverse_mass_on_the_fly){
         dg->apply_global_mass_matrix(stage_j, temp);
     } else{
-        dg->global_mass_matrix.vmult(temp,stage_j);
+        dg->apply_stored_global_mass_matrix(stage_j, temp);
     } //replace stage_j with M*stage_j
 
     const double result = temp * stage_i;
@@ -48,6 +48,13 @@ public:
         // Return 1 such that the time step isn't modified
         return 1.0;
     };
+
+    /// Returns whether the derivative at every stage is used by this object
+    /** Used by low-storage RK solvers, which only store the stage derivatives if needed.
+     ** False here */
+    virtual bool requires_stage_derivatives() const {
+        return false;
+    };
     
 
 };
@@ -376,7 +376,7 @@ real RootFindingRRKODESolver<dim,real,MeshType>::compute_entropy_change_estimate
 
         }
         else
-            dg->global_mass_matrix.vmult( mass_matrix_times_rk_stage, rk_stage[istage]);
+            dg->apply_stored_global_mass_matrix(rk_stage[istage], mass_matrix_times_rk_stage);
         
         //transform solution into entropy variables
         dealii::LinearAlgebra::distributed::Vector<double> entropy_var_hat_global = this->compute_entropy_vars(this->rk_stage_solution[istage],dg);
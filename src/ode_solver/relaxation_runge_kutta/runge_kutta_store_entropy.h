@@ -31,6 +31,11 @@ public:
             const std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &rk_stage,
             const bool compute_K_norm) const override;
     
+    /// Returns true, as the stage derivatives are needed to compute the FR entropy contribution
+    bool requires_stage_derivatives() const override {
+        return true;
+    };
+
     // "using" keyword to prevent compiler complaining
     using EmptyRRKBase<dim, real, MeshType>::compute_FR_entropy_contribution;
     using EmptyRRKBase<dim, real, MeshType>::update_relaxation_parameter;
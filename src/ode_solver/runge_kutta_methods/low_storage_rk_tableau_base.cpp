@@ -0,0 +1,81 @@
+#include "low_storage_rk_tableau_base.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+template <int dim, typename real, typename MeshType> 
+LowStorageRKTableauBase<dim,real, MeshType> :: LowStorageRKTableauBase (const int n_rk_stages_input, 
+        const std::string rk_method_string_input)
+    : RKTableauBase<dim,real,MeshType>(n_rk_stages_input, rk_method_string_input)
+{
+    this->low_storage_a.reinit(this->n_rk_stages);
+    this->low_storage_b.reinit(this->n_rk_stages);
+}
+
+template <int dim, typename real, typename MeshType> 
+double LowStorageRKTableauBase<dim,real, MeshType> :: get_low_storage_a (const int i) const
+{
+    return low_storage_a[i];
+}
+
+template <int dim, typename real, typename MeshType> 
+double LowStorageRKTableauBase<dim,real, MeshType> :: get_low_storage_b (const int i) const
+{
+    return low_storage_b[i];
+}
+
+template <int dim, typename real, typename MeshType> 
+double LowStorageRKTableauBase<dim,real, MeshType> :: compute_stage_weight (const int m, const int j) const
+{
+    double weight = 0.0;
+    double product_of_a = 1.0;
+    for (int l = j; l <= m; ++l) {
+        if (l > j) product_of_a *= low_storage_a[l];
+        weight += low_storage_b[l] * product_of_a;
+    }
+    return weight;
+}
+
+template <int dim, typename real, typename MeshType> 
+void LowStorageRKTableauBase<dim,real, MeshType> :: set_a ()
+{
+    // set_tableau() calls set_a() first, so the low-storage coefficients are assigned here
+    set_low_storage_a();
+    set_low_storage_b();
+
+    for (int i = 0; i < this->n_rk_stages; ++i) {
+        for (int j = 0; j < this->n_rk_stages; ++j) {
+            // Stage i is evaluated at Q_{i-1}
+            this->butcher_tableau_a[i][j] = (j < i) ? compute_stage_weight(i-1, j) : 0.0;
+        }
+    }
+}
+
+template <int dim, typename real, typename MeshType> 
+void LowStorageRKTableauBase<dim,real, MeshType> :: set_b ()
+{
+    for (int j = 0; j < this->n_rk_stages; ++j) {
+        this->butcher_tableau_b[j] = compute_stage_weight(this->n_rk_stages-1, j);
+    }
+}
+
+template <int dim, typename real, typename MeshType> 
+void LowStorageRKTableauBase<dim,real, MeshType> :: set_c ()
+{
+    for (int i = 0; i < this->n_rk_stages; ++i) {
+        double row_sum = 0.0;
+        for (int j = 0; j < i; ++j) {
+            row_sum += this->butcher_tableau_a[i][j];
+        }
+        this->butcher_tableau_c[i] = row_sum;
+    }
+}
+
+template class LowStorageRKTableauBase<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM>>;
+template class LowStorageRKTableauBase<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM>>;
+#if PHILIP_DIM != 1
+template class LowStorageRKTableauBase<PHILIP_DIM, double, dealii::parallel::distributed::Triangulation<PHILIP_DIM>>;
+#endif
+
+} // ODE namespace
+} // PHiLiP namespace
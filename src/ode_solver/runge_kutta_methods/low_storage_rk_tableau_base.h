@@ -0,0 +1,72 @@
+#ifndef __LOW_STORAGE_RK_TABLEAU_BASE__
+#define __LOW_STORAGE_RK_TABLEAU_BASE__
+
+#include "rk_tableau_base.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+/// Base class for storing a low-storage (2N) explicit RK method
+/** The method is stored in Williamson's 2N form:
+ *      dQ_i = A_i * dQ_{i-1} + dt * F(Q_{i-1}),
+ *      Q_i  = Q_{i-1} + B_i * dQ_i,
+ *  with A_0 = 0, such that only two solution-sized registers (Q, dQ) are needed
+ *  regardless of the number of stages.
+ *
+ *  The equivalent Butcher tableau is assembled from the 2N coefficients in set_a(),
+ *  set_b() and set_c() such that the RRK and numerical entropy classes, which are
+ *  written in terms of the Butcher tableau, can be used without modification.
+ *
+ *  See Williamson, J. H. "Low-storage Runge-Kutta schemes." Journal of Computational Physics 35.1 (1980): 48-56.
+ */
+#if PHILIP_DIM==1
+template <int dim, typename real, typename MeshType = dealii::Triangulation<dim>>
+#else
+template <int dim, typename real, typename MeshType = dealii::parallel::distributed::Triangulation<dim>>
+#endif
+class LowStorageRKTableauBase: public RKTableauBase <dim, real, MeshType>
+{
+public:
+    /// Default constructor that will set the constants.
+    LowStorageRKTableauBase(const int n_rk_stages, const std::string rk_method_string_input); 
+
+    /// Returns low-storage "A" coefficient at stage i
+    double get_low_storage_a(const int i) const;
+
+    /// Returns low-storage "B" coefficient at stage i
+    double get_low_storage_b(const int i) const;
+
+protected:
+    /// Low-storage "A" coefficients, scaling of the previous register dQ
+    dealii::Table<1,double> low_storage_a;
+
+    /// Low-storage "B" coefficients, weight of the register dQ in the solution update
+    dealii::Table<1,double> low_storage_b;
+
+    /// Setter for low_storage_a
+    virtual void set_low_storage_a() = 0;
+
+    /// Setter for low_storage_b
+    virtual void set_low_storage_b() = 0;
+
+    /// Sets the low-storage coefficients and the equivalent butcher_tableau_a
+    /** a_ij = \sum_{m=j}^{i-1} B_m \prod_{k=j+1}^{m} A_k for j < i
+     */
+    void set_a() override;
+
+    /// Sets the equivalent butcher_tableau_b
+    /** b_j = \sum_{m=j}^{s-1} B_m \prod_{k=j+1}^{m} A_k
+     */
+    void set_b() override;
+
+    /// Sets butcher_tableau_c as the row sums of butcher_tableau_a
+    void set_c() override;
+
+    /// Weight of the stage derivative j in the register Q_m, i.e. \sum_{l=j}^{m} B_l \prod_{k=j+1}^{l} A_k
+    double compute_stage_weight(const int m, const int j) const;
+};
+
+} // ODE namespace
+} // PHiLiP namespace
+
+#endif
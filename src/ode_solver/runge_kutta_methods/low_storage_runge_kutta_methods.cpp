@@ -0,0 +1,57 @@
+#include "low_storage_runge_kutta_methods.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+//##################################################################
+template <int dim, typename real, typename MeshType>
+void LowStorageRK3Williamson<dim,real,MeshType> :: set_low_storage_a()
+{
+    const double low_storage_a_values[3] = {0.0, -5.0/9.0, -153.0/128.0};
+    this->low_storage_a.fill(low_storage_a_values);
+}
+
+template <int dim, typename real, typename MeshType>
+void LowStorageRK3Williamson<dim,real,MeshType> :: set_low_storage_b()
+{
+    const double low_storage_b_values[3] = {1.0/3.0, 15.0/16.0, 8.0/15.0};
+    this->low_storage_b.fill(low_storage_b_values);
+}
+
+//##################################################################
+template <int dim, typename real, typename MeshType>
+void LowStorageRK4CarpenterKennedy<dim,real,MeshType> :: set_low_storage_a()
+{
+    const double low_storage_a_values[5] = {0.0,
+                                            -567301805773.0/1357537059087.0,
+                                            -2404267990393.0/2016746695238.0,
+                                            -3550918686646.0/2091501179385.0,
+                                            -1275806237668.0/842570457699.0};
+    this->low_storage_a.fill(low_storage_a_values);
+}
+
+template <int dim, typename real, typename MeshType>
+void LowStorageRK4CarpenterKennedy<dim,real,MeshType> :: set_low_storage_b()
+{
+    const double low_storage_b_values[5] = {1432997174477.0/9575080441755.0,
+                                            5161836677717.0/13612068292357.0,
+                                            1720146321549.0/2090206949498.0,
+                                            3134564353537.0/4481467310338.0,
+                                            2277821191437.0/14882151754819.0};
+    this->low_storage_b.fill(low_storage_b_values);
+}
+
+template class LowStorageRK3Williamson<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM> >;
+template class LowStorageRK3Williamson<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM> >;
+#if PHILIP_DIM != 1
+    template class LowStorageRK3Williamson<PHILIP_DIM, double, dealii::parallel::distributed::Triangulation<PHILIP_DIM> >;
+#endif
+
+template class LowStorageRK4CarpenterKennedy<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM> >;
+template class LowStorageRK4CarpenterKennedy<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM> >;
+#if PHILIP_DIM != 1
+    template class LowStorageRK4CarpenterKennedy<PHILIP_DIM, double, dealii::parallel::distributed::Triangulation<PHILIP_DIM> >;
+#endif
+
+} // ODESolver namespace
+} // PHiLiP namespace
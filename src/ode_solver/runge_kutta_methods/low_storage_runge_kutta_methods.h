@@ -0,0 +1,60 @@
+#ifndef __LOW_STORAGE_RUNGE_KUTTA_METHODS__
+#define __LOW_STORAGE_RUNGE_KUTTA_METHODS__
+
+#include "low_storage_rk_tableau_base.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+/// Third-order, three-stage low-storage (2N) explicit RK
+/** See
+ *  Williamson, J. H. "Low-storage Runge-Kutta schemes." Journal of Computational Physics 35.1 (1980): 48-56.
+ *  Case 7 in Table 1. */
+#if PHILIP_DIM==1
+template <int dim, typename real, typename MeshType = dealii::Triangulation<dim>>
+#else
+template <int dim, typename real, typename MeshType = dealii::parallel::distributed::Triangulation<dim>>
+#endif
+class LowStorageRK3Williamson: public LowStorageRKTableauBase <dim, real, MeshType>
+{
+public:
+    /// Constructor
+    LowStorageRK3Williamson(const int n_rk_stages, const std::string rk_method_string_input) 
+        : LowStorageRKTableauBase<dim,real,MeshType>(n_rk_stages, rk_method_string_input) { }
+
+protected:
+    /// Setter for low_storage_a
+    void set_low_storage_a() override;
+
+    /// Setter for low_storage_b
+    void set_low_storage_b() override;
+};
+
+/// Fourth-order, five-stage low-storage (2N) explicit RK
+/** See
+ *  Carpenter, M. H., and Kennedy, C. A. "Fourth-order 2N-storage Runge-Kutta schemes." NASA TM 109112 (1994).
+ *  Solution 3 of the RK4(5)-2N family. */
+#if PHILIP_DIM==1
+template <int dim, typename real, typename MeshType = dealii::Triangulation<dim>>
+#else
+template <int dim, typename real, typename MeshType = dealii::parallel::distributed::Triangulation<dim>>
+#endif
+class LowStorageRK4CarpenterKennedy: public LowStorageRKTableauBase <dim, real, MeshType>
+{
+public:
+    /// Constructor
+    LowStorageRK4CarpenterKennedy(const int n_rk_stages, const std::string rk_method_string_input) 
+        : LowStorageRKTableauBase<dim,real,MeshType>(n_rk_stages, rk_method_string_input) { }
+
+protected:
+    /// Setter for low_storage_a
+    void set_low_storage_a() override;
+
+    /// Setter for low_storage_b
+    void set_low_storage_b() override;
+};
+
+} // ODE namespace
+} // PHiLiP namespace
+
+#endif
@@ -14,6 +14,7 @@ RKTableauBase<dim,real, MeshType> :: RKTableauBase (const int n_rk_stages_input,
     this->butcher_tableau_a.reinit(n_rk_stages,n_rk_stages);
     this->butcher_tableau_b.reinit(n_rk_stages);
     this->butcher_tableau_c.reinit(n_rk_stages);
+    this->butcher_tableau_b_hat.reinit(n_rk_stages);
 }
 
 template <int dim, typename real, typename MeshType> 
@@ -22,6 +23,7 @@ void RKTableauBase<dim,real, MeshType> :: set_tableau ()
     set_a();
     set_b();
     set_c();
+    set_b_hat();
     pcout << "Assigned RK method: " << rk_method_string << std::endl;
 }
 
@@ -43,6 +45,12 @@ double RKTableauBase<dim,real, MeshType> :: get_c (const int i) const
     return butcher_tableau_c[i];
 }
 
+template <int dim, typename real, typename MeshType> 
+double RKTableauBase<dim,real, MeshType> :: get_b_hat (const int i) const
+{
+    return butcher_tableau_b_hat[i];
+}
+
 template class RKTableauBase<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM>>;
 template class RKTableauBase<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM>>;
 #if PHILIP_DIM != 1
@@ -34,6 +34,10 @@ public:
     /// Returns Butcher tableau "c" coefficient at position [i]
     double get_c(const int i) const;
 
+    /// Returns embedded Butcher tableau "b hat" coefficient at position [i]
+    /** Zero for methods without an embedded pair */
+    double get_b_hat(const int i) const;
+
     /// Calls setters for butcher tableau
     void set_tableau();
 
@@ -55,6 +59,9 @@ protected:
     
     /// Butcher tableau "c"
     dealii::Table<1,double> butcher_tableau_c;
+
+    /// Butcher tableau "b hat" of the embedded lower-order method
+    dealii::Table<1,double> butcher_tableau_b_hat;
     
     /// Setter for butcher_tableau_a
     virtual void set_a() = 0;
@@ -65,6 +72,10 @@ protected:
     /// Setter for butcher_tableau_c
     virtual void set_c() = 0;
 
+    /// Setter for butcher_tableau_b_hat
+    /** Does nothing by default, such that "b hat" is zero for methods without an embedded pair */
+    virtual void set_b_hat() {};
+
 
 };
 
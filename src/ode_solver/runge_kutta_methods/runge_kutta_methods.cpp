@@ -91,6 +91,38 @@ void HeunExplicit<dim,real,MeshType> :: set_c()
     this->butcher_tableau_c.fill(butcher_tableau_c_values);
 }
 
+//##################################################################
+template <int dim, typename real, typename MeshType>
+void BogackiShampine32Explicit<dim,real,MeshType> :: set_a()
+{
+    const double butcher_tableau_a_values[16] = {0,0,0,0,
+                                                 0.5,0,0,0,
+                                                 0,0.75,0,0,
+                                                 2.0/9.0,1.0/3.0,4.0/9.0,0};
+    this->butcher_tableau_a.fill(butcher_tableau_a_values);
+}
+
+template <int dim, typename real, typename MeshType>
+void BogackiShampine32Explicit<dim,real,MeshType> :: set_b()
+{
+    const double butcher_tableau_b_values[4] = {2.0/9.0,1.0/3.0,4.0/9.0,0};
+    this->butcher_tableau_b.fill(butcher_tableau_b_values);
+}
+
+template <int dim, typename real, typename MeshType>
+void BogackiShampine32Explicit<dim,real,MeshType> :: set_c()
+{
+    const double butcher_tableau_c_values[4] = {0,0.5,0.75,1.0};
+    this->butcher_tableau_c.fill(butcher_tableau_c_values);
+}
+
+template <int dim, typename real, typename MeshType>
+void BogackiShampine32Explicit<dim,real,MeshType> :: set_b_hat()
+{
+    const double butcher_tableau_b_hat_values[4] = {7.0/24.0,0.25,1.0/3.0,0.125};
+    this->butcher_tableau_b_hat.fill(butcher_tableau_b_hat_values);
+}
+
 //##################################################################
 template <int dim, typename real, typename MeshType>
 void EulerImplicit<dim,real,MeshType> :: set_a()
@@ -195,6 +227,12 @@ template class HeunExplicit<PHILIP_DIM, double, dealii::parallel::shared::Triang
     template class HeunExplicit<PHILIP_DIM, double, dealii::parallel::distributed::Triangulation<PHILIP_DIM> >;
 #endif
 
+template class BogackiShampine32Explicit<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM> >;
+template class BogackiShampine32Explicit<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM> >;
+#if PHILIP_DIM != 1
+    template class BogackiShampine32Explicit<PHILIP_DIM, double, dealii::parallel::distributed::Triangulation<PHILIP_DIM> >;
+#endif
+
 template class EulerImplicit<PHILIP_DIM, double, dealii::Triangulation<PHILIP_DIM> >;
 template class EulerImplicit<PHILIP_DIM, double, dealii::parallel::shared::Triangulation<PHILIP_DIM> >;
 #if PHILIP_DIM != 1
@@ -112,6 +112,36 @@ protected:
 };
 
 
+/// Bogacki-Shampine 3(2) explicit RK with an embedded second-order pair
+/** See
+ *  Bogacki, P., and Shampine, L. F. "A 3(2) pair of Runge-Kutta formulas." Applied Mathematics Letters 2.4 (1989): 321-325.
+ *  The third-order solution is used to advance in time; the embedded solution is only used for error control. */
+#if PHILIP_DIM==1
+template <int dim, typename real, typename MeshType = dealii::Triangulation<dim>>
+#else
+template <int dim, typename real, typename MeshType = dealii::parallel::distributed::Triangulation<dim>>
+#endif
+class BogackiShampine32Explicit: public RKTableauBase <dim, real, MeshType>
+{
+public:
+    /// Constructor
+    BogackiShampine32Explicit(const int n_rk_stages, const std::string rk_method_string_input) 
+        : RKTableauBase<dim,real,MeshType>(n_rk_stages, rk_method_string_input) { }
+
+protected:
+    /// Setter for butcher_tableau_a
+    void set_a() override;
+
+    /// Setter for butcher_tableau_b
+    void set_b() override;
+
+    /// Setter for butcher_tableau_c
+    void set_c() override;
+
+    /// Setter for butcher_tableau_b_hat
+    void set_b_hat() override;
+};
+
 /// Implicit Euler 
 #if PHILIP_DIM==1
 template <int dim, typename real, typename MeshType = dealii::Triangulation<dim>>
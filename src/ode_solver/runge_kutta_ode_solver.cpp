@@ -1,5 +1,8 @@
 #include "runge_kutta_ode_solver.h"
 
+#include <cmath>
+#include <limits>
+
 namespace PHiLiP {
 namespace ODE {
 
@@ -11,6 +14,7 @@ RungeKuttaODESolver<dim,real,n_rk_stages, MeshType>::RungeKuttaODESolver(std::sh
         , butcher_tableau(rk_tableau_input)
         , relaxation_runge_kutta(RRK_object_input)
         , solver(dg_input)
+        , previous_error_norm(1.0)
 {}
 
 template <int dim, typename real, int n_rk_stages, typename MeshType> 
@@ -19,6 +23,72 @@ void RungeKuttaODESolver<dim,real,n_rk_stages,MeshType>::step_in_time (real dt,
     this->original_time_step = dt;
     this->solution_update = this->dg->solution; //storing u_n
 
+    calculate_stages(dt, pseudotime);
+
+    if (this->ode_param.use_error_controlled_time_step && !pseudotime) {
+        // Reject the step and recompute the stages with a smaller time step until the local error is below tolerance
+        // A non-finite error estimate, e.g. from a NaN stage, is always rejected
+        double error_norm = compute_embedded_error_norm(dt);
+        unsigned int n_rejected_steps = 0;
+        while (!std::isfinite(error_norm) || error_norm > 1.0) {
+            ++n_rejected_steps;
+            const double rejected_error_norm = std::isfinite(error_norm) ? error_norm : std::numeric_limits<double>::max();
+            dt *= compute_time_step_factor(rejected_error_norm, true);
+            this->pcout << "Embedded error estimate " << error_norm 
+                        << " is above tolerance. Rejecting step and retrying with dt = " << dt << std::endl;
+            if (n_rejected_steps > this->ode_param.error_control_maximum_rejected_steps || dt < this->ode_param.error_control_minimum_time_step) {
+                this->pcout << "Error: the time step was rejected " << n_rejected_steps << " times, down to dt = " << dt
+                            << ", at time " << this->current_time << ". Aborting..." << std::endl;
+                std::abort();
+            }
+            calculate_stages(dt, pseudotime);
+            error_norm = compute_embedded_error_norm(dt);
+        }
+        this->original_time_step = dt;
+        this->error_controlled_time_step = dt * compute_time_step_factor(error_norm, false);
+        this->previous_error_norm = error_norm;
+    }
+
+    // Calculates relaxation parameter and modify the time step size as dt*=relaxation_parameter.
+    // if not using RRK, the relaxation parameter will be set to 1, such that dt is not modified.
+    this->relaxation_parameter_RRK_solver = relaxation_runge_kutta->update_relaxation_parameter(dt, this->dg, this->rk_stage, this->solution_update);
+    dt *= this->relaxation_parameter_RRK_solver;
+    this->modified_time_step = dt;
+
+    //assemble solution from stages
+    for (int i = 0; i < n_rk_stages; ++i){
+        if (pseudotime){
+            const double CFL = this->butcher_tableau->get_b(i) * dt;
+            this->dg->time_scale_solution_update(this->rk_stage[i], CFL);
+            this->solution_update.add(1.0, this->rk_stage[i]);
+        } else {
+            this->solution_update.add(dt* this->butcher_tableau->get_b(i),this->rk_stage[i]); 
+        }
+    }
+    this->dg->solution = this->solution_update; // u_np1 = u_n + dt* sum(k_i * b_i)
+
+    // Calculate numerical entropy with FR correction. Does nothing if use has not selected param.
+    this->FR_entropy_contribution_RRK_solver = relaxation_runge_kutta->compute_FR_entropy_contribution(dt, this->dg, this->rk_stage, true);
+
+    // Apply limiter at every RK stage
+    if (this->limiter) {
+        this->limiter->limit(this->dg->solution,
+            this->dg->dof_handler,
+            this->dg->fe_collection,
+            this->dg->volume_quadrature_collection,
+            this->dg->high_order_grid->fe_system.tensor_degree(),
+            this->dg->max_degree,
+            this->dg->oneD_fe_collection_1state,
+            this->dg->oneD_quadrature_collection);
+    }
+    
+    ++(this->current_iteration);
+    this->current_time += dt;
+}
+
+template <int dim, typename real, int n_rk_stages, typename MeshType> 
+void RungeKuttaODESolver<dim,real,n_rk_stages,MeshType>::calculate_stages (real dt, const bool pseudotime)
+{
     //calculating stages **Note that rk_stage[i] stores the RHS at a partial time-step (not solution u)
     for (int i = 0; i < n_rk_stages; ++i){
 
@@ -94,45 +164,61 @@ void RungeKuttaODESolver<dim,real,n_rk_stages,MeshType>::step_in_time (real dt,
         if(this->all_parameters->use_inverse_mass_on_the_fly){
             this->dg->apply_inverse_global_mass_matrix(this->dg->right_hand_side, this->rk_stage[i]); //rk_stage[i] = IMM*RHS = F(u_n + dt*sum(a_ij*k_j))
         } else{
-            this->dg->global_inverse_mass_matrix.vmult(this->rk_stage[i], this->dg->right_hand_side); //rk_stage[i] = IMM*RHS = F(u_n + dt*sum(a_ij*k_j))
+            this->dg->apply_stored_inverse_global_mass_matrix(this->dg->right_hand_side, this->rk_stage[i]); //rk_stage[i] = IMM*RHS = F(u_n + dt*sum(a_ij*k_j))
         }
     }
+}
 
-    // Calculates relaxation parameter and modify the time step size as dt*=relaxation_parameter.
-    // if not using RRK, the relaxation parameter will be set to 1, such that dt is not modified.
-    this->relaxation_parameter_RRK_solver = relaxation_runge_kutta->update_relaxation_parameter(dt, this->dg, this->rk_stage, this->solution_update);
-    dt *= this->relaxation_parameter_RRK_solver;
-    this->modified_time_step = dt;
+template <int dim, typename real, int n_rk_stages, typename MeshType> 
+double RungeKuttaODESolver<dim,real,n_rk_stages,MeshType>::compute_embedded_error_norm (const real dt) const
+{
+    // Weighted RMS norm of the local error estimate dt * sum((b_i - b_hat_i) * k_i),
+    // scaled entry-wise by atol + rtol * max(|u_n|, |u_np1|) (see Hairer, Norsett & Wanner, Sec. II.4)
+    const double atol = this->ode_param.error_control_absolute_tolerance;
+    const double rtol = this->ode_param.error_control_relative_tolerance;
 
-    //assemble solution from stages
-    for (int i = 0; i < n_rk_stages; ++i){
-        if (pseudotime){
-            const double CFL = this->butcher_tableau->get_b(i) * dt;
-            this->dg->time_scale_solution_update(this->rk_stage[i], CFL);
-            this->solution_update.add(1.0, this->rk_stage[i]);
-        } else {
-            this->solution_update.add(dt* this->butcher_tableau->get_b(i),this->rk_stage[i]); 
+    double local_sum_of_squares = 0.0;
+    for (const auto idof : this->solution_update.locally_owned_elements()) {
+        const double solution_n = this->solution_update[idof];
+        double solution_np1 = solution_n;
+        double local_error = 0.0;
+        for (int i = 0; i < n_rk_stages; ++i){
+            const double stage_value = this->rk_stage[i][idof];
+            solution_np1 += dt * this->butcher_tableau->get_b(i) * stage_value;
+            local_error += dt * (this->butcher_tableau->get_b(i) - this->butcher_tableau->get_b_hat(i)) * stage_value;
         }
+        const double scale = atol + rtol * std::max(std::abs(solution_n), std::abs(solution_np1));
+        local_sum_of_squares += (local_error/scale) * (local_error/scale);
     }
-    this->dg->solution = this->solution_update; // u_np1 = u_n + dt* sum(k_i * b_i)
+    const double sum_of_squares = dealii::Utilities::MPI::sum(local_sum_of_squares, this->mpi_communicator);
 
-    // Calculate numerical entropy with FR correction. Does nothing if use has not selected param.
-    this->FR_entropy_contribution_RRK_solver = relaxation_runge_kutta->compute_FR_entropy_contribution(dt, this->dg, this->rk_stage, true);
+    return sqrt(sum_of_squares / this->solution_update.size());
+}
 
-    // Apply limiter at every RK stage
-    if (this->limiter) {
-        this->limiter->limit(this->dg->solution,
-            this->dg->dof_handler,
-            this->dg->fe_collection,
-            this->dg->volume_quadrature_collection,
-            this->dg->high_order_grid->fe_system.tensor_degree(),
-            this->dg->max_degree,
-            this->dg->oneD_fe_collection_1state,
-            this->dg->oneD_quadrature_collection);
+template <int dim, typename real, int n_rk_stages, typename MeshType> 
+double RungeKuttaODESolver<dim,real,n_rk_stages,MeshType>::compute_time_step_factor (const double error_norm, const bool step_rejected) const
+{
+    // PI controller, dt_new = dt * safety * err^(-alpha) * err_prev^(beta),
+    // with alpha = 0.7/k and beta = 0.4/k where k is the embedded order + 1
+    // See Hairer & Wanner, Solving ODEs II, Sec. IV.2
+    const double k = this->ode_param.rk_embedded_order + 1.0;
+    const double safety_factor = this->ode_param.error_control_safety_factor;
+    const double minimum_factor = 0.2;
+    const double maximum_factor = 5.0;
+
+    // Guard against a vanishing error estimate, e.g. a steady solution
+    const double error = std::max(error_norm, 1e-10);
+
+    double factor = 1.0;
+    if (step_rejected) {
+        // Only use the elementary controller after a rejection, and never increase the step
+        factor = safety_factor * pow(error, -1.0/k);
+        factor = std::min(1.0, std::max(minimum_factor, factor));
+    } else {
+        factor = safety_factor * pow(error, -0.7/k) * pow(this->previous_error_norm, 0.4/k);
+        factor = std::min(maximum_factor, std::max(minimum_factor, factor));
     }
-    
-    ++(this->current_iteration);
-    this->current_time += dt;
+    return factor;
 }
 
 template <int dim, typename real, int n_rk_stages, typename MeshType> 
@@ -48,6 +48,19 @@ protected:
     
     /// Indicator for zero diagonal elements; used to toggle implicit solve.
     std::vector<bool> butcher_tableau_aii_is_zero;
+
+    /// Error norm of the last accepted step; used by the PI controller
+    double previous_error_norm;
+
+    /// Computes the derivative at every stage, rk_stage, starting from u_n stored in solution_update
+    void calculate_stages(real dt, const bool pseudotime);
+
+    /// Returns the weighted RMS norm of the local error estimated with the embedded "b hat" coefficients
+    /** A value smaller than one means the step satisfies the relative and absolute tolerances. */
+    double compute_embedded_error_norm(const real dt) const;
+
+    /// Returns the factor by which the time step is multiplied, computed with a PI controller
+    double compute_time_step_factor(const double error_norm, const bool step_rejected) const;
 };
 
 } // ODE namespace
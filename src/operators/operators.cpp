@@ -192,6 +192,174 @@ SumFactorizedOperators<dim,n_faces,real>::SumFactorizedOperators(
     : OperatorsBase<dim,n_faces,real>::OperatorsBase(nstate_input, max_degree_input, grid_degree_input)
 {}
 
+namespace {
+    /// Contracts one direction of a flattened tensor-product array with a 1D operator.
+    /** The input is viewed as (n_outer, basis.n(), n_inner) and the output as (n_outer, basis.m(), n_inner),
+    * where the innermost index runs the fastest. For the x direction n_inner = 1,
+    * for the y direction n_inner is the number of x entries, etc.
+    */
+    template <typename number>
+    void contract_1D_direction(
+        const std::vector<number> &input,
+        std::vector<number> &output,
+        const dealii::FullMatrix<double> &basis,
+        const unsigned int n_outer,
+        const unsigned int n_inner)
+    {
+        const unsigned int rows    = basis.m();
+        const unsigned int columns = basis.n();
+        output.resize(n_outer * rows * n_inner);
+        for(unsigned int iouter=0; iouter<n_outer; iouter++){
+            for(unsigned int irow=0; irow<rows; irow++){
+                number *out = &output[(iouter * rows + irow) * n_inner];
+                for(unsigned int iinner=0; iinner<n_inner; iinner++){
+                    out[iinner] = 0.0;
+                }
+                for(unsigned int icol=0; icol<columns; icol++){
+                    const double basis_val = basis[irow][icol];
+                    const number *in = &input[(iouter * columns + icol) * n_inner];
+                    for(unsigned int iinner=0; iinner<n_inner; iinner++){
+                        out[iinner] += basis_val * in[iinner];
+                    }
+                }
+            }
+        }
+    }
+
+    /// Contracts one direction of a flattened tensor-product array with a square 1D operator of compile-time size.
+    /** Same as contract_1D_direction, but the sizes are template arguments such that
+    * the compiler can unroll and vectorize the loops.
+    */
+    template <int n_1D, int n_outer, int n_inner, typename number>
+    void contract_1D_direction_fixed_size(
+        const number *input,
+        number *output,
+        const double (&basis)[n_1D][n_1D])
+    {
+        for(int iouter=0; iouter<n_outer; iouter++){
+            for(int irow=0; irow<n_1D; irow++){
+                number *out = &output[(iouter * n_1D + irow) * n_inner];
+                for(int iinner=0; iinner<n_inner; iinner++){
+                    out[iinner] = 0.0;
+                }
+                for(int icol=0; icol<n_1D; icol++){
+                    const double basis_val = basis[irow][icol];
+                    const number *in = &input[(iouter * n_1D + icol) * n_inner];
+                    for(int iinner=0; iinner<n_inner; iinner++){
+                        out[iinner] += basis_val * in[iinner];
+                    }
+                }
+            }
+        }
+    }
+
+    /// Sum-factorized matrix-vector product for square 1D operators of compile-time size n_1D.
+    /** The 1D operators are copied into fixed-size arrays, and the contractions in each
+    * direction are done on stack arrays of size \f$ n_{1D}^{d} \f$.
+    */
+    template <int dim, int n_1D, typename number>
+    void matrix_vector_mult_fixed_size(
+        const std::vector<number> &input_vect,
+        std::vector<number> &output_vect,
+        const dealii::FullMatrix<double> &basis_x,
+        const dealii::FullMatrix<double> &basis_y,
+        const dealii::FullMatrix<double> &basis_z,
+        const bool adding,
+        const double factor)
+    {
+        constexpr int n_pts = (dim == 1) ? n_1D : ((dim == 2) ? n_1D * n_1D : n_1D * n_1D * n_1D);
+        assert(input_vect.size() == (unsigned int) n_pts);
+        assert(output_vect.size() == (unsigned int) n_pts);
+
+        double basis_local[dim][n_1D][n_1D];
+        const dealii::FullMatrix<double> *basis_dir[3] = {&basis_x, &basis_y, &basis_z};
+        for(int idim=0; idim<dim; idim++){
+            for(int irow=0; irow<n_1D; irow++){
+                for(int icol=0; icol<n_1D; icol++){
+                    basis_local[idim][irow][icol] = (*basis_dir[idim])[irow][icol];
+                }
+            }
+        }
+
+        number temp1[n_pts];
+        number temp2[n_pts];
+        (void) temp2;//unused in 1D
+        //apply x tensor product
+        contract_1D_direction_fixed_size<n_1D, n_pts / n_1D, 1>(input_vect.data(), temp1, basis_local[0]);
+        const number *result = temp1;
+        if constexpr (dim > 1){
+            //apply y tensor product
+            contract_1D_direction_fixed_size<n_1D, n_pts / (n_1D * n_1D), n_1D>(temp1, temp2, basis_local[1]);
+            result = temp2;
+        }
+        if constexpr (dim > 2){
+            //apply z tensor product
+            contract_1D_direction_fixed_size<n_1D, 1, n_1D * n_1D>(temp2, temp1, basis_local[2]);
+            result = temp1;
+        }
+
+        for(int iquad=0; iquad<n_pts; iquad++){
+            if(adding)
+                output_vect[iquad] += factor * result[iquad];
+            else
+                output_vect[iquad] = factor * result[iquad];
+        }
+    }
+
+    /// Function pointer type of the fixed-size sum-factorized kernels.
+    template <int dim, typename number>
+    using matrix_vector_mult_kernel = void (*)(
+        const std::vector<number> &,
+        std::vector<number> &,
+        const dealii::FullMatrix<double> &,
+        const dealii::FullMatrix<double> &,
+        const dealii::FullMatrix<double> &,
+        const bool,
+        const double);
+
+    /// Returns the kernel specialized for the 1D size n_1D, or nullptr if there is none.
+    /** Kernels are instantiated for n_1D = 2,...,10, i.e. p = 1,...,9 with as many
+    * quadrature points as basis functions in each direction. Other sizes use the generic path.
+    */
+    template <int dim, typename number>
+    matrix_vector_mult_kernel<dim,number> get_fixed_size_kernel(const unsigned int n_1D)
+    {
+        static const std::array<matrix_vector_mult_kernel<dim,number>,11> kernels = {{
+            nullptr,
+            nullptr,
+            &matrix_vector_mult_fixed_size<dim, 2,number>,
+            &matrix_vector_mult_fixed_size<dim, 3,number>,
+            &matrix_vector_mult_fixed_size<dim, 4,number>,
+            &matrix_vector_mult_fixed_size<dim, 5,number>,
+            &matrix_vector_mult_fixed_size<dim, 6,number>,
+            &matrix_vector_mult_fixed_size<dim, 7,number>,
+            &matrix_vector_mult_fixed_size<dim, 8,number>,
+            &matrix_vector_mult_fixed_size<dim, 9,number>,
+            &matrix_vector_mult_fixed_size<dim,10,number>
+        }};
+        if(n_1D < kernels.size())
+            return kernels[n_1D];
+        return nullptr;
+    }
+
+    /// Checks whether the operator is the dyadic product of square 1D operators all of the same size.
+    template <int dim>
+    bool is_square_tensor_product(
+        const dealii::FullMatrix<double> &basis_x,
+        const dealii::FullMatrix<double> &basis_y,
+        const dealii::FullMatrix<double> &basis_z)
+    {
+        const unsigned int n_1D = basis_x.m();
+        if(basis_x.n() != n_1D)
+            return false;
+        if(dim > 1 && (basis_y.m() != n_1D || basis_y.n() != n_1D))
+            return false;
+        if(dim > 2 && (basis_z.m() != n_1D || basis_z.n() != n_1D))
+            return false;
+        return true;
+    }
+}
+
 template <int dim, int n_faces, typename real>  
 void SumFactorizedOperators<dim,n_faces,real>::matrix_vector_mult(
     const std::vector<real> &input_vect,
@@ -222,6 +390,15 @@ void SumFactorizedOperators<dim,n_faces,real>::matrix_vector_mult(
         assert(columns_x * columns_y * columns_z == input_vect.size());
     }
 
+    //use the kernel specialized on the 1D size if there is one
+    if(is_square_tensor_product<dim>(basis_x, basis_y, basis_z)){
+        const matrix_vector_mult_kernel<dim,real> kernel = get_fixed_size_kernel<dim,real>(rows_x);
+        if(kernel != nullptr){
+            kernel(input_vect, output_vect, basis_x, basis_y, basis_z, adding, factor);
+            return;
+        }
+    }
+
     if constexpr (dim==1){
         for(unsigned int iquad=0; iquad<rows_x; iquad++){
             if(!adding)
@@ -532,6 +709,116 @@ void SumFactorizedOperators<dim,n_faces,real>::inner_product_1D(
     this->inner_product(input_vect, weight_vect, output_vect, basis_x, basis_x, basis_x, adding, factor);
 }
 
+template <int dim, int n_faces, typename real>  
+void SumFactorizedOperators<dim,n_faces,real>::matrix_vector_mult_vectorized(
+    const std::vector<dealii::VectorizedArray<real>> &input_vect,
+    std::vector<dealii::VectorizedArray<real>> &output_vect,
+    const dealii::FullMatrix<double> &basis_x,
+    const dealii::FullMatrix<double> &basis_y,
+    const dealii::FullMatrix<double> &basis_z,
+    const bool adding,
+    const double factor)
+{
+    //the directions beyond dim are of size one
+    const unsigned int rows_x    = basis_x.m();
+    const unsigned int rows_y    = (dim > 1) ? basis_y.m() : 1;
+    const unsigned int columns_x = basis_x.n();
+    const unsigned int columns_y = (dim > 1) ? basis_y.n() : 1;
+    const unsigned int columns_z = (dim > 2) ? basis_z.n() : 1;
+    (void) columns_x;
+    assert(columns_x * columns_y * columns_z == input_vect.size());
+
+    //use the kernel specialized on the 1D size if there is one
+    if(is_square_tensor_product<dim>(basis_x, basis_y, basis_z)){
+        const matrix_vector_mult_kernel<dim,dealii::VectorizedArray<real>> kernel
+            = get_fixed_size_kernel<dim,dealii::VectorizedArray<real>>(rows_x);
+        if(kernel != nullptr){
+            kernel(input_vect, output_vect, basis_x, basis_y, basis_z, adding, factor);
+            return;
+        }
+    }
+
+    std::vector<dealii::VectorizedArray<real>> &temp_x = vectorized_scratch[0];
+    contract_1D_direction(input_vect, temp_x, basis_x, columns_y * columns_z, 1);//apply x tensor product
+    std::vector<dealii::VectorizedArray<real>> &temp_y = vectorized_scratch[1];
+    if constexpr (dim > 1){
+        contract_1D_direction(temp_x, temp_y, basis_y, columns_z, rows_x);//apply y tensor product
+    }
+    std::vector<dealii::VectorizedArray<real>> &temp_z = vectorized_scratch[2];
+    if constexpr (dim > 2){
+        contract_1D_direction(temp_y, temp_z, basis_z, 1, rows_x * rows_y);//apply z tensor product
+    }
+    const std::vector<dealii::VectorizedArray<real>> &result = (dim == 1) ? temp_x : ((dim == 2) ? temp_y : temp_z);
+
+    assert(result.size() == output_vect.size());
+    for(unsigned int iquad=0; iquad<result.size(); iquad++){
+        if(adding)
+            output_vect[iquad] += factor * result[iquad];
+        else
+            output_vect[iquad] = factor * result[iquad];
+    }
+}
+
+template <int dim, int n_faces, typename real>  
+void SumFactorizedOperators<dim,n_faces,real>::matrix_vector_mult_1D_vectorized(
+    const std::vector<dealii::VectorizedArray<real>> &input_vect,
+    std::vector<dealii::VectorizedArray<real>> &output_vect,
+    const dealii::FullMatrix<double> &basis_x,
+    const bool adding,
+    const double factor)
+{
+    this->matrix_vector_mult_vectorized(input_vect, output_vect, basis_x, basis_x, basis_x, adding, factor);
+}
+
+template <int dim, int n_faces, typename real>  
+void SumFactorizedOperators<dim,n_faces,real>::divergence_matrix_vector_mult_1D_vectorized(
+    const dealii::Tensor<1,dim,std::vector<dealii::VectorizedArray<real>>> &input_vect,
+    std::vector<dealii::VectorizedArray<real>> &output_vect,
+    const dealii::FullMatrix<double> &basis,
+    const dealii::FullMatrix<double> &gradient_basis)
+{
+    for(int idim=0; idim<dim;idim++){
+        if(idim==0)
+            this->matrix_vector_mult_vectorized(input_vect[idim], output_vect, 
+                                                gradient_basis, 
+                                                basis, 
+                                                basis,
+                                                false);//first one doesn't add in the divergence
+        if(idim==1)
+            this->matrix_vector_mult_vectorized(input_vect[idim], output_vect, 
+                                                basis, 
+                                                gradient_basis, 
+                                                basis,
+                                                true);
+        if(idim==2)
+            this->matrix_vector_mult_vectorized(input_vect[idim], output_vect, 
+                                                basis, 
+                                                basis,
+                                                gradient_basis,
+                                                true);
+    } 
+}
+
+template <int dim, int n_faces, typename real>  
+void SumFactorizedOperators<dim,n_faces,real>::inner_product_1D_vectorized(
+    const std::vector<dealii::VectorizedArray<real>> &input_vect,
+    const std::vector<real> &weight_vect,
+    std::vector<dealii::VectorizedArray<real>> &output_vect,
+    const dealii::FullMatrix<double> &basis_x_transpose,
+    const bool adding,
+    const double factor) 
+{
+    assert(weight_vect.size() == input_vect.size()); 
+
+    std::vector<dealii::VectorizedArray<real>> &new_input_vect = vectorized_scratch[3];
+    new_input_vect.resize(input_vect.size());
+    for(unsigned int iquad=0; iquad<input_vect.size(); iquad++){
+        new_input_vect[iquad] = input_vect[iquad] * weight_vect[iquad];
+    }
+
+    this->matrix_vector_mult_vectorized(new_input_vect, output_vect, basis_x_transpose, basis_x_transpose, basis_x_transpose, adding, factor);
+}
+
 template <int dim, int n_faces, typename real>  
 void SumFactorizedOperators<dim,n_faces,real>::divergence_two_pt_flux_Hadamard_product(
     const dealii::Tensor<1,dim,dealii::FullMatrix<real>> &input_mat,
@@ -1096,6 +1383,13 @@ void basis_functions<dim,n_faces,real>::build_1D_volume_operator(
             this->oneD_vol_operator[iquad][idof] = finite_element.shape_value_component(idof,qpoint,istate);
         }
     }
+    //store the transpose once for the inner products
+    this->oneD_vol_operator_transpose.reinit(n_dofs, n_quad_pts);
+    for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
+        for(unsigned int idof=0; idof<n_dofs; idof++){
+            this->oneD_vol_operator_transpose[idof][iquad] = this->oneD_vol_operator[iquad][idof];
+        }
+    }
 }
 
 template <int dim, int n_faces, typename real>  
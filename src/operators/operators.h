@@ -5,6 +5,7 @@
 #include <deal.II/base/parameter_handler.h>
 
 #include <deal.II/base/qprojector.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/grid/tria.h>
 
@@ -312,6 +313,48 @@ public:
             const bool adding  = false,
             const double factor = 1.0);
 
+    ///Computes a sum-factorized matrix-vector product on SIMD-packed input vectors.
+    /** Each lane of dealii::VectorizedArray holds an independent vector (typically one state of the solution),
+    * such that a single tensor contraction in each direction is applied to all lanes at once.
+    * The contractions are done with plain loops on the flattened arrays instead of FullMatrix::mmult,
+    * since FullMatrix only stores scalars.
+    */
+    void matrix_vector_mult_vectorized(
+            const std::vector<dealii::VectorizedArray<real>> &input_vect,
+            std::vector<dealii::VectorizedArray<real>> &output_vect,
+            const dealii::FullMatrix<double> &basis_x,
+            const dealii::FullMatrix<double> &basis_y,
+            const dealii::FullMatrix<double> &basis_z,
+            const bool adding = false,
+            const double factor = 1.0);
+
+    ///Computes the SIMD-packed matrix-vector product where the basis are the same in each direction.
+    void matrix_vector_mult_1D_vectorized(
+            const std::vector<dealii::VectorizedArray<real>> &input_vect,
+            std::vector<dealii::VectorizedArray<real>> &output_vect,
+            const dealii::FullMatrix<double> &basis_x,
+            const bool adding = false,
+            const double factor = 1.0);
+
+    ///Computes the SIMD-packed divergence where the basis are the same in each direction.
+    void divergence_matrix_vector_mult_1D_vectorized(
+            const dealii::Tensor<1,dim,std::vector<dealii::VectorizedArray<real>>> &input_vect,
+            std::vector<dealii::VectorizedArray<real>> &output_vect,
+            const dealii::FullMatrix<double> &basis,
+            const dealii::FullMatrix<double> &gradient_basis);
+
+    ///Computes the SIMD-packed inner product where the basis are the same in each direction.
+    /** The weights are shared by all lanes. Unlike inner_product(), we pass the transpose \f$ \mathbf{A}^T \f$,
+    * e.g. oneD_vol_operator_transpose, such that it is not transposed on every call.
+    */
+    void inner_product_1D_vectorized(
+            const std::vector<dealii::VectorizedArray<real>> &input_vect,
+            const std::vector<real> &weight_vect,
+            std::vector<dealii::VectorizedArray<real>> &output_vect,
+            const dealii::FullMatrix<double> &basis_x_transpose,
+            const bool adding  = false,
+            const double factor = 1.0);
+
     /// Apply sum-factorization matrix vector multiplication on a surface.
     /** Often times we have to interpolate to a surface, where in multiple dimensions,
     * that's the tensor product of a surface operator with volume operators. This simplifies
@@ -365,6 +408,15 @@ public:
     ///Stores the one dimensional surface gradient operator.
     std::array<dealii::FullMatrix<double>,2>  oneD_surf_grad_operator;
 
+    ///Stores the transpose of the one dimensional volume operator, used by inner_product_1D_vectorized().
+    dealii::FullMatrix<double>  oneD_vol_operator_transpose;
+
+protected:
+    ///Scratch arrays of the SIMD-packed sum-factorized products, reused between calls to avoid allocations.
+    /** The first three store the contractions in each direction, and the last one the weighted input of the inner product.
+    */
+    std::array<std::vector<dealii::VectorizedArray<real>>,4> vectorized_scratch;
+
 };//End of SumFactorizedOperators Class
 
 /************************************************************************
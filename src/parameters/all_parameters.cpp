@@ -2,6 +2,8 @@
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/patterns.h>
 
+#include <sstream>
+
 #include "parameters/all_parameters.h"
 
 //for checking output directories
@@ -92,6 +94,26 @@ void AllParameters::declare_parameters (dealii::ParameterHandler &prm)
                       dealii::Patterns::Bool(),
                       "Do not store the residual local processor cpu time by default. Store the residual cpu time if true.");
 
+    prm.declare_entry("n_threads_residual_assembly", "1",
+                      dealii::Patterns::Integer(1, dealii::Patterns::Integer::max_int_value),
+                      "Number of threads per MPI process used to assemble the explicit residual. "
+                      "1 by default, which uses the serial cell loop.");
+
+    prm.declare_entry("overlap_ghost_exchange", "false",
+                      dealii::Patterns::Bool(),
+                      "Overlap the solution ghost exchange with the residual assembly of cells without ghost neighbours. "
+                      "False by default.");
+
+    prm.declare_entry("use_metric_cache", "false",
+                      dealii::Patterns::Bool(),
+                      "Store the metric cofactor and Jacobian determinant of each cell across residual evaluations. "
+                      "Recomputed only when the grid nodes change. Uses more memory. False by default.");
+
+    prm.declare_entry("use_vectorized_volume_kernel", "false",
+                      dealii::Patterns::Bool(),
+                      "Pack the states into SIMD lanes for the sum-factorized products of the strong form volume term. "
+                      "False by default.");
+
     prm.declare_entry("use_weight_adjusted_mass", "false",
                       dealii::Patterns::Bool(),
                       "Use original form by defualt. Otherwise, use the weight adjusted low storage mass matrix for curvilinear.");
@@ -141,6 +163,11 @@ void AllParameters::declare_parameters (dealii::ParameterHandler &prm)
                       dealii::Patterns::Bool(),
                       "Build global mass inverse matrix and apply it. Otherwise, use inverse mass on-the-fly by default for explicit timestepping.");
 
+    prm.declare_entry("use_block_diagonal_mass_matrices", "false",
+                      dealii::Patterns::Bool(),
+                      "Store the global mass matrices and their inverses as one dense block per cell "
+                      "instead of sparse matrices. Reduces their memory and the cost of applying them. False by default.");
+
     prm.declare_entry("check_valid_metric_Jacobian", "true",
                       dealii::Patterns::Bool(),
                       "Check validty of metric Jacobian when high-order grid is constructed by default. Do not check if false. Not checking is useful if the metric terms are built on the fly with operators, it reduces the memory cost for high polynomial grids. The metric Jacobian is never checked for strong form, regardless of the user input.");
@@ -321,6 +348,32 @@ void AllParameters::declare_parameters (dealii::ParameterHandler &prm)
                       dealii::Patterns::Bool(),
                       "Outputs the surface solution vtk files. False by default");
 
+    prm.declare_entry("number_of_subdivisions_in_vtk_output", "0",
+                      dealii::Patterns::Integer(0, dealii::Patterns::Integer::max_int_value),
+                      "Number of subdivisions of each cell in the solution vtk files. "
+                      "0 by default, which uses the number of subdivisions chosen by enable_higher_order_vtk_output. "
+                      "A smaller number subsamples the solution to reduce the size of the files.");
+
+    prm.declare_entry("vtk_output_compression_level", "best_compression",
+                      dealii::Patterns::Selection(
+                      " no_compression | "
+                      " best_speed | "
+                      " default_compression | "
+                      " best_compression"),
+                      "Zlib compression level of the binary solution vtk files. "
+                      "Choices are <no_compression | best_speed | default_compression | best_compression>.");
+
+    prm.declare_entry("vtk_output_variables", " ",
+                      dealii::Patterns::Anything(),
+                      "Names of the variables of the physics post-processor written to the solution vtk files, separated by spaces. "
+                      "Example: 'density velocity pressure'. Add 'residual' to also write the residual. "
+                      "All the variables and the residual are written by default.");
+
+    prm.declare_entry("write_vtk_output_asynchronously", "false",
+                      dealii::Patterns::Bool(),
+                      "Compress and write the solution vtk files in the background, "
+                      "while the solver continues. False by default.");
+
     prm.declare_entry("do_renumber_dofs", "true",
                       dealii::Patterns::Bool(),
                       "Flag for renumbering DOFs using Cuthill-McKee renumbering. True by default. Set to false if doing 3D unsteady flow simulations.");
@@ -436,6 +489,10 @@ const std::string test_string = prm.get("test_type");
     use_curvilinear_split_form = prm.get_bool("use_curvilinear_split_form");
     use_curvilinear_grid = prm.get_bool("use_curvilinear_grid");
     store_residual_cpu_time = prm.get_bool("store_residual_cpu_time");
+    n_threads_residual_assembly = prm.get_integer("n_threads_residual_assembly");
+    overlap_ghost_exchange = prm.get_bool("overlap_ghost_exchange");
+    use_metric_cache = prm.get_bool("use_metric_cache");
+    use_vectorized_volume_kernel = prm.get_bool("use_vectorized_volume_kernel");
     use_weight_adjusted_mass = prm.get_bool("use_weight_adjusted_mass");
     use_periodic_bc = prm.get_bool("use_periodic_bc");
     use_energy = prm.get_bool("use_energy");
@@ -444,6 +501,7 @@ const std::string test_string = prm.get("test_type");
     sipg_penalty_factor = prm.get_double("sipg_penalty_factor");
     use_invariant_curl_form = prm.get_bool("use_invariant_curl_form");
     use_inverse_mass_on_the_fly = prm.get_bool("use_inverse_mass_on_the_fly");
+    use_block_diagonal_mass_matrices = prm.get_bool("use_block_diagonal_mass_matrices");
     check_valid_metric_Jacobian = prm.get_bool("check_valid_metric_Jacobian");
     if(!use_weak_form){
         check_valid_metric_Jacobian = false;
@@ -504,6 +562,20 @@ const std::string test_string = prm.get("test_type");
     output_high_order_grid = prm.get_bool("output_high_order_grid");
     enable_higher_order_vtk_output = prm.get_bool("enable_higher_order_vtk_output");
     output_face_results_vtk = prm.get_bool("output_face_results_vtk");
+    number_of_subdivisions_in_vtk_output = prm.get_integer("number_of_subdivisions_in_vtk_output");
+
+    const std::string vtk_output_compression_level_string = prm.get("vtk_output_compression_level");
+    if (vtk_output_compression_level_string == "no_compression")      { vtk_output_compression_level = VtkOutputCompressionLevel::no_compression; }
+    if (vtk_output_compression_level_string == "best_speed")          { vtk_output_compression_level = VtkOutputCompressionLevel::best_speed; }
+    if (vtk_output_compression_level_string == "default_compression") { vtk_output_compression_level = VtkOutputCompressionLevel::default_compression; }
+    if (vtk_output_compression_level_string == "best_compression")    { vtk_output_compression_level = VtkOutputCompressionLevel::best_compression; }
+
+    vtk_output_variables.clear();
+    std::istringstream vtk_output_variables_stream(prm.get("vtk_output_variables"));
+    for (std::string variable; vtk_output_variables_stream >> variable;) {
+        vtk_output_variables.push_back(variable);
+    }
+    write_vtk_output_asynchronously = prm.get_bool("write_vtk_output_asynchronously");
     do_renumber_dofs = prm.get_bool("do_renumber_dofs");
 
     const std::string renumber_dofs_type_string = prm.get("renumber_dofs_type");
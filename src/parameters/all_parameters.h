@@ -119,6 +119,32 @@ public:
     /// Flag to store the residual local processor cput time.
     bool store_residual_cpu_time;
 
+    /// Number of threads per MPI process used to assemble the explicit residual.
+    /** A value of 1 uses the serial cell loop. Larger values use a graph-colored
+     *  cell loop such that face contributions of cells in the same color never write
+     *  to the same cell. Derivative assembly (dRdW, dRdX, d2R) is always serial.
+     */
+    unsigned int n_threads_residual_assembly;
+
+    /// Flag to overlap the solution's ghost exchange with the residual of interior cells.
+    /** Interior cells, which have no ghost neighbours, are assembled while the ghost
+     *  values are in flight. Ignored when the ghosted solution is needed before the cell
+     *  loop, i.e. with artificial dissipation, physics models or auxiliary equations.
+     */
+    bool overlap_ghost_exchange;
+
+    /// Flag to store the metric terms of each cell across residual evaluations.
+    /** Used by the strong form and the on-the-fly inverse mass matrix. Trades memory
+     *  for not rebuilding the metric cofactor and Jacobian determinant on static grids.
+     */
+    bool use_metric_cache;
+
+    /// Flag to use the SIMD-vectorized sum-factorization products in the strong form volume term.
+    /** The states (and auxiliary components) of a cell are packed into the lanes of
+     *  dealii::VectorizedArray, so that one tensor contraction serves several states.
+     */
+    bool use_vectorized_volume_kernel;
+
     /// Flag to use periodic BC.
     /** Not fully tested.
      */
@@ -149,6 +175,9 @@ public:
     /// Flag to use inverse mass matrix on-the-fly for explicit solves.
     bool use_inverse_mass_on_the_fly;
 
+    /// Flag to store the global mass matrices and their inverses as dense blocks per cell instead of sparse matrices.
+    bool use_block_diagonal_mass_matrices;
+
     /// Flag to check if the metric Jacobian is valid when high-order grid is constructed.
     bool check_valid_metric_Jacobian;
 
@@ -289,6 +318,20 @@ public:
     /// Flag for outputting the surface solution vtk files
     bool output_face_results_vtk;
 
+    /// Number of subdivisions of each cell in the solution vtk files; 0 uses the default of enable_higher_order_vtk_output
+    unsigned int number_of_subdivisions_in_vtk_output;
+
+    /// Zlib compression levels of the solution vtk files
+    enum VtkOutputCompressionLevel { no_compression, best_speed, default_compression, best_compression };
+    /// Store the compression level of the solution vtk files
+    VtkOutputCompressionLevel vtk_output_compression_level;
+
+    /// Names of the post-processed variables written to the solution vtk files; all of them if empty
+    std::vector<std::string> vtk_output_variables;
+
+    /// Flag for compressing and writing the solution vtk files in the background
+    bool write_vtk_output_asynchronously;
+
     /// Flag for renumbering DOFs
     bool do_renumber_dofs;
 
@@ -109,7 +109,7 @@ void FlowSolverParam::declare_parameters(dealii::ParameterHandler &prm)
 
         prm.declare_entry("output_restart_files", "false",
                           dealii::Patterns::Bool(),
-                          "Output restart files for restarting the computation. False by default.");
+                          "Output restart files for restarting the computation, on any number of processes. False by default.");
 
         prm.declare_entry("restart_files_directory_name", ".",
                           dealii::Patterns::FileName(dealii::Patterns::FileName::FileType::input),
@@ -281,7 +281,8 @@ void FlowSolverParam::declare_parameters(dealii::ParameterHandler &prm)
         prm.declare_entry("input_flow_setup_filename_prefix", "setup",
                           dealii::Patterns::FileName(dealii::Patterns::FileName::FileType::input),
                           "Filename prefix of the input flow setup file. "
-                          "Example: 'setup' for files named setup-0000i.dat, where i is the MPI rank. "
+                          "Example: 'setup' for files named setup-0000i.dat, where i is the MPI rank, "
+                          "or for the single binary file setup.field written on any number of processes, which is read if it exists. "
                           "For initializing the flow with values from a file. "
                           "To be set when apply_initial_condition_method is read_values_from_file_and_project.");
 
@@ -303,6 +304,12 @@ void FlowSolverParam::declare_parameters(dealii::ParameterHandler &prm)
             prm.declare_entry("output_flow_field_files_directory_name", ".",
                               dealii::Patterns::FileName(dealii::Patterns::FileName::FileType::input),
                               "Name of directory for writing flow field files. Current directory by default.");
+
+            prm.declare_entry("output_flow_field_files_in_binary", "false",
+                              dealii::Patterns::Bool(),
+                              "Write each flow field as a single binary file (.field) with parallel I/O, "
+                              "which can be read on any number of processes, instead of one text file per process. "
+                              "False by default.");
         }
         prm.leave_subsection();
 
@@ -449,6 +456,7 @@ void FlowSolverParam::parse_parameters(dealii::ParameterHandler &prm)
                           << "Please create the directory and restart. Aborting..." << std::endl;
                 std::abort();
             }
+          output_flow_field_files_in_binary = prm.get_bool("output_flow_field_files_in_binary");
         }
         prm.leave_subsection();
 
@@ -17,6 +17,12 @@ void LinearSolverParam::declare_parameters (dealii::ParameterHandler &prm)
                           "Enum of linear solver"
                           "Choices are <direct|gmres>.");
 
+        prm.declare_entry("mesh_movement_preconditioner_type", "ilut",
+                          dealii::Patterns::Selection("ilut|amg"),
+                          "Preconditioner of the GMRES solves of the linear elasticity mesh movement "
+                          "and of its sensitivities. "
+                          "Choices are <ilut|amg>.");
+
         prm.enter_subsection("gmres options");
         {
             prm.declare_entry("linear_residual_tolerance", "1e-4",
@@ -56,6 +62,50 @@ void LinearSolverParam::declare_parameters (dealii::ParameterHandler &prm)
                               dealii::Patterns::Double(),
                               "Factor by which the diagonal of the matrix will be scaled, "
                               "which sometimes can help to get better preconditioners");
+
+            prm.declare_entry("preconditioner_type", "ilut",
+                              dealii::Patterns::Selection("ilut|block_jacobi|block_ilu0|block_gauss_seidel|p_multigrid"),
+                              "Preconditioner of the GMRES solver. "
+                              "ilut uses the Trilinos ILU(k) or ILUT based on ilut_fill. "
+                              "The block preconditioners factor the dense cell blocks of the DG Jacobian with a dense LU "
+                              "and ignore the ilut parameters. "
+                              "p_multigrid cycles over the polynomial degrees with the p-multigrid options. "
+                              "Choices are <ilut|block_jacobi|block_ilu0|block_gauss_seidel|p_multigrid>.");
+            prm.declare_entry("block_gauss_seidel_sweeps", "1",
+                              dealii::Patterns::Integer(1, dealii::Patterns::Integer::max_int_value),
+                              "Number of symmetric sweeps of the block Gauss-Seidel preconditioner.");
+
+            prm.enter_subsection("p-multigrid options");
+            {
+                prm.declare_entry("coarse_degree", "0",
+                                  dealii::Patterns::Integer(0, dealii::Patterns::Integer::max_int_value),
+                                  "Polynomial degree of the coarsest level. "
+                                  "Each level lowers the degree of the cells above it by one.");
+                prm.declare_entry("cycle_type", "v_cycle",
+                                  dealii::Patterns::Selection("v_cycle|w_cycle"),
+                                  "Multigrid cycle. "
+                                  "Choices are <v_cycle|w_cycle>.");
+                prm.declare_entry("smoother_type", "block_jacobi",
+                                  dealii::Patterns::Selection("block_jacobi|runge_kutta"),
+                                  "Smoother of the levels above the coarsest. "
+                                  "block_jacobi uses damped cell-block Jacobi iterations. "
+                                  "runge_kutta uses block-Jacobi preconditioned four-stage Runge-Kutta iterations. "
+                                  "Choices are <block_jacobi|runge_kutta>.");
+                prm.declare_entry("smoothing_steps", "2",
+                                  dealii::Patterns::Integer(0, dealii::Patterns::Integer::max_int_value),
+                                  "Number of pre- and post-smoothing steps on each level above the coarsest.");
+                prm.declare_entry("smoother_relaxation", "0.7",
+                                  dealii::Patterns::Double(0.0, 2.0),
+                                  "Damping factor of the smoother updates.");
+                prm.declare_entry("coarse_solver_type", "ilu",
+                                  dealii::Patterns::Selection("ilu|amg"),
+                                  "Preconditioner of the Richardson iterations on the coarsest level. "
+                                  "Choices are <ilu|amg>.");
+                prm.declare_entry("coarse_iterations", "4",
+                                  dealii::Patterns::Integer(1, dealii::Patterns::Integer::max_int_value),
+                                  "Number of preconditioned Richardson iterations on the coarsest level.");
+            }
+            prm.leave_subsection();
         }
         prm.leave_subsection();
 
@@ -71,6 +121,20 @@ void LinearSolverParam::declare_parameters (dealii::ParameterHandler &prm)
                               dealii::Patterns::Double(),
                               "Small perturbation for Jacobian-free methods."
                               " Default value is the square root of machine epsilon.");
+            prm.declare_entry("use_jfnk_for_steady_state", "false",
+                              dealii::Patterns::Bool(),
+                              "Solve the implicit pseudo-time steps of the steady-state solver with "
+                              "matrix-free finite difference Jacobian-vector products. "
+                              "The Jacobian is then only assembled to build a lagged preconditioner. "
+                              "Requires linear_solver_type = gmres.");
+            prm.declare_entry("jacobian_update_frequency", "10",
+                              dealii::Patterns::Integer(1, dealii::Patterns::Integer::max_int_value),
+                              "Number of pseudo-time steps between assemblies of the Jacobian "
+                              "used to build the matrix-free steady-state preconditioner.");
+            prm.declare_entry("jfnk_preconditioner_type", "ilu",
+                              dealii::Patterns::Selection("ilu|block_jacobi"),
+                              "Preconditioner built from the lagged Jacobian of the matrix-free steady-state solver. "
+                              "Choices are <ilu|block_jacobi>.");
         }
         prm.leave_subsection();
 
@@ -89,6 +153,10 @@ void LinearSolverParam ::parse_parameters (dealii::ParameterHandler &prm)
         const std::string solver_string = prm.get("linear_solver_type");
         if (solver_string == "direct") linear_solver_type = LinearSolverEnum::direct;
 
+        const std::string mesh_movement_preconditioner_string = prm.get("mesh_movement_preconditioner_type");
+        if (mesh_movement_preconditioner_string == "ilut") mesh_movement_preconditioner_type = MeshMovementPreconditionerEnum::ilut;
+        if (mesh_movement_preconditioner_string == "amg")  mesh_movement_preconditioner_type = MeshMovementPreconditionerEnum::amg;
+
         if (solver_string == "gmres")
         {
             linear_solver_type = LinearSolverEnum::gmres;
@@ -102,6 +170,37 @@ void LinearSolverParam ::parse_parameters (dealii::ParameterHandler &prm)
                 ilut_drop = prm.get_double("ilut_drop");
                 ilut_rtol = prm.get_double("ilut_rtol");
                 ilut_atol = prm.get_double("ilut_atol");
+
+                const std::string preconditioner_string = prm.get("preconditioner_type");
+                if (preconditioner_string == "ilut")               preconditioner_type = PreconditionerEnum::ilut;
+                if (preconditioner_string == "block_jacobi")       preconditioner_type = PreconditionerEnum::block_jacobi;
+                if (preconditioner_string == "block_ilu0")         preconditioner_type = PreconditionerEnum::block_ilu0;
+                if (preconditioner_string == "block_gauss_seidel") preconditioner_type = PreconditionerEnum::block_gauss_seidel;
+                if (preconditioner_string == "p_multigrid")        preconditioner_type = PreconditionerEnum::p_multigrid;
+                block_gauss_seidel_sweeps = prm.get_integer("block_gauss_seidel_sweeps");
+
+                prm.enter_subsection("p-multigrid options");
+                {
+                    p_multigrid_coarse_degree = prm.get_integer("coarse_degree");
+
+                    const std::string cycle_string = prm.get("cycle_type");
+                    if (cycle_string == "v_cycle") p_multigrid_cycle_type = PMultigridCycleEnum::v_cycle;
+                    if (cycle_string == "w_cycle") p_multigrid_cycle_type = PMultigridCycleEnum::w_cycle;
+
+                    const std::string smoother_string = prm.get("smoother_type");
+                    if (smoother_string == "block_jacobi") p_multigrid_smoother_type = PMultigridSmootherEnum::block_jacobi;
+                    if (smoother_string == "runge_kutta")  p_multigrid_smoother_type = PMultigridSmootherEnum::runge_kutta;
+
+                    p_multigrid_smoothing_steps = prm.get_integer("smoothing_steps");
+                    p_multigrid_smoother_relaxation = prm.get_double("smoother_relaxation");
+
+                    const std::string coarse_solver_string = prm.get("coarse_solver_type");
+                    if (coarse_solver_string == "ilu") p_multigrid_coarse_solver_type = PMultigridCoarseSolverEnum::ilu;
+                    if (coarse_solver_string == "amg") p_multigrid_coarse_solver_type = PMultigridCoarseSolverEnum::amg;
+
+                    p_multigrid_coarse_iterations = prm.get_integer("coarse_iterations");
+                }
+                prm.leave_subsection();
             }
             prm.leave_subsection();
         }
@@ -111,6 +210,12 @@ void LinearSolverParam ::parse_parameters (dealii::ParameterHandler &prm)
             newton_residual = prm.get_double("newton_residual");
             newton_max_iterations = prm.get_integer("newton_max_iterations");
             perturbation_magnitude = prm.get_double("perturbation_magnitude");
+            use_jfnk_for_steady_state = prm.get_bool("use_jfnk_for_steady_state");
+            jacobian_update_frequency = prm.get_integer("jacobian_update_frequency");
+
+            const std::string preconditioner_string = prm.get("jfnk_preconditioner_type");
+            if (preconditioner_string == "ilu")          jfnk_preconditioner_type = JFNKPreconditionerEnum::ilu;
+            if (preconditioner_string == "block_jacobi") jfnk_preconditioner_type = JFNKPreconditionerEnum::block_jacobi;
         }
         prm.leave_subsection();
 
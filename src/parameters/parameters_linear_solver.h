@@ -32,6 +32,40 @@ public:
 
     int ilut_fill; ///< ILU fill-in
 
+    /// Types of preconditioners for the GMRES solver.
+    enum class PreconditionerEnum {
+        ilut,              /// Trilinos ILU(k) or ILUT, depending on ilut_fill.
+        block_jacobi,      /// Exact inverse of the cell-diagonal blocks.
+        block_ilu0,        /// Block ILU(0) on the cell graph.
+        block_gauss_seidel, /// Symmetric block Gauss-Seidel sweeps.
+        p_multigrid         /// p-multigrid cycle over the polynomial degrees.
+    };
+    PreconditionerEnum preconditioner_type; ///< Preconditioner of the GMRES solver.
+    int block_gauss_seidel_sweeps; ///< Number of symmetric sweeps of the block Gauss-Seidel preconditioner.
+
+    /// Types of p-multigrid cycles.
+    enum class PMultigridCycleEnum {
+        v_cycle, /// One coarse-level correction per level.
+        w_cycle  /// Two coarse-level corrections per level.
+    };
+    /// Smoothers of the p-multigrid fine levels.
+    enum class PMultigridSmootherEnum {
+        block_jacobi, /// Damped cell-block Jacobi iterations.
+        runge_kutta   /// Block-Jacobi preconditioned four-stage Runge-Kutta iterations.
+    };
+    /// Solvers of the p-multigrid coarsest level.
+    enum class PMultigridCoarseSolverEnum {
+        ilu, /// ILU preconditioned Richardson iterations.
+        amg  /// AMG preconditioned Richardson iterations.
+    };
+    int p_multigrid_coarse_degree; ///< Polynomial degree of the coarsest p-multigrid level.
+    PMultigridCycleEnum p_multigrid_cycle_type; ///< V- or W-cycle.
+    PMultigridSmootherEnum p_multigrid_smoother_type; ///< Smoother of the fine levels.
+    int p_multigrid_smoothing_steps; ///< Number of pre- and post-smoothing steps on each fine level.
+    double p_multigrid_smoother_relaxation; ///< Damping factor of the smoother updates.
+    PMultigridCoarseSolverEnum p_multigrid_coarse_solver_type; ///< Solver of the coarsest level.
+    int p_multigrid_coarse_iterations; ///< Number of preconditioned Richardson iterations on the coarsest level.
+
     double linear_residual; ///< Tolerance for linear residual.
     int max_iterations; ///< Maximum number of linear iteration.
     int restart_number; ///< Number of iterations before restarting GMRES
@@ -40,6 +74,23 @@ public:
     int newton_max_iterations; ///< Maximum number of Newton iterations (for Jacobian-free Newton-Krylov)
     double perturbation_magnitude; ///<Small perturbation magnitude for Jacobian-free methods
 
+    /// Types of preconditioners built from the lagged Jacobian of the matrix-free steady-state solver.
+    enum class JFNKPreconditionerEnum {
+        ilu,         /// ILU(k) or ILUT, using the gmres options' ilut parameters.
+        block_jacobi /// Inverse of the cell-diagonal blocks.
+    };
+
+    bool use_jfnk_for_steady_state; ///< Flag to solve the implicit pseudo-time steps matrix-free instead of with the assembled Jacobian
+    int jacobian_update_frequency; ///< Number of pseudo-time steps between Jacobian assemblies for the matrix-free steady-state preconditioner
+    JFNKPreconditionerEnum jfnk_preconditioner_type; ///< Preconditioner of the matrix-free steady-state solver
+
+    /// Types of preconditioners of the linear elasticity mesh movement solves.
+    enum class MeshMovementPreconditionerEnum {
+        ilut, /// Trilinos ILUT.
+        amg   /// Smoothed aggregation AMG with the rigid-body modes as near-nullspace.
+    };
+    MeshMovementPreconditionerEnum mesh_movement_preconditioner_type; ///< Preconditioner of the mesh movement solves
+
     /// Declares the possible variables and sets the defaults.
     static void declare_parameters (dealii::ParameterHandler &prm);
     /// Parses input file and sets the variables.
@@ -75,7 +75,8 @@ void ODESolverParam::declare_parameters (dealii::ParameterHandler &prm)
                           "Output final steady state solution to file if set to true");
         prm.declare_entry("steady_state_final_solution_filename", "solution_snapshot",
                           dealii::Patterns::Anything(),
-                          "Filename to use when outputting solution to a file.");
+                          "Filename to use when outputting solution to a file. "
+                          "The solution is written as a binary snapshot file with the extension .snapshots.");
         prm.declare_entry("output_ode_solver_steady_state_convergence_table","false",
                           dealii::Patterns::Bool(),
                           "Set as false by default. If true, writes the linear solver convergence data "
@@ -102,8 +103,12 @@ void ODESolverParam::declare_parameters (dealii::ParameterHandler &prm)
                           " euler_ex | "
                           " euler_im | "
                           " dirk_2_im | "
-                          " dirk_3_im"),
-                          "Runge-kutta method to use. Methods with _ex are explicit, and with _im are implicit."
+                          " dirk_3_im | "
+                          " lsrk3_2N_ex | "
+                          " lsrk4_2N_ex | "
+                          " bs3_ex"),
+                          "Runge-kutta method to use. Methods with _ex are explicit, and with _im are implicit. "
+                          "Methods with _2N are low-storage and only store two solution-sized registers regardless of the number of stages."
                           "Choices are "
                           " <rk4_ex | "
                           " ssprk3_ex | "
@@ -111,7 +116,39 @@ void ODESolverParam::declare_parameters (dealii::ParameterHandler &prm)
                           " euler_ex | "
                           " euler_im | "
                           " dirk_2_im | "
-                          " dirk_3_im>.");
+                          " dirk_3_im | "
+                          " lsrk3_2N_ex | "
+                          " lsrk4_2N_ex | "
+                          " bs3_ex>.");
+        prm.enter_subsection("embedded error control");
+        {
+            prm.declare_entry("use_error_controlled_time_step", "false",
+                              dealii::Patterns::Bool(),
+                              "Adapt the time step from the local error estimated with the embedded RK pair, using a PI controller. "
+                              "Only valid for RK methods with an embedded pair (bs3_ex). False by default.");
+
+            prm.declare_entry("relative_tolerance", "1e-4",
+                              dealii::Patterns::Double(0,dealii::Patterns::Double::max_double_value),
+                              "Relative tolerance on the local error estimate.");
+
+            prm.declare_entry("absolute_tolerance", "1e-6",
+                              dealii::Patterns::Double(0,dealii::Patterns::Double::max_double_value),
+                              "Absolute tolerance on the local error estimate.");
+
+            prm.declare_entry("safety_factor", "0.9",
+                              dealii::Patterns::Double(0,1),
+                              "Safety factor multiplying the time step proposed by the PI controller.");
+
+            prm.declare_entry("maximum_rejected_steps", "20",
+                              dealii::Patterns::Integer(0,dealii::Patterns::Integer::max_int_value),
+                              "Maximum number of consecutive rejections of a time step before aborting.");
+
+            prm.declare_entry("minimum_time_step", "1e-14",
+                              dealii::Patterns::Double(0,dealii::Patterns::Double::max_double_value),
+                              "Time step below which a rejected step aborts the computation.");
+        }
+        prm.leave_subsection();
+
         prm.enter_subsection("rrk root solver");
         {
             prm.declare_entry("rrk_root_solver_output", "quiet",
@@ -174,6 +211,8 @@ void ODESolverParam::parse_parameters (dealii::ParameterHandler &prm)
         initial_desired_time_for_output_solution_every_dt_time_intervals = prm.get_double("initial_desired_time_for_output_solution_every_dt_time_intervals");
         
         const std::string rk_method_string = prm.get("runge_kutta_method");
+        rk_low_storage = false;
+        rk_embedded_order = 0;
         if (rk_method_string == "rk4_ex"){
             runge_kutta_method = RKMethodEnum::rk4_ex;
             n_rk_stages  = 4;
@@ -209,6 +248,35 @@ void ODESolverParam::parse_parameters (dealii::ParameterHandler &prm)
             n_rk_stages  = 3;
             rk_order = 3;
         }
+        else if (rk_method_string == "lsrk3_2N_ex"){
+            runge_kutta_method = RKMethodEnum::lsrk3_2N_ex;
+            n_rk_stages  = 3;
+            rk_order = 3;
+            rk_low_storage = true;
+        }
+        else if (rk_method_string == "lsrk4_2N_ex"){
+            runge_kutta_method = RKMethodEnum::lsrk4_2N_ex;
+            n_rk_stages  = 5;
+            rk_order = 4;
+            rk_low_storage = true;
+        }
+        else if (rk_method_string == "bs3_ex"){
+            runge_kutta_method = RKMethodEnum::bs3_ex;
+            n_rk_stages  = 4;
+            rk_order = 3;
+            rk_embedded_order = 2;
+        }
+        prm.enter_subsection("embedded error control");
+        {
+            use_error_controlled_time_step = prm.get_bool("use_error_controlled_time_step");
+            error_control_relative_tolerance = prm.get_double("relative_tolerance");
+            error_control_absolute_tolerance = prm.get_double("absolute_tolerance");
+            error_control_safety_factor = prm.get_double("safety_factor");
+            error_control_maximum_rejected_steps = prm.get_integer("maximum_rejected_steps");
+            error_control_minimum_time_step = prm.get_double("minimum_time_step");
+        }
+        prm.leave_subsection();
+
         prm.enter_subsection("rrk root solver");
         {
             const std::string output_string_rrk = prm.get("rrk_root_solver_output");
@@ -61,12 +61,25 @@ public:
         euler_ex, ///Forward Euler
         euler_im, ///Implicit Euler
         dirk_2_im, ///Second-order diagonally-implicit RK
-        dirk_3_im ///Third-order diagonally-implicit RK
+        dirk_3_im, ///Third-order diagonally-implicit RK
+        lsrk3_2N_ex, ///Third-order, three-stage low-storage (2N) RK of Williamson
+        lsrk4_2N_ex, ///Fourth-order, five-stage low-storage (2N) RK of Carpenter and Kennedy
+        bs3_ex ///Bogacki-Shampine third-order RK with embedded second-order pair
     };
 
     RKMethodEnum runge_kutta_method; ///< Runge-kutta method.
     int n_rk_stages; ///< Number of stages for an RK method; assigned based on runge_kutta_method
     int rk_order; ///< Order of the RK method; assigned based on runge_kutta_method
+    bool rk_low_storage; ///< Flag for a low-storage (2N) RK method; assigned based on runge_kutta_method
+    int rk_embedded_order; ///< Order of the embedded RK method; assigned based on runge_kutta_method, 0 if there is no embedded pair
+
+    /// Flag to control the time step from the embedded error estimate
+    bool use_error_controlled_time_step;
+    double error_control_relative_tolerance; ///< Relative tolerance on the local error estimate
+    double error_control_absolute_tolerance; ///< Absolute tolerance on the local error estimate
+    double error_control_safety_factor; ///< Safety factor of the PI step size controller
+    unsigned int error_control_maximum_rejected_steps; ///< Maximum number of consecutive rejections of a time step
+    double error_control_minimum_time_step; ///< Time step below which a rejected step aborts
 
     /// Flag to signal that automatic differentiation (AD) matrix dRdW must be allocated
     bool allocate_matrix_dRdW;
@@ -30,6 +30,20 @@ void ReducedOrderModelParam::declare_parameters (dealii::ParameterHandler &prm)
         prm.declare_entry("parameter_max_values", "0.7, 4",
                           dealii::Patterns::List(dealii::Patterns::Double(), 0, 10, ","),
                           "Maximum values for parameters");
+        prm.declare_entry("hyper_reduction", "none",
+                          dealii::Patterns::Selection("none | ecsw"),
+                          "Hyper-reduction of the reduced-order residual and Jacobian. "
+                          "Choices are <none | ecsw>. "
+                          "ecsw only assembles the cells sampled by energy-conserving sampling and weighting.");
+        prm.declare_entry("ecsw_tolerance", "1E-4",
+                          dealii::Patterns::Double(0, 1),
+                          "Relative tolerance of the non-negative least-squares problem selecting the ECSW cells. "
+                          "A looser tolerance samples fewer cells.");
+        prm.declare_entry("number_of_sampling_groups", "1",
+                          dealii::Patterns::Integer(1, dealii::Patterns::Integer::max_int_value),
+                          "Number of groups the processes are split into during adaptive sampling. "
+                          "Each group solves its own full-order snapshots and ROM test locations, claimed dynamically. "
+                          "Must divide the number of processes.");
     }
     prm.leave_subsection();
 }
@@ -44,6 +58,12 @@ void ReducedOrderModelParam::parse_parameters (dealii::ParameterHandler &prm)
         recomputation_coefficient = prm.get_integer("recomputation_coefficient");
         path_to_search = prm.get("path_to_search");
 
+        const std::string hyper_reduction_string = prm.get("hyper_reduction");
+        if (hyper_reduction_string == "none") hyper_reduction = HyperReductionEnum::none;
+        else if (hyper_reduction_string == "ecsw") hyper_reduction = HyperReductionEnum::ecsw;
+        ecsw_tolerance = prm.get_double("ecsw_tolerance");
+        number_of_sampling_groups = prm.get_integer("number_of_sampling_groups");
+
         std::string parameter_names_string = prm.get("parameter_names");
         std::unique_ptr<dealii::Patterns::PatternBase> ListPatternNames(new dealii::Patterns::List(dealii::Patterns::Anything(), 0, 10, ",")); //Note, in a future version of dealii, this may change from a unique_ptr to simply the object. Will need to use std::move(ListPattern) in next line.
         parameter_names = dealii::Patterns::Tools::Convert<decltype(parameter_names)>::to_value(parameter_names_string, ListPatternNames);
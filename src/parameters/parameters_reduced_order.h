@@ -34,6 +34,20 @@ public:
     /// Maximum value of parameters
     std::vector<double> parameter_max_values;
 
+    /// Types of hyper-reduction of the reduced-order residual and Jacobian
+    enum class HyperReductionEnum {
+        none, ///< The residual and Jacobian are assembled on the full mesh.
+        ecsw  ///< Energy-conserving sampling and weighting of the cells.
+    };
+    /// Hyper-reduction of the reduced-order residual and Jacobian
+    HyperReductionEnum hyper_reduction;
+
+    /// Relative tolerance of the non-negative least-squares problem providing the ECSW weights
+    double ecsw_tolerance;
+
+    /// Number of groups of processes solving the adaptive sampling snapshots and ROM test locations concurrently
+    int number_of_sampling_groups;
+
     /// Declares the possible variables and sets the defaults.
     static void declare_parameters (dealii::ParameterHandler &prm);
     /// Parses input file and sets the variables.
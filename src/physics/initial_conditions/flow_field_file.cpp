@@ -0,0 +1,274 @@
+#include "flow_field_file.h"
+
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace PHiLiP {
+
+static_assert(sizeof(FlowFieldFileHeader) == FlowFieldFile::data_offset, "The flow field file header must fill the data offset.");
+
+namespace {
+
+const char flow_field_file_magic[8] = {'P','H','F','L','O','W','F','D'};
+const std::uint32_t flow_field_file_version = 1;
+const std::uint64_t flow_field_file_byte_order_mark = 0x0102030405060708ULL;
+
+/// Returns true if header starts a valid flow field file.
+bool is_valid_header(const FlowFieldFileHeader &header)
+{
+    return std::memcmp(header.magic, flow_field_file_magic, sizeof(flow_field_file_magic)) == 0
+           && header.version == flow_field_file_version
+           && header.byte_order_mark == flow_field_file_byte_order_mark;
+}
+
+/// Offset of the first record in a file of n_cells cells, in bytes.
+MPI_Offset records_offset(const std::uint64_t n_cells)
+{
+    return FlowFieldFile::data_offset + n_cells * sizeof(std::uint64_t);
+}
+
+/// Process storing the record of a key in the distributed hash table.
+unsigned int key_owner(const std::uint64_t key, const unsigned int n_mpi_processes)
+{
+    return key % n_mpi_processes;
+}
+
+/// Sends send_buffers[rank] to each process and returns the buffer received from each process.
+std::vector<std::vector<std::uint64_t>> exchange(const std::vector<std::vector<std::uint64_t>> &send_buffers, const MPI_Comm mpi_communicator)
+{
+    const unsigned int n_mpi_processes = send_buffers.size();
+    std::vector<int> send_counts(n_mpi_processes), send_displacements(n_mpi_processes);
+    std::vector<std::uint64_t> send_data;
+    for (unsigned int rank = 0; rank < n_mpi_processes; ++rank) {
+        send_counts[rank] = send_buffers[rank].size();
+        send_displacements[rank] = send_data.size();
+        send_data.insert(send_data.end(), send_buffers[rank].begin(), send_buffers[rank].end());
+    }
+
+    std::vector<int> recv_counts(n_mpi_processes), recv_displacements(n_mpi_processes);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_communicator);
+    std::partial_sum(recv_counts.begin(), recv_counts.end() - 1, recv_displacements.begin() + 1);
+    std::vector<std::uint64_t> recv_data(recv_displacements.back() + recv_counts.back());
+    MPI_Alltoallv(send_data.data(), send_counts.data(), send_displacements.data(), MPI_UINT64_T,
+                  recv_data.data(), recv_counts.data(), recv_displacements.data(), MPI_UINT64_T, mpi_communicator);
+
+    std::vector<std::vector<std::uint64_t>> recv_buffers(n_mpi_processes);
+    for (unsigned int rank = 0; rank < n_mpi_processes; ++rank) {
+        recv_buffers[rank].assign(recv_data.begin() + recv_displacements[rank],
+                                  recv_data.begin() + recv_displacements[rank] + recv_counts[rank]);
+    }
+    return recv_buffers;
+}
+
+}
+
+FlowFieldFile::FlowFieldFile(const std::string &filename_input, const MPI_Comm mpi_communicator_input)
+        : filename(filename_input)
+        , mpi_communicator(mpi_communicator_input)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
+        , pcout(std::cout, mpi_rank==0)
+{}
+
+bool FlowFieldFile::is_flow_field_file(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    FlowFieldFileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(FlowFieldFileHeader))) return false;
+    return is_valid_header(header);
+}
+
+std::uint64_t FlowFieldFile::cell_key(const dealii::CellId &cell_id)
+{
+    // 64-bit FNV-1a hash of the cell id, which names the coarse cell and the path of children down to the cell.
+    const std::string cell_id_string = cell_id.to_string();
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const char c : cell_id_string) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void FlowFieldFile::write(const unsigned int dim,
+                          const std::vector<dealii::CellId> &cell_ids,
+                          const unsigned int n_points_per_cell,
+                          const unsigned int n_values_per_point,
+                          const std::vector<double> &values) const
+{
+    const std::uint64_t n_values_per_cell = n_points_per_cell * n_values_per_point;
+    const std::uint64_t n_local_cells = cell_ids.size();
+    if (values.size() != n_local_cells * n_values_per_cell) {
+        std::cout << "Error: " << values.size() << " values given for the " << n_local_cells << " cells of flow field file "
+                  << filename << ", instead of " << n_local_cells * n_values_per_cell << "." << std::endl;
+        std::abort();
+    }
+
+    // The cells of each process are written after the cells of the lower ranks.
+    std::uint64_t first_cell = 0;
+    MPI_Exscan(&n_local_cells, &first_cell, 1, MPI_UINT64_T, MPI_SUM, mpi_communicator);
+    if (mpi_rank == 0) first_cell = 0;
+    std::uint64_t n_cells = 0;
+    MPI_Allreduce(&n_local_cells, &n_cells, 1, MPI_UINT64_T, MPI_SUM, mpi_communicator);
+
+    FlowFieldFileHeader header;
+    std::memset(&header, 0, sizeof(FlowFieldFileHeader));
+    std::memcpy(header.magic, flow_field_file_magic, sizeof(flow_field_file_magic));
+    header.version = flow_field_file_version;
+    header.dim = dim;
+    header.n_cells = n_cells;
+    header.n_points_per_cell = n_points_per_cell;
+    header.n_values_per_point = n_values_per_point;
+    header.byte_order_mark = flow_field_file_byte_order_mark;
+
+    std::vector<std::uint64_t> keys(n_local_cells);
+    std::transform(cell_ids.begin(), cell_ids.end(), keys.begin(), cell_key);
+
+    MPI_File file;
+    if (MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        pcout << "Error opening flow field file " << filename << std::endl;
+        std::abort();
+    }
+    MPI_File_set_size(file, 0);
+    if (mpi_rank == 0) {
+        MPI_File_write_at(file, 0, &header, sizeof(FlowFieldFileHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    MPI_File_write_at_all(file, data_offset + first_cell * sizeof(std::uint64_t),
+                          keys.data(), keys.size(), MPI_UINT64_T, MPI_STATUS_IGNORE);
+    MPI_File_write_at_all(file, records_offset(n_cells) + first_cell * n_values_per_cell * sizeof(double),
+                          values.data(), values.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+}
+
+std::vector<double> FlowFieldFile::read(const unsigned int dim,
+                                        const std::vector<dealii::CellId> &cell_ids,
+                                        const unsigned int n_points_per_cell,
+                                        const unsigned int n_values_per_point) const
+{
+    MPI_File file;
+    if (MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        pcout << "Error opening flow field file " << filename << std::endl;
+        std::abort();
+    }
+
+    // The first process reads the header and broadcasts it.
+    FlowFieldFileHeader header;
+    std::memset(&header, 0, sizeof(FlowFieldFileHeader));
+    if (mpi_rank == 0) {
+        MPI_File_read_at(file, 0, &header, sizeof(FlowFieldFileHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    MPI_Bcast(&header, sizeof(FlowFieldFileHeader), MPI_BYTE, 0, mpi_communicator);
+    if (!is_valid_header(header)) {
+        pcout << "Error: " << filename << " is not a flow field file of version " << flow_field_file_version
+              << " written with the byte order of this machine." << std::endl;
+        std::abort();
+    }
+    if (header.dim != dim || header.n_points_per_cell != n_points_per_cell || header.n_values_per_point != n_values_per_point) {
+        pcout << "Error: flow field file " << filename << " stores " << header.n_values_per_point << " values at "
+              << header.n_points_per_cell << " points of each cell in " << header.dim << "D, instead of "
+              << n_values_per_point << " values at " << n_points_per_cell << " points in " << dim << "D." << std::endl;
+        std::abort();
+    }
+
+    const std::uint64_t n_values_per_cell = n_points_per_cell * n_values_per_point;
+    const std::vector<std::uint64_t> records = find_records(file, header.n_cells, cell_ids);
+
+    // The records are read in the order in which they are stored, as required by MPI file views.
+    std::vector<std::size_t> order(cell_ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&records](const std::size_t a, const std::size_t b) { return records[a] < records[b]; });
+    std::vector<MPI_Aint> displacements(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        displacements[i] = records_offset(header.n_cells) + records[order[i]] * n_values_per_cell * sizeof(double);
+    }
+    MPI_Datatype records_type;
+    MPI_Type_create_hindexed_block(displacements.size(), n_values_per_cell, displacements.data(), MPI_DOUBLE, &records_type);
+    MPI_Type_commit(&records_type);
+    char data_representation[] = "native";
+    MPI_File_set_view(file, 0, MPI_DOUBLE, records_type, data_representation, MPI_INFO_NULL);
+    MPI_Type_free(&records_type);
+
+    std::vector<double> sorted_values(cell_ids.size() * n_values_per_cell);
+    MPI_File_read_all(file, sorted_values.data(), sorted_values.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+
+    std::vector<double> values(sorted_values.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        std::copy(sorted_values.begin() + i * n_values_per_cell, sorted_values.begin() + (i + 1) * n_values_per_cell,
+                  values.begin() + order[i] * n_values_per_cell);
+    }
+    return values;
+}
+
+std::vector<std::uint64_t> FlowFieldFile::find_records(MPI_File file,
+                                                       const std::uint64_t n_cells,
+                                                       const std::vector<dealii::CellId> &cell_ids) const
+{
+    const unsigned int n_mpi_processes = dealii::Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    // Each process reads an even slice of the key table and sends the (key, record) pairs to the keys' owners.
+    const std::uint64_t first_record = n_cells * mpi_rank / n_mpi_processes;
+    const std::uint64_t end_record = n_cells * (mpi_rank + 1) / n_mpi_processes;
+    std::vector<std::uint64_t> keys(end_record - first_record);
+    MPI_File_read_at_all(file, data_offset + first_record * sizeof(std::uint64_t),
+                         keys.data(), keys.size(), MPI_UINT64_T, MPI_STATUS_IGNORE);
+
+    std::vector<std::vector<std::uint64_t>> key_records(n_mpi_processes);
+    for (std::uint64_t i = 0; i < keys.size(); ++i) {
+        std::vector<std::uint64_t> &key_records_owner = key_records[key_owner(keys[i], n_mpi_processes)];
+        key_records_owner.push_back(keys[i]);
+        key_records_owner.push_back(first_record + i);
+    }
+    key_records = exchange(key_records, mpi_communicator);
+
+    std::unordered_map<std::uint64_t, std::uint64_t> record_of_key;
+    for (const std::vector<std::uint64_t> &received : key_records) {
+        for (std::size_t i = 0; i < received.size(); i += 2) {
+            if (!record_of_key.emplace(received[i], received[i+1]).second) {
+                std::cout << "Error: flow field file " << filename << " stores two cells with the key " << received[i] << "." << std::endl;
+                std::abort();
+            }
+        }
+    }
+
+    // Each process then asks the owners for the records of its cells' keys.
+    std::vector<std::vector<std::uint64_t>> requested_keys(n_mpi_processes);
+    std::vector<std::vector<std::size_t>> requesting_cells(n_mpi_processes);
+    for (std::size_t i = 0; i < cell_ids.size(); ++i) {
+        const std::uint64_t key = cell_key(cell_ids[i]);
+        const unsigned int owner = key_owner(key, n_mpi_processes);
+        requested_keys[owner].push_back(key);
+        requesting_cells[owner].push_back(i);
+    }
+    std::vector<std::vector<std::uint64_t>> answers = exchange(requested_keys, mpi_communicator);
+
+    const std::uint64_t missing_record = std::numeric_limits<std::uint64_t>::max();
+    for (std::vector<std::uint64_t> &answer : answers) {
+        for (std::uint64_t &key_or_record : answer) {
+            const auto record = record_of_key.find(key_or_record);
+            key_or_record = (record == record_of_key.end()) ? missing_record : record->second;
+        }
+    }
+    answers = exchange(answers, mpi_communicator);
+
+    std::vector<std::uint64_t> records(cell_ids.size());
+    for (unsigned int rank = 0; rank < n_mpi_processes; ++rank) {
+        for (std::size_t i = 0; i < answers[rank].size(); ++i) {
+            const std::size_t cell = requesting_cells[rank][i];
+            if (answers[rank][i] == missing_record) {
+                std::cout << "Error: cell " << cell_ids[cell].to_string() << " is missing from flow field file " << filename << "." << std::endl;
+                std::abort();
+            }
+            records[cell] = answers[rank][i];
+        }
+    }
+    return records;
+}
+
+}
@@ -0,0 +1,94 @@
+#ifndef __FLOW_FIELD_FILE__
+#define __FLOW_FIELD_FILE__
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/grid/cell_id.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+namespace PHiLiP {
+
+/// Header of a binary flow field file.
+/** The header is followed by the keys of the n_cells cells, as std::uint64_t, then by the record of each cell in the same
+ *  order. A record holds the n_values_per_point values, typically the coordinates followed by flow quantities, at each of
+ *  the n_points_per_cell points of the cell, as doubles in native byte order.
+ */
+struct FlowFieldFileHeader
+{
+    char magic[8]; ///< File signature, "PHFLOWFD".
+    std::uint32_t version; ///< Version of the file layout.
+    std::uint32_t dim; ///< Number of dimensions of the mesh.
+    std::uint64_t n_cells; ///< Number of cells.
+    std::uint32_t n_points_per_cell; ///< Number of points at which the values of each cell are stored.
+    std::uint32_t n_values_per_point; ///< Number of values stored at each point.
+    std::uint64_t byte_order_mark; ///< Written as 0x0102030405060708 to detect files written with another byte order.
+    std::uint64_t reserved[3]; ///< Pads the header to 64 bytes.
+};
+
+/// Single binary file holding values at points of every cell, such as velocity fields and flow setups.
+/** The values are stored by cell, under a key computed from the deal.II cell id, which identifies the cell independently of
+ *  the partition of the mesh. Each process writes its locally owned cells contiguously with collective MPI-IO, and reads the
+ *  cells it owns wherever they are in the file. A file written on any number of processes can therefore be read on any
+ *  other number of processes, with any partition of the same mesh.
+ *
+ *  All the member functions except is_flow_field_file and cell_key are collective over mpi_communicator.
+ */
+class FlowFieldFile
+{
+public:
+    /// Constructor.
+    FlowFieldFile(const std::string &filename_input, const MPI_Comm mpi_communicator_input);
+
+    /// Returns true if filename starts with a valid flow field file header. Does not communicate.
+    static bool is_flow_field_file(const std::string &filename);
+
+    /// Key of a cell in the file.
+    static std::uint64_t cell_key(const dealii::CellId &cell_id);
+
+    /// Overwrites the file with the values of the cells of each process.
+    /** values holds the n_values_per_point values at the n_points_per_cell points of each cell, in the order of cell_ids.
+     */
+    void write(const unsigned int dim,
+               const std::vector<dealii::CellId> &cell_ids,
+               const unsigned int n_points_per_cell,
+               const unsigned int n_values_per_point,
+               const std::vector<double> &values) const;
+
+    /// Returns the values of the given cells, in the same layout as write().
+    /** Aborts if the file stores another number of points or values per cell, or if a cell is missing.
+     */
+    std::vector<double> read(const unsigned int dim,
+                             const std::vector<dealii::CellId> &cell_ids,
+                             const unsigned int n_points_per_cell,
+                             const unsigned int n_values_per_point) const;
+
+    /// Offset of the cell keys in the file, in bytes.
+    static constexpr std::size_t data_offset = 64;
+
+    const std::string filename; ///< Name of the file.
+    const MPI_Comm mpi_communicator; ///< MPI communicator.
+    const int mpi_rank; ///< MPI rank.
+
+protected:
+    /// Returns the record of each of the given cells in a file storing n_cells cells.
+    /** The key table is not read by every process. Each process reads a contiguous slice of it and sends each key to the
+     *  process owning it in a distributed hash table, which then answers the lookups of the other processes. The memory and
+     *  communication per process are therefore proportional to the number of cells per process rather than to n_cells.
+     */
+    std::vector<std::uint64_t> find_records(MPI_File file,
+                                            const std::uint64_t n_cells,
+                                            const std::vector<dealii::CellId> &cell_ids) const;
+
+    /// ConditionalOStream.
+    /** Used as std::cout, but only prints if mpi_rank == 0
+     */
+    dealii::ConditionalOStream pcout;
+};
+
+}
+
+#endif
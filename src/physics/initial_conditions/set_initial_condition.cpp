@@ -1,6 +1,8 @@
 #include "set_initial_condition.h"
 #include "parameters/parameters_flow_solver.h"
+#include "flow_field_file.h"
 #include <deal.II/numerics/vector_tools.h>
+#include <array>
 #include <string>
 #include <stdlib.h>
 #include <sstream>
@@ -45,7 +47,7 @@ void SetInitialCondition<dim,nstate,real>::interpolate_initial_condition(
         std::shared_ptr < PHiLiP::DGBase<dim,real> > &dg) 
 {
     dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
-    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    solution_no_ghost.reinit(dg->locally_owned_dofs, dg->mpi_communicator);
     dealii::VectorTools::interpolate(dg->dof_handler,*initial_condition_function,solution_no_ghost);
     dg->solution = solution_no_ghost;
 }
@@ -118,6 +120,12 @@ void SetInitialCondition<dim,nstate,real>::read_values_from_file_and_project(
 {
     dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
     
+    // (0) Use the binary file written on any number of processes if it exists
+    //-------------------------------------------------------------
+    const std::string binary_filename = input_filename_prefix + std::string(".field");
+    const bool read_binary = FlowFieldFile::is_flow_field_file(binary_filename);
+    //-------------------------------------------------------------
+
     // (1) Get filename based on MPI rank
     //-------------------------------------------------------------
     const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
@@ -133,31 +141,54 @@ void SetInitialCondition<dim,nstate,real>::read_values_from_file_and_project(
     std::string line;
     std::string::size_type sz1;
 
-    std::ifstream FILE (filename);
-    std::getline(FILE, line); // read first line: DOFs
-    
-    // check that the file is not empty
-    if (line.empty()) {
-        pcout << "ERROR: Trying to read empty file named " << filename << std::endl;
-        std::abort();
-    } else {
-        const unsigned int number_of_degrees_of_freedom_per_state_DG = dg->dof_handler.n_dofs()/nstate;
-        const unsigned int number_of_degrees_of_freedom_per_state_file = std::stoi(line);
-        if(number_of_degrees_of_freedom_per_state_file != number_of_degrees_of_freedom_per_state_DG) {
-            pcout << "ERROR: Cannot read initial condition. "
-                      << "Number of degrees of freedom per state do not match expected by DG in file: " 
-                      << filename << "\n Aborting..." << std::endl;
+    std::ifstream FILE;
+    if (!read_binary) {
+        FILE.open(filename);
+        std::getline(FILE, line); // read first line: DOFs
+        
+        // check that the file is not empty
+        if (line.empty()) {
+            pcout << "ERROR: Trying to read empty file named " << filename << std::endl;
             std::abort();
+        } else {
+            const unsigned int number_of_degrees_of_freedom_per_state_DG = dg->dof_handler.n_dofs()/nstate;
+            const unsigned int number_of_degrees_of_freedom_per_state_file = std::stoi(line);
+            if(number_of_degrees_of_freedom_per_state_file != number_of_degrees_of_freedom_per_state_DG) {
+                pcout << "ERROR: Cannot read initial condition. "
+                          << "Number of degrees of freedom per state do not match expected by DG in file: " 
+                          << filename << "\n Aborting..." << std::endl;
+                std::abort();
+            }
         }
-    }
 
-    std::getline(FILE, line); // read first line of data
+        std::getline(FILE, line); // read first line of data
 
-    // check that there indeed is data to be read
-    if (line.empty()) {
-        pcout << "Error: File has no data to be read" << std::endl;
-        std::abort();
+        // check that there indeed is data to be read
+        if (line.empty()) {
+            pcout << "Error: File has no data to be read" << std::endl;
+            std::abort();
+        }
+    }
+
+    // Values of the locally owned cells, as the coordinates followed by the nstate values at each quadrature point
+    const unsigned int n_quad_pts_binary = dg->volume_quadrature_collection[dg->max_degree].size();
+    const unsigned int n_values_per_point_binary = dim + nstate;
+    std::vector<double> binary_values;
+    if (read_binary) {
+        pcout << "Reading flow field file " << binary_filename << std::endl;
+        std::vector<dealii::CellId> cell_ids;
+        for (auto current_cell = dg->dof_handler.begin_active(); current_cell!=dg->dof_handler.end(); ++current_cell) {
+            if (!current_cell->is_locally_owned()) continue;
+            if (dg->volume_quadrature_collection[current_cell->active_fe_index()].size() != n_quad_pts_binary) {
+                std::cout << "ERROR: Flow field files require the same polynomial degree on every cell.\n Aborting..." << std::endl;
+                std::abort();
+            }
+            cell_ids.push_back(current_cell->id());
+        }
+        const FlowFieldFile flow_field_file(binary_filename, dg->mpi_communicator);
+        binary_values = flow_field_file.read(dim, cell_ids, n_quad_pts_binary, n_values_per_point_binary);
     }
+    unsigned int i_cell_binary = 0;
 
     // Commented since this has not yet been tested
     // dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
@@ -195,6 +226,21 @@ void SetInitialCondition<dim,nstate,real>::read_values_from_file_and_project(
             for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
                 const dealii::Point<dim> qpoint = (fe_values.quadrature_point(iquad));
                 
+                if (read_binary) {
+                    const double *const point_values = &binary_values[(i_cell_binary*n_quad_pts_binary + iquad)*n_values_per_point_binary];
+                    dealii::Point<dim> current_point_read_from_file;
+                    for(int i=0; i<dim; ++i) {
+                        current_point_read_from_file[i] = point_values[i];
+                    }
+                    if(qpoint.distance(current_point_read_from_file) > 1.0e-14) {
+                        std::cout << "ERROR: Distance between points is " << qpoint.distance(current_point_read_from_file)
+                                  << ".\n Aborting..." << std::endl;
+                        std::abort();
+                    }
+                    exact_value[iquad] = point_values[dim+istate]; // store value for projection
+                    continue;
+                }
+
                 // -- get point
                 dealii::Point<dim> current_point_read_from_file;
                 std::string dummy_line = line;
@@ -232,6 +278,7 @@ void SetInitialCondition<dim,nstate,real>::read_values_from_file_and_project(
                 dg->solution[current_dofs_indices[ishape+istate*n_shape_fns]] = sol[ishape];
             }
         }
+        ++i_cell_binary;
     }
     if(!line.empty()) {
         pcout << "ERROR: Line is not empty:\n" << line << std::endl;
@@ -239,6 +286,60 @@ void SetInitialCondition<dim,nstate,real>::read_values_from_file_and_project(
     }
 }
 
+template<int dim, int nstate, typename real>
+void SetInitialCondition<dim,nstate,real>::write_values_to_file(
+        std::shared_ptr < PHiLiP::DGBase<dim,real> > &dg,
+        const std::string filename_prefix)
+{
+    const std::string filename = filename_prefix + std::string(".field");
+    const unsigned int n_quad_pts = dg->volume_quadrature_collection[dg->max_degree].size();
+    const unsigned int n_values_per_point = dim + nstate;
+
+    const auto mapping = (*(dg->high_order_grid->mapping_fe_field));
+    dealii::hp::MappingCollection<dim> mapping_collection(mapping);
+    dealii::hp::FEValues<dim,dim> fe_values_collection(mapping_collection, dg->fe_collection, dg->volume_quadrature_collection, 
+                                dealii::update_values | dealii::update_quadrature_points);
+    const unsigned int max_dofs_per_cell = dg->dof_handler.get_fe_collection().max_dofs_per_cell();
+    std::vector<dealii::types::global_dof_index> current_dofs_indices(max_dofs_per_cell);
+
+    std::vector<dealii::CellId> cell_ids;
+    std::vector<double> values;
+    for (auto current_cell = dg->dof_handler.begin_active(); current_cell!=dg->dof_handler.end(); ++current_cell) {
+        if (!current_cell->is_locally_owned()) continue;
+
+        const int i_fele = current_cell->active_fe_index();
+        const int i_quad = i_fele;
+        const int i_mapp = 0;
+        fe_values_collection.reinit (current_cell, i_quad, i_mapp, i_fele);
+        const dealii::FEValues<dim,dim> &fe_values = fe_values_collection.get_present_fe_values();
+        if (fe_values.n_quadrature_points != n_quad_pts) {
+            std::cout << "ERROR: Flow field files require the same polynomial degree on every cell.\n Aborting..." << std::endl;
+            std::abort();
+        }
+        const unsigned int n_dofs_cell = fe_values.dofs_per_cell;
+        current_dofs_indices.resize(n_dofs_cell);
+        current_cell->get_dof_indices (current_dofs_indices);
+
+        cell_ids.push_back(current_cell->id());
+        for(unsigned int iquad=0; iquad<n_quad_pts; iquad++){
+            const dealii::Point<dim> qpoint = (fe_values.quadrature_point(iquad));
+            for(int i=0; i<dim; ++i) {
+                values.push_back(qpoint[i]);
+            }
+            std::array<double,nstate> soln_at_q;
+            soln_at_q.fill(0.0);
+            for(unsigned int idof=0; idof<n_dofs_cell; idof++){
+                const unsigned int istate = fe_values.get_fe().system_to_component_index(idof).first;
+                soln_at_q[istate] += dg->solution[current_dofs_indices[idof]] * fe_values.shape_value_component(idof, iquad, istate);
+            }
+            values.insert(values.end(), soln_at_q.begin(), soln_at_q.end());
+        }
+    }
+
+    const FlowFieldFile flow_field_file(filename, dg->mpi_communicator);
+    flow_field_file.write(dim, cell_ids, n_quad_pts, n_values_per_point, values);
+}
+
 template class SetInitialCondition<PHILIP_DIM, 1, double>;
 template class SetInitialCondition<PHILIP_DIM, 2, double>;
 template class SetInitialCondition<PHILIP_DIM, 3, double>;
@@ -19,6 +19,13 @@ public:
         std::shared_ptr< InitialConditionFunction<dim,nstate,double> > initial_condition_function_input,
         std::shared_ptr< PHiLiP::DGBase<dim,real> > dg_input,
         const Parameters::AllParameters *const parameters_input);
+
+    /// Writes the solution at the volume quadrature nodes to the binary file filename_prefix.field
+    /** The file can be read back with read_values_from_file_and_project on any number of processes.
+     */
+    static void write_values_to_file(
+        std::shared_ptr < PHiLiP::DGBase<dim,real> > &dg,
+        const std::string filename_prefix);
 private:
     ///Interpolates the initial condition function onto the dg solution.
     static void interpolate_initial_condition(
@@ -40,6 +47,9 @@ private:
         std::shared_ptr < PHiLiP::DGBase<dim,real> > &dg); 
 
     /// Reads values from file and projects
+    /** Reads the binary file input_filename_prefix.field if it exists, otherwise the text files
+     *  input_filename_prefix-0000i.dat written for the same number of processes.
+     */
     static void read_values_from_file_and_project(
         std::shared_ptr < PHiLiP::DGBase<dim,real> > &dg,
         const std::string input_filename_prefix);
@@ -1,4 +1,5 @@
 #include "physics_post_processor.h"
+#include <algorithm>
 #include "physics/physics_factory.h"
 #include "physics/model_factory.h"
 
@@ -53,7 +54,32 @@ template <int dim, int nstate> PhysicsPostprocessor<dim,nstate>
 ::PhysicsPostprocessor (const Parameters::AllParameters *const parameters_input)
     : model(Physics::ModelFactory<dim,nstate,double>::create_Model(parameters_input)) 
     , physics(Physics::PhysicsFactory<dim,nstate,double>::create_Physics(parameters_input,model))
-{ }
+{
+    const std::vector<std::string> names = this->physics->post_get_names();
+    const std::vector<std::string> &output_variables = parameters_input->vtk_output_variables;
+    for (const std::string &variable : output_variables) {
+        if (variable != "residual" && std::find(names.begin(), names.end(), variable) == names.end()) {
+            std::cout << "Invalid vtk output variable " << variable << ". The physics outputs:";
+            for (const std::string &name : names) std::cout << " " << name;
+            std::cout << std::endl;
+            std::abort();
+        }
+    }
+    for (unsigned int i = 0; i < names.size(); ++i) {
+        if (output_variables.empty() || std::find(output_variables.begin(), output_variables.end(), names[i]) != output_variables.end()) {
+            output_quantity_indices.push_back(i);
+        }
+    }
+}
+
+template <int dim, int nstate> void PhysicsPostprocessor<dim,nstate>
+::select_output_quantities (const dealii::Vector<double> &all_quantities, dealii::Vector<double> &computed_quantities) const
+{
+    computed_quantities.reinit(output_quantity_indices.size());
+    for (unsigned int i = 0; i < output_quantity_indices.size(); ++i) {
+        computed_quantities(i) = all_quantities(output_quantity_indices[i]);
+    }
+}
 
 template <int dim, int nstate> void PhysicsPostprocessor<dim,nstate>
 ::evaluate_vector_field (const dealii::DataPostprocessorInputs::Vector<dim> &inputs, std::vector<dealii::Vector<double>> &computed_quantities) const
@@ -63,12 +89,14 @@ template <int dim, int nstate> void PhysicsPostprocessor<dim,nstate>
     Assert (inputs.solution_values[0].size() == nstate, dealii::ExcInternalError());
     for (unsigned int q=0; q<n_quadrature_points; ++q)
     {
-        computed_quantities[q] = this->physics->post_compute_derived_quantities_vector(
+        select_output_quantities(
+            this->physics->post_compute_derived_quantities_vector(
                 inputs.solution_values[q],
                 inputs.solution_gradients[q],
                 inputs.solution_hessians[q],
                 inputs.normals[q],
-                inputs.evaluation_points[q]);
+                inputs.evaluation_points[q]),
+            computed_quantities[q]);
     }
 }
 
@@ -79,12 +107,14 @@ template <int dim, int nstate> void PhysicsPostprocessor<dim,nstate>
     Assert (computed_quantities.size() == n_quadrature_points, dealii::ExcInternalError());
     for (unsigned int q=0; q<n_quadrature_points; ++q)
     {
-        computed_quantities[q] = this->physics->post_compute_derived_quantities_scalar(
+        select_output_quantities(
+            this->physics->post_compute_derived_quantities_scalar(
                 inputs.solution_values[q],
                 inputs.solution_gradients[q],
                 inputs.solution_hessians[q],
                 inputs.normals[q],
-                inputs.evaluation_points[q]);
+                inputs.evaluation_points[q]),
+            computed_quantities[q]);
     }
 }
 
@@ -92,13 +122,20 @@ template <int dim, int nstate> void PhysicsPostprocessor<dim,nstate>
 template <int dim, int nstate>
 std::vector<std::string> PhysicsPostprocessor<dim,nstate>::get_names () const
 {
-    return this->physics->post_get_names();
+    const std::vector<std::string> names = this->physics->post_get_names();
+    std::vector<std::string> output_names;
+    for (const unsigned int i : output_quantity_indices) output_names.push_back(names[i]);
+    return output_names;
 }
 template <int dim, int nstate>
 std::vector<dealii::DataComponentInterpretation::DataComponentInterpretation>
 PhysicsPostprocessor<dim,nstate>::get_data_component_interpretation () const
 {
-    return this->physics->post_get_data_component_interpretation();
+    const std::vector<dealii::DataComponentInterpretation::DataComponentInterpretation> interpretation
+        = this->physics->post_get_data_component_interpretation();
+    std::vector<dealii::DataComponentInterpretation::DataComponentInterpretation> output_interpretation;
+    for (const unsigned int i : output_quantity_indices) output_interpretation.push_back(interpretation[i]);
+    return output_interpretation;
 }
 template <int dim, int nstate>
 dealii::UpdateFlags PhysicsPostprocessor<dim,nstate>::get_needed_update_flags () const
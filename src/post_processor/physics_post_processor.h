@@ -44,6 +44,13 @@ public:
     virtual std::vector<dealii::DataComponentInterpretation::DataComponentInterpretation> get_data_component_interpretation () const override;
     /// Queries the Physics for the required update flags to evaluate output data.
     virtual dealii::UpdateFlags get_needed_update_flags () const override;
+
+protected:
+    /// Indices of the output data variables of the Physics selected by the vtk_output_variables parameter.
+    std::vector<unsigned int> output_quantity_indices;
+
+    /// Keeps the selected variables out of all the data variables computed by the Physics.
+    void select_output_quantities (const dealii::Vector<double> &all_quantities, dealii::Vector<double> &computed_quantities) const;
 };
 
 } // Postprocess namespace
@@ -0,0 +1,105 @@
+#include "nnls_solver.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+
+NNLSSolver::NNLSSolver(MatrixXd A, VectorXd b, const double tolerance, const int max_iterations)
+        : A(std::move(A))
+        , b(std::move(b))
+        , tolerance(tolerance)
+        , max_iterations(max_iterations)
+        , x(VectorXd::Zero(this->A.cols()))
+        , relative_residual(1.0)
+{}
+
+bool NNLSSolver::solve()
+{
+    const int n = A.cols();
+    x = VectorXd::Zero(n);
+
+    const double b_norm = b.norm();
+    if (b_norm == 0.0) {
+        relative_residual = 0.0;
+        return true;
+    }
+
+    std::vector<bool> is_passive(n, false);
+    std::vector<int> passive_set;
+    VectorXd residual = b;
+    relative_residual = 1.0;
+
+    for (int iteration = 0; iteration < max_iterations && relative_residual > tolerance; ++iteration) {
+        // Add the column most correlated with the residual to the passive set.
+        const VectorXd gradient = A.transpose() * residual;
+        int j_max = -1;
+        double gradient_max = 0.0;
+        for (int j = 0; j < n; ++j) {
+            if (!is_passive[j] && gradient(j) > gradient_max) {
+                gradient_max = gradient(j);
+                j_max = j;
+            }
+        }
+        if (j_max < 0) break;
+        is_passive[j_max] = true;
+        passive_set.push_back(j_max);
+
+        // Inner loop keeping the passive variables positive.
+        while (true) {
+            const VectorXd z = solvePassiveSet(passive_set);
+            double alpha = 1.0;
+            for (unsigned int i = 0; i < passive_set.size(); ++i) {
+                if (z(i) <= 0.0) {
+                    const double x_i = x(passive_set[i]);
+                    alpha = std::min(alpha, x_i / (x_i - z(i)));
+                }
+            }
+            for (unsigned int i = 0; i < passive_set.size(); ++i) {
+                x(passive_set[i]) += alpha * (z(i) - x(passive_set[i]));
+            }
+            if (alpha == 1.0) break;
+
+            // Move the variables that reached zero back to the active set.
+            std::vector<int> new_passive_set;
+            for (const int j : passive_set) {
+                if (x(j) <= std::numeric_limits<double>::epsilon()) {
+                    x(j) = 0.0;
+                    is_passive[j] = false;
+                } else {
+                    new_passive_set.push_back(j);
+                }
+            }
+            passive_set = new_passive_set;
+            if (passive_set.empty()) break;
+        }
+
+        residual = b - A * x;
+        relative_residual = residual.norm() / b_norm;
+    }
+    return (relative_residual <= tolerance);
+}
+
+VectorXd NNLSSolver::solvePassiveSet(const std::vector<int> &passive_set) const
+{
+    MatrixXd A_passive(A.rows(), passive_set.size());
+    for (unsigned int i = 0; i < passive_set.size(); ++i) {
+        A_passive.col(i) = A.col(passive_set[i]);
+    }
+    return A_passive.colPivHouseholderQr().solve(b);
+}
+
+const VectorXd &NNLSSolver::getSolution() const
+{
+    return x;
+}
+
+double NNLSSolver::getRelativeResidual() const
+{
+    return relative_residual;
+}
+
+}
+}
@@ -0,0 +1,50 @@
+#ifndef __NNLS_SOLVER__
+#define __NNLS_SOLVER__
+
+#include <eigen/Eigen/Dense>
+#include <vector>
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+/// Non-negative least-squares solver, used to compute the ECSW weights of the hyper-reduced ROM.
+/** Lawson-Hanson active set algorithm, minimizing ||A*x - b|| subject to x >= 0.
+ *  The iterations stop as soon as ||A*x - b|| <= tolerance*||b||, such that the solution
+ *  only has a few non-zero entries when the tolerance is loose.
+ *
+ *  Reference: Lawson, C. L., & Hanson, R. J. (1995). Solving least squares problems. SIAM, Chapter 23.
+ */
+class NNLSSolver
+{
+public:
+    /// Constructor. The problem is stored by value, such that temporaries can be moved in.
+    NNLSSolver(MatrixXd A, VectorXd b, const double tolerance, const int max_iterations);
+
+    /// Solves the problem. Returns true if the tolerance was reached.
+    bool solve();
+
+    /// Solution of the last solve.
+    const VectorXd &getSolution() const;
+
+    /// Relative residual ||A*x - b|| / ||b|| of the last solve.
+    double getRelativeResidual() const;
+
+private:
+    /// Unconstrained least-squares solution restricted to the columns of the passive set.
+    VectorXd solvePassiveSet(const std::vector<int> &passive_set) const;
+
+    const MatrixXd A; ///< Matrix of the least-squares problem.
+    const VectorXd b; ///< Right-hand side of the least-squares problem.
+    const double tolerance; ///< Relative residual tolerance.
+    const int max_iterations; ///< Maximum number of outer iterations.
+
+    VectorXd x; ///< Solution.
+    double relative_residual; ///< Relative residual of the solution.
+};
+
+}
+}
+
+#endif
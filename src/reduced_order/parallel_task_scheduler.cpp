@@ -0,0 +1,99 @@
+#include "parallel_task_scheduler.h"
+
+#include <deal.II/base/mpi.h>
+
+#include <iostream>
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+
+ParallelTaskScheduler::ParallelTaskScheduler(const MPI_Comm mpi_communicator_input, const unsigned int n_groups_input)
+        : mpi_communicator(mpi_communicator_input)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
+        , n_mpi(dealii::Utilities::MPI::n_mpi_processes(mpi_communicator))
+        , n_groups(n_groups_input)
+        , pcout(std::cout, mpi_rank==0)
+{
+    if (n_groups == 0 || n_mpi % n_groups != 0) {
+        pcout << "Error: the " << n_mpi << " processes can not be split into " << n_groups << " groups of equal size." << std::endl;
+        std::abort();
+    }
+    const unsigned int processes_per_group = n_mpi / n_groups;
+    group_id = mpi_rank / processes_per_group;
+    group_rank = mpi_rank % processes_per_group;
+
+    MPI_Comm_split(mpi_communicator, group_id, group_rank, &group_communicator);
+    MPI_Comm_split(mpi_communicator, group_rank, group_id, &peer_communicator);
+
+    pcout << "Splitting " << n_mpi << " processes into " << n_groups << " groups of " << processes_per_group << " processes." << std::endl;
+}
+
+ParallelTaskScheduler::~ParallelTaskScheduler()
+{
+    MPI_Comm_free(&group_communicator);
+    MPI_Comm_free(&peer_communicator);
+}
+
+std::vector<unsigned int> ParallelTaskScheduler::run(const unsigned int n_tasks, const std::function<void(const unsigned int)> &task) const
+{
+    if (n_groups == 1) {
+        for (unsigned int itask = 0; itask < n_tasks; ++itask) {
+            task(itask);
+        }
+        return std::vector<unsigned int>(n_tasks, 0);
+    }
+
+    // Counter of the next unclaimed task, held by the first process and incremented atomically by the group leaders.
+    int next_task = 0;
+    MPI_Win counter_window;
+    MPI_Win_create(&next_task, (mpi_rank == 0) ? sizeof(int) : 0, sizeof(int), MPI_INFO_NULL, mpi_communicator, &counter_window);
+
+    std::vector<int> task_groups(n_tasks, -1);
+    const int increment = 1;
+    while (true) {
+        int claimed_task = 0;
+        if (group_rank == 0) {
+            MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, counter_window);
+            MPI_Fetch_and_op(&increment, &claimed_task, MPI_INT, 0, 0, MPI_SUM, counter_window);
+            MPI_Win_unlock(0, counter_window);
+        }
+        MPI_Bcast(&claimed_task, 1, MPI_INT, 0, group_communicator);
+        if (claimed_task >= static_cast<int>(n_tasks)) break;
+
+        task(claimed_task);
+        task_groups[claimed_task] = group_id;
+    }
+    MPI_Win_free(&counter_window);
+
+    MPI_Allreduce(MPI_IN_PLACE, task_groups.data(), n_tasks, MPI_INT, MPI_MAX, mpi_communicator);
+    return std::vector<unsigned int>(task_groups.begin(), task_groups.end());
+}
+
+void ParallelTaskScheduler::broadcast_from_group(dealii::LinearAlgebra::distributed::Vector<double> &vector, const unsigned int source_group) const
+{
+    if (n_groups == 1) return;
+
+    const unsigned int n_local_values = vector.locally_owned_elements().n_elements();
+    unsigned int n_source_values = n_local_values;
+    MPI_Bcast(&n_source_values, 1, MPI_UNSIGNED, source_group, peer_communicator);
+    if (n_source_values != n_local_values) {
+        std::cout << "Error: process " << mpi_rank << " owns " << n_local_values << " values, while its peer on group "
+                  << source_group << " owns " << n_source_values << ". The groups must have the same parallel layout." << std::endl;
+        std::abort();
+    }
+    MPI_Bcast(vector.begin(), n_local_values, MPI_DOUBLE, source_group, peer_communicator);
+    vector.update_ghost_values();
+}
+
+void ParallelTaskScheduler::share_task_values(std::vector<double> &values, const std::vector<unsigned int> &task_groups) const
+{
+    if (n_groups == 1) return;
+
+    for (unsigned int itask = 0; itask < values.size(); ++itask) {
+        if (task_groups[itask] != group_id) values[itask] = 0.0;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE, MPI_SUM, peer_communicator);
+}
+
+}
+}
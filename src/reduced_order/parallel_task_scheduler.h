@@ -0,0 +1,68 @@
+#ifndef __PARALLEL_TASK_SCHEDULER__
+#define __PARALLEL_TASK_SCHEDULER__
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <functional>
+#include <mpi.h>
+#include <vector>
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+
+/// Distributes independent tasks, such as snapshot and ROM solves, over groups of processes.
+/** The processes are split into n_groups groups of consecutive ranks, which each solve their tasks on group_communicator.
+ *  The groups claim the tasks one at a time from a counter held by the first process, such that the load is balanced
+ *  when the cost of the tasks varies.
+ *
+ *  Process i of every group is connected to process i of the other groups through peer_communicator, used to share the results.
+ *  Groups of equal size building the same mesh own the same degrees of freedom, such that a distributed vector is
+ *  shared by exchanging its locally owned values between peers.
+ */
+class ParallelTaskScheduler
+{
+public:
+    /// Constructor. The number of groups must divide the number of processes of mpi_communicator_input.
+    ParallelTaskScheduler(const MPI_Comm mpi_communicator_input, const unsigned int n_groups_input);
+
+    /// Destructor. Frees the group and peer communicators.
+    ~ParallelTaskScheduler();
+
+    ParallelTaskScheduler(const ParallelTaskScheduler &) = delete; ///< Owns communicators, not copyable.
+    ParallelTaskScheduler &operator=(const ParallelTaskScheduler &) = delete; ///< Owns communicators, not copyable.
+
+    /// Executes task(i) for i in [0, n_tasks) on the groups, and returns the group which executed each task.
+    /** All the processes of a group call the task together. Must be called by all the processes.
+     */
+    std::vector<unsigned int> run(const unsigned int n_tasks, const std::function<void(const unsigned int)> &task) const;
+
+    /// Overwrites vector with the locally owned values of the same vector on source_group, and updates its ghost values.
+    /** The vector must have the same parallel layout on every group.
+     */
+    void broadcast_from_group(dealii::LinearAlgebra::distributed::Vector<double> &vector, const unsigned int source_group) const;
+
+    /// Sets values[i] to its value on task_groups[i], the group which computed it.
+    void share_task_values(std::vector<double> &values, const std::vector<unsigned int> &task_groups) const;
+
+    const MPI_Comm mpi_communicator; ///< Communicator split into the groups.
+    const int mpi_rank; ///< MPI rank.
+    const int n_mpi; ///< Number of MPI processes.
+    const unsigned int n_groups; ///< Number of groups.
+    unsigned int group_id; ///< Group of this process.
+    unsigned int group_rank; ///< Rank of this process within its group.
+
+    MPI_Comm group_communicator; ///< Processes of this group.
+    MPI_Comm peer_communicator; ///< Processes with the same rank in every group, ranked by group.
+
+protected:
+    /// ConditionalOStream.
+    /** Used as std::cout, but only prints if mpi_rank == 0
+     */
+    dealii::ConditionalOStream pcout;
+};
+
+}
+}
+
+#endif
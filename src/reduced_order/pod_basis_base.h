@@ -5,6 +5,10 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 
+#include <Epetra_MultiVector.h>
+
+#include <eigen/Eigen/Dense>
+
 namespace PHiLiP {
 namespace ProperOrthogonalDecomposition {
 
@@ -19,8 +23,16 @@ public:
     /// Function to return basis
     virtual std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> getPODBasis() = 0;
 
+    /// Function to return basis as a dense multivector, distributed by rows as the system matrix
+    /** Preferred for projections, since products with the basis are then dense GEMMs instead of sparse matrix-matrix products.
+     */
+    virtual std::shared_ptr<Epetra_MultiVector> getPODBasisDense() = 0;
+
     /// Function to return reference state
     virtual dealii::LinearAlgebra::ReadWriteVector<double> getReferenceState() = 0;
+
+    /// Function to return the snapshots the basis was computed from, one full-order solution per vector, distributed by rows as the basis
+    virtual std::shared_ptr<Epetra_MultiVector> getSnapshots() = 0;
 };
 
 }
@@ -2,18 +2,28 @@
 
 #include <EpetraExt_MatrixMatrix.h>
 #include <Epetra_CrsMatrix.h>
+#include <Epetra_Import.h>
 #include <Epetra_Map.h>
+#include <Epetra_MultiVector.h>
+#include <Epetra_Vector.h>
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/fe/mapping_q1_eulerian.h>
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 
 #include <eigen/Eigen/SVD>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 #include "dg/dg_base.hpp"
 #include "pod_basis_base.h"
+#include "reduced_basis_operations.h"
+#include "snapshot_file.h"
 
 namespace PHiLiP {
 namespace ProperOrthogonalDecomposition {
@@ -22,8 +32,8 @@ template <int dim>
 OfflinePOD<dim>::OfflinePOD(std::shared_ptr<DGBase<dim,double>> &dg_input)
         : basis(std::make_shared<dealii::TrilinosWrappers::SparseMatrix>())
         , dg(dg_input)
-        , mpi_communicator(MPI_COMM_WORLD)
-        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD))
+        , mpi_communicator(dg_input->mpi_communicator)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
         , pcout(std::cout, mpi_rank==0)
 {
     const bool compute_dRdW = true;
@@ -37,121 +47,240 @@ OfflinePOD<dim>::OfflinePOD(std::shared_ptr<DGBase<dim,double>> &dg_input)
 template <int dim>
 bool OfflinePOD<dim>::getPODBasisFromSnapshots() {
     bool file_found = false;
-    MatrixXd snapshotMatrix(0,0);
-    std::string path = dg->all_parameters->reduced_order_param.path_to_search; //Search specified directory for files containing "solutions_table"
+    std::string path = dg->all_parameters->reduced_order_param.path_to_search; //Search specified directory for files containing "solution_snapshot"
 
     std::vector<std::filesystem::path> files_in_directory;
     std::copy(std::filesystem::directory_iterator(path), std::filesystem::directory_iterator(), std::back_inserter(files_in_directory));
     std::sort(files_in_directory.begin(), files_in_directory.end()); //Sort files so that the order is the same as for the sensitivity basis
 
+    // Binary files are only opened here to count their snapshots, which are read once the distributed snapshots are allocated.
+    const SnapshotFileHeader expected_header = snapshot_file_header(*dg);
+    std::vector<std::pair<std::string, int>> binary_files;
+    std::vector<std::pair<MatrixXd, int>> text_files;
+    int n_snapshots = 0;
+
     for (const auto & entry : files_in_directory){
         if(std::string(entry.filename()).std::string::find("solution_snapshot") != std::string::npos){
             pcout << "Processing " << entry << std::endl;
             file_found = true;
-            std::ifstream myfile(entry);
-            if(!myfile)
-            {
-                pcout << "Error opening file." << std::endl;
-                std::abort();
-            }
-            std::string line;
-            int rows = 0;
-            int cols = 0;
-            //First loop set to count rows and columns
-            while(std::getline(myfile, line)){ //for each line
-                std::istringstream stream(line);
-                std::string field;
-                cols = 0;
-                while (getline(stream, field,' ')){ //parse data values on each line
-                    if (field.empty()){ //due to whitespace
-                        continue;
-                    } else {
-                        cols++;
-                    }
+            if (SnapshotFile::is_snapshot_file(entry)) {
+                const SnapshotFile snapshot_file(entry, mpi_communicator);
+                const SnapshotFileHeader header = snapshot_file.read_header();
+                if (!snapshot_file.is_compatible(header, expected_header)) {
+                    pcout << "Error: the snapshots of " << entry << " do not belong to the current discretization." << std::endl;
+                    std::abort();
+                }
+                binary_files.emplace_back(entry, n_snapshots);
+                n_snapshots += header.n_snapshots;
+            } else {
+                text_files.emplace_back(readTextSnapshots(entry), n_snapshots);
+                if (text_files.back().first.rows() != static_cast<int>(expected_header.n_dofs)) {
+                    pcout << "Error: " << entry << " has " << text_files.back().first.rows() << " rows instead of " << expected_header.n_dofs << "." << std::endl;
+                    std::abort();
                 }
-                rows++;
+                n_snapshots += text_files.back().first.cols();
             }
+        }
+    }
 
-            snapshotMatrix.conservativeResize(rows, snapshotMatrix.cols()+cols);
-
-            int row = 0;
-            myfile.clear();
-            myfile.seekg(0); //Bring back to beginning of file
-            //Second loop set to build solutions matrix
-            while(std::getline(myfile, line)){ //for each line
-                std::istringstream stream(line);
-                std::string field;
-                int col = 0;
-                while (getline(stream, field,' ')) { //parse data values on each line
-                    if (field.empty()) {
-                        continue;
-                    } else {
-                        snapshotMatrix(row, snapshotMatrix.cols()-cols+col) = std::stod(field); //This will work for however many solutions in each file
-                        col++;
-                    }
-                }
-                row++;
+    if (n_snapshots == 0) {
+        pcout << "No snapshots found in " << path << std::endl;
+        return file_found;
+    }
+
+    const Epetra_Map &system_matrix_map = dg->system_matrix.trilinos_matrix().RowMap();
+    snapshots = std::make_shared<Epetra_MultiVector>(system_matrix_map, n_snapshots);
+    if (!binary_files.empty()) {
+        // The rows of the snapshot matrix are the locally owned degrees of freedom.
+        const SnapshotFileOrdering ordering(*dg);
+        for (const auto &binary_file : binary_files) {
+            SnapshotFile(binary_file.first, mpi_communicator).read(*snapshots, binary_file.second, ordering);
+        }
+    }
+    for (const auto &text_file : text_files) {
+        for (int localRow = 0; localRow < system_matrix_map.NumMyElements(); ++localRow){
+            const int globalRow = system_matrix_map.GID(localRow);
+            for(int n = 0 ; n < text_file.first.cols() ; n++){
+                (*snapshots)[text_file.second + n][localRow] = text_file.first(globalRow, n);
             }
-            myfile.close();
         }
     }
 
     pcout << "Snapshot matrix generated." << std::endl;
 
+    computeBasis();
+
+    const unsigned int precision = 16;
+    printBasis("POD_basis.txt", precision);
+
+    return file_found;
+}
+
+template <int dim>
+MatrixXd OfflinePOD<dim>::readTextSnapshots(const std::string &filename) {
+    MatrixXd text_snapshots;
+    std::ifstream myfile(filename);
+    if(!myfile)
+    {
+        std::cout << "Error opening file " << filename << std::endl;
+        std::abort();
+    }
+    std::string line;
+    int rows = 0;
+    int cols = 0;
+    //First loop set to count rows and columns
+    while(std::getline(myfile, line)){ //for each line
+        std::istringstream stream(line);
+        std::string field;
+        cols = 0;
+        while (getline(stream, field,' ')){ //parse data values on each line
+            if (field.empty()){ //due to whitespace
+                continue;
+            } else {
+                cols++;
+            }
+        }
+        rows++;
+    }
+
+    text_snapshots.resize(rows, cols);
+
+    int row = 0;
+    myfile.clear();
+    myfile.seekg(0); //Bring back to beginning of file
+    //Second loop set to build solutions matrix
+    while(std::getline(myfile, line)){ //for each line
+        std::istringstream stream(line);
+        std::string field;
+        int col = 0;
+        while (getline(stream, field,' ')) { //parse data values on each line
+            if (field.empty()) {
+                continue;
+            } else {
+                text_snapshots(row, col) = std::stod(field); //This will work for however many solutions in each file
+                col++;
+            }
+        }
+        row++;
+    }
+    myfile.close();
+    return text_snapshots;
+}
 
+template <int dim>
+void OfflinePOD<dim>::computeBasis() {
     /* Reference for simple POD basis computation: Refer to Algorithm 1 in the following reference:
     "Efficient non-linear model reduction via a least-squares Petrov–Galerkin projection and compressive tensor approximations"
     Kevin Carlberg, Charbel Bou-Mosleh, Charbel Farhat
     International Journal for Numerical Methods in Engineering, 2011
     */
-
     pcout << "Computing POD basis..." << std::endl;
 
-    VectorXd reference_state = snapshotMatrix.rowwise().mean();
+    const Epetra_Map &system_matrix_map = dg->system_matrix.trilinos_matrix().RowMap();
+    const int n_snapshots = snapshots->NumVectors();
 
-    referenceState.reinit(reference_state.size());
-    for(unsigned int i = 0 ; i < reference_state.size() ; i++){
-        referenceState(i) = reference_state(i);
+    Epetra_Vector snapshot_mean(system_matrix_map);
+    for (int j = 0; j < n_snapshots; ++j) {
+        snapshot_mean.Update(1.0/n_snapshots, *(*snapshots)(j), 1.0);
     }
+    referenceState.reinit(dg->system_matrix.locally_owned_range_indices());
+    for (int i = 0; i < snapshot_mean.MyLength(); ++i) {
+        referenceState.local_element(i) = snapshot_mean[i];
+    }
+
+    // The centered snapshots are factored as Q*R with two passes of classical Gram-Schmidt, skipping the snapshots already in the span of Q.
+    // The left singular vectors of the centered snapshots are then Q times the left singular vectors of the small factor R.
+    Epetra_MultiVector orthonormal(system_matrix_map, n_snapshots);
+    MatrixXd triangular = MatrixXd::Zero(n_snapshots, n_snapshots);
+    const double new_direction_tolerance = 1e-12;
+    int n_modes = 0;
+    for (int j = 0; j < n_snapshots; ++j) {
+        Epetra_Vector residual(*(*snapshots)(j));
+        residual.Update(-1.0, snapshot_mean, 1.0);
+        double column_norm;
+        residual.Norm2(&column_norm);
+
+        if (n_modes > 0) {
+            const Epetra_MultiVector current_basis(Epetra_DataAccess::View, orthonormal, 0, n_modes);
+            Epetra_Vector coefficients(reduced_space_map(current_basis));
+            for (int pass = 0; pass < 2; ++pass) {
+                coefficients.Multiply('T', 'N', 1.0, current_basis, residual, 0.0);
+                residual.Multiply('N', 'N', -1.0, current_basis, coefficients, 1.0);
+                for (int i = 0; i < n_modes; ++i) {
+                    triangular(i, j) += coefficients[i];
+                }
+            }
+        }
 
-    MatrixXd snapshotMatrixCentered = snapshotMatrix.colwise() - reference_state;
+        double residual_norm;
+        residual.Norm2(&residual_norm);
+        if (residual_norm > new_direction_tolerance * column_norm) {
+            triangular(n_modes, j) = residual_norm;
+            residual.Scale(1.0/residual_norm);
+            (*orthonormal(n_modes)) = residual;
+            n_modes++;
+        }
+    }
 
-    Eigen::BDCSVD<MatrixXd, Eigen::DecompositionOptions::ComputeThinU> svd(snapshotMatrixCentered);
-    MatrixXd pod_basis = svd.matrixU();
+    if (n_modes == 0) {
+        pcout << "Error: at least two distinct snapshots are needed to compute a POD basis." << std::endl;
+        std::abort();
+    }
 
-    fullBasis.reinit(pod_basis.rows(), pod_basis.cols());
+    Eigen::BDCSVD<MatrixXd, Eigen::DecompositionOptions::ComputeThinU> svd(triangular.topRows(n_modes));
+    singularValues = svd.singularValues();
+    const MatrixXd &triangular_basis = svd.matrixU();
 
-    for (unsigned int m = 0; m < pod_basis.rows(); m++) {
-        for (unsigned int n = 0; n < pod_basis.cols(); n++) {
-            fullBasis.set(m, n, pod_basis(m, n));
+    const Epetra_MultiVector orthonormal_basis(Epetra_DataAccess::View, orthonormal, 0, n_modes);
+    Epetra_MultiVector rotation(reduced_space_map(orthonormal_basis), n_modes);
+    for (int j = 0; j < n_modes; ++j) {
+        for (int i = 0; i < n_modes; ++i) {
+            rotation[j][i] = triangular_basis(i, j);
         }
     }
+    dense_basis = std::make_shared<Epetra_MultiVector>(system_matrix_map, n_modes);
+    dense_basis->Multiply('N', 'N', 1.0, orthonormal_basis, rotation, 0.0);
 
-    std::ofstream out_file("POD_basis.txt");
-    unsigned int precision = 16;
-    fullBasis.print_formatted(out_file, precision);
-
-    const Epetra_CrsMatrix epetra_system_matrix  = this->dg->system_matrix.trilinos_matrix();
-    Epetra_Map system_matrix_map = epetra_system_matrix.RowMap();
-    Epetra_CrsMatrix epetra_basis(Epetra_DataAccess::Copy, system_matrix_map, pod_basis.cols());
+    Epetra_CrsMatrix epetra_basis(Epetra_DataAccess::Copy, system_matrix_map, n_modes);
 
     const int numMyElements = system_matrix_map.NumMyElements(); //Number of elements on the calling processor
 
     for (int localRow = 0; localRow < numMyElements; ++localRow){
         const int globalRow = system_matrix_map.GID(localRow);
-        for(int n = 0 ; n < pod_basis.cols() ; n++){
-            epetra_basis.InsertGlobalValues(globalRow, 1, &pod_basis(globalRow, n), &n);
+        for(int n = 0 ; n < n_modes ; n++){
+            epetra_basis.InsertGlobalValues(globalRow, 1, &(*dense_basis)[n][localRow], &n);
         }
     }
 
-    Epetra_MpiComm epetra_comm(MPI_COMM_WORLD);
-    Epetra_Map domain_map((int)pod_basis.cols(), 0, epetra_comm);
+    Epetra_MpiComm epetra_comm(mpi_communicator);
+    Epetra_Map domain_map(n_modes, 0, epetra_comm);
 
     epetra_basis.FillComplete(domain_map, system_matrix_map);
 
     basis->reinit(epetra_basis);
 
-    return file_found;
+    pcout << "Done computing POD basis. Basis now has " << basis->n() << " columns." << std::endl;
+}
+
+template <int dim>
+void OfflinePOD<dim>::printBasis(const std::string &filename, const unsigned int precision) const {
+    // Gather the basis on the first process for output only.
+    const Epetra_BlockMap &row_map = dense_basis->Map();
+    const int n_rows = row_map.NumGlobalElements();
+    const Epetra_Map root_map(n_rows, (mpi_rank == 0) ? n_rows : 0, 0, row_map.Comm());
+    const Epetra_Import importer(root_map, row_map);
+    Epetra_MultiVector root_basis(root_map, dense_basis->NumVectors());
+    root_basis.Import(*dense_basis, importer, Insert);
+    if (mpi_rank != 0) return;
+
+    dealii::LAPACKFullMatrix<double> full_basis(n_rows, dense_basis->NumVectors());
+    for (int m = 0; m < n_rows; m++) {
+        for (int n = 0; n < dense_basis->NumVectors(); n++) {
+            full_basis.set(m, n, root_basis[n][m]);
+        }
+    }
+    std::ofstream out_file(filename);
+    full_basis.print_formatted(out_file, precision);
 }
 
 template <int dim>
@@ -159,11 +288,21 @@ std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> OfflinePOD<dim>::getPODB
     return basis;
 }
 
+template <int dim>
+std::shared_ptr<Epetra_MultiVector> OfflinePOD<dim>::getPODBasisDense() {
+    return dense_basis;
+}
+
 template <int dim>
 dealii::LinearAlgebra::ReadWriteVector<double> OfflinePOD<dim>::getReferenceState() {
     return referenceState;
 }
 
+template <int dim>
+std::shared_ptr<Epetra_MultiVector> OfflinePOD<dim>::getSnapshots() {
+    return snapshots;
+}
+
 template class OfflinePOD <PHILIP_DIM>;
 
 }
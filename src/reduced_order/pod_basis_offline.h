@@ -8,6 +8,7 @@
 #include <deal.II/numerics/vector_tools.h>
 
 #include <eigen/Eigen/Dense>
+#include <string>
 
 #include "dg/dg_base.hpp"
 #include "parameters/all_parameters.h"
@@ -19,6 +20,9 @@ using Eigen::MatrixXd;
 using Eigen::VectorXd;
 
 /// Class for Offline Proper Orthogonal Decomposition basis. This class reads some previously computed snapshots stored as files and computes a POD basis.
+/** Binary snapshot files are read in parallel directly into the distributed snapshots, while text files written by older
+ *  versions are still parsed. The basis is computed from the distributed snapshots, which are never gathered.
+ */
 template <int dim>
 class OfflinePOD: public PODBase<dim>
 {
@@ -29,24 +33,45 @@ public:
     ///Function to get POD basis for all derived classes
     std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> getPODBasis() override;
 
+    ///Function to get POD basis as a dense distributed multivector
+    std::shared_ptr<Epetra_MultiVector> getPODBasisDense() override;
+
     ///Function to get POD reference state
     dealii::LinearAlgebra::ReadWriteVector<double> getReferenceState() override;
 
+    ///Function to get the snapshots
+    std::shared_ptr<Epetra_MultiVector> getSnapshots() override;
+
     /// Read snapshots to build POD basis
     bool getPODBasisFromSnapshots();
 
+    /// Compute the POD basis from the thin singular value decomposition of the centered snapshots
+    void computeBasis();
+
+    /// Read the snapshots stored column by column in a text file, one row per line
+    static MatrixXd readTextSnapshots(const std::string &filename);
+
+    /// Print the POD basis to a text file, gathering it on the first process
+    void printBasis(const std::string &filename, const unsigned int precision) const;
+
     /// POD basis
     std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> basis;
 
+    /// POD basis stored densely, one mode per vector
+    std::shared_ptr<Epetra_MultiVector> dense_basis;
+
     /// Reference state
     dealii::LinearAlgebra::ReadWriteVector<double> referenceState;
 
+    /// Singular values of the centered snapshots, one per mode
+    VectorXd singularValues;
+
+    /// Snapshots distributed by rows as the system matrix
+    std::shared_ptr<Epetra_MultiVector> snapshots;
+
     /// dg needed for sparsity pattern of system matrix
     std::shared_ptr<DGBase<dim,double>> dg;
 
-    /// LAPACKFullMatrix for nice printing
-    dealii::LAPACKFullMatrix<double> fullBasis;
-
     const MPI_Comm mpi_communicator; ///< MPI communicator.
     const int mpi_rank; ///< MPI rank.
 
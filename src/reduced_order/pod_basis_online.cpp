@@ -8,8 +8,13 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <Teuchos_DefaultMpiComm.hpp>
 #include <Epetra_CrsMatrix.h>
+#include <Epetra_Import.h>
 #include <Epetra_Map.h>
+#include <Epetra_MultiVector.h>
 #include <eigen/Eigen/SVD>
+#include <cmath>
+#include <fstream>
+#include "reduced_basis_operations.h"
 
 namespace PHiLiP {
 namespace ProperOrthogonalDecomposition {
@@ -18,8 +23,9 @@ template<int dim>
 OnlinePOD<dim>::OnlinePOD(std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> _system_matrix)
         : basis(std::make_shared<dealii::TrilinosWrappers::SparseMatrix>())
         , system_matrix(_system_matrix)
-        , mpi_communicator(MPI_COMM_WORLD)
-        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD))
+        , snapshotMean(_system_matrix->trilinos_matrix().RowMap())
+        , mpi_communicator(_system_matrix->get_mpi_communicator())
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
         , pcout(std::cout, mpi_rank==0)
 {
 }
@@ -27,55 +33,134 @@ OnlinePOD<dim>::OnlinePOD(std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix
 template <int dim>
 void OnlinePOD<dim>::addSnapshot(dealii::LinearAlgebra::distributed::Vector<double> snapshot) {
     pcout << "Adding new snapshot to snapshot matrix..." << std::endl;
-    dealii::LinearAlgebra::ReadWriteVector<double> read_snapshot(snapshot.size());
-    read_snapshot.import(snapshot, dealii::VectorOperation::values::insert);
-    VectorXd eigen_snapshot(snapshot.size());
-    for(unsigned int i = 0 ; i < snapshot.size() ; i++){
-        eigen_snapshot(i) = read_snapshot(i);
+    const Epetra_Vector epetra_snapshot(Epetra_DataAccess::Copy, snapshotMean.Map(), snapshot.begin());
+    appendVectors(snapshots, epetra_snapshot);
+    const int n_snapshots = snapshots->NumVectors();
+
+    /* Adding a snapshot x to n snapshots of mean m appends the column sqrt(n/(n+1))*(x - m) to the centered snapshots,
+    up to an orthogonal transformation of the columns which leaves the singular values and left singular vectors unchanged.
+    Refer to Proposition 1 in the following reference:
+    "Incremental Learning for Robust Visual Tracking"
+    David A. Ross, Jongwoo Lim, Ruei-Sung Lin, Ming-Hsuan Yang
+    International Journal of Computer Vision, 2008
+    */
+    Epetra_Vector new_column(epetra_snapshot);
+    new_column.Update(-1.0, snapshotMean, 1.0);
+    snapshotMean.Update(1.0/n_snapshots, new_column, 1.0);
+    if (n_snapshots > 1) {
+        new_column.Scale(std::sqrt((n_snapshots - 1.0) / n_snapshots));
+        updateSVD(new_column);
     }
-    snapshotMatrix.conservativeResize(snapshot.size(), snapshotMatrix.cols()+1);
-    snapshotMatrix.col(snapshotMatrix.cols()-1) = eigen_snapshot;
-
-    //Copy snapshot matrix to dealii Lapack matrix for easy printing to file
-    dealiiSnapshotMatrix.reinit(snapshotMatrix.rows(), snapshotMatrix.cols());
-    for (unsigned int m = 0; m < snapshotMatrix.rows(); m++) {
-        for (unsigned int n = 0; n < snapshotMatrix.cols(); n++) {
-            dealiiSnapshotMatrix.set(m, n, snapshotMatrix(m, n));
+}
+
+template <int dim>
+void OnlinePOD<dim>::updateSVD(const Epetra_Vector &column) {
+    /* Reference for the rank-one update of the thin SVD: Refer to Section 2 in the following reference:
+    "Fast low-rank modifications of the thin singular value decomposition"
+    Matthew Brand
+    Linear Algebra and its Applications, 2006
+    */
+    const int n_modes = singularValues.size();
+
+    // Two passes of classical Gram-Schmidt keep the raw basis orthonormal to machine precision.
+    // Since the rotation is orthogonal, the projection onto the raw basis equals the projection onto the left singular vectors.
+    VectorXd raw_projection = VectorXd::Zero(n_modes);
+    Epetra_Vector residual(column);
+    if (n_modes > 0) {
+        Epetra_Vector raw_coefficients(reduced_space_map(*rawBasis));
+        for (int pass = 0; pass < 2; ++pass) {
+            raw_coefficients.Multiply('T', 'N', 1.0, *rawBasis, residual, 0.0);
+            residual.Multiply('N', 'N', -1.0, *rawBasis, raw_coefficients, 1.0);
+            for (int i = 0; i < n_modes; ++i) {
+                raw_projection(i) += raw_coefficients[i];
+            }
         }
     }
+
+    double column_norm;
+    column.Norm2(&column_norm);
+    double residual_norm;
+    residual.Norm2(&residual_norm);
+
+    // Snapshots lying in the current subspace only rotate and rescale the singular vectors.
+    const double new_direction_tolerance = 1e-12;
+    const bool new_direction = residual_norm > new_direction_tolerance * column_norm;
+    const int n_new_modes = new_direction ? n_modes + 1 : n_modes;
+    if (n_new_modes == 0) return;
+
+    MatrixXd core = MatrixXd::Zero(n_new_modes, n_modes + 1);
+    core.topLeftCorner(n_modes, n_modes) = singularValues.asDiagonal();
+    core.col(n_modes).head(n_modes) = basisRotation.transpose() * raw_projection;
+    if (new_direction) {
+        core(n_modes, n_modes) = residual_norm;
+    }
+
+    Eigen::JacobiSVD<MatrixXd> svd(core, Eigen::ComputeFullU);
+    singularValues = svd.singularValues();
+
+    if (new_direction) {
+        residual.Scale(1.0/residual_norm);
+        appendVectors(rawBasis, residual);
+        basisRotation.conservativeResize(n_new_modes, n_new_modes);
+        basisRotation.row(n_modes).setZero();
+        basisRotation.col(n_modes).setZero();
+        basisRotation(n_modes, n_modes) = 1.0;
+    }
+    basisRotation = basisRotation * svd.matrixU();
+}
+
+template <int dim>
+void OnlinePOD<dim>::appendVectors(std::shared_ptr<Epetra_MultiVector> &multivector, const Epetra_MultiVector &new_vectors) {
+    const int n_old_vectors = multivector ? multivector->NumVectors() : 0;
+    std::shared_ptr<Epetra_MultiVector> appended = std::make_shared<Epetra_MultiVector>(new_vectors.Map(), n_old_vectors + new_vectors.NumVectors(), false);
+    for (int j = 0; j < n_old_vectors; ++j) {
+        (*(*appended)(j)) = (*(*multivector)(j));
+    }
+    for (int j = 0; j < new_vectors.NumVectors(); ++j) {
+        (*(*appended)(n_old_vectors + j)) = (*new_vectors(j));
+    }
+    multivector = appended;
 }
 
 template <int dim>
 void OnlinePOD<dim>::computeBasis() {
     pcout << "Computing POD basis..." << std::endl;
 
-    VectorXd reference_state = snapshotMatrix.rowwise().mean();
-
-    referenceState.reinit(reference_state.size());
-    for(unsigned int i = 0 ; i < reference_state.size() ; i++){
-        referenceState(i) = reference_state(i);
+    const int n_modes = singularValues.size();
+    if (n_modes == 0) {
+        pcout << "Error: at least two distinct snapshots are needed to compute a POD basis." << std::endl;
+        std::abort();
     }
 
-    MatrixXd snapshotMatrixCentered = snapshotMatrix.colwise() - reference_state;
+    referenceState.reinit(system_matrix->locally_owned_range_indices());
+    for (int i = 0; i < snapshotMean.MyLength(); ++i) {
+        referenceState.local_element(i) = snapshotMean[i];
+    }
 
-    Eigen::BDCSVD<MatrixXd, Eigen::DecompositionOptions::ComputeThinU> svd(snapshotMatrixCentered);
-    MatrixXd pod_basis = svd.matrixU();
+    Epetra_MultiVector rotation(reduced_space_map(*rawBasis), n_modes);
+    for (int j = 0; j < n_modes; ++j) {
+        for (int i = 0; i < n_modes; ++i) {
+            rotation[j][i] = basisRotation(i, j);
+        }
+    }
+    dense_basis = std::make_shared<Epetra_MultiVector>(rawBasis->Map(), n_modes);
+    dense_basis->Multiply('N', 'N', 1.0, *rawBasis, rotation, 0.0);
 
     const Epetra_CrsMatrix epetra_system_matrix = system_matrix->trilinos_matrix();
     Epetra_Map system_matrix_map = epetra_system_matrix.RowMap();
-    Epetra_CrsMatrix epetra_basis(Epetra_DataAccess::Copy, system_matrix_map, pod_basis.cols());
+    Epetra_CrsMatrix epetra_basis(Epetra_DataAccess::Copy, system_matrix_map, n_modes);
 
     const int numMyElements = system_matrix_map.NumMyElements(); //Number of elements on the calling processor
 
     for (int localRow = 0; localRow < numMyElements; ++localRow){
         const int globalRow = system_matrix_map.GID(localRow);
-        for(int n = 0 ; n < pod_basis.cols() ; n++){
-            epetra_basis.InsertGlobalValues(globalRow, 1, &pod_basis(globalRow, n), &n);
+        for(int n = 0 ; n < n_modes ; n++){
+            epetra_basis.InsertGlobalValues(globalRow, 1, &(*dense_basis)[n][localRow], &n);
         }
     }
 
-    Epetra_MpiComm epetra_comm(MPI_COMM_WORLD);
-    Epetra_Map domain_map((int)pod_basis.cols(), 0, epetra_comm);
+    Epetra_MpiComm epetra_comm(mpi_communicator);
+    Epetra_Map domain_map(n_modes, 0, epetra_comm);
 
     epetra_basis.FillComplete(domain_map, system_matrix_map);
 
@@ -84,16 +169,49 @@ void OnlinePOD<dim>::computeBasis() {
     pcout << "Done computing POD basis. Basis now has " << basis->n() << " columns." << std::endl;
 }
 
+template <int dim>
+void OnlinePOD<dim>::printSnapshots(const std::string &filename, const unsigned int precision) const {
+    if (!snapshots) return;
+
+    // Gather the snapshots on the first process for output only.
+    const Epetra_BlockMap &row_map = snapshots->Map();
+    const int n_rows = row_map.NumGlobalElements();
+    const Epetra_Map root_map(n_rows, (mpi_rank == 0) ? n_rows : 0, 0, row_map.Comm());
+    const Epetra_Import importer(root_map, row_map);
+    Epetra_MultiVector root_snapshots(root_map, snapshots->NumVectors());
+    root_snapshots.Import(*snapshots, importer, Insert);
+    if (mpi_rank != 0) return;
+
+    dealii::LAPACKFullMatrix<double> full_snapshots(n_rows, snapshots->NumVectors());
+    for (int m = 0; m < n_rows; m++) {
+        for (int n = 0; n < snapshots->NumVectors(); n++) {
+            full_snapshots.set(m, n, root_snapshots[n][m]);
+        }
+    }
+    std::ofstream out_file(filename);
+    full_snapshots.print_formatted(out_file, precision);
+}
+
 template <int dim>
 std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> OnlinePOD<dim>::getPODBasis() {
     return basis;
 }
 
+template <int dim>
+std::shared_ptr<Epetra_MultiVector> OnlinePOD<dim>::getPODBasisDense() {
+    return dense_basis;
+}
+
 template <int dim>
 dealii::LinearAlgebra::ReadWriteVector<double> OnlinePOD<dim>::getReferenceState() {
     return referenceState;
 }
 
+template <int dim>
+std::shared_ptr<Epetra_MultiVector> OnlinePOD<dim>::getSnapshots() {
+    return snapshots;
+}
+
 template class OnlinePOD <PHILIP_DIM>;
 
 }
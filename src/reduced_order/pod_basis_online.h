@@ -8,7 +8,11 @@
 #include <deal.II/lac/vector_operation.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <Epetra_MultiVector.h>
+#include <Epetra_Vector.h>
+
 #include <eigen/Eigen/Dense>
+#include <string>
 
 #include "dg/dg_base.hpp"
 #include "parameters/all_parameters.h"
@@ -20,6 +24,10 @@ using Eigen::MatrixXd;
 using Eigen::VectorXd;
 
 /// Class for Online Proper Orthogonal Decomposition basis. This class takes snapshots on the fly and computes a POD basis for use in adaptive sampling.
+/** The snapshots are distributed by rows as the system matrix and are never gathered.
+ *  The thin singular value decomposition of the centered snapshots is updated every time a snapshot is added,
+ *  at a cost linear in the number of modes, instead of being recomputed from all the snapshots.
+ */
 template <int dim>
 class OnlinePOD: public PODBase<dim>
 {
@@ -30,29 +38,52 @@ public:
     ///Function to get POD basis for all derived classes
     std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> getPODBasis() override;
 
+    ///Function to get POD basis as a dense distributed multivector
+    std::shared_ptr<Epetra_MultiVector> getPODBasisDense() override;
+
     ///Function to get POD reference state
     dealii::LinearAlgebra::ReadWriteVector<double> getReferenceState() override;
 
-    /// Add snapshot
+    ///Function to get the snapshots
+    std::shared_ptr<Epetra_MultiVector> getSnapshots() override;
+
+    /// Add snapshot and update the singular value decomposition of the centered snapshots
     void addSnapshot(dealii::LinearAlgebra::distributed::Vector<double> snapshot);
 
-    /// Compute new POD basis from snapshots
+    /// Compute new POD basis from the current singular value decomposition
     void computeBasis();
 
+    /// Write the snapshots to a text file, one snapshot per column. Only the first process writes.
+    void printSnapshots(const std::string &filename, const unsigned int precision) const;
+
     /// POD basis
     std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> basis;
 
+    /// POD basis stored densely, one mode per vector
+    std::shared_ptr<Epetra_MultiVector> dense_basis;
+
     /// Reference state
     dealii::LinearAlgebra::ReadWriteVector<double> referenceState;
 
     /// For sparsity pattern of system matrix
     std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> system_matrix;
 
-    /// LAPACK matrix of snapshots for nice printing
-    dealii::LAPACKFullMatrix<double> dealiiSnapshotMatrix;
+    /// Snapshots distributed by rows as the system matrix
+    std::shared_ptr<Epetra_MultiVector> snapshots;
+
+    /// Mean of the snapshots
+    Epetra_Vector snapshotMean;
+
+    /// Orthonormal vectors spanning the left singular vectors of the centered snapshots
+    std::shared_ptr<Epetra_MultiVector> rawBasis;
+
+    /// Orthogonal rotation of the raw basis giving the left singular vectors, U = rawBasis*basisRotation
+    /** Keeping the rotation separate avoids rotating the distributed vectors every time a snapshot is added.
+     */
+    MatrixXd basisRotation;
 
-    /// Matrix containing snapshots
-    MatrixXd snapshotMatrix;
+    /// Singular values of the centered snapshots
+    VectorXd singularValues;
 
     const MPI_Comm mpi_communicator; ///< MPI communicator.
     const int mpi_rank; ///< MPI rank.
@@ -62,7 +93,12 @@ public:
      */
     dealii::ConditionalOStream pcout;
 
+private:
+    /// Brand's update of the singular value decomposition when a column is appended to the centered snapshots
+    void updateSVD(const Epetra_Vector &column);
 
+    /// Appends the vectors of a multivector to another one, which is reallocated
+    static void appendVectors(std::shared_ptr<Epetra_MultiVector> &multivector, const Epetra_MultiVector &new_vectors);
 };
 
 }
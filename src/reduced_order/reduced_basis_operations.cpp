@@ -0,0 +1,46 @@
+#include "reduced_basis_operations.h"
+
+#include <Epetra_SerialDenseSolver.h>
+#include <Epetra_SerialDenseVector.h>
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+
+Epetra_LocalMap reduced_space_map(const Epetra_MultiVector &basis)
+{
+    return Epetra_LocalMap(basis.NumVectors(), 0, basis.Comm());
+}
+
+Epetra_SerialDenseMatrix transpose_product(const Epetra_MultiVector &left, const Epetra_MultiVector &right)
+{
+    const int n_rows = left.NumVectors();
+    const int n_cols = right.NumVectors();
+
+    // Multiplying two distributed multivectors into a locally replicated one sums the local GEMMs over the processes.
+    Epetra_MultiVector replicated_product(reduced_space_map(left), n_cols);
+    replicated_product.Multiply('T', 'N', 1.0, left, right, 0.0);
+
+    Epetra_SerialDenseMatrix product(n_rows, n_cols);
+    for (int j = 0; j < n_cols; ++j) {
+        for (int i = 0; i < n_rows; ++i) {
+            product(i,j) = replicated_product[j][i];
+        }
+    }
+    return product;
+}
+
+int solve_reduced_system(const Epetra_SerialDenseMatrix &lhs, const Epetra_Vector &rhs, Epetra_Vector &solution)
+{
+    // The factorization overwrites the matrix.
+    Epetra_SerialDenseMatrix factored_lhs(lhs);
+    Epetra_SerialDenseVector dense_rhs(Epetra_DataAccess::View, rhs.Values(), rhs.MyLength());
+    Epetra_SerialDenseVector dense_solution(Epetra_DataAccess::View, solution.Values(), solution.MyLength());
+
+    Epetra_SerialDenseSolver solver;
+    solver.SetMatrix(factored_lhs);
+    solver.SetVectors(dense_solution, dense_rhs);
+    return solver.Solve();
+}
+
+}
+}
@@ -0,0 +1,30 @@
+#ifndef __REDUCED_BASIS_OPERATIONS__
+#define __REDUCED_BASIS_OPERATIONS__
+
+#include <Epetra_LocalMap.h>
+#include <Epetra_MultiVector.h>
+#include <Epetra_SerialDenseMatrix.h>
+#include <Epetra_Vector.h>
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+
+/// Locally replicated map of the reduced space spanned by the columns of a basis.
+/** Reduced vectors live on every process, such that the reduced operators can be formed and solved without redistribution.
+ */
+Epetra_LocalMap reduced_space_map(const Epetra_MultiVector &basis);
+
+/// Dense product left^T*right of two row-distributed bases, replicated on every process.
+/** Each process performs a GEMM on its own rows, followed by a single reduction over the processes.
+ */
+Epetra_SerialDenseMatrix transpose_product(const Epetra_MultiVector &left, const Epetra_MultiVector &right);
+
+/// Solves the dense reduced system lhs*solution = rhs with LAPACK, redundantly on every process.
+/** Returns the LAPACK error code, 0 on success.
+ */
+int solve_reduced_system(const Epetra_SerialDenseMatrix &lhs, const Epetra_Vector &rhs, Epetra_Vector &solution);
+
+}
+}
+
+#endif
@@ -6,12 +6,9 @@
 #include "parameters/all_parameters.h"
 #include "pod_basis_base.h"
 #include "reduced_order_solution.h"
+#include "reduced_basis_operations.h"
 #include "linear_solver/linear_solver.h"
 #include <Epetra_Vector.h>
-#include <EpetraExt_MatrixMatrix.h>
-#include <Epetra_LinearProblem.h>
-#include "Amesos.h"
-#include <Amesos_Lapack.h>
 #include "flow_solver/flow_solver.h"
 #include "flow_solver/flow_solver_factory.h"
 #include <deal.II/base/parameter_handler.h>
@@ -20,11 +17,12 @@ namespace PHiLiP {
 namespace ProperOrthogonalDecomposition {
 
 template <int dim, int nstate>
-ROMTestLocation<dim, nstate>::ROMTestLocation(const RowVectorXd& parameter, std::unique_ptr<ROMSolution<dim, nstate>> rom_solution)
+ROMTestLocation<dim, nstate>::ROMTestLocation(const RowVectorXd& parameter, std::unique_ptr<ROMSolution<dim, nstate>> rom_solution,
+                                              const MPI_Comm mpi_communicator_input)
         : parameter(parameter)
         , rom_solution(std::move(rom_solution))
-        , mpi_communicator(MPI_COMM_WORLD)
-        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD))
+        , mpi_communicator(mpi_communicator_input)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
         , pcout(std::cout, mpi_rank==0)
 {
     pcout << "Creating ROM test location..." << std::endl;
@@ -35,12 +33,26 @@ ROMTestLocation<dim, nstate>::ROMTestLocation(const RowVectorXd& parameter, std:
     pcout << "ROM test location created. Error estimate updated." << std::endl;
 }
 
+template <int dim, int nstate>
+ROMTestLocation<dim, nstate>::ROMTestLocation(const RowVectorXd& parameter, std::unique_ptr<ROMSolution<dim, nstate>> rom_solution,
+                                              const double fom_to_initial_rom_error, const MPI_Comm mpi_communicator_input)
+        : parameter(parameter)
+        , rom_solution(std::move(rom_solution))
+        , fom_to_initial_rom_error(fom_to_initial_rom_error)
+        , initial_rom_to_final_rom_error(0)
+        , total_error(fom_to_initial_rom_error)
+        , mpi_communicator(mpi_communicator_input)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
+        , pcout(std::cout, mpi_rank==0)
+{
+}
+
 template <int dim, int nstate>
 void ROMTestLocation<dim, nstate>::compute_FOM_to_initial_ROM_error(){
     pcout << "Computing adjoint-based error estimate between ROM and FOM..." << std::endl;
 
     dealii::ParameterHandler dummy_handler;
-    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&rom_solution->params, dummy_handler);
+    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&rom_solution->params, dummy_handler, mpi_communicator);
     flow_solver->dg->solution = rom_solution->solution;
     const bool compute_dRdW = true;
     flow_solver->dg->assemble_residual(compute_dRdW);
@@ -80,40 +92,35 @@ void ROMTestLocation<dim, nstate>::compute_initial_rom_to_final_rom_error(std::s
     pcout << "Computing adjoint-based error estimate between initial ROM and updated ROM..." << std::endl;
 
     dealii::ParameterHandler dummy_handler;
-    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&rom_solution->params, dummy_handler);
+    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&rom_solution->params, dummy_handler, mpi_communicator);
     flow_solver->dg->solution = rom_solution->solution;
     const bool compute_dRdW = true;
     flow_solver->dg->assemble_residual(compute_dRdW);
 
-    const Epetra_CrsMatrix epetra_pod_basis = pod_updated->getPODBasis()->trilinos_matrix();
+    const Epetra_MultiVector &epetra_pod_basis = *pod_updated->getPODBasisDense();
     const Epetra_CrsMatrix epetra_system_matrix_transpose = flow_solver->dg->system_matrix_transpose.trilinos_matrix();
 
-    Epetra_CrsMatrix epetra_petrov_galerkin_basis(Epetra_DataAccess::Copy, epetra_system_matrix_transpose.DomainMap(), pod_updated->getPODBasis()->n());
-    EpetraExt::MatrixMatrix::Multiply(epetra_system_matrix_transpose, true, epetra_pod_basis, false, epetra_petrov_galerkin_basis, true);
+    Epetra_MultiVector epetra_petrov_galerkin_basis(epetra_system_matrix_transpose.DomainMap(), epetra_pod_basis.NumVectors());
+    epetra_system_matrix_transpose.Multiply(true, epetra_pod_basis, epetra_petrov_galerkin_basis);
 
-    Epetra_Vector epetra_gradient(Epetra_DataAccess::Copy, epetra_pod_basis.RowMap(), const_cast<double *>(rom_solution->gradient.begin()));
-    Epetra_Vector epetra_reduced_gradient(epetra_pod_basis.DomainMap());
+    const Epetra_LocalMap reduced_map = reduced_space_map(epetra_pod_basis);
+    Epetra_Vector epetra_gradient(Epetra_DataAccess::Copy, epetra_pod_basis.Map(), const_cast<double *>(rom_solution->gradient.begin()));
+    Epetra_Vector epetra_reduced_gradient(reduced_map);
 
-    epetra_pod_basis.Multiply(true, epetra_gradient, epetra_reduced_gradient);
+    epetra_reduced_gradient.Multiply('T', 'N', 1.0, epetra_pod_basis, epetra_gradient, 0.0);
 
-    Epetra_CrsMatrix epetra_reduced_jacobian_transpose(Epetra_DataAccess::Copy, epetra_petrov_galerkin_basis.DomainMap(), pod_updated->getPODBasis()->n());
-    EpetraExt::MatrixMatrix::Multiply(epetra_petrov_galerkin_basis, true, epetra_petrov_galerkin_basis, false, epetra_reduced_jacobian_transpose);
+    const Epetra_SerialDenseMatrix epetra_reduced_jacobian_transpose = transpose_product(epetra_petrov_galerkin_basis, epetra_petrov_galerkin_basis);
 
-    Epetra_Vector epetra_reduced_adjoint(epetra_reduced_jacobian_transpose.DomainMap());
+    Epetra_Vector epetra_reduced_adjoint(reduced_map);
     epetra_reduced_gradient.Scale(-1);
-    Epetra_LinearProblem linearProblem(&epetra_reduced_jacobian_transpose, &epetra_reduced_adjoint, &epetra_reduced_gradient);
-
-    Amesos_Lapack Solver(linearProblem);
-
-    Teuchos::ParameterList List;
-    Solver.SetParameters(List);
-    Solver.SymbolicFactorization();
-    Solver.NumericFactorization();
-    Solver.Solve();
-
-    Epetra_Vector epetra_reduced_residual(epetra_petrov_galerkin_basis.DomainMap());
-    Epetra_Vector epetra_residual(Epetra_DataAccess::Copy, epetra_petrov_galerkin_basis.RangeMap(), const_cast<double *>(flow_solver->dg->right_hand_side.begin()));
-    epetra_petrov_galerkin_basis.Multiply(true, epetra_residual, epetra_reduced_residual);
+    if (solve_reduced_system(epetra_reduced_jacobian_transpose, epetra_reduced_gradient, epetra_reduced_adjoint) != 0) {
+        pcout << "Error: the reduced adjoint system is singular." << std::endl;
+        std::abort();
+    }
+
+    Epetra_Vector epetra_reduced_residual(reduced_map);
+    Epetra_Vector epetra_residual(Epetra_DataAccess::Copy, epetra_petrov_galerkin_basis.Map(), const_cast<double *>(flow_solver->dg->right_hand_side.begin()));
+    epetra_reduced_residual.Multiply('T', 'N', 1.0, epetra_petrov_galerkin_basis, epetra_residual, 0.0);
 
     //Compute dual weighted residual
     initial_rom_to_final_rom_error = 0;
@@ -15,8 +15,13 @@ template <int dim, int nstate>
 class ROMTestLocation
 {
 public:
-    /// Constructor
-    ROMTestLocation(const RowVectorXd& parameter, std::unique_ptr<ROMSolution < dim, nstate>> rom_solution);
+    /// Constructor. Computes the error estimate between the FOM and the ROM with flow solvers on mpi_communicator_input.
+    ROMTestLocation(const RowVectorXd& parameter, std::unique_ptr<ROMSolution < dim, nstate>> rom_solution,
+                    const MPI_Comm mpi_communicator_input = MPI_COMM_WORLD);
+
+    /// Constructor from an error estimate between the FOM and the ROM computed elsewhere.
+    ROMTestLocation(const RowVectorXd& parameter, std::unique_ptr<ROMSolution < dim, nstate>> rom_solution,
+                    const double fom_to_initial_rom_error, const MPI_Comm mpi_communicator_input = MPI_COMM_WORLD);
 
     /// Compute adjoint error estimate between FOM and initial ROM
     void compute_FOM_to_initial_ROM_error();
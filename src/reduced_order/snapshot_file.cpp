@@ -0,0 +1,495 @@
+#include "snapshot_file.h"
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/distributed/tria_base.h>
+#include <deal.II/grid/cell_id.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+
+static_assert(sizeof(SnapshotFileHeader) == SnapshotFile::data_offset, "The snapshot file header must fill the data offset.");
+
+namespace {
+
+const char snapshot_file_magic[8] = {'P','H','S','N','A','P','S','H'};
+const std::uint32_t snapshot_file_version = 2;
+const std::uint64_t snapshot_file_byte_order_mark = 0x0102030405060708ULL;
+
+/// 64-bit FNV-1a hash of n_bytes bytes, continuing from hash.
+std::uint64_t fnv1a_hash(const void *data, const std::size_t n_bytes, std::uint64_t hash = 14695981039346656037ULL)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < n_bytes; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/// Returns true if header starts a valid snapshot file.
+bool is_valid_header(const SnapshotFileHeader &header)
+{
+    return std::memcmp(header.magic, snapshot_file_magic, sizeof(snapshot_file_magic)) == 0
+           && header.version == snapshot_file_version
+           && header.byte_order_mark == snapshot_file_byte_order_mark;
+}
+
+using RowRanges = SnapshotFileOrdering::RowRanges;
+
+/// Appends row to the ranges, merging it with the last range if they are contiguous.
+void add_row(RowRanges &ranges, const std::uint64_t row)
+{
+    if (!ranges.empty() && ranges.back().first + ranges.back().second > row) {
+        std::cout << "Error: the rows of a snapshot file must be in increasing order." << std::endl;
+        std::abort();
+    }
+    if (!ranges.empty() && ranges.back().first + ranges.back().second == row) {
+        ++ranges.back().second;
+    } else {
+        ranges.emplace_back(row, 1);
+    }
+}
+
+/// Restricts the view of file to the rows of snapshot i, such that the locally owned values are read or written contiguously.
+void set_snapshot_view(MPI_File file, const std::uint64_t n_dofs, const std::uint64_t i, const RowRanges &ranges)
+{
+    std::vector<int> block_lengths;
+    std::vector<MPI_Aint> displacements;
+    for (const auto &range : ranges) {
+        block_lengths.push_back(range.second);
+        displacements.push_back(static_cast<MPI_Aint>(range.first * sizeof(double)));
+    }
+    MPI_Datatype rows_type;
+    MPI_Type_create_hindexed(ranges.size(), block_lengths.data(), displacements.data(), MPI_DOUBLE, &rows_type);
+    MPI_Type_commit(&rows_type);
+
+    const MPI_Offset snapshot_offset = SnapshotFile::data_offset + i * n_dofs * sizeof(double);
+    char data_representation[] = "native";
+    MPI_File_set_view(file, snapshot_offset, MPI_DOUBLE, rows_type, data_representation, MPI_INFO_NULL);
+    MPI_Type_free(&rows_type);
+}
+
+/// Resets the view of file to its raw bytes.
+void set_byte_view(MPI_File file)
+{
+    char data_representation[] = "native";
+    MPI_File_set_view(file, 0, MPI_BYTE, MPI_BYTE, data_representation, MPI_INFO_NULL);
+}
+
+/// Aborts if the locally owned values of snapshot do not match the ordering and the header.
+void check_snapshot_size(const std::string &filename, const dealii::LinearAlgebra::distributed::Vector<double> &snapshot,
+                         const SnapshotFileOrdering &ordering, const SnapshotFileHeader &header)
+{
+    if (snapshot.size() != header.n_dofs || snapshot.locally_owned_elements().n_elements() != ordering.n_local_values()) {
+        std::cout << "Error: snapshot of size " << snapshot.size() << " with " << snapshot.locally_owned_elements().n_elements()
+                  << " local values does not match snapshot file " << filename << " of " << header.n_dofs
+                  << " degrees of freedom with " << ordering.n_local_values() << " local values." << std::endl;
+        std::abort();
+    }
+}
+
+/// Hash of a cell, from its CellId, its vertices and its polynomial degree.
+template <int dim, typename CellIterator>
+std::uint64_t cell_hash(const CellIterator &cell)
+{
+    const std::string cell_id = cell->id().to_string();
+    std::uint64_t hash = fnv1a_hash(cell_id.data(), cell_id.size());
+    for (unsigned int vertex = 0; vertex < dealii::GeometryInfo<dim>::vertices_per_cell; ++vertex) {
+        const dealii::Point<dim> point = cell->vertex(vertex);
+        for (int d = 0; d < dim; ++d) {
+            const double coordinate = point[d];
+            hash = fnv1a_hash(&coordinate, sizeof(double), hash);
+        }
+    }
+    const unsigned int cell_degree = cell->get_fe().tensor_degree();
+    return fnv1a_hash(&cell_degree, sizeof(unsigned int), hash);
+}
+
+}
+
+SnapshotFileHeader snapshot_file_header(const std::uint64_t n_dofs, const std::uint32_t poly_degree, const std::uint64_t mesh_hash)
+{
+    SnapshotFileHeader header;
+    std::memset(&header, 0, sizeof(SnapshotFileHeader));
+    std::memcpy(header.magic, snapshot_file_magic, sizeof(snapshot_file_magic));
+    header.version = snapshot_file_version;
+    header.poly_degree = poly_degree;
+    header.n_dofs = n_dofs;
+    header.n_snapshots = 0;
+    header.mesh_hash = mesh_hash;
+    header.byte_order_mark = snapshot_file_byte_order_mark;
+    return header;
+}
+
+template <int dim, typename MeshType>
+SnapshotFileHeader snapshot_file_header(const DGBase<dim,double,MeshType> &dg)
+{
+    // The cell hashes are summed, which does not depend on the order in which the cells are visited nor on their owner.
+    std::uint64_t mesh_hash = 0;
+    for (const auto &cell : dg.dof_handler.active_cell_iterators()) {
+        if (cell->is_locally_owned()) mesh_hash += cell_hash<dim>(cell);
+    }
+    // Every process owns all the cells of a serial triangulation.
+    if (dynamic_cast<const dealii::parallel::TriangulationBase<dim>*>(&dg.dof_handler.get_triangulation()) != nullptr) {
+        MPI_Allreduce(MPI_IN_PLACE, &mesh_hash, 1, MPI_UINT64_T, MPI_SUM, dg.mpi_communicator);
+    }
+    return snapshot_file_header(dg.dof_handler.n_dofs(), dg.max_degree, mesh_hash);
+}
+
+SnapshotFileOrdering::SnapshotFileOrdering(const dealii::IndexSet &locally_owned_rows)
+{
+    std::vector<std::uint64_t> file_rows;
+    for (const auto &row : locally_owned_rows) file_rows.push_back(row);
+    set_file_rows(file_rows);
+}
+
+template <int dim, typename MeshType>
+SnapshotFileOrdering::SnapshotFileOrdering(const DGBase<dim,double,MeshType> &dg)
+{
+    const auto &triangulation = dg.dof_handler.get_triangulation();
+
+    // Active cells sorted by CellId.
+    using CellIterator = typename dealii::DoFHandler<dim>::active_cell_iterator;
+    std::vector<std::pair<dealii::CellId, CellIterator>> sorted_cells;
+    // Serial and shared triangulations hold every cell, such that all the cells are sorted on every process.
+    const bool holds_all_cells = (dynamic_cast<const dealii::parallel::distributed::Triangulation<dim>*>(&triangulation) == nullptr);
+    for (const auto &cell : dg.dof_handler.active_cell_iterators()) {
+        if (holds_all_cells || cell->is_locally_owned()) sorted_cells.emplace_back(cell->id(), cell);
+    }
+    std::sort(sorted_cells.begin(), sorted_cells.end(),
+              [](const std::pair<dealii::CellId, CellIterator> &a, const std::pair<dealii::CellId, CellIterator> &b) { return a.first < b.first; });
+
+    std::uint64_t first_row = 0;
+    if (!holds_all_cells) {
+        // The cells of a distributed triangulation are partitioned along the space-filling curve of p4est,
+        // whose order is the order of the CellIds. The cells of a process therefore follow the cells of the previous processes.
+        std::uint64_t n_rows = 0;
+        for (const auto &cell : sorted_cells) n_rows += cell.second->get_fe().n_dofs_per_cell();
+        MPI_Exscan(&n_rows, &first_row, 1, MPI_UINT64_T, MPI_SUM, dg.mpi_communicator);
+        if (dealii::Utilities::MPI::this_mpi_process(dg.mpi_communicator) == 0) first_row = 0;
+
+        // Checks the assumption from the first and last cells of every process.
+        std::vector<dealii::CellId> first_and_last;
+        if (!sorted_cells.empty()) {
+            first_and_last.push_back(sorted_cells.front().first);
+            first_and_last.push_back(sorted_cells.back().first);
+        }
+        const std::vector<std::vector<dealii::CellId>> all_first_and_last = dealii::Utilities::MPI::all_gather(dg.mpi_communicator, first_and_last);
+        bool is_sorted = true;
+        const std::vector<dealii::CellId> *previous = nullptr;
+        for (const auto &process_cells : all_first_and_last) {
+            if (process_cells.empty()) continue;
+            if (previous && !((*previous)[1] < process_cells[0])) is_sorted = false;
+            previous = &process_cells;
+        }
+        if (!is_sorted) {
+            if (dealii::Utilities::MPI::this_mpi_process(dg.mpi_communicator) == 0) {
+                std::cout << "Error: the cells of the distributed triangulation are not partitioned in the order of their CellId." << std::endl;
+            }
+            std::abort();
+        }
+    }
+
+    std::vector<std::uint64_t> file_rows(dg.locally_owned_dofs.n_elements());
+    std::vector<dealii::types::global_dof_index> dof_indices;
+    std::uint64_t row = first_row;
+    for (const auto &cell : sorted_cells) {
+        const unsigned int n_dofs_cell = cell.second->get_fe().n_dofs_per_cell();
+        if (cell.second->is_locally_owned()) {
+            dof_indices.resize(n_dofs_cell);
+            cell.second->get_dof_indices(dof_indices);
+            for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
+                file_rows[dg.locally_owned_dofs.index_within_set(dof_indices[idof])] = row + idof;
+            }
+        }
+        row += n_dofs_cell;
+    }
+    set_file_rows(file_rows);
+}
+
+void SnapshotFileOrdering::set_file_rows(const std::vector<std::uint64_t> &file_rows)
+{
+    local_index.resize(file_rows.size());
+    for (unsigned int i = 0; i < local_index.size(); ++i) local_index[i] = i;
+    std::sort(local_index.begin(), local_index.end(),
+              [&file_rows](const unsigned int a, const unsigned int b) { return file_rows[a] < file_rows[b]; });
+    ranges.clear();
+    for (const unsigned int i : local_index) add_row(ranges, file_rows[i]);
+}
+
+const SnapshotFileOrdering::RowRanges &SnapshotFileOrdering::file_row_ranges() const
+{
+    return ranges;
+}
+
+unsigned int SnapshotFileOrdering::n_local_values() const
+{
+    return local_index.size();
+}
+
+void SnapshotFileOrdering::to_file_order(const double *values, std::vector<double> &file_values) const
+{
+    file_values.resize(local_index.size());
+    for (unsigned int i = 0; i < local_index.size(); ++i) file_values[i] = values[local_index[i]];
+}
+
+void SnapshotFileOrdering::from_file_order(const std::vector<double> &file_values, double *values) const
+{
+    for (unsigned int i = 0; i < local_index.size(); ++i) values[local_index[i]] = file_values[i];
+}
+
+SnapshotFile::SnapshotFile(const std::string &filename_input, const MPI_Comm mpi_communicator_input)
+        : filename(filename_input)
+        , mpi_communicator(mpi_communicator_input)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
+        , pcout(std::cout, mpi_rank==0)
+{}
+
+bool SnapshotFile::is_snapshot_file(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    SnapshotFileHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(SnapshotFileHeader))) return false;
+    return is_valid_header(header);
+}
+
+SnapshotFileHeader SnapshotFile::read_header() const
+{
+    MPI_File file;
+    if (MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        pcout << "Error opening snapshot file " << filename << std::endl;
+        std::abort();
+    }
+    SnapshotFileHeader header;
+    std::memset(&header, 0, sizeof(SnapshotFileHeader));
+    if (mpi_rank == 0) {
+        MPI_File_read_at(file, 0, &header, sizeof(SnapshotFileHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    MPI_Bcast(&header, sizeof(SnapshotFileHeader), MPI_BYTE, 0, mpi_communicator);
+    MPI_File_close(&file);
+
+    if (!is_valid_header(header)) {
+        pcout << "Error: " << filename << " is not a snapshot file of version " << snapshot_file_version
+              << " written with the byte order of this machine." << std::endl;
+        std::abort();
+    }
+    return header;
+}
+
+bool SnapshotFile::is_compatible(const SnapshotFileHeader &header, const SnapshotFileHeader &expected_header) const
+{
+    bool compatible = true;
+    if (header.n_dofs != expected_header.n_dofs) {
+        pcout << "Snapshot file " << filename << " has " << header.n_dofs << " degrees of freedom instead of " << expected_header.n_dofs << "." << std::endl;
+        compatible = false;
+    }
+    if (header.poly_degree != expected_header.poly_degree) {
+        pcout << "Snapshot file " << filename << " has polynomial degree " << header.poly_degree << " instead of " << expected_header.poly_degree << "." << std::endl;
+        compatible = false;
+    }
+    if (header.mesh_hash != expected_header.mesh_hash) {
+        pcout << "Snapshot file " << filename << " was written on a different mesh." << std::endl;
+        compatible = false;
+    }
+    return compatible;
+}
+
+void SnapshotFile::write_snapshot(MPI_File file, SnapshotFileHeader header, const std::uint64_t i,
+                                  const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering) const
+{
+    check_snapshot_size(filename, snapshot, ordering, header);
+    std::vector<double> file_values;
+    ordering.to_file_order(snapshot.begin(), file_values);
+    set_snapshot_view(file, header.n_dofs, i, ordering.file_row_ranges());
+    MPI_File_write_all(file, file_values.data(), file_values.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+
+    // The header is updated once the snapshot is complete, such that an interrupted write leaves a readable file.
+    set_byte_view(file);
+    header.n_snapshots = i + 1;
+    if (mpi_rank == 0) {
+        MPI_File_write_at(file, 0, &header, sizeof(SnapshotFileHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+}
+
+void SnapshotFile::write(const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering,
+                         const SnapshotFileHeader &header) const
+{
+    MPI_File file;
+    if (MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        pcout << "Error opening snapshot file " << filename << std::endl;
+        std::abort();
+    }
+    MPI_File_set_size(file, 0);
+    write_snapshot(file, header, 0, snapshot, ordering);
+    MPI_File_close(&file);
+}
+
+void SnapshotFile::append(const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering,
+                          const SnapshotFileHeader &header) const
+{
+    MPI_File file;
+    if (MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_RDWR, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        pcout << "Error opening snapshot file " << filename << std::endl;
+        std::abort();
+    }
+    MPI_Offset file_size;
+    MPI_File_get_size(file, &file_size);
+
+    SnapshotFileHeader file_header = header;
+    file_header.n_snapshots = 0;
+    if (file_size > 0) {
+        if (mpi_rank == 0) {
+            MPI_File_read_at(file, 0, &file_header, sizeof(SnapshotFileHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+        MPI_Bcast(&file_header, sizeof(SnapshotFileHeader), MPI_BYTE, 0, mpi_communicator);
+        if (!is_valid_header(file_header) || !is_compatible(file_header, header)) {
+            pcout << "Error: can not append a snapshot to " << filename << std::endl;
+            std::abort();
+        }
+    }
+    write_snapshot(file, file_header, file_header.n_snapshots, snapshot, ordering);
+    MPI_File_close(&file);
+}
+
+void SnapshotFile::read(const std::uint64_t i, const SnapshotFileOrdering &ordering, dealii::LinearAlgebra::distributed::Vector<double> &snapshot) const
+{
+    const SnapshotFileHeader header = read_header();
+    if (i >= header.n_snapshots || snapshot.size() != header.n_dofs) {
+        pcout << "Error: snapshot file " << filename << " does not contain snapshot " << i << " of size " << snapshot.size() << std::endl;
+        std::abort();
+    }
+    check_snapshot_size(filename, snapshot, ordering, header);
+    MPI_File file;
+    MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+    std::vector<double> file_values(ordering.n_local_values());
+    set_snapshot_view(file, header.n_dofs, i, ordering.file_row_ranges());
+    MPI_File_read_all(file, file_values.data(), file_values.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+    ordering.from_file_order(file_values, snapshot.begin());
+    snapshot.update_ghost_values();
+}
+
+void SnapshotFile::read(Epetra_MultiVector &snapshots, const int first_column, const SnapshotFileOrdering &ordering) const
+{
+    const SnapshotFileHeader header = read_header();
+    if (static_cast<std::uint64_t>(snapshots.GlobalLength()) != header.n_dofs
+        || first_column + header.n_snapshots > static_cast<std::uint64_t>(snapshots.NumVectors())) {
+        pcout << "Error: the " << header.n_snapshots << " snapshots of size " << header.n_dofs << " in " << filename
+              << " do not fit in columns " << first_column << " onwards of the snapshot matrix." << std::endl;
+        std::abort();
+    }
+    if (static_cast<unsigned int>(snapshots.MyLength()) != ordering.n_local_values()) {
+        std::cout << "Error: the snapshot matrix has " << snapshots.MyLength() << " local rows, but the ordering of "
+                  << filename << " has " << ordering.n_local_values() << "." << std::endl;
+        std::abort();
+    }
+    MPI_File file;
+    MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+    std::vector<double> file_values(ordering.n_local_values());
+    for (std::uint64_t i = 0; i < header.n_snapshots; ++i) {
+        set_snapshot_view(file, header.n_dofs, i, ordering.file_row_ranges());
+        MPI_File_read_all(file, file_values.data(), file_values.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+        ordering.from_file_order(file_values, snapshots[first_column + i]);
+    }
+    MPI_File_close(&file);
+}
+
+PendingSnapshotWrite::PendingSnapshotWrite(const std::string &filename_input, const MPI_Comm mpi_communicator,
+                                           const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering,
+                                           const SnapshotFileHeader &header_input)
+        : filename(filename_input)
+        , mpi_rank(dealii::Utilities::MPI::this_mpi_process(mpi_communicator))
+        , header(header_input)
+        , pending(true)
+{
+    check_snapshot_size(filename, snapshot, ordering, header);
+    ordering.to_file_order(snapshot.begin(), buffer);
+    if (MPI_File_open(mpi_communicator, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        std::cout << "Error opening snapshot file " << filename << std::endl;
+        std::abort();
+    }
+    MPI_File_set_size(file, 0);
+    header.n_snapshots = 1;
+
+    set_snapshot_view(file, header.n_dofs, 0, ordering.file_row_ranges());
+    MPI_File_iwrite_all(file, buffer.data(), buffer.size(), MPI_DOUBLE, &request);
+}
+
+PendingSnapshotWrite::~PendingSnapshotWrite()
+{
+    wait();
+}
+
+void PendingSnapshotWrite::wait()
+{
+    if (!pending) return;
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    set_byte_view(file);
+    if (mpi_rank == 0) {
+        MPI_File_write_at(file, 0, &header, sizeof(SnapshotFileHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+    MPI_File_close(&file);
+    pending = false;
+    buffer.clear();
+    buffer.shrink_to_fit();
+}
+
+MappedSnapshotFile::MappedSnapshotFile(const std::string &filename)
+        : mapping(MAP_FAILED)
+        , mapping_size(0)
+{
+    const int file_descriptor = open(filename.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor >= 0 && fstat(file_descriptor, &file_status) == 0 && file_status.st_size >= static_cast<off_t>(SnapshotFile::data_offset)) {
+        mapping_size = file_status.st_size;
+        mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+    }
+    if (file_descriptor >= 0) close(file_descriptor);
+
+    if (mapping == MAP_FAILED || !is_valid_header(header())
+        || mapping_size < SnapshotFile::data_offset + header().n_snapshots * header().n_dofs * sizeof(double)) {
+        std::cout << "Error: could not map snapshot file " << filename << std::endl;
+        std::abort();
+    }
+}
+
+MappedSnapshotFile::~MappedSnapshotFile()
+{
+    munmap(mapping, mapping_size);
+}
+
+const SnapshotFileHeader &MappedSnapshotFile::header() const
+{
+    return *static_cast<const SnapshotFileHeader *>(mapping);
+}
+
+const double *MappedSnapshotFile::snapshot(const std::uint64_t i) const
+{
+    const char *data = static_cast<const char *>(mapping) + SnapshotFile::data_offset;
+    return reinterpret_cast<const double *>(data) + i * header().n_dofs;
+}
+
+template SnapshotFileHeader snapshot_file_header<PHILIP_DIM, dealii::Triangulation<PHILIP_DIM>>(const DGBase<PHILIP_DIM,double,dealii::Triangulation<PHILIP_DIM>> &dg);
+template SnapshotFileHeader snapshot_file_header<PHILIP_DIM, dealii::parallel::shared::Triangulation<PHILIP_DIM>>(const DGBase<PHILIP_DIM,double,dealii::parallel::shared::Triangulation<PHILIP_DIM>> &dg);
+template SnapshotFileOrdering::SnapshotFileOrdering<PHILIP_DIM, dealii::Triangulation<PHILIP_DIM>>(const DGBase<PHILIP_DIM,double,dealii::Triangulation<PHILIP_DIM>> &dg);
+template SnapshotFileOrdering::SnapshotFileOrdering<PHILIP_DIM, dealii::parallel::shared::Triangulation<PHILIP_DIM>>(const DGBase<PHILIP_DIM,double,dealii::parallel::shared::Triangulation<PHILIP_DIM>> &dg);
+#if PHILIP_DIM!=1
+template SnapshotFileHeader snapshot_file_header<PHILIP_DIM, dealii::parallel::distributed::Triangulation<PHILIP_DIM>>(const DGBase<PHILIP_DIM,double,dealii::parallel::distributed::Triangulation<PHILIP_DIM>> &dg);
+template SnapshotFileOrdering::SnapshotFileOrdering<PHILIP_DIM, dealii::parallel::distributed::Triangulation<PHILIP_DIM>>(const DGBase<PHILIP_DIM,double,dealii::parallel::distributed::Triangulation<PHILIP_DIM>> &dg);
+#endif
+
+}
+}
@@ -0,0 +1,216 @@
+#ifndef __SNAPSHOT_FILE__
+#define __SNAPSHOT_FILE__
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <Epetra_MultiVector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mpi.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dg/dg_base.hpp"
+
+namespace PHiLiP {
+namespace ProperOrthogonalDecomposition {
+
+/// Header of a binary snapshot file, identifying the discretization which the snapshots belong to.
+/** The header is followed by the snapshots stored one after the other, each as n_dofs doubles in native byte order
+ *  and in the order of the file rows, see SnapshotFileOrdering. The layout depends neither on the number of processes
+ *  which wrote the file nor on the numbering of the degrees of freedom, and snapshot i starts at byte
+ *  SnapshotFile::data_offset + i*n_dofs*sizeof(double), such that the file can be memory-mapped.
+ */
+struct SnapshotFileHeader
+{
+    char magic[8]; ///< File signature, "PHSNAPSH".
+    std::uint32_t version; ///< Version of the file layout.
+    std::uint32_t poly_degree; ///< Maximum polynomial degree of the discretization.
+    std::uint64_t n_dofs; ///< Number of degrees of freedom of each snapshot.
+    std::uint64_t n_snapshots; ///< Number of snapshots stored after the header.
+    std::uint64_t mesh_hash; ///< Hash of the active cells, their vertices and their polynomial degree.
+    std::uint64_t byte_order_mark; ///< Written as 0x0102030405060708 to detect files written with another byte order.
+    std::uint64_t reserved[2]; ///< Pads the header to 64 bytes.
+};
+
+/// Returns the header of a file without snapshots, for the given discretization.
+SnapshotFileHeader snapshot_file_header(const std::uint64_t n_dofs, const std::uint32_t poly_degree, const std::uint64_t mesh_hash);
+
+/// Returns the header describing the discretization of dg, with no snapshots.
+/** The mesh hash is accumulated cell by cell, such that it does not depend on the partitioning of the mesh.
+ *  Must be called by all the processes of dg.
+ */
+template <int dim, typename MeshType>
+SnapshotFileHeader snapshot_file_header(const DGBase<dim,double,MeshType> &dg);
+
+/// Rows of a snapshot file holding the locally owned values of a distributed vector.
+/** The values of a DG solution are stored cell by cell, with the cells sorted by their CellId and the degrees of freedom
+ *  of a cell in their local order. This order is the same for any partitioning of the mesh and any numbering of the
+ *  degrees of freedom, such that a file written with Cuthill-McKee renumbering on some number of processes can be read
+ *  on any other number of processes.
+ */
+class SnapshotFileOrdering
+{
+public:
+    /// Values stored in the global numbering of the rows, for vectors which are not tied to a mesh.
+    explicit SnapshotFileOrdering(const dealii::IndexSet &locally_owned_rows);
+
+    /// Values stored cell by cell, for the locally owned degrees of freedom of dg.
+    /** Must be called by all the processes of dg.
+     */
+    template <int dim, typename MeshType>
+    explicit SnapshotFileOrdering(const DGBase<dim,double,MeshType> &dg);
+
+    /// Contiguous ranges of file rows, as (first row, number of rows), in increasing order.
+    using RowRanges = std::vector<std::pair<std::uint64_t, int>>;
+
+    /// File rows of the locally owned values, in increasing order.
+    const RowRanges &file_row_ranges() const;
+
+    /// Number of locally owned values.
+    unsigned int n_local_values() const;
+
+    /// Copies the locally owned values into file_values, in the order of the file rows.
+    void to_file_order(const double *values, std::vector<double> &file_values) const;
+
+    /// Copies values read in the order of the file rows back into the locally owned values.
+    void from_file_order(const std::vector<double> &file_values, double *values) const;
+
+protected:
+    /// Sorts the file rows of the locally owned values and merges them into ranges.
+    void set_file_rows(const std::vector<std::uint64_t> &file_rows);
+
+    /// Ranges of file rows of the locally owned values.
+    RowRanges ranges;
+
+    /// Local index of the value stored in each file row, in increasing file row.
+    std::vector<unsigned int> local_index;
+};
+
+/// Binary container of solution snapshots, read and written in parallel with MPI-IO.
+/** Each process reads and writes its locally owned values directly in the global layout of the file, at the rows given
+ *  by a SnapshotFileOrdering. A file written on any number of processes can therefore be read on any other number of processes.
+ *
+ *  All the member functions except is_snapshot_file are collective over mpi_communicator.
+ */
+class SnapshotFile
+{
+public:
+    /// Constructor.
+    SnapshotFile(const std::string &filename_input, const MPI_Comm mpi_communicator_input);
+
+    /// Returns true if filename starts with a valid snapshot file header. Does not communicate.
+    static bool is_snapshot_file(const std::string &filename);
+
+    /// Reads the header. Aborts if the file is not a snapshot file.
+    SnapshotFileHeader read_header() const;
+
+    /// Overwrites the file with header followed by the single snapshot.
+    void write(const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering,
+               const SnapshotFileHeader &header) const;
+
+    /// Appends snapshot to the file, which is created with header if it does not exist.
+    /** Aborts if the existing file does not describe the same discretization as header.
+     */
+    void append(const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering,
+                const SnapshotFileHeader &header) const;
+
+    /// Reads the locally owned values of snapshot i.
+    void read(const std::uint64_t i, const SnapshotFileOrdering &ordering, dealii::LinearAlgebra::distributed::Vector<double> &snapshot) const;
+
+    /// Reads all the snapshots into the columns first_column, first_column+1, ... of snapshots, distributed by rows.
+    /** The locally owned rows of snapshots are those described by ordering.
+     */
+    void read(Epetra_MultiVector &snapshots, const int first_column, const SnapshotFileOrdering &ordering) const;
+
+    /// Returns true if the two headers describe the same discretization, otherwise prints the differences.
+    bool is_compatible(const SnapshotFileHeader &header, const SnapshotFileHeader &expected_header) const;
+
+    /// Offset of the first snapshot in the file, in bytes.
+    static constexpr std::size_t data_offset = 64;
+
+    const std::string filename; ///< Name of the file.
+    const MPI_Comm mpi_communicator; ///< MPI communicator.
+    const int mpi_rank; ///< MPI rank.
+
+protected:
+    /// Writes the locally owned values of snapshot as snapshot i of the open file, then updates the header with i+1 snapshots.
+    void write_snapshot(MPI_File file, SnapshotFileHeader header, const std::uint64_t i,
+                        const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering) const;
+
+    /// ConditionalOStream.
+    /** Used as std::cout, but only prints if mpi_rank == 0
+     */
+    dealii::ConditionalOStream pcout;
+};
+
+/// Overwrite of a snapshot file with a single snapshot, which proceeds while the caller continues its computations.
+/** The locally owned values are copied into a buffer in the order of the file rows on construction, and written with a
+ *  nonblocking collective MPI-IO write.
+ *  The header, which records the snapshot, is only written once the values are in the file, such that an interrupted
+ *  write never leaves a file which looks complete.
+ *
+ *  The constructor and wait() are collective over mpi_communicator.
+ */
+class PendingSnapshotWrite
+{
+public:
+    /// Constructor. Starts overwriting the file with header followed by snapshot.
+    PendingSnapshotWrite(const std::string &filename_input, const MPI_Comm mpi_communicator,
+                         const dealii::LinearAlgebra::distributed::Vector<double> &snapshot, const SnapshotFileOrdering &ordering,
+                         const SnapshotFileHeader &header_input);
+
+    /// Destructor. Waits for the write to complete.
+    ~PendingSnapshotWrite();
+
+    PendingSnapshotWrite(const PendingSnapshotWrite &) = delete; ///< Owns the open file, not copyable.
+    PendingSnapshotWrite &operator=(const PendingSnapshotWrite &) = delete; ///< Owns the open file, not copyable.
+
+    /// Waits until the snapshot is written, then writes the header and closes the file.
+    void wait();
+
+    const std::string filename; ///< Name of the file.
+
+private:
+    const int mpi_rank; ///< MPI rank.
+    std::vector<double> buffer; ///< Copy of the locally owned values in the order of the file rows, kept until they are written.
+    SnapshotFileHeader header; ///< Header written once the snapshot is complete.
+    MPI_File file; ///< File being written.
+    MPI_Request request; ///< Request of the nonblocking write of the values.
+    bool pending; ///< Whether the write has not been completed by wait() yet.
+};
+
+/// Read-only memory map of a snapshot file, giving direct access to its snapshots without copying them.
+/** Used for serial processing of the snapshots, such as post-processing and verification.
+ */
+class MappedSnapshotFile
+{
+public:
+    /// Constructor. Maps the whole file, and aborts if it is not a snapshot file.
+    explicit MappedSnapshotFile(const std::string &filename);
+
+    /// Destructor. Unmaps the file.
+    ~MappedSnapshotFile();
+
+    MappedSnapshotFile(const MappedSnapshotFile &) = delete; ///< Owns the mapping, not copyable.
+    MappedSnapshotFile &operator=(const MappedSnapshotFile &) = delete; ///< Owns the mapping, not copyable.
+
+    /// Header of the file.
+    const SnapshotFileHeader &header() const;
+
+    /// Values of snapshot i, in the order of the file rows.
+    const double *snapshot(const std::uint64_t i) const;
+
+private:
+    void *mapping; ///< Start of the mapped file.
+    std::size_t mapping_size; ///< Size of the mapped file in bytes.
+};
+
+}
+}
+
+#endif
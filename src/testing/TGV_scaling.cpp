@@ -88,7 +88,7 @@ int EulerTaylorGreenScaling<dim, nstate>::run_test() const
             if(all_parameters->use_inverse_mass_on_the_fly){
                 dg->apply_inverse_global_mass_matrix(dg->right_hand_side, solution_update);
             } else{
-                dg->global_inverse_mass_matrix.vmult(solution_update, dg->right_hand_side);
+                dg->apply_stored_inverse_global_mass_matrix(dg->right_hand_side, solution_update);
             }
         }
 
@@ -165,7 +165,7 @@ int EulerTaylorGreenScaling<dim, nstate>::run_test() const
         if(all_parameters->use_inverse_mass_on_the_fly){
             dg->apply_inverse_global_mass_matrix(dg->right_hand_side, solution_update);
         } else{
-            dg->global_inverse_mass_matrix.vmult(solution_update, dg->right_hand_side);
+            dg->apply_stored_inverse_global_mass_matrix(dg->right_hand_side, solution_update);
         }
     }
     //if it reaches here, then there is no memory issue.
@@ -62,7 +62,7 @@ double ConvectionDiffusionPeriodic<dim, nstate>::compute_conservation(std::share
     if(dg->all_parameters->use_inverse_mass_on_the_fly)
         dg->apply_global_mass_matrix(dg->solution,mass_matrix_times_solution);
     else
-        dg->global_mass_matrix.vmult(mass_matrix_times_solution, dg->solution);
+        dg->apply_stored_global_mass_matrix(dg->solution, mass_matrix_times_solution);
 
     const unsigned int n_dofs_cell = dg->fe_collection[poly_degree].dofs_per_cell;
     const unsigned int n_quad_pts = dg->volume_quadrature_collection[poly_degree].size();
@@ -98,7 +98,7 @@ double ConvectionDiffusionPeriodic<dim, nstate>::compute_conservation(std::share
         if(dg->all_parameters->use_inverse_mass_on_the_fly)
             dg->apply_global_mass_matrix(dg->auxiliary_solution[idim], mass_matrix_times_auxiliary_variable,true);
         else
-            dg->global_mass_matrix_auxiliary.vmult( mass_matrix_times_auxiliary_variable, dg->auxiliary_solution[idim]);
+            dg->apply_stored_global_mass_matrix(dg->auxiliary_solution[idim], mass_matrix_times_auxiliary_variable, true);
         for(int jdim=0; jdim<dim; jdim++){
             double temp_cons = ones_hat_global * mass_matrix_times_auxiliary_variable * diff_tensor[idim][jdim];
             conservation += diff_coeff * temp_cons;
@@ -221,7 +221,8 @@ int EulerBumpOptimization<dim,nstate>
     const dealii::Point<dim> ffd_origin(-1.4,-0.1);
     const std::array<double,dim> ffd_rectangle_lengths = {{2.8,0.6}};
     const std::array<unsigned int,dim> ffd_ndim_control_pts = {{nx_ffd,2}};
-    FreeFormDeformation<dim> ffd( ffd_origin, ffd_rectangle_lengths, ffd_ndim_control_pts);
+    FreeFormDeformation<dim> ffd( ffd_origin, ffd_rectangle_lengths, ffd_ndim_control_pts,
+                                  param.linear_solver_param.mesh_movement_preconditioner_type);
 
     unsigned int n_design_variables = 0;
     // Vector of ijk indices and dimension.
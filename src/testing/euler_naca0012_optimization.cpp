@@ -460,7 +460,8 @@ int EulerNACAOptimization<dim,nstate>
     const dealii::Point<dim> ffd_origin(0.0,-0.061);
     const std::array<double,dim> ffd_rectangle_lengths = {{0.9,0.122}};
     const std::array<unsigned int,dim> ffd_ndim_control_pts = {{nx_ffd,3}};
-    FreeFormDeformation<dim> ffd( ffd_origin, ffd_rectangle_lengths, ffd_ndim_control_pts);
+    FreeFormDeformation<dim> ffd( ffd_origin, ffd_rectangle_lengths, ffd_ndim_control_pts,
+                                  param.linear_solver_param.mesh_movement_preconditioner_type);
 
     unsigned int n_design_variables = 0;
     // Vector of ijk indices and dimension.
@@ -568,7 +568,9 @@ int EulerTaylorGreen<dim, nstate>::run_test() const
     PHiLiP::Parameters::AllParameters all_parameters_new = *all_parameters;  
     double left = 0.0;
     double right = 2 * dealii::numbers::PI;
+    // The curvilinear grid is refined twice, whereas the straight grid's size is given in the flow_solver subsection.
     const int n_refinements = 2;
+    const int number_of_cells_per_direction = all_parameters->flow_solver_param.number_of_grid_elements_per_dimension;
     unsigned int poly_degree = 3;
 
     const unsigned int grid_degree = all_parameters->use_curvilinear_grid ? poly_degree : 1;
@@ -578,7 +580,7 @@ int EulerTaylorGreen<dim, nstate>::run_test() const
     }
     else{
         //if straight
-        PHiLiP::Grids::straight_periodic_cube<dim,Triangulation>(grid, left, right, pow(2.0,n_refinements));
+        PHiLiP::Grids::straight_periodic_cube<dim,Triangulation>(grid, left, right, number_of_cells_per_direction);
     }
 
     // Create DG
@@ -599,7 +601,7 @@ int EulerTaylorGreen<dim, nstate>::run_test() const
     pcout << "creating ODE solver" << std::endl;
     std::shared_ptr<ODE::ODESolverBase<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
     pcout << "ODE solver successfully created" << std::endl;
-    double finalTime = 14.;
+    const double finalTime = all_parameters->flow_solver_param.final_time;
 
     pcout << " number dofs " << dg->dof_handler.n_dofs()<<std::endl;
     pcout << "preparing to advance solution in time" << std::endl;
@@ -2,6 +2,8 @@
 #include "flow_solver/flow_solver_factory.h"
 #include "flow_solver/flow_solver_cases/periodic_turbulence.h"
 #include "physics/initial_conditions/set_initial_condition.h"
+#include "physics/initial_conditions/flow_field_file.h"
+#include "reduced_order/snapshot_file.h"
 #include <deal.II/base/table_handler.h>
 #include <algorithm>
 #include <iterator>
@@ -35,6 +37,68 @@ int HomogeneousIsotropicTurbulenceInitializationCheck<dim, nstate>::run_test() c
     std::unique_ptr<FlowSolver::PeriodicTurbulence<dim, nstate>> flow_solver_case = std::make_unique<FlowSolver::PeriodicTurbulence<dim,nstate>>(this->all_parameters);
     flow_solver_case->output_velocity_field(flow_solver->dg,0,0.0);
 
+    const std::string &input_filename_prefix = parameters.flow_solver_param.input_flow_setup_filename_prefix;
+    const bool initialized_from_binary_file = FlowFieldFile::is_flow_field_file(input_filename_prefix + ".field");
+    if (initialized_from_binary_file) {
+        // The binary file was written by another run, possibly on another number of processes.
+        // Compare the solution read from it with the solution that run read from its text files.
+        return compare_with_reference_solution(*(flow_solver->dg), input_filename_prefix + "_reference.snapshots");
+    }
+
+    // Write the initialized solution to a single binary file, and check that reading it back recovers the solution
+    const std::string binary_setup_filename_prefix = "setup_binary";
+    this->pcout << "Writing and reading back the binary flow setup file " << binary_setup_filename_prefix << ".field... " << std::flush;
+    SetInitialCondition<dim,nstate,double>::write_values_to_file(flow_solver->dg, binary_setup_filename_prefix);
+    const dealii::LinearAlgebra::distributed::Vector<double> solution_read_from_text_files = flow_solver->dg->solution;
+    flow_solver->dg->solution = 0.0;
+    PHiLiP::Parameters::AllParameters parameters_binary_setup = parameters;
+    parameters_binary_setup.flow_solver_param.apply_initial_condition_method = Parameters::FlowSolverParam::ApplyInitialConditionMethod::read_values_from_file_and_project;
+    parameters_binary_setup.flow_solver_param.input_flow_setup_filename_prefix = binary_setup_filename_prefix;
+    SetInitialCondition<dim,nstate,double>::set_initial_condition(flow_solver->flow_solver_case->initial_condition_function, flow_solver->dg, &parameters_binary_setup);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_difference = flow_solver->dg->solution;
+    solution_difference -= solution_read_from_text_files;
+    const double solution_difference_linfty_norm = solution_difference.linfty_norm();
+    this->pcout << "done." << std::endl;
+    if (solution_difference_linfty_norm > 1.0e-12) {
+        this->pcout << "Binary flow setup file does not recover the solution; max difference is "
+                    << solution_difference_linfty_norm << std::endl;
+        return 1;
+    }
+
+    // Store the solution read from the text files in a partition-independent snapshot file,
+    // such that runs on other numbers of processes can check what they read from the binary file.
+    using namespace ProperOrthogonalDecomposition;
+    const SnapshotFile reference_file(binary_setup_filename_prefix + "_reference.snapshots", this->mpi_communicator);
+    reference_file.write(solution_read_from_text_files, SnapshotFileOrdering(*(flow_solver->dg)), snapshot_file_header(*(flow_solver->dg)));
+
+    return 0;
+}
+
+template <int dim, int nstate>
+int HomogeneousIsotropicTurbulenceInitializationCheck<dim, nstate>::compare_with_reference_solution(
+    const DGBase<dim,double> &dg,
+    const std::string &reference_filename) const
+{
+    using namespace ProperOrthogonalDecomposition;
+    this->pcout << "Comparing the solution read from the binary flow setup file with " << reference_filename << "... " << std::flush;
+    const SnapshotFile reference_file(reference_filename, this->mpi_communicator);
+    if (!reference_file.is_compatible(reference_file.read_header(), snapshot_file_header(dg))) {
+        this->pcout << "The reference solution does not belong to this discretization." << std::endl;
+        return 1;
+    }
+    dealii::LinearAlgebra::distributed::Vector<double> solution_difference;
+    solution_difference.reinit(dg.locally_owned_dofs, this->mpi_communicator);
+    reference_file.read(0, SnapshotFileOrdering(dg), solution_difference);
+    for (const auto &dof : dg.locally_owned_dofs) {
+        solution_difference[dof] -= dg.solution[dof];
+    }
+    const double solution_difference_linfty_norm = solution_difference.linfty_norm();
+    this->pcout << "done." << std::endl;
+    if (solution_difference_linfty_norm > 1.0e-12) {
+        this->pcout << "Binary flow setup file read on " << dealii::Utilities::MPI::n_mpi_processes(this->mpi_communicator)
+                    << " processes does not recover the solution; max difference is " << solution_difference_linfty_norm << std::endl;
+        return 1;
+    }
     return 0;
 }
 
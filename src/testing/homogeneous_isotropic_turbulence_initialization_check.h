@@ -25,7 +25,17 @@ public:
     const double kinetic_energy_expected;
 
     /// Run test
+    /** When initialized from a binary flow setup file, the solution is compared with the reference solution
+     *  written next to that file. Otherwise, the solution read from the text files is written to a binary file
+     *  named setup_binary.field, checked by reading it back, and stored as the reference solution.
+     */
     int run_test () const override;
+
+protected:
+    /// Returns 1 if the solution differs from the one stored in the reference snapshot file, 0 otherwise.
+    int compare_with_reference_solution(
+        const DGBase<dim,double> &dg,
+        const std::string &reference_filename) const;
 };
 
 } // End of Tests namespace
@@ -419,7 +419,7 @@ int OptimizationInverseManufactured<dim,nstate>
     // SplineY spline(n_design, spline_degree, y_start, y_end);
     // auto x_displacements = spline.evalSpline(y_locations);
 
- MeshMover::LinearElasticity<dim, double> meshmover(*high_order_grid, surface_node_displacements_vector);
+ MeshMover::LinearElasticity<dim, double> meshmover(*high_order_grid, surface_node_displacements_vector, all_parameters->linear_solver_param.mesh_movement_preconditioner_type);
  VectorType volume_displacements = meshmover.get_volume_displacements();
 
  high_order_grid->volume_nodes += volume_displacements;
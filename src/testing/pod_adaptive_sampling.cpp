@@ -26,9 +26,17 @@ AdaptiveSampling<dim, nstate>::AdaptiveSampling(const PHiLiP::Parameters::AllPar
                                                 const dealii::ParameterHandler &parameter_handler_input)
         : TestsBase::TestsBase(parameters_input)
         , parameter_handler(parameter_handler_input)
+        , scheduler(MPI_COMM_WORLD, parameters_input->reduced_order_param.number_of_sampling_groups)
 {
     configureInitialParameterSpace();
-    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(all_parameters, parameter_handler);
+    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(all_parameters, parameter_handler, scheduler.group_communicator);
+    int communicator_comparison;
+    MPI_Comm_compare(flow_solver->dg->mpi_communicator, scheduler.group_communicator, &communicator_comparison);
+    if (communicator_comparison == MPI_UNEQUAL) {
+        pcout << "Error: the grid of this flow case is not distributed over the sampling groups. Use a single sampling group." << std::endl;
+        std::abort();
+    }
+    solution_layout.reinit(flow_solver->dg->solution);
     const bool compute_dRdW = true;
     flow_solver->dg->assemble_residual(compute_dRdW);
     std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> system_matrix = std::make_shared<dealii::TrilinosWrappers::SparseMatrix>();
@@ -58,7 +66,7 @@ int AdaptiveSampling<dim, nstate>::run_test() const
         outputIterationData(iteration);
 
         this->pcout << "Sampling snapshot at " << max_error_params << std::endl;
-        dealii::LinearAlgebra::distributed::Vector<double> fom_solution = solveSnapshotFOM(max_error_params);
+        dealii::LinearAlgebra::distributed::Vector<double> fom_solution = solveSnapshotsFOM(max_error_params)[0];
         snapshot_parameters.conservativeResize(snapshot_parameters.rows()+1, snapshot_parameters.cols());
         snapshot_parameters.row(snapshot_parameters.rows()-1) = max_error_params;
         nearest_neighbors->updateSnapshots(snapshot_parameters, fom_solution);
@@ -66,10 +74,7 @@ int AdaptiveSampling<dim, nstate>::run_test() const
         current_pod->computeBasis();
 
         //Update previous ROM errors with updated current_pod
-        for(auto it = rom_locations.begin(); it != rom_locations.end(); ++it){
-            it->get()->compute_initial_rom_to_final_rom_error(current_pod);
-            it->get()->compute_total_error();
-        }
+        updateROMErrors();
 
         updateNearestExistingROMs(max_error_params);
 
@@ -94,10 +99,11 @@ template <int dim, int nstate>
 void AdaptiveSampling<dim, nstate>::outputIterationData(int iteration) const{
     std::unique_ptr<dealii::TableHandler> snapshot_table = std::make_unique<dealii::TableHandler>();
 
-    std::ofstream solution_out_file("solution_snapshots_iteration_" +  std::to_string(iteration) + ".txt");
     unsigned int precision = 16;
-    current_pod->dealiiSnapshotMatrix.print_formatted(solution_out_file, precision);
-    solution_out_file.close();
+    // Every group holds the same snapshots.
+    if(scheduler.group_id == 0){
+        current_pod->printSnapshots("solution_snapshots_iteration_" +  std::to_string(iteration) + ".txt", precision);
+    }
 
     for(auto parameters : snapshot_parameters.rowwise()){
         for(int i = 0 ; i < snapshot_parameters.cols() ; i++){
@@ -246,9 +252,9 @@ RowVectorXd AdaptiveSampling<dim, nstate>::getMaxErrorROM() const{
 
 template <int dim, int nstate>
 void AdaptiveSampling<dim, nstate>::placeInitialSnapshots() const{
-    for(auto snap_param : snapshot_parameters.rowwise()){
-        this->pcout << "Sampling initial snapshot at " << snap_param << std::endl;
-        dealii::LinearAlgebra::distributed::Vector<double> fom_solution = solveSnapshotFOM(snap_param);
+    this->pcout << "Sampling initial snapshots at " << std::endl << snapshot_parameters << std::endl;
+    const std::vector<DealiiVector> fom_solutions = solveSnapshotsFOM(snapshot_parameters);
+    for(const auto &fom_solution : fom_solutions){
         nearest_neighbors->updateSnapshots(snapshot_parameters, fom_solution);
         current_pod->addSnapshot(fom_solution);
     }
@@ -257,31 +263,42 @@ void AdaptiveSampling<dim, nstate>::placeInitialSnapshots() const{
 template <int dim, int nstate>
 bool AdaptiveSampling<dim, nstate>::placeROMLocations(const MatrixXd& rom_points) const{
     bool error_greater_than_tolerance = false;
+    MatrixXd new_rom_points(0, rom_points.cols());
     for(auto midpoint : rom_points.rowwise()){
 
         //Check if ROM point already exists as another ROM point
         auto element = std::find_if(rom_locations.begin(), rom_locations.end(), [&midpoint](std::unique_ptr<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>& location){ return location->parameter.isApprox(midpoint);} );
 
-        //Check if ROM point already exists as a snapshot
+        //Check if ROM point already exists as a snapshot or is already being placed
         bool snapshot_exists = false;
         for(auto snap_param : snapshot_parameters.rowwise()){
             if(snap_param.isApprox(midpoint)){
                 snapshot_exists = true;
             }
         }
-
-        if(element == rom_locations.end() && snapshot_exists == false){
-            //ProperOrthogonalDecomposition::ROMSolution<dim, nstate> rom_solution = solveSnapshotROM(midpoint);
-            std::unique_ptr<ProperOrthogonalDecomposition::ROMSolution<dim, nstate>> rom_solution = solveSnapshotROM(midpoint);
-            rom_locations.emplace_back(std::make_unique<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>(midpoint, std::move(rom_solution)));
-            if(abs(rom_locations.back()->total_error) > all_parameters->reduced_order_param.adaptation_tolerance){
-                error_greater_than_tolerance = true;
+        bool point_placed = false;
+        for(auto new_point : new_rom_points.rowwise()){
+            if(new_point.isApprox(midpoint)){
+                point_placed = true;
             }
         }
+
+        if(element == rom_locations.end() && snapshot_exists == false && point_placed == false){
+            new_rom_points.conservativeResize(new_rom_points.rows()+1, new_rom_points.cols());
+            new_rom_points.row(new_rom_points.rows()-1) = midpoint;
+        }
         else{
             this->pcout << "ROM already computed." << std::endl;
         }
     }
+
+    std::vector<std::unique_ptr<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>> new_rom_locations = solveROMTestLocations(new_rom_points);
+    for(auto &rom_location : new_rom_locations){
+        if(abs(rom_location->total_error) > all_parameters->reduced_order_param.adaptation_tolerance){
+            error_greater_than_tolerance = true;
+        }
+        rom_locations.emplace_back(std::move(rom_location));
+    }
     return error_greater_than_tolerance;
 }
 
@@ -320,9 +337,8 @@ void AdaptiveSampling<dim, nstate>::updateNearestExistingROMs(const RowVectorXd&
         local_mean_error = local_mean_error / (rom_points.cols() + 1);
         if ((std::abs(rom_locations[index[0]]->total_error) > all_parameters->reduced_order_param.recomputation_coefficient * local_mean_error) || (std::abs(rom_locations[index[0]]->total_error) < (1/all_parameters->reduced_order_param.recomputation_coefficient) * local_mean_error)) {
             pcout << "Total error greater than tolerance. Recomputing ROM solution" << std::endl;
-            std::unique_ptr<ProperOrthogonalDecomposition::ROMSolution<dim, nstate>> rom_solution = solveSnapshotROM(rom_locations[index[0]]->parameter);
-            std::unique_ptr<ProperOrthogonalDecomposition::ROMTestLocation<dim, nstate>> rom_location = std::make_unique<ProperOrthogonalDecomposition::ROMTestLocation<dim, nstate>>(rom_locations[index[0]]->parameter, std::move(rom_solution));
-            rom_locations[index[0]] = std::move(rom_location);
+            const MatrixXd recomputed_parameter = rom_locations[index[0]]->parameter;
+            rom_locations[index[0]] = std::move(solveROMTestLocations(recomputed_parameter)[0]);
         }
     }
 }
@@ -332,7 +348,7 @@ dealii::LinearAlgebra::distributed::Vector<double> AdaptiveSampling<dim, nstate>
     this->pcout << "Solving FOM at " << parameter << std::endl;
     Parameters::AllParameters params = reinitParams(parameter);
 
-    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&params, parameter_handler);
+    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&params, parameter_handler, scheduler.group_communicator);
 
     // Solve implicit solution
     auto ode_solver_type = Parameters::ODESolverParam::ODESolverEnum::implicit_solver;
@@ -349,7 +365,7 @@ std::unique_ptr<ProperOrthogonalDecomposition::ROMSolution<dim,nstate>> Adaptive
     this->pcout << "Solving ROM at " << parameter << std::endl;
     Parameters::AllParameters params = reinitParams(parameter);
 
-    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&params, parameter_handler);
+    std::unique_ptr<FlowSolver::FlowSolver<dim,nstate>> flow_solver = FlowSolver::FlowSolverFactory<dim,nstate>::select_flow_case(&params, parameter_handler, scheduler.group_communicator);
 
     // Solve implicit solution
     auto ode_solver_type = Parameters::ODESolverParam::ODESolverEnum::pod_petrov_galerkin_solver;
@@ -371,6 +387,75 @@ std::unique_ptr<ProperOrthogonalDecomposition::ROMSolution<dim,nstate>> Adaptive
     return rom_solution;
 }
 
+template <int dim, int nstate>
+std::vector<DealiiVector> AdaptiveSampling<dim, nstate>::solveSnapshotsFOM(const MatrixXd& parameters) const{
+    std::vector<DealiiVector> fom_solutions(parameters.rows(), solution_layout);
+    const std::vector<unsigned int> task_groups = scheduler.run(parameters.rows(), [&](const unsigned int i){
+        fom_solutions[i] = solveSnapshotFOM(parameters.row(i));
+    });
+
+    for(int i = 0 ; i < parameters.rows() ; i++){
+        scheduler.broadcast_from_group(fom_solutions[i], task_groups[i]);
+    }
+    return fom_solutions;
+}
+
+template <int dim, int nstate>
+std::vector<std::unique_ptr<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>> AdaptiveSampling<dim, nstate>::solveROMTestLocations(const MatrixXd& parameters) const{
+    std::vector<std::unique_ptr<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>> rom_test_locations(parameters.rows());
+    const std::vector<unsigned int> task_groups = scheduler.run(parameters.rows(), [&](const unsigned int i){
+        std::unique_ptr<ProperOrthogonalDecomposition::ROMSolution<dim, nstate>> rom_solution = solveSnapshotROM(parameters.row(i));
+        rom_test_locations[i] = std::make_unique<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>(parameters.row(i), std::move(rom_solution), scheduler.group_communicator);
+    });
+    if(scheduler.n_groups == 1){
+        return rom_test_locations;
+    }
+
+    //The other groups rebuild each test location from the solution, gradient and error estimate of the group which computed it
+    std::vector<double> fom_to_initial_rom_errors(parameters.rows(), 0.0);
+    for(int i = 0 ; i < parameters.rows() ; i++){
+        if(rom_test_locations[i]){
+            fom_to_initial_rom_errors[i] = rom_test_locations[i]->fom_to_initial_rom_error;
+        }
+    }
+    scheduler.share_task_values(fom_to_initial_rom_errors, task_groups);
+
+    for(int i = 0 ; i < parameters.rows() ; i++){
+        DealiiVector solution(solution_layout);
+        DealiiVector gradient(solution_layout.locally_owned_elements(), solution_layout.get_mpi_communicator());
+        if(rom_test_locations[i]){
+            solution = rom_test_locations[i]->rom_solution->solution;
+            gradient = rom_test_locations[i]->rom_solution->gradient;
+        }
+        scheduler.broadcast_from_group(solution, task_groups[i]);
+        scheduler.broadcast_from_group(gradient, task_groups[i]);
+
+        if(!rom_test_locations[i]){
+            std::unique_ptr<ProperOrthogonalDecomposition::ROMSolution<dim, nstate>> rom_solution = std::make_unique<ProperOrthogonalDecomposition::ROMSolution<dim, nstate>>(reinitParams(parameters.row(i)), solution, gradient);
+            rom_test_locations[i] = std::make_unique<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>(parameters.row(i), std::move(rom_solution), fom_to_initial_rom_errors[i], scheduler.group_communicator);
+        }
+    }
+    return rom_test_locations;
+}
+
+template <int dim, int nstate>
+void AdaptiveSampling<dim, nstate>::updateROMErrors() const{
+    const std::vector<unsigned int> task_groups = scheduler.run(rom_locations.size(), [&](const unsigned int i){
+        rom_locations[i]->compute_initial_rom_to_final_rom_error(current_pod);
+    });
+
+    std::vector<double> initial_rom_to_final_rom_errors(rom_locations.size());
+    for(unsigned int i = 0 ; i < rom_locations.size() ; i++){
+        initial_rom_to_final_rom_errors[i] = rom_locations[i]->initial_rom_to_final_rom_error;
+    }
+    scheduler.share_task_values(initial_rom_to_final_rom_errors, task_groups);
+
+    for(unsigned int i = 0 ; i < rom_locations.size() ; i++){
+        rom_locations[i]->initial_rom_to_final_rom_error = initial_rom_to_final_rom_errors[i];
+        rom_locations[i]->compute_total_error();
+    }
+}
+
 template <int dim, int nstate>
 Parameters::AllParameters AdaptiveSampling<dim, nstate>::reinitParams(const RowVectorXd& parameter) const{
     // Copy all parameters
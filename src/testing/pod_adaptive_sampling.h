@@ -5,6 +5,7 @@
 #include "parameters/all_parameters.h"
 #include "reduced_order/pod_basis_online.h"
 #include "reduced_order/rom_test_location.h"
+#include "reduced_order/parallel_task_scheduler.h"
 #include <eigen/Eigen/Dense>
 #include "reduced_order/nearest_neighbors.h"
 #include "tests.h"
@@ -18,6 +19,9 @@ using Eigen::RowVectorXd;
 using Eigen::VectorXd;
 
 /// POD adaptive sampling
+/** The full-order snapshots and the ROM test locations are independent solves, distributed over the groups of processes
+ *  of the scheduler. Every group holds a replica of the POD, the snapshots and the ROM test locations on its own communicator.
+ */
 template <int dim, int nstate>
 class AdaptiveSampling: public TestsBase
 {
@@ -38,6 +42,12 @@ public:
     /// Parameter handler for storing the .prm file being ran
     const dealii::ParameterHandler &parameter_handler;
 
+    /// Distributes the snapshot and ROM solves over groups of processes
+    const ProperOrthogonalDecomposition::ParallelTaskScheduler scheduler;
+
+    /// Solution vector with the parallel layout of the group, used to receive the solutions computed by other groups
+    DealiiVector solution_layout;
+
     /// Most up to date POD basis
     std::shared_ptr<ProperOrthogonalDecomposition::OnlinePOD<dim>> current_pod;
 
@@ -65,6 +75,15 @@ public:
     /// Solve reduced-order solution
     std::unique_ptr<ProperOrthogonalDecomposition::ROMSolution<dim,nstate>> solveSnapshotROM(const RowVectorXd& parameter) const;
 
+    /// Solve the full-order snapshots at each row of parameters, concurrently on the groups
+    std::vector<DealiiVector> solveSnapshotsFOM(const MatrixXd& parameters) const;
+
+    /// Solve the ROMs and their error estimates at each row of parameters, concurrently on the groups
+    std::vector<std::unique_ptr<ProperOrthogonalDecomposition::ROMTestLocation<dim,nstate>>> solveROMTestLocations(const MatrixXd& parameters) const;
+
+    /// Update the error estimates of all the ROM test locations with the current POD, concurrently on the groups
+    void updateROMErrors() const;
+
     /// Reinitialize parameters
     Parameters::AllParameters reinitParams(const RowVectorXd& parameter) const;
 
@@ -24,6 +24,7 @@
 
 #include "mesh/high_order_grid.h"
 #include "mesh/meshmover_linear_elasticity.hpp"
+#include "parameters/parameters_linear_solver.h"
 
 /// Tests the LinearElasticity mesh movement by displacing the mesh and integrating its
 /// volume, checking against its known volume.
@@ -60,6 +61,15 @@ int main (int argc, char * argv[])
 
     using namespace PHiLiP;
 
+    // The mesh movement is solved with the default ILUT preconditioner, and compared against the AMG one.
+    dealii::ParameterHandler parameter_handler;
+    Parameters::LinearSolverParam::declare_parameters (parameter_handler);
+    parameter_handler.enter_subsection("linear solver");
+    parameter_handler.set("mesh_movement_preconditioner_type", "amg");
+    parameter_handler.leave_subsection();
+    Parameters::LinearSolverParam amg_linear_solver_param;
+    amg_linear_solver_param.parse_parameters (parameter_handler);
+
     const int initial_n_cells = 3;
     const unsigned int n_grids = 3;
     const unsigned int p_start = 1;
@@ -194,6 +204,17 @@ int main (int argc, char * argv[])
                 meshmover(high_order_grid, surface_node_displacements_vector);
             VectorType volume_displacements = meshmover.get_volume_displacements();
 
+            MeshMover::LinearElasticity<dim, double>
+                amg_meshmover(high_order_grid, surface_node_displacements_vector, amg_linear_solver_param.mesh_movement_preconditioner_type);
+            VectorType amg_volume_displacements = amg_meshmover.get_volume_displacements();
+            amg_volume_displacements -= volume_displacements;
+            const double amg_difference = amg_volume_displacements.linfty_norm();
+            if (amg_difference > 1e-8 * volume_displacements.linfty_norm()) {
+                pcout << "The volume displacements obtained with the AMG preconditioner differ by " << amg_difference
+                      << " from the ones obtained with the ILUT preconditioner." << std::endl;
+                return 1;
+            }
+
             dealii::IndexSet locally_owned_dofs = high_order_grid.dof_handler_grid.locally_owned_dofs();
             dealii::IndexSet locally_relevant_dofs;
             dealii::DoFTools::extract_locally_relevant_dofs(high_order_grid.dof_handler_grid, locally_relevant_dofs);
@@ -1,5 +1,6 @@
 #include <fstream>
 
+#include <deal.II/base/timer.h>
 #include <deal.II/grid/grid_out.h>
 #include "mesh/gmsh_reader.hpp"
 
@@ -30,7 +31,13 @@ int main (int argc, char * argv[])
     }
 
     const bool do_renumber_dofs = true;
+    dealii::Timer timer(MPI_COMM_WORLD, false);
+    timer.start();
     std::shared_ptr< HighOrderGrid<dim, double> > high_order_grid = read_gmsh <dim, dim> (filename,do_renumber_dofs);
+    timer.stop();
+    pcout << "Read " << high_order_grid->triangulation->n_global_active_cells() << " cells of order "
+          << high_order_grid->dof_handler_grid.get_fe().degree << " from " << filename
+          << " in " << timer.wall_time() << " seconds." << std::endl;
 
     dealii::GridOut gridout;
     gridout.write_mesh_per_processor_as_vtu(*(high_order_grid->triangulation), "tria");
@@ -0,0 +1,202 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parameter_handler.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dg/dg_base.hpp"
+#include "dg/dg_factory.hpp"
+#include "linear_solver/dg_block_preconditioner.h"
+#include "linear_solver/linear_solver.h"
+#include "parameters/all_parameters.h"
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+using PreconditionerEnum = PHiLiP::Parameters::LinearSolverParam::PreconditionerEnum;
+
+const double TOLERANCE = 1E-10;
+
+/// Creates the DG discretization of a mesh whose cells have different polynomial degrees.
+/** In 2D, the left cells are also refined once, such that the cells have hanging nodes and the mesh is split
+ *  between the processes. In 1D, the cells stay ordered from left to right.
+ */
+template <int dim>
+std::shared_ptr<PHiLiP::DGBase<dim,double>> create_hp_dg(const PHiLiP::Parameters::AllParameters &parameters, const unsigned int poly_degree)
+{
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+#if PHILIP_DIM!=1
+        MPI_COMM_WORLD
+#endif
+        );
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, (dim==1) ? 8 : 4, 0.0, 1.0);
+    if (dim > 1) {
+        for (const auto &cell : grid->active_cell_iterators()) {
+            if (cell->is_locally_owned() && cell->center()[0] < 0.3) cell->set_refine_flag();
+        }
+        grid->execute_coarsening_and_refinement();
+    }
+
+    const unsigned int max_degree = poly_degree + 1;
+    std::shared_ptr<PHiLiP::DGBase<dim,double>> dg = PHiLiP::DGFactory<dim,double>::create_discontinuous_galerkin(&parameters, poly_degree, max_degree, grid);
+
+    dg->triangulation->prepare_coarsening_and_refinement();
+    for (const auto &cell : dg->dof_handler.active_cell_iterators()) {
+        if (cell->is_locally_owned() && cell->center()[dim-1] > 0.5) cell->set_future_fe_index(max_degree);
+    }
+    dg->triangulation->execute_coarsening_and_refinement();
+    dg->allocate_system();
+
+    for (const auto &dof : dg->locally_owned_dofs) {
+        dg->solution[dof] = 1.0 + 0.1 * std::sin(static_cast<double>(dof));
+    }
+    dg->solution.update_ghost_values();
+    return dg;
+}
+
+/// Returns a right-hand side independent of the partition.
+VectorType create_rhs(const dealii::IndexSet &locally_owned_dofs)
+{
+    VectorType rhs;
+    rhs.reinit(locally_owned_dofs, MPI_COMM_WORLD);
+    for (const auto &dof : locally_owned_dofs) {
+        rhs[dof] = std::cos(0.7 * dof) + 0.5;
+    }
+    return rhs;
+}
+
+// Applies the DG block preconditioners to the Jacobian of an advection discretization with
+// cells of different polynomial degrees, possibly distributed over several processes.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    const int dim = PHILIP_DIM;
+    const unsigned int n_mpi = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+
+    dealii::ParameterHandler parameter_handler;
+    PHiLiP::Parameters::AllParameters::declare_parameters (parameter_handler);
+    PHiLiP::Parameters::AllParameters parameters;
+    parameters.parse_parameters (parameter_handler);
+    parameters.pde_type = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation::advection;
+    parameters.linear_solver_param.linear_solver_type = PHiLiP::Parameters::LinearSolverParam::LinearSolverEnum::gmres;
+    parameters.linear_solver_param.linear_residual = 1e-12;
+    parameters.linear_solver_param.max_iterations = 2000;
+    parameters.linear_solver_param.restart_number = 200;
+
+    const unsigned int poly_degree = 1;
+    std::shared_ptr<PHiLiP::DGBase<dim,double>> dg = create_hp_dg<dim>(parameters, poly_degree);
+    dg->assemble_residual(true);
+    const dealii::TrilinosWrappers::SparseMatrix &jacobian = dg->system_matrix;
+
+    const std::vector<std::vector<dealii::types::global_dof_index>> cell_dof_indices = dg->locally_owned_cell_dof_indices();
+    pcout << "Number of cells: " << dg->triangulation->n_global_active_cells()
+          << ", number of dofs: " << dg->dof_handler.n_dofs()
+          << ", number of processes: " << n_mpi << std::endl;
+
+    int testfail = 0;
+
+    // The cells of both polynomial degrees must be present, otherwise all the blocks have the same size.
+    unsigned int min_block_size = dealii::numbers::invalid_unsigned_int;
+    unsigned int max_block_size = 0;
+    for (const auto &cell_dofs : cell_dof_indices) {
+        min_block_size = std::min<unsigned int>(min_block_size, cell_dofs.size());
+        max_block_size = std::max<unsigned int>(max_block_size, cell_dofs.size());
+    }
+    min_block_size = dealii::Utilities::MPI::min(min_block_size, MPI_COMM_WORLD);
+    max_block_size = dealii::Utilities::MPI::max(max_block_size, MPI_COMM_WORLD);
+    if (min_block_size == max_block_size) {
+        pcout << "The test mesh does not have cells of different polynomial degrees." << std::endl;
+        testfail = 1;
+    }
+
+    const VectorType rhs = create_rhs(dg->locally_owned_dofs);
+
+    // Block Jacobi must solve each cell's diagonal block exactly, whatever the size and the dof numbering of the block.
+    {
+        PHiLiP::DGBlockPreconditioner block_jacobi;
+        block_jacobi.initialize(jacobian, cell_dof_indices, PreconditionerEnum::block_jacobi);
+        if (block_jacobi.n_blocks() != cell_dof_indices.size()) {
+            std::cout << "Block Jacobi has " << block_jacobi.n_blocks() << " blocks for " << cell_dof_indices.size() << " locally owned cells." << std::endl;
+            testfail = 1;
+        }
+
+        VectorType block_solution;
+        block_solution.reinit(rhs);
+        block_jacobi.vmult(block_solution, rhs);
+
+        double block_error = 0.0;
+        for (const auto &cell_dofs : cell_dof_indices) {
+            for (const auto &row : cell_dofs) {
+                double block_product = 0.0;
+                for (const auto &column : cell_dofs) {
+                    block_product += jacobian.el(row, column) * block_solution[column];
+                }
+                block_error = std::max(block_error, std::abs(block_product - rhs[row]));
+            }
+        }
+        block_error = dealii::Utilities::MPI::max(block_error, MPI_COMM_WORLD);
+        pcout << "Maximum error of the block Jacobi solves of the cell blocks: " << block_error << std::endl;
+        if (block_error > TOLERANCE * rhs.linfty_norm()) testfail = 1;
+    }
+
+    // On a single process in 1D, the cells are only coupled to their left and right neighbours.
+    // The block ILU(0) then has no fill and is the exact inverse of the Jacobian.
+    if (dim == 1 && n_mpi == 1) {
+        PHiLiP::DGBlockPreconditioner block_ilu0;
+        block_ilu0.initialize(jacobian, cell_dof_indices, PreconditionerEnum::block_ilu0);
+
+        VectorType product;
+        product.reinit(rhs);
+        jacobian.vmult(product, rhs);
+        VectorType ilu0_solution;
+        ilu0_solution.reinit(rhs);
+        block_ilu0.vmult(ilu0_solution, product);
+        ilu0_solution -= rhs;
+
+        const double ilu0_error = ilu0_solution.linfty_norm();
+        pcout << "Error of the block ILU(0) inverse of a block tridiagonal Jacobian: " << ilu0_error << std::endl;
+        if (ilu0_error > TOLERANCE * rhs.linfty_norm()) testfail = 1;
+    }
+
+    // Every block preconditioner must let GMRES solve the system through the linear solver's cell blocks.
+    const std::vector<PreconditionerEnum> preconditioner_types {
+        PreconditionerEnum::block_jacobi,
+        PreconditionerEnum::block_ilu0,
+        PreconditionerEnum::block_gauss_seidel
+    };
+    const std::vector<std::string> preconditioner_names { "block_jacobi", "block_ilu0", "block_gauss_seidel" };
+    for (unsigned int itype = 0; itype < preconditioner_types.size(); ++itype) {
+        PHiLiP::Parameters::LinearSolverParam linear_solver_param = parameters.linear_solver_param;
+        linear_solver_param.preconditioner_type = preconditioner_types[itype];
+
+        VectorType right_hand_side = rhs;
+        VectorType solution;
+        solution.reinit(rhs);
+        PHiLiP::solve_linear(jacobian, right_hand_side, solution, linear_solver_param, cell_dof_indices);
+
+        VectorType residual;
+        residual.reinit(rhs);
+        jacobian.vmult(residual, solution);
+        residual -= rhs;
+        const double relative_residual = residual.l2_norm() / rhs.l2_norm();
+        pcout << "Relative residual of GMRES with " << preconditioner_names[itype] << ": " << relative_residual << std::endl;
+        if (relative_residual > 1e-8) testfail = 1;
+    }
+
+    if (testfail) {
+        pcout << "The DG block preconditioners failed on cells of different sizes." << std::endl;
+    }
+    return testfail;
+}
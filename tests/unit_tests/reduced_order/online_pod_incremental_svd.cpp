@@ -0,0 +1,101 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <eigen/Eigen/SVD>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "reduced_order/pod_basis_online.h"
+
+// Compares the incrementally updated POD of OnlinePOD with the SVD of all the centered snapshots.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    const unsigned int n_mpi = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    const unsigned int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP::ProperOrthogonalDecomposition;
+
+    const unsigned int n_dofs = 200;
+    const unsigned int n_distinct_snapshots = 7;
+    const double tolerance = 1e-9;
+
+    dealii::IndexSet locally_owned_dofs(n_dofs);
+    locally_owned_dofs.add_range(mpi_rank * n_dofs / n_mpi, (mpi_rank+1) * n_dofs / n_mpi);
+    dealii::DynamicSparsityPattern sparsity_pattern(n_dofs);
+    for (const auto &dof : locally_owned_dofs) {
+        sparsity_pattern.add(dof, dof);
+    }
+    std::shared_ptr<dealii::TrilinosWrappers::SparseMatrix> system_matrix = std::make_shared<dealii::TrilinosWrappers::SparseMatrix>();
+    system_matrix->reinit(locally_owned_dofs, locally_owned_dofs, sparsity_pattern, MPI_COMM_WORLD);
+
+    // Independent snapshots followed by a repeated one, which lies in the current subspace.
+    MatrixXd all_snapshots(n_dofs, n_distinct_snapshots + 1);
+    for (unsigned int j = 0; j < n_distinct_snapshots + 1; ++j) {
+        const double wavenumber = (j < n_distinct_snapshots) ? j + 1.0 : 1.0;
+        for (unsigned int i = 0; i < n_dofs; ++i) {
+            const double x = i / (n_dofs - 1.0);
+            all_snapshots(i,j) = std::sin(M_PI * wavenumber * x) / wavenumber + x;
+        }
+    }
+
+    OnlinePOD<PHILIP_DIM> pod(system_matrix);
+    dealii::LinearAlgebra::distributed::Vector<double> snapshot(locally_owned_dofs, MPI_COMM_WORLD);
+    for (int j = 0; j < all_snapshots.cols(); ++j) {
+        for (const auto &dof : locally_owned_dofs) {
+            snapshot[dof] = all_snapshots(dof,j);
+        }
+        pod.addSnapshot(snapshot);
+    }
+    pod.computeBasis();
+
+    const VectorXd mean = all_snapshots.rowwise().mean();
+    const MatrixXd centered_snapshots = all_snapshots.colwise() - mean;
+    Eigen::BDCSVD<MatrixXd, Eigen::DecompositionOptions::ComputeThinU> svd(centered_snapshots);
+    const VectorXd &reference_singular_values = svd.singularValues();
+    const MatrixXd &reference_basis = svd.matrixU();
+
+    int testfail = 0;
+
+    const int n_modes = pod.singularValues.size();
+    for (int i = 0; i < reference_singular_values.size(); ++i) {
+        const double online_singular_value = (i < n_modes) ? pod.singularValues(i) : 0.0;
+        const double error = std::abs(online_singular_value - reference_singular_values(i)) / reference_singular_values(0);
+        pcout << "Singular value " << i << ": online " << online_singular_value << " reference " << reference_singular_values(i) << std::endl;
+        if (error > tolerance) testfail = 1;
+    }
+
+    const dealii::LinearAlgebra::ReadWriteVector<double> reference_state = pod.getReferenceState();
+    double mean_error = 0.0;
+    for (const auto &dof : locally_owned_dofs) {
+        mean_error = std::max(mean_error, std::abs(reference_state[dof] - mean(dof)));
+    }
+    mean_error = dealii::Utilities::MPI::max(mean_error, MPI_COMM_WORLD);
+    pcout << "Reference state error: " << mean_error << std::endl;
+    if (mean_error > tolerance) testfail = 1;
+
+    // The left singular vectors are compared up to their sign, where the singular values are well separated from zero.
+    const Epetra_MultiVector &dense_basis = *pod.getPODBasisDense();
+    for (int mode = 0; mode < n_modes; ++mode) {
+        if (reference_singular_values(mode) < 1e-6 * reference_singular_values(0)) break;
+        double alignment = 0.0;
+        for (const auto &dof : locally_owned_dofs) {
+            alignment += dense_basis[mode][locally_owned_dofs.index_within_set(dof)] * reference_basis(dof, mode);
+        }
+        alignment = dealii::Utilities::MPI::sum(alignment, MPI_COMM_WORLD);
+        pcout << "Mode " << mode << " alignment with the reference mode: " << alignment << std::endl;
+        if (std::abs(std::abs(alignment) - 1.0) > 1e-7) testfail = 1;
+    }
+
+    if (testfail) {
+        pcout << "Incrementally updated POD does not match the SVD of the snapshots." << std::endl;
+    }
+    return testfail;
+}
@@ -0,0 +1,72 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "reduced_order/parallel_task_scheduler.h"
+
+// Checks that every task is executed by exactly one group and that the results of the groups are shared.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    const unsigned int n_mpi = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    const unsigned int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP::ProperOrthogonalDecomposition;
+
+    const unsigned int n_groups = (n_mpi % 2 == 0) ? 2 : 1;
+    const ParallelTaskScheduler scheduler(MPI_COMM_WORLD, n_groups);
+    const unsigned int group_size = dealii::Utilities::MPI::n_mpi_processes(scheduler.group_communicator);
+
+    int testfail = 0;
+
+    // Each task sums its index over the processes of the group executing it.
+    const unsigned int n_tasks = 13;
+    std::vector<double> task_values(n_tasks, -1.0);
+    std::vector<unsigned int> n_executions(n_tasks, 0);
+    const std::vector<unsigned int> task_groups = scheduler.run(n_tasks, [&](const unsigned int itask){
+        task_values[itask] = dealii::Utilities::MPI::sum(itask + 1.0, scheduler.group_communicator);
+        if (scheduler.group_rank == 0) n_executions[itask] += 1;
+    });
+    MPI_Allreduce(MPI_IN_PLACE, n_executions.data(), n_tasks, MPI_UNSIGNED, MPI_SUM, MPI_COMM_WORLD);
+    for (unsigned int itask = 0; itask < n_tasks; ++itask) {
+        if (n_executions[itask] != 1) {
+            pcout << "Task " << itask << " was executed " << n_executions[itask] << " times." << std::endl;
+            testfail = 1;
+        }
+        if (task_groups[itask] >= n_groups) testfail = 1;
+    }
+
+    scheduler.share_task_values(task_values, task_groups);
+    for (unsigned int itask = 0; itask < n_tasks; ++itask) {
+        if (std::abs(task_values[itask] - (itask + 1.0) * group_size) > 1e-12) {
+            std::cout << "Process " << mpi_rank << " received " << task_values[itask] << " for task " << itask << std::endl;
+            testfail = 1;
+        }
+    }
+
+    // Every group distributes the same vector identically, such that the last group can overwrite the others.
+    const unsigned int n_dofs = 20;
+    const dealii::IndexSet locally_owned_dofs = dealii::Utilities::MPI::create_evenly_distributed_partitioning(scheduler.group_communicator, n_dofs);
+    dealii::LinearAlgebra::distributed::Vector<double> vector(locally_owned_dofs, scheduler.group_communicator);
+    for (const auto &dof : locally_owned_dofs) {
+        vector[dof] = dof + 100.0 * scheduler.group_id;
+    }
+    const unsigned int source_group = n_groups - 1;
+    scheduler.broadcast_from_group(vector, source_group);
+    for (const auto &dof : locally_owned_dofs) {
+        if (vector[dof] != dof + 100.0 * source_group) testfail = 1;
+    }
+
+    testfail = dealii::Utilities::MPI::max(testfail, MPI_COMM_WORLD);
+    if (testfail) {
+        pcout << "Parallel task scheduler failed." << std::endl;
+    }
+    return testfail;
+}
@@ -0,0 +1,102 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <Epetra_Map.h>
+#include <Epetra_MpiComm.h>
+#include <Epetra_MultiVector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "reduced_order/snapshot_file.h"
+
+/// Value of degree of freedom i of snapshot j.
+double snapshot_value(const unsigned int i, const unsigned int j)
+{
+    return std::sin(0.1 * i * (j + 1.0)) + j;
+}
+
+// Writes snapshots with one parallel layout and reads them back with another, as done with a different number of processes.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    const unsigned int n_mpi = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    const unsigned int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP::ProperOrthogonalDecomposition;
+
+    const unsigned int n_dofs = 101;
+    const unsigned int n_snapshots = 3;
+    const std::string filename = "unit_test.snapshots";
+    const SnapshotFileHeader header = snapshot_file_header(n_dofs, 2, 12345);
+
+    // Written with the degrees of freedom split evenly over the processes.
+    dealii::IndexSet write_dofs(n_dofs);
+    write_dofs.add_range(mpi_rank * n_dofs / n_mpi, (mpi_rank+1) * n_dofs / n_mpi);
+    dealii::LinearAlgebra::distributed::Vector<double> snapshot(write_dofs, MPI_COMM_WORLD);
+
+    const SnapshotFileOrdering write_ordering(write_dofs);
+    const SnapshotFile snapshot_file(filename, MPI_COMM_WORLD);
+    for (unsigned int j = 0; j < n_snapshots; ++j) {
+        for (const auto &dof : write_dofs) {
+            snapshot[dof] = snapshot_value(dof, j);
+        }
+        // Writing the first snapshot discards the content of a previous run.
+        if (j == 0) snapshot_file.write(snapshot, write_ordering, header);
+        else snapshot_file.append(snapshot, write_ordering, header);
+    }
+
+    int testfail = 0;
+
+    const SnapshotFileHeader file_header = snapshot_file.read_header();
+    if (file_header.n_snapshots != n_snapshots || !snapshot_file.is_compatible(file_header, header)) {
+        pcout << "Snapshot file header does not match the written snapshots." << std::endl;
+        testfail = 1;
+    }
+
+    // Read with a single row on every process but the last, which owns all the other rows.
+    const int n_read_rows = (mpi_rank + 1 == n_mpi) ? n_dofs - (n_mpi - 1) : 1;
+    Epetra_MpiComm epetra_comm(MPI_COMM_WORLD);
+    const Epetra_Map read_map(static_cast<int>(n_dofs), n_read_rows, 0, epetra_comm);
+    Epetra_MultiVector read_snapshots(read_map, n_snapshots + 1);
+    dealii::IndexSet read_rows(n_dofs);
+    read_rows.add_range(read_map.MinMyGID(), read_map.MaxMyGID() + 1);
+    snapshot_file.read(read_snapshots, 1, SnapshotFileOrdering(read_rows));
+
+    double read_error = 0.0;
+    for (int local_row = 0; local_row < read_map.NumMyElements(); ++local_row) {
+        const int row = read_map.GID(local_row);
+        for (unsigned int j = 0; j < n_snapshots; ++j) {
+            read_error = std::max(read_error, std::abs(read_snapshots[j+1][local_row] - snapshot_value(row, j)));
+        }
+    }
+
+    dealii::LinearAlgebra::distributed::Vector<double> read_snapshot(write_dofs, MPI_COMM_WORLD);
+    snapshot_file.read(1, write_ordering, read_snapshot);
+    for (const auto &dof : write_dofs) {
+        read_error = std::max(read_error, std::abs(read_snapshot[dof] - snapshot_value(dof, 1)));
+    }
+
+    // The mapped file exposes the snapshots in the global ordering, as written.
+    if (mpi_rank == 0) {
+        const MappedSnapshotFile mapped_file(filename);
+        for (unsigned int j = 0; j < n_snapshots; ++j) {
+            for (unsigned int i = 0; i < n_dofs; ++i) {
+                read_error = std::max(read_error, std::abs(mapped_file.snapshot(j)[i] - snapshot_value(i, j)));
+            }
+        }
+    }
+    read_error = dealii::Utilities::MPI::max(read_error, MPI_COMM_WORLD);
+    pcout << "Maximum error of the values read: " << read_error << std::endl;
+    if (read_error != 0.0) testfail = 1;
+
+    if (testfail) {
+        pcout << "Snapshots read from the snapshot file do not match the snapshots written." << std::endl;
+    }
+    return testfail;
+}
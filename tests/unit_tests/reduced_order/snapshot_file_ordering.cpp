@@ -0,0 +1,109 @@
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parameter_handler.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+#include "dg/dg_base.hpp"
+#include "dg/dg_factory.hpp"
+#include "parameters/all_parameters.h"
+#include "reduced_order/snapshot_file.h"
+
+const double TOLERANCE = 1E-14;
+
+/// Value of local degree of freedom idof of the cell centered at center, independent of the DoF numbering.
+template <int dim>
+double cell_value(const dealii::Point<dim> &center, const unsigned int idof)
+{
+    double value = idof;
+    for (int d = 0; d < dim; ++d) value += std::sin((d + 1.0) * center[d]);
+    return value;
+}
+
+/// Creates a DG discretization of a locally refined square, such that the cells have different levels.
+template <int dim>
+std::shared_ptr<PHiLiP::DGBase<dim,double>> create_dg(const PHiLiP::Parameters::AllParameters &parameters, const unsigned int poly_degree)
+{
+    using Triangulation = dealii::parallel::distributed::Triangulation<dim>;
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(MPI_COMM_WORLD);
+    dealii::GridGenerator::hyper_cube(*grid, 0.0, 1.0);
+    grid->refine_global(3);
+    for (const auto &cell : grid->active_cell_iterators()) {
+        if (cell->is_locally_owned() && cell->center()[0] < 0.3) cell->set_refine_flag();
+    }
+    grid->execute_coarsening_and_refinement();
+
+    std::shared_ptr<PHiLiP::DGBase<dim,double>> dg = PHiLiP::DGFactory<dim,double>::create_discontinuous_galerkin(&parameters, poly_degree, grid);
+    dg->allocate_system();
+
+    std::vector<dealii::types::global_dof_index> dof_indices;
+    for (const auto &cell : dg->dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) continue;
+        dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(dof_indices);
+        for (unsigned int idof = 0; idof < dof_indices.size(); ++idof) {
+            dg->solution[dof_indices[idof]] = cell_value(cell->center(), idof);
+        }
+    }
+    dg->solution.update_ghost_values();
+    return dg;
+}
+
+// Writes a DG solution numbered with Cuthill-McKee and reads it back into a discretization without renumbering.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    const int dim = PHILIP_DIM;
+    dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+
+    using namespace PHiLiP::ProperOrthogonalDecomposition;
+
+    dealii::ParameterHandler parameter_handler;
+    PHiLiP::Parameters::AllParameters::declare_parameters (parameter_handler);
+    PHiLiP::Parameters::AllParameters renumbered_parameters;
+    renumbered_parameters.parse_parameters (parameter_handler);
+    renumbered_parameters.pde_type = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation::advection;
+    renumbered_parameters.do_renumber_dofs = true;
+    PHiLiP::Parameters::AllParameters parameters;
+    parameters.parse_parameters (parameter_handler);
+    parameters.pde_type = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation::advection;
+    parameters.do_renumber_dofs = false;
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr<PHiLiP::DGBase<dim,double>> renumbered_dg = create_dg<dim>(renumbered_parameters, poly_degree);
+    std::shared_ptr<PHiLiP::DGBase<dim,double>> dg = create_dg<dim>(parameters, poly_degree);
+
+    int testfail = 0;
+
+    const SnapshotFileHeader header = snapshot_file_header(*renumbered_dg);
+    if (header.mesh_hash != snapshot_file_header(*dg).mesh_hash) {
+        pcout << "The mesh hash depends on the numbering of the degrees of freedom." << std::endl;
+        testfail = 1;
+    }
+
+    const std::string filename = "unit_test_ordering.snapshots";
+    const SnapshotFile snapshot_file(filename, MPI_COMM_WORLD);
+    snapshot_file.write(renumbered_dg->solution, SnapshotFileOrdering(*renumbered_dg), header);
+
+    dealii::LinearAlgebra::distributed::Vector<double> read_solution;
+    read_solution.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    snapshot_file.read(0, SnapshotFileOrdering(*dg), read_solution);
+
+    double read_error = 0.0;
+    for (const auto &dof : dg->locally_owned_dofs) {
+        read_error = std::max(read_error, std::abs(read_solution[dof] - dg->solution[dof]));
+    }
+    read_error = dealii::Utilities::MPI::max(read_error, MPI_COMM_WORLD);
+    pcout << "Maximum error of the values read with another numbering: " << read_error << std::endl;
+    if (read_error > TOLERANCE) testfail = 1;
+
+    if (testfail) {
+        pcout << "The snapshot file ordering depends on the numbering of the degrees of freedom." << std::endl;
+    }
+    return testfail;
+}
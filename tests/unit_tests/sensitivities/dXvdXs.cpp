@@ -305,6 +305,21 @@ int main (int argc, char * argv[])
                     std::abort();
                 }
 
+                // The multiple right-hand side solve of evaluate_dXvdXs() should match the single right-hand side solve.
+                VectorType unit_rhs, dXvdXs_column;
+                unit_rhs.reinit(meshmover.displacement_solution);
+                if (iown) unit_rhs[corresponding_volume_dof] = 1.0;
+                unit_rhs.update_ghost_values();
+                dXvdXs_column.reinit(unit_rhs);
+                meshmover.apply_dXvdXvs(unit_rhs, dXvdXs_column);
+                dXvdXs_column.add(-1.0,meshmover.dXvdXs[isurface]);
+                const double column_error = dXvdXs_column.l2_norm();
+                pcout << "L2-norm of the difference with the single right-hand side solve: " << column_error << std::endl;
+                if (column_error > TOL) {
+                    pcout << "The multiple right-hand side dXvdXs differs from the single right-hand side one." << std::endl;
+                    std::abort();
+                }
+
                 if (iown) surface_node_displacements_vector[isurface] = old_value;
                 surface_node_displacements_vector.update_ghost_values();
             }